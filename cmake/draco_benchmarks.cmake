@@ -0,0 +1,30 @@
+if(DRACO_CMAKE_DRACO_BENCHMARKS_CMAKE)
+  return()
+endif()
+set(DRACO_CMAKE_DRACO_BENCHMARKS_CMAKE 1)
+
+# Every benchmark is a standalone executable named after its source file.
+list(APPEND draco_benchmark_sources
+            "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_delta_benchmark.cc"
+            "${draco_src_root}/compression/entropy/rans_benchmark.cc"
+            "${draco_src_root}/compression/entropy/symbol_decoding_benchmark.cc"
+            "${draco_src_root}/core/bit_decoder_benchmark.cc"
+            "${draco_src_root}/mesh/corner_table_benchmark.cc")
+
+macro(draco_setup_benchmark_targets)
+  if(DRACO_BENCHMARKS)
+    foreach(benchmark_source ${draco_benchmark_sources})
+      get_filename_component(benchmark_name "${benchmark_source}" NAME_WE)
+      draco_add_executable(NAME
+                           draco_${benchmark_name}
+                           SOURCES
+                           ${benchmark_source}
+                           DEFINES
+                           ${draco_defines}
+                           INCLUDES
+                           ${draco_include_paths}
+                           LIB_DEPS
+                           ${draco_dependency})
+    endforeach()
+  endif()
+endmacro()
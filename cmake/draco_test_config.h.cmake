@@ -9,5 +9,6 @@
 
 #define DRACO_TEST_DATA_DIR "${DRACO_TEST_DATA_DIR}"
 #define DRACO_TEST_TEMP_DIR "${DRACO_TEST_TEMP_DIR}"
+#define DRACO_TEST_TOOLS_DIR "${DRACO_TEST_TOOLS_DIR}"
 
 #endif  // DRACO_TESTING_DRACO_TEST_CONFIG_H_
@@ -16,26 +16,35 @@ list(
     "${draco_src_root}/animation/keyframe_animation_encoding_test.cc"
     "${draco_src_root}/animation/keyframe_animation_test.cc"
     "${draco_src_root}/attributes/point_attribute_test.cc"
+    "${draco_src_root}/compression/attributes/normal_compression_utils_test.cc"
     "${draco_src_root}/compression/attributes/point_d_vector_test.cc"
+    "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels_test.cc"
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_transform_test.cc"
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_transform_test.cc"
     "${draco_src_root}/compression/attributes/sequential_integer_attribute_encoding_test.cc"
+    "${draco_src_root}/compression/batch_decoder_test.cc"
     "${draco_src_root}/compression/bit_coders/rans_coding_test.cc"
     "${draco_src_root}/compression/decode_test.cc"
     "${draco_src_root}/compression/encode_test.cc"
     "${draco_src_root}/compression/entropy/shannon_entropy_test.cc"
     "${draco_src_root}/compression/entropy/symbol_coding_test.cc"
+    "${draco_src_root}/compression/mesh/chunked_mesh_encoding_test.cc"
     "${draco_src_root}/compression/mesh/mesh_edgebreaker_encoding_test.cc"
     "${draco_src_root}/compression/mesh/mesh_encoder_test.cc"
+    "${draco_src_root}/compression/mesh/progressive_mesh_encoding_test.cc"
     "${draco_src_root}/compression/point_cloud/point_cloud_kd_tree_encoding_test.cc"
     "${draco_src_root}/compression/point_cloud/point_cloud_sequential_encoding_test.cc"
+    "${draco_src_root}/compression/point_cloud/split_container_test.cc"
+    "${draco_src_root}/core/arena_test.cc"
     "${draco_src_root}/core/buffer_bit_coding_test.cc"
+    "${draco_src_root}/core/data_buffer_test.cc"
     "${draco_src_root}/core/draco_test_base.h"
     "${draco_src_root}/core/draco_test_utils.cc"
     "${draco_src_root}/core/draco_test_utils.h"
     "${draco_src_root}/core/math_utils_test.cc"
     "${draco_src_root}/core/quantization_utils_test.cc"
     "${draco_src_root}/core/status_test.cc"
+    "${draco_src_root}/core/thread_pool_test.cc"
     "${draco_src_root}/core/vector_d_test.cc"
     "${draco_src_root}/io/file_reader_test_common.h"
     "${draco_src_root}/io/file_utils_test.cc"
@@ -46,13 +55,16 @@ list(
     "${draco_src_root}/io/ply_decoder_test.cc"
     "${draco_src_root}/io/ply_reader_test.cc"
     "${draco_src_root}/io/point_cloud_io_test.cc"
+    "${draco_src_root}/mesh/compact_corner_table_test.cc"
+    "${draco_src_root}/mesh/corner_table_test.cc"
     "${draco_src_root}/mesh/mesh_are_equivalent_test.cc"
     "${draco_src_root}/mesh/mesh_cleanup_test.cc"
     "${draco_src_root}/mesh/triangle_soup_mesh_builder_test.cc"
     "${draco_src_root}/metadata/metadata_encoder_test.cc"
     "${draco_src_root}/metadata/metadata_test.cc"
     "${draco_src_root}/point_cloud/point_cloud_builder_test.cc"
-    "${draco_src_root}/point_cloud/point_cloud_test.cc")
+    "${draco_src_root}/point_cloud/point_cloud_test.cc"
+    "${draco_src_root}/tools/draco_tools_test.cc")
 
 list(APPEND draco_gtest_all
             "${draco_root}/../googletest/googletest/src/gtest-all.cc")
@@ -96,8 +108,9 @@ macro(draco_setup_test_targets)
     set(DRACO_TEST_DATA_DIR "${draco_root}/testdata")
     set(DRACO_TEST_TEMP_DIR "${draco_build}/draco_test_temp")
     file(MAKE_DIRECTORY "${DRACO_TEST_TEMP_DIR}")
+    set(DRACO_TEST_TOOLS_DIR "${draco_build}")
 
-    # Sets DRACO_TEST_DATA_DIR and DRACO_TEST_TEMP_DIR.
+    # Sets DRACO_TEST_DATA_DIR, DRACO_TEST_TEMP_DIR and DRACO_TEST_TOOLS_DIR.
     configure_file("${draco_root}/cmake/draco_test_config.h.cmake"
                    "${draco_build}/testing/draco_test_config.h")
 
@@ -116,6 +129,11 @@ macro(draco_setup_test_targets)
                          draco_gtest
                          draco_gtest_main)
 
+    # The tool tests run the command line encoder and decoder.
+    if(TARGET draco_encoder AND TARGET draco_decoder)
+      add_dependencies(draco_tests draco_encoder draco_decoder)
+    endif()
+
     draco_add_executable(NAME
                          draco_factory_tests
                          SOURCES
@@ -16,6 +16,7 @@
 #define DRACO_ATTRIBUTES_GEOMETRY_ATTRIBUTE_H_
 
 #include <array>
+#include <cstring>
 #include <limits>
 
 #include "draco/attributes/geometry_indices.h"
@@ -143,6 +144,38 @@ class GeometryAttribute {
     return ConvertValue(att_id, out_att_components_t, out_val);
   }
 
+  // Function for conversion of |num_values| consecutive attribute values
+  // starting at |first_index| to a specific output format. The converted
+  // values are stored one after another in |out_values| that needs to be able
+  // to store |num_values| * |out_num_components| values. Unlike calling
+  // ConvertValue() for each entry, the data type of the attribute is resolved
+  // only once for the whole range.
+  // OutT is the desired data type of the attribute.
+  // Returns false when the conversion failed.
+  template <typename OutT>
+  bool ConvertValues(AttributeValueIndex first_index, int num_values,
+                     int8_t out_num_components, OutT *out_values) const {
+    const int64_t first_byte_pos = GetBytePos(first_index);
+    const int64_t byte_stride = byte_stride_;
+    // Values without gaps between them are converted as one flat array.
+    const bool packed =
+        out_num_components == num_components_ &&
+        byte_stride_ == num_components_ * DataTypeLength(data_type_);
+    return ConvertValues(num_values, out_num_components, out_values, packed,
+                         [first_byte_pos, byte_stride](int i) {
+                           return first_byte_pos + byte_stride * i;
+                         });
+  }
+
+  // Same as above but each output value stores all components of a single
+  // attribute entry.
+  template <typename OutT>
+  bool ConvertValues(AttributeValueIndex first_index, int num_values,
+                     OutT *out_values) const {
+    return ConvertValues<OutT>(first_index, num_values, num_components_,
+                               out_values);
+  }
+
   // Function for conversion of a attribute to a specific output format.
   // |out_val| needs to be able to store |out_num_components| values.
   // OutT is the desired data type of the attribute.
@@ -254,6 +287,58 @@ class GeometryAttribute {
   void ResetBuffer(DataBuffer *buffer, int64_t byte_stride,
                    int64_t byte_offset);
 
+  // Converts |num_values| attribute entries to a specific output format and
+  // stores them one after another in |out_values|. The byte position of the
+  // i-th converted entry in the buffer is given by |byte_pos_fn(i)|. When
+  // |packed| is set, the entries must be stored next to each other without
+  // any gaps and with |out_num_components| equal to num_components().
+  template <typename OutT, typename BytePosFnT>
+  bool ConvertValues(int num_values, int8_t out_num_components,
+                     OutT *out_values, bool packed,
+                     const BytePosFnT &byte_pos_fn) const {
+    if (out_values == nullptr || num_values < 0 || out_num_components < 0) {
+      return false;
+    }
+    switch (data_type_) {
+      case DT_INT8:
+        return ConvertTypedValues<int8_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_UINT8:
+        return ConvertTypedValues<uint8_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_INT16:
+        return ConvertTypedValues<int16_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_UINT16:
+        return ConvertTypedValues<uint16_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_INT32:
+        return ConvertTypedValues<int32_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_UINT32:
+        return ConvertTypedValues<uint32_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_INT64:
+        return ConvertTypedValues<int64_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_UINT64:
+        return ConvertTypedValues<uint64_t, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_FLOAT32:
+        return ConvertTypedValues<float, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_FLOAT64:
+        return ConvertTypedValues<double, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      case DT_BOOL:
+        return ConvertTypedValues<bool, OutT>(
+            num_values, out_num_components, out_values, packed, byte_pos_fn);
+      default:
+        // Wrong attribute type.
+        return false;
+    }
+  }
+
  private:
   // Function for conversion of an attribute to a specific output format given a
   // format of the stored attribute.
@@ -270,35 +355,118 @@ class GeometryAttribute {
         return false;
       }
       const T in_value = *reinterpret_cast<const T *>(src_address);
+      if (!ConvertComponent<T, OutT>(in_value, out_value + i)) {
+        return false;
+      }
+      src_address += sizeof(T);
+    }
+    // Fill empty data for unused output components if needed.
+    for (int i = num_components_; i < out_num_components; ++i) {
+      out_value[i] = static_cast<OutT>(0);
+    }
+    return true;
+  }
+
+  // Same as ConvertTypedValue() but for |num_values| entries whose byte
+  // positions are given by |byte_pos_fn|. Bounds are checked once per entry
+  // rather than once per component, or once for all |packed| entries.
+  template <typename T, typename OutT, typename BytePosFnT>
+  bool ConvertTypedValues(int num_values, int8_t out_num_components,
+                          OutT *out_values, bool packed,
+                          const BytePosFnT &byte_pos_fn) const {
+    const int num_converted_components =
+        std::min<int>(num_components_, out_num_components);
+    const int64_t converted_size = num_converted_components * sizeof(T);
+    const DataBuffer *const buffer = buffer_;
+    const uint8_t *const data = buffer->data();
+    const int64_t data_size = buffer->data_size();
+    if (packed && num_values > 0) {
+      const int64_t byte_pos = byte_pos_fn(0);
+      if (byte_pos < 0 || byte_pos + converted_size * num_values > data_size) {
+        return false;
+      }
+      return ConvertTypedComponents<T, OutT>(
+          data + byte_pos, static_cast<int64_t>(num_values) * num_components_,
+          out_values);
+    }
+    for (int v = 0; v < num_values; ++v) {
+      const int64_t byte_pos = byte_pos_fn(v);
+      if (byte_pos < 0 || byte_pos + converted_size > data_size) {
+        return false;
+      }
+      const uint8_t *const src_address = data + byte_pos;
+      for (int i = 0; i < num_converted_components; ++i) {
+        T in_value;
+        memcpy(&in_value, src_address + i * sizeof(T), sizeof(T));
+        if (!ConvertComponent<T, OutT>(in_value, out_values + i)) {
+          return false;
+        }
+      }
+      for (int i = num_converted_components; i < out_num_components; ++i) {
+        out_values[i] = static_cast<OutT>(0);
+      }
+      out_values += out_num_components;
+    }
+    return true;
+  }
 
-      // Make sure the in_value fits within the range of values that OutT
-      // is able to represent. Perform the check only for integral types.
-      if (std::is_integral<T>::value && std::is_integral<OutT>::value) {
-        static constexpr OutT kOutMin =
-            std::is_signed<T>::value ? std::numeric_limits<OutT>::lowest() : 0;
-        if (in_value < kOutMin || in_value > std::numeric_limits<OutT>::max()) {
+  // Converts |num_components| components stored one after another starting
+  // at |src_address|. The check of the value range and the normalization are
+  // resolved outside of the loops so that the compiler can vectorize them.
+  template <typename T, typename OutT>
+  bool ConvertTypedComponents(const uint8_t *src_address,
+                              int64_t num_components, OutT *out_values) const {
+    if (std::is_integral<T>::value && std::is_integral<OutT>::value) {
+      for (int64_t i = 0; i < num_components; ++i) {
+        T in_value;
+        memcpy(&in_value, src_address + i * sizeof(T), sizeof(T));
+        if (!ConvertComponent<T, OutT>(in_value, out_values + i)) {
           return false;
         }
       }
+    } else if (std::is_integral<T>::value && normalized_) {
+      const OutT max_value = static_cast<OutT>(std::numeric_limits<T>::max());
+      for (int64_t i = 0; i < num_components; ++i) {
+        T in_value;
+        memcpy(&in_value, src_address + i * sizeof(T), sizeof(T));
+        out_values[i] = static_cast<OutT>(in_value) / max_value;
+      }
+    } else {
+      for (int64_t i = 0; i < num_components; ++i) {
+        T in_value;
+        memcpy(&in_value, src_address + i * sizeof(T), sizeof(T));
+        out_values[i] = static_cast<OutT>(in_value);
+      }
+    }
+    return true;
+  }
 
-      out_value[i] = static_cast<OutT>(in_value);
-      // When converting integer to floating point, normalize the value if
-      // necessary.
-      if (std::is_integral<T>::value && std::is_floating_point<OutT>::value &&
-          normalized_) {
-        out_value[i] /= static_cast<OutT>(std::numeric_limits<T>::max());
+  // Converts a single component |in_value| of the attribute to the output
+  // format. Returns false when the value can't be represented by OutT.
+  template <typename T, typename OutT>
+  bool ConvertComponent(T in_value, OutT *out_value) const {
+    // Make sure the in_value fits within the range of values that OutT
+    // is able to represent. Perform the check only for integral types.
+    if (std::is_integral<T>::value && std::is_integral<OutT>::value) {
+      static constexpr OutT kOutMin =
+          std::is_signed<T>::value ? std::numeric_limits<OutT>::lowest() : 0;
+      if (in_value < kOutMin || in_value > std::numeric_limits<OutT>::max()) {
+        return false;
       }
-      // TODO(ostava): Add handling of normalized attributes when converting
-      // between different integer representations. If the attribute is
-      // normalized, integer values should be converted as if they represent 0-1
-      // range. E.g. when we convert uint16 to uint8, the range <0, 2^16 - 1>
-      // should be converted to range <0, 2^8 - 1>.
-      src_address += sizeof(T);
     }
-    // Fill empty data for unused output components if needed.
-    for (int i = num_components_; i < out_num_components; ++i) {
-      out_value[i] = static_cast<OutT>(0);
+
+    *out_value = static_cast<OutT>(in_value);
+    // When converting integer to floating point, normalize the value if
+    // necessary.
+    if (std::is_integral<T>::value && std::is_floating_point<OutT>::value &&
+        normalized_) {
+      *out_value /= static_cast<OutT>(std::numeric_limits<T>::max());
     }
+    // TODO(ostava): Add handling of normalized attributes when converting
+    // between different integer representations. If the attribute is
+    // normalized, integer values should be converted as if they represent 0-1
+    // range. E.g. when we convert uint16 to uint8, the range <0, 2^16 - 1>
+    // should be converted to range <0, 2^8 - 1>.
     return true;
   }
 
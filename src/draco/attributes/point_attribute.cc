@@ -43,6 +43,21 @@ void PointAttribute::Init(Type attribute_type, int8_t num_components,
   SetIdentityMapping();
 }
 
+bool PointAttribute::Init(Type attribute_type, int8_t num_components,
+                          DataType data_type, bool normalized,
+                          size_t num_attribute_values,
+                          std::unique_ptr<DataBuffer> buffer) {
+  if (buffer == nullptr) {
+    return false;
+  }
+  attribute_buffer_ = std::move(buffer);
+  GeometryAttribute::Init(attribute_type, attribute_buffer_.get(),
+                          num_components, data_type, normalized,
+                          DataTypeLength(data_type) * num_components, 0);
+  SetIdentityMapping();
+  return Reset(num_attribute_values);
+}
+
 void PointAttribute::CopyFrom(const PointAttribute &src_att) {
   if (buffer() == nullptr) {
     // If the destination attribute doesn't have a valid buffer, create it.
@@ -46,6 +46,15 @@ class PointAttribute : public GeometryAttribute {
   void Init(Type attribute_type, int8_t num_components, DataType data_type,
             bool normalized, size_t num_attribute_values);
 
+  // Same as above, but the attribute values are stored in |buffer| that can
+  // use external memory (see DataBuffer::SetExternalData()). Existing content
+  // of |buffer| is kept, so values already stored in the external memory are
+  // used without a copy. Returns false when |buffer| can't hold
+  // |num_attribute_values| entries.
+  bool Init(Type attribute_type, int8_t num_components, DataType data_type,
+            bool normalized, size_t num_attribute_values,
+            std::unique_ptr<DataBuffer> buffer);
+
   // Copies attribute data from the provided |src_att| attribute.
   void CopyFrom(const PointAttribute &src_att);
 
@@ -109,6 +118,58 @@ class PointAttribute : public GeometryAttribute {
     return GetValue(mapped_index(point_index), out_data);
   }
 
+  // Same as GetMappedValue(), but for |num_points| points starting at
+  // |first_point|. |out_data| must be at least |num_points| * byte_stride()
+  // long. Values of attributes with identity mapping are copied at once.
+  void GetMappedValues(PointIndex first_point, int num_points,
+                       void *out_data) const {
+    uint8_t *const out_bytes = static_cast<uint8_t *>(out_data);
+    if (identity_mapping_) {
+      buffer()->Read(GetBytePos(AttributeValueIndex(first_point.value())),
+                     out_bytes, num_points * byte_stride());
+      return;
+    }
+    for (int i = 0; i < num_points; ++i) {
+      GetValue(indices_map_[first_point + i], out_bytes + i * byte_stride());
+    }
+  }
+
+  // Same as GeometryAttribute::ConvertValues(), but for |num_points| points
+  // starting at |first_point|. Mapping to attribute value indices is
+  // performed automatically.
+  template <typename OutT>
+  bool ConvertMappedValues(PointIndex first_point, int num_points,
+                           int8_t out_num_components, OutT *out_values) const {
+    if (identity_mapping_) {
+      return ConvertValues<OutT>(AttributeValueIndex(first_point.value()),
+                                 num_points, out_num_components, out_values);
+    }
+    if (num_points <= 0) {
+      return num_points == 0;
+    }
+    if (first_point.value() + num_points > indices_map_.size()) {
+      return false;
+    }
+    const AttributeValueIndex *const value_indices =
+        &indices_map_[first_point];
+    const int64_t byte_offset = this->byte_offset();
+    const int64_t byte_stride = this->byte_stride();
+    return GeometryAttribute::ConvertValues(
+        num_points, out_num_components, out_values, /* packed */ false,
+        [value_indices, byte_offset, byte_stride](int i) {
+          return byte_offset + byte_stride * value_indices[i].value();
+        });
+  }
+
+  // Same as above but each output value stores all components of a single
+  // attribute entry.
+  template <typename OutT>
+  bool ConvertMappedValues(PointIndex first_point, int num_points,
+                           OutT *out_values) const {
+    return ConvertMappedValues<OutT>(first_point, num_points, num_components(),
+                                     out_values);
+  }
+
 #ifdef DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED
   // Deduplicate |in_att| values into |this| attribute. |in_att| can be equal
   // to |this|.
@@ -125,4 +125,72 @@ TEST_F(PointAttributeTest, TestResize) {
   ASSERT_EQ(pa.buffer()->data_size(), 4 * 3 * 10);
 }
 
+TEST_F(PointAttributeTest, TestConvertValues) {
+  // This test verifies that the bulk conversion of attribute values matches
+  // conversion of the individual values.
+  draco::PointAttribute pa;
+  pa.Init(draco::GeometryAttribute::GENERIC, 3, draco::DT_UINT16, true, 6);
+  for (int32_t i = 0; i < 6; ++i) {
+    const uint16_t values[3] = {static_cast<uint16_t>(i * 1000),
+                                static_cast<uint16_t>(i * 2000 + 1),
+                                static_cast<uint16_t>(65535 - i)};
+    pa.SetAttributeValue(draco::AttributeValueIndex(i), values);
+  }
+  // Points are mapped to the values in reverse order.
+  pa.SetExplicitMapping(6);
+  for (int32_t i = 0; i < 6; ++i) {
+    pa.SetPointMapEntry(draco::PointIndex(i),
+                        draco::AttributeValueIndex(5 - i));
+  }
+
+  // Normalized values converted to floats with an extra zero component.
+  std::vector<float> floats(4 * 5);
+  ASSERT_TRUE(pa.ConvertValues<float>(draco::AttributeValueIndex(1), 5, 4,
+                                      floats.data()));
+  std::vector<float> mapped_floats(4 * 6);
+  ASSERT_TRUE(pa.ConvertMappedValues<float>(draco::PointIndex(0), 6, 4,
+                                            mapped_floats.data()));
+  float value[4];
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(pa.ConvertValue<float>(draco::AttributeValueIndex(i + 1), 4,
+                                       value));
+    for (int c = 0; c < 4; ++c) {
+      ASSERT_EQ(floats[i * 4 + c], value[c]);
+    }
+  }
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(pa.ConvertValue<float>(draco::AttributeValueIndex(5 - i), 4,
+                                       value));
+    for (int c = 0; c < 4; ++c) {
+      ASSERT_EQ(mapped_floats[i * 4 + c], value[c]);
+    }
+  }
+
+  // Integer values with a dropped component.
+  std::vector<int32_t> ints(2 * 6);
+  ASSERT_TRUE(pa.ConvertMappedValues<int32_t>(draco::PointIndex(0), 6, 2,
+                                              ints.data()));
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(ints[i * 2], (5 - i) * 1000);
+    ASSERT_EQ(ints[i * 2 + 1], (5 - i) * 2000 + 1);
+  }
+
+  // Raw values.
+  std::vector<uint16_t> raw(3 * 6);
+  pa.GetMappedValues(draco::PointIndex(0), 6, raw.data());
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(raw[i * 3 + 2], 65535 - (5 - i));
+  }
+
+  // Values that don't fit the output type and ranges out of the attribute
+  // can't be converted.
+  std::vector<int8_t> bytes(3 * 6);
+  ASSERT_FALSE(pa.ConvertValues<int8_t>(draco::AttributeValueIndex(0), 6,
+                                        bytes.data()));
+  ASSERT_FALSE(pa.ConvertValues<float>(draco::AttributeValueIndex(2), 5, 4,
+                                       floats.data()));
+  ASSERT_FALSE(pa.ConvertMappedValues<float>(draco::PointIndex(1), 6, 4,
+                                             mapped_floats.data()));
+}
+
 }  // namespace
@@ -48,7 +48,8 @@ bool AttributesDecoder::DecodeAttributesDecoderData(DecoderBuffer *in_buffer) {
   if (num_attributes == 0) {
     return false;
   }
-  if (num_attributes > 5 * in_buffer->remaining_size()) {
+  if (!in_buffer->CheckRemainingSize(
+          (static_cast<uint64_t>(num_attributes) + 4) / 5)) {
     // The decoded number of attributes is unreasonably high, because at least
     // five bytes of attribute descriptor data per attribute are expected.
     return false;
@@ -124,4 +125,18 @@ bool AttributesDecoder::DecodeAttributesDecoderData(DecoderBuffer *in_buffer) {
   return true;
 }
 
+void AttributesDecoder::SetAttributeIds(
+    const std::vector<int32_t> &point_attribute_ids) {
+  point_attribute_ids_ = point_attribute_ids;
+  point_attribute_to_local_id_map_.clear();
+  for (int i = 0; i < static_cast<int>(point_attribute_ids_.size()); ++i) {
+    const int32_t att_id = point_attribute_ids_[i];
+    if (att_id >=
+        static_cast<int32_t>(point_attribute_to_local_id_map_.size())) {
+      point_attribute_to_local_id_map_.resize(att_id + 1, -1);
+    }
+    point_attribute_to_local_id_map_[att_id] = i;
+  }
+}
+
 }  // namespace draco
@@ -81,6 +81,10 @@ class AttributesDecoder : public AttributesDecoderInterface {
   }
   virtual bool TransformAttributesToOriginalFormat() { return true; }
 
+  // Sets the ids of the attributes decoded by this decoder without decoding
+  // them from a buffer. The attributes must already exist in the point cloud.
+  void SetAttributeIds(const std::vector<int32_t> &point_attribute_ids);
+
  private:
   // List of attribute ids that need to be decoded with this decoder.
   std::vector<int32_t> point_attribute_ids_;
@@ -140,6 +140,9 @@ Status KdTreeAttributesDecoder::DecodePortableAttributes(
     return Status(Status::DRACO_ERROR, "Failed to decode KD tree, compression_level.");
   }
   const int32_t num_points = GetDecoder()->point_cloud()->num_points();
+  // Drop the state of a previous attempt that ran out of data.
+  min_signed_values_.clear();
+  quantized_portable_attributes_.clear();
 
   // Decode data using the kd tree decoding into integer (portable) attributes.
   // We first need to go over all attributes and create a new portable storage
@@ -155,7 +158,10 @@ Status KdTreeAttributesDecoder::DecodePortableAttributes(
     PointAttribute *const att = GetDecoder()->point_cloud()->attribute(att_id);
     // All attributes have the same number of values and identity mapping
     // between PointIndex and AttributeValueIndex.
-    att->Reset(num_points);
+    if (!GetDecoder()->ResetAttribute(att, num_points)) {
+      return Status(Status::DRACO_ERROR,
+                    "Failed to decode KD tree, attribute memory.");
+    }
     att->SetIdentityMapping();
 
     PointAttribute *target_att = nullptr;
@@ -258,6 +264,7 @@ bool KdTreeAttributesDecoder::DecodeDataNeededByPortableTransforms(
   if (in_buffer->bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 3)) {
     // Decode quantization data for each attribute that need it.
     // TODO(ostava): This should be moved to AttributeQuantizationTransform.
+    attribute_quantization_transforms_.clear();
     std::vector<float> min_value;
     for (int i = 0; i < GetNumAttributes(); ++i) {
       const int att_id = GetAttributeId(i);
@@ -344,7 +351,9 @@ bool KdTreeAttributesDecoder::DecodeDataNeededByPortableTransforms(
     if (!in_buffer->Decode(&num_points)) {
       return false;
     }
-    att->Reset(num_points);
+    if (!GetDecoder()->ResetAttribute(att, num_points)) {
+      return false;
+    }
     FloatPointsTreeDecoder decoder;
     decoder.set_num_points_from_header(num_points);
     PointAttributeVectorOutputIterator<float> out_it(atts);
@@ -374,7 +383,9 @@ bool KdTreeAttributesDecoder::DecodeDataNeededByPortableTransforms(
       const int att_id = GetAttributeId(attribute_index);
       PointAttribute *const attr =
           GetDecoder()->point_cloud()->attribute(att_id);
-      attr->Reset(num_points);
+      if (!GetDecoder()->ResetAttribute(attr, num_points)) {
+        return false;
+      }
       attr->SetIdentityMapping();
     };
 
@@ -526,28 +537,26 @@ bool KdTreeAttributesDecoder::TransformAttributesToOriginalFormat() {
       const int32_t max_quantized_value =
           (1u << static_cast<uint32_t>(transform.quantization_bits())) - 1;
       const int num_components = att->num_components();
-      const int entry_size = sizeof(float) * num_components;
-      const std::unique_ptr<float[]> att_val(new float[num_components]);
-      int quant_val_id = 0;
-      int out_byte_pos = 0;
+      if (transform.min_values().size() <
+          static_cast<size_t>(num_components)) {
+        return false;
+      }
       Dequantizer dequantizer;
       if (!dequantizer.Init(transform.range(), max_quantized_value)) {
         return false;
       }
-      const uint32_t *const portable_attribute_data =
-          reinterpret_cast<const uint32_t *>(
-              src_att->GetAddress(AttributeValueIndex(0)));
-      for (uint32_t i = 0; i < src_att->size(); ++i) {
-        for (int c = 0; c < num_components; ++c) {
-          float value = dequantizer.DequantizeFloat(
-              portable_attribute_data[quant_val_id++]);
-          value = value + transform.min_value(c);
-          att_val[c] = value;
-        }
-        // Store the floating point value into the attribute buffer.
-        att->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-        out_byte_pos += entry_size;
+      if (src_att->size() == 0) {
+        continue;
       }
+      const int32_t *const portable_attribute_data =
+          reinterpret_cast<const int32_t *>(
+              src_att->GetAddress(AttributeValueIndex(0)));
+      // The floating point values are stored directly into the attribute
+      // buffer.
+      dequantizer.DequantizeFloats(
+          portable_attribute_data, src_att->size(), num_components,
+          transform.min_values().data(),
+          reinterpret_cast<float *>(att->buffer()->data()));
     }
   }
   return true;
@@ -0,0 +1,65 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#include "draco/core/cpu_features.h"
+
+namespace draco {
+
+void OctahedronToolBox::QuantizedOctahedralCoordsToUnitVectors(
+    const int32_t *in_coords, int num_vectors, float *out_vectors) const {
+  int i = 0;
+#if DRACO_ENABLE_SSE4_1
+  if (CpuSupportsSse4()) {
+    i = QuantizedOctahedralCoordsToUnitVectorsSse4(
+        in_coords, num_vectors, dequantization_scale_, out_vectors);
+  }
+#elif DRACO_ENABLE_NEON && defined(__aarch64__)
+  i = QuantizedOctahedralCoordsToUnitVectorsNeon(
+      in_coords, num_vectors, dequantization_scale_, out_vectors);
+#endif
+  for (; i < num_vectors; ++i) {
+    QuantizedOctahedralCoordsToUnitVector(in_coords[2 * i],
+                                          in_coords[2 * i + 1],
+                                          out_vectors + 3 * i);
+  }
+}
+
+int ComputeCanonicalizedOctahedralCoords(const int32_t *pred_coords,
+                                         const int32_t *corr_coords,
+                                         int num_coords, int32_t center_value,
+                                         int32_t max_quantized_value,
+                                         int32_t *out_coords) {
+#if DRACO_ENABLE_SSE4_1
+  if (CpuSupportsSse4()) {
+    return ComputeCanonicalizedOctahedralCoordsSse4(
+        pred_coords, corr_coords, num_coords, center_value,
+        max_quantized_value, out_coords);
+  }
+#elif DRACO_ENABLE_NEON && defined(__aarch64__)
+  return ComputeCanonicalizedOctahedralCoordsNeon(
+      pred_coords, corr_coords, num_coords, center_value, max_quantized_value,
+      out_coords);
+#endif
+  (void)pred_coords;
+  (void)corr_coords;
+  (void)num_coords;
+  (void)center_value;
+  (void)max_quantized_value;
+  (void)out_coords;
+  return 0;
+}
+
+}  // namespace draco
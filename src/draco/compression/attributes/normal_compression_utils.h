@@ -201,6 +201,14 @@ class OctahedronToolBox {
                                  out_vector);
   }
 
+  // Converts |num_vectors| pairs of quantized octahedral coordinates
+  // |in_coords| stored as (s, t) into unit vectors of three components stored
+  // in |out_vectors|. The result is identical to calling
+  // QuantizedOctahedralCoordsToUnitVector() for every pair.
+  void QuantizedOctahedralCoordsToUnitVectors(const int32_t *in_coords,
+                                              int num_vectors,
+                                              float *out_vectors) const;
+
   // |s| and |t| are expected to be signed values.
   inline bool IsInDiamond(const int32_t &s, const int32_t &t) const {
     // Expect center already at origin.
@@ -355,6 +363,53 @@ class OctahedronToolBox {
   float dequantization_scale_;
   int32_t center_value_;
 };
+
+// SIMD kernels for batches of octahedral coordinates stored as (s, t) pairs.
+// They process the pairs from the start of the input in groups of four and
+// return the number of processed pairs.
+//
+// The unit vector kernels compute the same values as
+// OctahedronToolBox::QuantizedOctahedralCoordsToUnitVector().
+//
+// The canonicalized kernels compute the same values as
+// PredictionSchemeNormalOctahedronCanonicalizedDecodingTransform::
+// ComputeOriginalValue() from predictions |pred_coords| and corrections
+// |corr_coords|. Groups with values outside of <0, 2 * |center_value|>, i.e.
+// malformed input, are not processed and the kernel stops there.
+#if DRACO_ENABLE_SSE4_1
+int QuantizedOctahedralCoordsToUnitVectorsSse4(const int32_t *in_coords,
+                                               int num_vectors,
+                                               float dequantization_scale,
+                                               float *out_vectors);
+int ComputeCanonicalizedOctahedralCoordsSse4(const int32_t *pred_coords,
+                                             const int32_t *corr_coords,
+                                             int num_coords,
+                                             int32_t center_value,
+                                             int32_t max_quantized_value,
+                                             int32_t *out_coords);
+#endif
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+int QuantizedOctahedralCoordsToUnitVectorsNeon(const int32_t *in_coords,
+                                               int num_vectors,
+                                               float dequantization_scale,
+                                               float *out_vectors);
+int ComputeCanonicalizedOctahedralCoordsNeon(const int32_t *pred_coords,
+                                             const int32_t *corr_coords,
+                                             int num_coords,
+                                             int32_t center_value,
+                                             int32_t max_quantized_value,
+                                             int32_t *out_coords);
+#endif
+
+// Processes as many |num_coords| pairs as possible with the canonicalized
+// SIMD kernels above and returns their number. The remaining pairs must be
+// processed by the prediction scheme transform.
+int ComputeCanonicalizedOctahedralCoords(const int32_t *pred_coords,
+                                         const int32_t *corr_coords,
+                                         int num_coords, int32_t center_value,
+                                         int32_t max_quantized_value,
+                                         int32_t *out_coords);
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ATTRIBUTES_NORMAL_COMPRESSION_UTILS_H_
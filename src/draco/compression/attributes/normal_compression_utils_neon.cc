@@ -0,0 +1,176 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+
+namespace draco {
+
+namespace {
+
+// See normal_compression_utils_sse4.cc for the description of the kernels.
+
+float GetMinNormSquared() {
+  float threshold = static_cast<float>(1e-6);
+  if (threshold < 1e-6) {
+    threshold = std::nextafter(threshold, 1.f);
+  }
+  return threshold;
+}
+
+inline int32x4_t NegateIf(int32x4_t value, uint32x4_t mask) {
+  return vbslq_s32(mask, vnegq_s32(value), value);
+}
+
+inline int32x4_t HalveTowardsZero(int32x4_t value) {
+  const int32x4_t round = vreinterpretq_s32_u32(
+      vshrq_n_u32(vreinterpretq_u32_s32(value), 31));
+  return vshrq_n_s32(vaddq_s32(value, round), 1);
+}
+
+inline void InvertDiamond(int32x4_t center, uint32x4_t mask, int32x4_t *s,
+                          int32x4_t *t) {
+  const uint32x4_t s_pos = vcgtzq_s32(*s);
+  const uint32x4_t t_pos = vcgtzq_s32(*t);
+  const uint32x4_t both_non_neg = vandq_u32(vcgezq_s32(*s), vcgezq_s32(*t));
+  const uint32x4_t both_non_pos = vandq_u32(vclezq_s32(*s), vclezq_s32(*t));
+  const uint32x4_t sign_s = vbicq_u32(vbicq_u32(mask, s_pos), both_non_neg);
+  const uint32x4_t sign_t = vbicq_u32(vbicq_u32(mask, t_pos), both_non_neg);
+  const int32x4_t corner_s = NegateIf(center, sign_s);
+  const int32x4_t corner_t = NegateIf(center, sign_t);
+  const int32x4_t s2 = vsubq_s32(vaddq_s32(*s, *s), corner_s);
+  const int32x4_t t2 = vsubq_s32(vaddq_s32(*t, *t), corner_t);
+  const uint32x4_t same_sign = vorrq_u32(both_non_neg, both_non_pos);
+  const int32x4_t new_s =
+      HalveTowardsZero(vaddq_s32(NegateIf(t2, same_sign), corner_s));
+  const int32x4_t new_t =
+      HalveTowardsZero(vaddq_s32(NegateIf(s2, same_sign), corner_t));
+  *s = vbslq_s32(mask, new_s, *s);
+  *t = vbslq_s32(mask, new_t, *t);
+}
+
+inline void RotatePoint(uint32x4_t rot1, uint32x4_t rot2, uint32x4_t rot3,
+                        int32x4_t *s, int32x4_t *t) {
+  const uint32x4_t swap = vorrq_u32(rot1, rot3);
+  const int32x4_t a = vbslq_s32(swap, *t, *s);
+  const int32x4_t b = vbslq_s32(swap, *s, *t);
+  *s = NegateIf(a, vorrq_u32(rot2, rot3));
+  *t = NegateIf(b, vorrq_u32(rot1, rot2));
+}
+
+}  // namespace
+
+int QuantizedOctahedralCoordsToUnitVectorsNeon(const int32_t *in_coords,
+                                               int num_vectors,
+                                               float dequantization_scale,
+                                               float *out_vectors) {
+  const float32x4_t scale = vdupq_n_f32(dequantization_scale);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t min_norm_squared = vdupq_n_f32(GetMinNormSquared());
+  int i = 0;
+  for (; i + 4 <= num_vectors; i += 4) {
+    const int32x4x2_t st = vld2q_s32(in_coords + 2 * i);
+    // Multiplications and additions are not fused so that the results are
+    // identical to the scalar code.
+    float32x4_t y = vsubq_f32(vmulq_f32(vcvtq_f32_s32(st.val[0]), scale), one);
+    float32x4_t z = vsubq_f32(vmulq_f32(vcvtq_f32_s32(st.val[1]), scale), one);
+    // The scalar code truncates the absolute values to integers.
+    const float32x4_t x = vsubq_f32(vsubq_f32(one, vrndq_f32(vabsq_f32(y))),
+                                    vrndq_f32(vabsq_f32(z)));
+    const float32x4_t neg_x = vnegq_f32(x);
+    // Keeps -x when it is a negative zero like the scalar code.
+    const float32x4_t x_offset = vbslq_f32(vcltzq_f32(neg_x), zero, neg_x);
+    const float32x4_t neg_x_offset = vnegq_f32(x_offset);
+    y = vaddq_f32(y, vbslq_f32(vcltzq_f32(y), x_offset, neg_x_offset));
+    z = vaddq_f32(z, vbslq_f32(vcltzq_f32(z), x_offset, neg_x_offset));
+    const float32x4_t norm_squared = vaddq_f32(
+        vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)), vmulq_f32(z, z));
+    const uint32x4_t degenerate = vcltq_f32(norm_squared, min_norm_squared);
+    const float32x4_t d = vdivq_f32(one, vsqrtq_f32(norm_squared));
+    float32x4x3_t out;
+    out.val[0] = vbslq_f32(degenerate, zero, vmulq_f32(x, d));
+    out.val[1] = vbslq_f32(degenerate, zero, vmulq_f32(y, d));
+    out.val[2] = vbslq_f32(degenerate, zero, vmulq_f32(z, d));
+    vst3q_f32(out_vectors + 3 * i, out);
+  }
+  return i;
+}
+
+int ComputeCanonicalizedOctahedralCoordsNeon(const int32_t *pred_coords,
+                                             const int32_t *corr_coords,
+                                             int num_coords,
+                                             int32_t center_value,
+                                             int32_t max_quantized_value,
+                                             int32_t *out_coords) {
+  const int32x4_t center = vdupq_n_s32(center_value);
+  const int32x4_t neg_center = vdupq_n_s32(-center_value);
+  const int32x4_t max_quantized = vdupq_n_s32(max_quantized_value);
+  const uint32x4_t max_input = vdupq_n_u32(2 * center_value);
+  int i = 0;
+  for (; i + 4 <= num_coords; i += 4) {
+    const int32x4x2_t pred = vld2q_s32(pred_coords + 2 * i);
+    const int32x4x2_t corr = vld2q_s32(corr_coords + 2 * i);
+    const uint32x4_t max_value = vmaxq_u32(
+        vmaxq_u32(vreinterpretq_u32_s32(pred.val[0]),
+                  vreinterpretq_u32_s32(pred.val[1])),
+        vmaxq_u32(vreinterpretq_u32_s32(corr.val[0]),
+                  vreinterpretq_u32_s32(corr.val[1])));
+    if (vmaxvq_u32(vcgtq_u32(max_value, max_input)) != 0) {
+      break;
+    }
+    int32x4_t s = vsubq_s32(pred.val[0], center);
+    int32x4_t t = vsubq_s32(pred.val[1], center);
+
+    const uint32x4_t outside_diamond =
+        vcgtq_s32(vaddq_s32(vabsq_s32(s), vabsq_s32(t)), center);
+    InvertDiamond(center, outside_diamond, &s, &t);
+
+    const uint32x4_t s_pos = vcgtzq_s32(s);
+    const uint32x4_t s_neg = vcltzq_s32(s);
+    const uint32x4_t t_pos = vcgtzq_s32(t);
+    const uint32x4_t t_neg = vcltzq_s32(t);
+    const uint32x4_t rot1 = vbicq_u32(t_neg, s_neg);
+    const uint32x4_t rot2 = vbicq_u32(s_pos, t_neg);
+    const uint32x4_t rot3 = vbicq_u32(t_pos, s_pos);
+    RotatePoint(rot1, rot2, rot3, &s, &t);
+
+    s = vaddq_s32(s, corr.val[0]);
+    t = vaddq_s32(t, corr.val[1]);
+    s = vaddq_s32(
+        vsubq_s32(s, vandq_s32(vreinterpretq_s32_u32(vcgtq_s32(s, center)),
+                               max_quantized)),
+        vandq_s32(vreinterpretq_s32_u32(vcltq_s32(s, neg_center)),
+                  max_quantized));
+    t = vaddq_s32(
+        vsubq_s32(t, vandq_s32(vreinterpretq_s32_u32(vcgtq_s32(t, center)),
+                               max_quantized)),
+        vandq_s32(vreinterpretq_s32_u32(vcltq_s32(t, neg_center)),
+                  max_quantized));
+
+    RotatePoint(rot3, rot2, rot1, &s, &t);
+    InvertDiamond(center, outside_diamond, &s, &t);
+    int32x4x2_t out;
+    out.val[0] = vaddq_s32(s, center);
+    out.val[1] = vaddq_s32(t, center);
+    vst2q_s32(out_coords + 2 * i, out);
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_NEON && defined(__aarch64__)
@@ -0,0 +1,232 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#if DRACO_ENABLE_SSE4_1
+#include <smmintrin.h>
+
+namespace draco {
+
+namespace {
+
+// Returns the smallest float that is not smaller than the double precision
+// threshold used by OctahedronToolBox for degenerate vectors.
+float GetMinNormSquared() {
+  float threshold = static_cast<float>(1e-6);
+  if (threshold < 1e-6) {
+    threshold = std::nextafter(threshold, 1.f);
+  }
+  return threshold;
+}
+
+// Returns |value| negated in lanes where |mask| is set.
+inline __m128i NegateIf(__m128i value, __m128i mask) {
+  return _mm_sub_epi32(_mm_xor_si128(value, mask), mask);
+}
+
+// Division by two rounding towards zero like the scalar integer division.
+inline __m128i HalveTowardsZero(__m128i value) {
+  return _mm_srai_epi32(_mm_add_epi32(value, _mm_srli_epi32(value, 31)), 1);
+}
+
+// Branch-free version of OctahedronToolBox::InvertDiamond() applied only in
+// lanes where |mask| is set.
+inline void InvertDiamond(__m128i center, __m128i mask, __m128i *s,
+                          __m128i *t) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i s_pos = _mm_cmpgt_epi32(*s, zero);
+  const __m128i t_pos = _mm_cmpgt_epi32(*t, zero);
+  const __m128i s_neg = _mm_cmplt_epi32(*s, zero);
+  const __m128i t_neg = _mm_cmplt_epi32(*t, zero);
+  const __m128i both_non_neg = _mm_andnot_si128(_mm_or_si128(s_neg, t_neg),
+                                                _mm_set1_epi32(-1));
+  const __m128i both_non_pos = _mm_andnot_si128(_mm_or_si128(s_pos, t_pos),
+                                                _mm_set1_epi32(-1));
+  // Lanes where the sign of the corner point is negative.
+  const __m128i sign_s = _mm_andnot_si128(both_non_neg,
+                                          _mm_andnot_si128(s_pos, mask));
+  const __m128i sign_t = _mm_andnot_si128(both_non_neg,
+                                          _mm_andnot_si128(t_pos, mask));
+  const __m128i corner_s = NegateIf(center, sign_s);
+  const __m128i corner_t = NegateIf(center, sign_t);
+  const __m128i s2 = _mm_sub_epi32(_mm_add_epi32(*s, *s), corner_s);
+  const __m128i t2 = _mm_sub_epi32(_mm_add_epi32(*t, *t), corner_t);
+  // Points with equal signs are mirrored, the others are swapped.
+  const __m128i same_sign = _mm_or_si128(both_non_neg, both_non_pos);
+  const __m128i new_s =
+      HalveTowardsZero(_mm_add_epi32(NegateIf(t2, same_sign), corner_s));
+  const __m128i new_t =
+      HalveTowardsZero(_mm_add_epi32(NegateIf(s2, same_sign), corner_t));
+  *s = _mm_blendv_epi8(*s, new_s, mask);
+  *t = _mm_blendv_epi8(*t, new_t, mask);
+}
+
+// Branch-free version of
+// PredictionSchemeNormalOctahedronCanonicalizedTransformBase::RotatePoint()
+// where |rot1|, |rot2| and |rot3| mark lanes rotated by one, two and three
+// quarters.
+inline void RotatePoint(__m128i rot1, __m128i rot2, __m128i rot3, __m128i *s,
+                        __m128i *t) {
+  const __m128i swap = _mm_or_si128(rot1, rot3);
+  const __m128i a = _mm_blendv_epi8(*s, *t, swap);
+  const __m128i b = _mm_blendv_epi8(*t, *s, swap);
+  *s = NegateIf(a, _mm_or_si128(rot2, rot3));
+  *t = NegateIf(b, _mm_or_si128(rot1, rot2));
+}
+
+}  // namespace
+
+int QuantizedOctahedralCoordsToUnitVectorsSse4(const int32_t *in_coords,
+                                               int num_vectors,
+                                               float dequantization_scale,
+                                               float *out_vectors) {
+  const __m128 scale = _mm_set1_ps(dequantization_scale);
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 sign_bit = _mm_set1_ps(-0.f);
+  const __m128 min_norm_squared = _mm_set1_ps(GetMinNormSquared());
+  int i = 0;
+  for (; i + 4 <= num_vectors; i += 4) {
+    const __m128 st01 = _mm_cvtepi32_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_coords + 2 * i)));
+    const __m128 st23 = _mm_cvtepi32_ps(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(in_coords + 2 * i + 4)));
+    const __m128 s = _mm_shuffle_ps(st01, st23, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 t = _mm_shuffle_ps(st01, st23, _MM_SHUFFLE(3, 1, 3, 1));
+    // The operations follow the scalar code so that the results are
+    // identical.
+    __m128 y = _mm_sub_ps(_mm_mul_ps(s, scale), one);
+    __m128 z = _mm_sub_ps(_mm_mul_ps(t, scale), one);
+    // The scalar code truncates the absolute values to integers.
+    const __m128 x = _mm_sub_ps(
+        _mm_sub_ps(one, _mm_round_ps(_mm_andnot_ps(sign_bit, y),
+                                     _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)),
+        _mm_round_ps(_mm_andnot_ps(sign_bit, z),
+                     _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    // max(0, -x) keeps -x when both values are zero like the scalar code.
+    const __m128 x_offset = _mm_max_ps(zero, _mm_xor_ps(x, sign_bit));
+    const __m128 neg_x_offset = _mm_xor_ps(x_offset, sign_bit);
+    y = _mm_add_ps(
+        y, _mm_blendv_ps(neg_x_offset, x_offset, _mm_cmplt_ps(y, zero)));
+    z = _mm_add_ps(
+        z, _mm_blendv_ps(neg_x_offset, x_offset, _mm_cmplt_ps(z, zero)));
+    const __m128 norm_squared = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    const __m128 degenerate = _mm_cmplt_ps(norm_squared, min_norm_squared);
+    const __m128 d = _mm_div_ps(one, _mm_sqrt_ps(norm_squared));
+    const __m128 out_x = _mm_andnot_ps(degenerate, _mm_mul_ps(x, d));
+    const __m128 out_y = _mm_andnot_ps(degenerate, _mm_mul_ps(y, d));
+    const __m128 out_z = _mm_andnot_ps(degenerate, _mm_mul_ps(z, d));
+
+    // Interleave the components into (x, y, z) triplets.
+    const __m128 xy_lo = _mm_unpacklo_ps(out_x, out_y);
+    const __m128 xy_hi = _mm_unpackhi_ps(out_x, out_y);
+    const __m128 yz_lo = _mm_unpacklo_ps(out_y, out_z);
+    const __m128 yz_hi = _mm_unpackhi_ps(out_y, out_z);
+    const __m128 zx_lo = _mm_unpacklo_ps(out_z, out_x);
+    const __m128 zx_hi = _mm_unpackhi_ps(out_z, out_x);
+    float *const out = out_vectors + 3 * i;
+    _mm_storeu_ps(out, _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(3, 0, 1, 0)));
+    _mm_storeu_ps(out + 4,
+                  _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    _mm_storeu_ps(out + 8,
+                  _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(3, 2, 3, 0)));
+  }
+  return i;
+}
+
+int ComputeCanonicalizedOctahedralCoordsSse4(const int32_t *pred_coords,
+                                             const int32_t *corr_coords,
+                                             int num_coords,
+                                             int32_t center_value,
+                                             int32_t max_quantized_value,
+                                             int32_t *out_coords) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i center = _mm_set1_epi32(center_value);
+  const __m128i neg_center = _mm_set1_epi32(-center_value);
+  const __m128i max_quantized = _mm_set1_epi32(max_quantized_value);
+  const __m128i max_input = _mm_set1_epi32(2 * center_value);
+  int i = 0;
+  for (; i + 4 <= num_coords; i += 4) {
+    const __m128i pred01 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(pred_coords + 2 * i));
+    const __m128i pred23 = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(pred_coords + 2 * i + 4));
+    const __m128i corr01 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(corr_coords + 2 * i));
+    const __m128i corr23 = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(corr_coords + 2 * i + 4));
+    // All inputs must be within <0, 2 * center_value>. Negative values are
+    // large unsigned numbers.
+    const __m128i max_value = _mm_max_epu32(
+        _mm_max_epu32(pred01, pred23), _mm_max_epu32(corr01, corr23));
+    if (!_mm_testc_si128(_mm_cmpeq_epi32(_mm_max_epu32(max_value, max_input),
+                                         max_input),
+                         _mm_set1_epi32(-1))) {
+      break;
+    }
+    // Deinterleave the (s, t) pairs.
+    const __m128i pred_lo = _mm_shuffle_epi32(pred01, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i pred_hi = _mm_shuffle_epi32(pred23, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i corr_lo = _mm_shuffle_epi32(corr01, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i corr_hi = _mm_shuffle_epi32(corr23, _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i s = _mm_sub_epi32(_mm_unpacklo_epi64(pred_lo, pred_hi), center);
+    __m128i t = _mm_sub_epi32(_mm_unpackhi_epi64(pred_lo, pred_hi), center);
+    const __m128i corr_s = _mm_unpacklo_epi64(corr_lo, corr_hi);
+    const __m128i corr_t = _mm_unpackhi_epi64(corr_lo, corr_hi);
+
+    const __m128i outside_diamond = _mm_cmpgt_epi32(
+        _mm_add_epi32(_mm_abs_epi32(s), _mm_abs_epi32(t)), center);
+    InvertDiamond(center, outside_diamond, &s, &t);
+
+    // Rotation of the prediction into the bottom left quadrant. Points that
+    // are already there have a rotation count of zero.
+    const __m128i s_pos = _mm_cmpgt_epi32(s, zero);
+    const __m128i s_neg = _mm_cmplt_epi32(s, zero);
+    const __m128i t_pos = _mm_cmpgt_epi32(t, zero);
+    const __m128i t_neg = _mm_cmplt_epi32(t, zero);
+    const __m128i rot1 = _mm_andnot_si128(s_neg, t_neg);
+    const __m128i rot2 = _mm_andnot_si128(t_neg, s_pos);
+    const __m128i rot3 = _mm_andnot_si128(s_pos, t_pos);
+    RotatePoint(rot1, rot2, rot3, &s, &t);
+
+    s = _mm_add_epi32(s, corr_s);
+    t = _mm_add_epi32(t, corr_t);
+    s = _mm_add_epi32(
+        _mm_sub_epi32(s, _mm_and_si128(_mm_cmpgt_epi32(s, center),
+                                       max_quantized)),
+        _mm_and_si128(_mm_cmplt_epi32(s, neg_center), max_quantized));
+    t = _mm_add_epi32(
+        _mm_sub_epi32(t, _mm_and_si128(_mm_cmpgt_epi32(t, center),
+                                       max_quantized)),
+        _mm_and_si128(_mm_cmplt_epi32(t, neg_center), max_quantized));
+
+    // Reverse rotation swaps rotations by one and three quarters.
+    RotatePoint(rot3, rot2, rot1, &s, &t);
+    InvertDiamond(center, outside_diamond, &s, &t);
+    s = _mm_add_epi32(s, center);
+    t = _mm_add_epi32(t, center);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out_coords + 2 * i),
+                     _mm_unpacklo_epi32(s, t));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out_coords + 2 * i + 4),
+                     _mm_unpackhi_epi32(s, t));
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_SSE4_1
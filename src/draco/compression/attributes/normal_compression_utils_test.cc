@@ -0,0 +1,104 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#include <cstring>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class NormalCompressionUtilsTest : public ::testing::Test {
+ protected:
+  // Verifies that the batched conversion of |coords| to unit vectors matches
+  // the conversion of the individual coordinates bit by bit.
+  void TestUnitVectors(int quantization_bits,
+                       const std::vector<int32_t> &coords) {
+    draco::OctahedronToolBox tool_box;
+    ASSERT_TRUE(tool_box.SetQuantizationBits(quantization_bits));
+    const int num_vectors = static_cast<int>(coords.size() / 2);
+    std::vector<float> reference(3 * num_vectors);
+    for (int i = 0; i < num_vectors; ++i) {
+      tool_box.QuantizedOctahedralCoordsToUnitVector(
+          coords[2 * i], coords[2 * i + 1], &reference[3 * i]);
+    }
+    std::vector<float> out(3 * num_vectors);
+    tool_box.QuantizedOctahedralCoordsToUnitVectors(coords.data(),
+                                                    num_vectors, out.data());
+    ASSERT_EQ(
+        std::memcmp(out.data(), reference.data(), out.size() * sizeof(float)),
+        0);
+  }
+};
+
+TEST_F(NormalCompressionUtilsTest, TestQuantizedOctahedralCoordsToUnitVector) {
+  // Pins the unit vectors of a few 8 bit coordinates, so that existing files
+  // keep decoding to the same normals. The scalar code computes the x
+  // component from abs() of y and z, which truncates them to integers.
+  struct {
+    int32_t s, t;
+    float vector[3];
+  } const expected[] = {
+      {127, 127, {1.f, 0.f, 0.f}},
+      {0, 0, {-1.f, 0.f, 0.f}},
+      {100, 200, {0.85261786f, -0.181265235f, 0.49008739f}},
+      {3, 250, {0.588101625f, -0.574209452f, 0.569578767f}},
+      {250, 10, {0.599036634f, 0.58016932f, -0.551868379f}},
+      {30, 60, {0.73290509f, -0.559777915f, -0.386650711f}}};
+  draco::OctahedronToolBox tool_box;
+  ASSERT_TRUE(tool_box.SetQuantizationBits(8));
+  std::vector<int32_t> coords;
+  for (const auto &e : expected) {
+    float vector[3];
+    tool_box.QuantizedOctahedralCoordsToUnitVector(e.s, e.t, vector);
+    for (int c = 0; c < 3; ++c) {
+      EXPECT_FLOAT_EQ(vector[c], e.vector[c]) << e.s << " " << e.t;
+    }
+    coords.insert(coords.end(), {e.s, e.t});
+  }
+  // The batched conversion produces the same vectors.
+  std::vector<float> vectors(coords.size() / 2 * 3);
+  tool_box.QuantizedOctahedralCoordsToUnitVectors(
+      coords.data(), static_cast<int>(coords.size() / 2), vectors.data());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    EXPECT_FLOAT_EQ(vectors[i], expected[i / 3].vector[i % 3]);
+  }
+}
+
+TEST_F(NormalCompressionUtilsTest, TestQuantizedOctahedralCoordsToUnitVectors) {
+  // All valid coordinates for 8 bit quantization.
+  std::vector<int32_t> coords;
+  for (int32_t s = 0; s < 255; ++s) {
+    for (int32_t t = 0; t < 255; ++t) {
+      coords.insert(coords.end(), {s, t});
+    }
+  }
+  TestUnitVectors(8, coords);
+
+  // Random coordinates, including values out of the quantization range, and a
+  // number of vectors that is not a multiple of the SIMD group size.
+  uint32_t seed = 1;
+  coords.resize(2 * 1003);
+  for (size_t i = 0; i < coords.size(); ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    coords[i] = i % 7 == 0 ? static_cast<int32_t>(seed)
+                           : static_cast<int32_t>((seed >> 8) % 1023);
+  }
+  TestUnitVectors(10, coords);
+  TestUnitVectors(30, coords);
+}
+
+}  // namespace
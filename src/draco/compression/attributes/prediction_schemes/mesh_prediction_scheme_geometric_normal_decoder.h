@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_DECODER_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_DECODER_H_
 
+#include <algorithm>
+
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_predictor_area.h"
 #include "draco/compression/bit_coders/rans_bit_decoder.h"
@@ -110,27 +112,37 @@ bool MeshPredictionSchemeGeometricNormalDecoder<
   const int corner_map_size =
       static_cast<int>(this->mesh_data().data_to_corner_map()->size());
 
+  // Predictions are computed for blocks of entries that are then transformed
+  // together.
+  constexpr int kNumEntriesPerBlock = 256;
   VectorD<int32_t, 3> pred_normal_3d;
-  int32_t pred_normal_oct[2];
-
-  for (int data_id = 0; data_id < corner_map_size; ++data_id) {
-    const CornerIndex corner_id =
-        this->mesh_data().data_to_corner_map()->at(data_id);
-    predictor_.ComputePredictedValue(corner_id, pred_normal_3d.data());
-
-    // Compute predicted octahedral coordinates.
-    octahedron_tool_box_.CanonicalizeIntegerVector(pred_normal_3d.data());
-    DRACO_DCHECK_EQ(pred_normal_3d.AbsSum(),
-                    octahedron_tool_box_.center_value());
-    if (flip_normal_bit_decoder_.DecodeNextBit()) {
-      pred_normal_3d = -pred_normal_3d;
+  int32_t pred_normal_oct[2 * kNumEntriesPerBlock];
+
+  for (int block_begin = 0; block_begin < corner_map_size;
+       block_begin += kNumEntriesPerBlock) {
+    const int block_end =
+        std::min(block_begin + kNumEntriesPerBlock, corner_map_size);
+    for (int data_id = block_begin; data_id < block_end; ++data_id) {
+      const CornerIndex corner_id =
+          this->mesh_data().data_to_corner_map()->at(data_id);
+      predictor_.ComputePredictedValue(corner_id, pred_normal_3d.data());
+
+      // Compute predicted octahedral coordinates.
+      octahedron_tool_box_.CanonicalizeIntegerVector(pred_normal_3d.data());
+      DRACO_DCHECK_EQ(pred_normal_3d.AbsSum(),
+                      octahedron_tool_box_.center_value());
+      if (flip_normal_bit_decoder_.DecodeNextBit()) {
+        pred_normal_3d = -pred_normal_3d;
+      }
+      int32_t *const pred_oct = pred_normal_oct + 2 * (data_id - block_begin);
+      octahedron_tool_box_.IntegerVectorToQuantizedOctahedralCoords(
+          pred_normal_3d.data(), pred_oct, pred_oct + 1);
     }
-    octahedron_tool_box_.IntegerVectorToQuantizedOctahedralCoords(
-        pred_normal_3d.data(), pred_normal_oct, pred_normal_oct + 1);
 
-    const int data_offset = data_id * 2;
-    this->transform().ComputeOriginalValue(
-        pred_normal_oct, in_corr + data_offset, out_data + data_offset);
+    const int data_offset = block_begin * 2;
+    this->transform().ComputeOriginalValues(
+        pred_normal_oct, in_corr + data_offset, out_data + data_offset,
+        block_end - block_begin);
   }
   flip_normal_bit_decoder_.EndDecoding();
   return true;
@@ -47,6 +47,18 @@ class PredictionSchemeDecodingTransform {
     }
   }
 
+  // Computes original values of |num_entries| consecutive entries.
+  void ComputeOriginalValues(const DataTypeT *predicted_vals,
+                             const CorrTypeT *corr_vals,
+                             DataTypeT *out_original_vals,
+                             int num_entries) const {
+    const int size = num_entries * num_components_;
+    for (int i = 0; i < size; i += num_components_) {
+      ComputeOriginalValue(predicted_vals + i, corr_vals + i,
+                           out_original_vals + i);
+    }
+  }
+
   // Decodes any transform specific data. Called before Init() method.
   bool DecodeTransformData(DecoderBuffer * /* buffer */) { return true; }
 
@@ -0,0 +1,121 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Microbenchmark of the delta + wrap reconstruction kernels compared to
+// calling PredictionSchemeWrapDecodingTransform::ComputeOriginalValue() for
+// every value.
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace {
+
+typedef draco::PredictionSchemeWrapDecodingTransform<int32_t> Transform;
+
+void ComputeWithTransform(Transform *transform, const int32_t *corr,
+                          int32_t *out, int size, int num_components) {
+  transform->Init(num_components);
+  const std::vector<int32_t> zero_vals(num_components, 0);
+  transform->ComputeOriginalValue(zero_vals.data(), corr, out);
+  for (int i = num_components; i < size; i += num_components) {
+    transform->ComputeOriginalValue(out + i - num_components, corr + i,
+                                    out + i);
+  }
+}
+
+void ComputeWithKernel(const Transform &transform, const int32_t *corr,
+                       int32_t *out, int size, int num_components) {
+  const draco::DeltaWrapBounds bounds = transform.GetDeltaWrapBounds();
+  switch (num_components) {
+    case 1:
+      draco::ComputeDeltaWrapOriginalValues<1>(corr, out, size, bounds);
+      break;
+    case 2:
+      draco::ComputeDeltaWrapOriginalValues<2>(corr, out, size, bounds);
+      break;
+    case 3:
+      draco::ComputeDeltaWrapOriginalValues<3>(corr, out, size, bounds);
+      break;
+    default:
+      draco::ComputeDeltaWrapOriginalValues<4>(corr, out, size, bounds);
+      break;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_iterations = 50;
+  if (argc > 1) {
+    num_iterations = atoi(argv[1]);
+  }
+  const int32_t min_value = -4096;
+  const int32_t max_value = 4095;
+  draco::EncoderBuffer eb;
+  eb.Encode(min_value);
+  eb.Encode(max_value);
+  draco::DecoderBuffer db;
+  db.Init(eb.data(), eb.size());
+  Transform transform;
+  if (!transform.DecodeTransformData(&db)) {
+    return -1;
+  }
+  const draco::DeltaWrapBounds bounds = transform.GetDeltaWrapBounds();
+
+  const int num_entries = 1 << 20;
+  for (int num_components = 1; num_components <= 4; ++num_components) {
+    const int size = num_entries * num_components;
+    std::vector<int32_t> corr(size);
+    uint32_t state = 1;
+    for (int i = 0; i < size; ++i) {
+      state = state * 1664525u + 1013904223u;
+      corr[i] = bounds.min_correction +
+                static_cast<int32_t>((state >> 8) % (bounds.max_dif + 1));
+    }
+    std::vector<int32_t> reference(size);
+    std::vector<int32_t> out(size);
+
+    draco::CycleTimer timer;
+    timer.Start();
+    for (int it = 0; it < num_iterations; ++it) {
+      ComputeWithTransform(&transform, corr.data(), reference.data(), size,
+                           num_components);
+    }
+    timer.Stop();
+    const int64_t reference_ms = timer.GetInMs();
+
+    timer.Start();
+    for (int it = 0; it < num_iterations; ++it) {
+      ComputeWithKernel(transform, corr.data(), out.data(), size,
+                        num_components);
+    }
+    timer.Stop();
+    const int64_t ms = timer.GetInMs();
+
+    if (out != reference) {
+      printf("Reconstructed values do not match.\n");
+      return -1;
+    }
+    printf("%d component(s), %d values %d times: transform %" PRId64
+           " ms, kernel %" PRId64 " ms\n",
+           num_components, num_entries, num_iterations, reference_ms, ms);
+  }
+  return 0;
+}
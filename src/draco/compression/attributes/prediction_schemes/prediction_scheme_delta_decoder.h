@@ -16,6 +16,8 @@
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_DELTA_DECODER_H_
 
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
 
 namespace draco {
 
@@ -41,6 +43,38 @@ class PredictionSchemeDeltaDecoder
     return PREDICTION_DIFFERENCE;
   }
   bool IsInitialized() const override { return true; }
+
+ private:
+  // Reconstructs the values with kernels specialized for the transform and
+  // the number of components. Returns false when there is no such kernel.
+  template <class OtherTransformT>
+  static bool ComputeOriginalValuesWithKernel(const OtherTransformT &,
+                                              const CorrType *, DataTypeT *,
+                                              int, int) {
+    return false;
+  }
+  static bool ComputeOriginalValuesWithKernel(
+      const PredictionSchemeWrapDecodingTransform<int32_t> &transform,
+      const int32_t *in_corr, int32_t *out_data, int size,
+      int num_components) {
+    const DeltaWrapBounds bounds = transform.GetDeltaWrapBounds();
+    switch (num_components) {
+      case 1:
+        ComputeDeltaWrapOriginalValues<1>(in_corr, out_data, size, bounds);
+        return true;
+      case 2:
+        ComputeDeltaWrapOriginalValues<2>(in_corr, out_data, size, bounds);
+        return true;
+      case 3:
+        ComputeDeltaWrapOriginalValues<3>(in_corr, out_data, size, bounds);
+        return true;
+      case 4:
+        ComputeDeltaWrapOriginalValues<4>(in_corr, out_data, size, bounds);
+        return true;
+      default:
+        return false;
+    }
+  }
 };
 
 template <typename DataTypeT, class TransformT>
@@ -48,6 +82,10 @@ bool PredictionSchemeDeltaDecoder<DataTypeT, TransformT>::ComputeOriginalValues(
     const CorrType *in_corr, DataTypeT *out_data, int size, int num_components,
     const PointIndex *) {
   this->transform().Init(num_components);
+  if (ComputeOriginalValuesWithKernel(this->transform(), in_corr, out_data, size,
+                                      num_components)) {
+    return true;
+  }
   // Decode the original value for the first element.
   std::unique_ptr<DataTypeT[]> zero_vals(new DataTypeT[num_components]());
   this->transform().ComputeOriginalValue(zero_vals.get(), in_corr, out_data);
@@ -0,0 +1,58 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+
+#include "draco/core/cpu_features.h"
+
+namespace draco {
+
+template <int num_components_t>
+void ComputeDeltaWrapOriginalValues(const int32_t *corr, int32_t *out,
+                                    int size, const DeltaWrapBounds &bounds) {
+  if (size < num_components_t) {
+    return;
+  }
+  int i = 0;
+#if DRACO_ENABLE_SSE4_1
+  if (CpuSupportsSse4()) {
+    i = ComputeDeltaWrapOriginalValuesSse4<num_components_t>(corr, out, size,
+                                                             bounds);
+  }
+#elif DRACO_ENABLE_NEON && defined(__aarch64__)
+  i = ComputeDeltaWrapOriginalValuesNeon<num_components_t>(corr, out, size,
+                                                           bounds);
+#endif
+  if (i == 0) {
+    const int32_t zero_vals[num_components_t] = {};
+    ComputeDeltaWrapOriginalValue<num_components_t>(zero_vals, corr, out,
+                                                    bounds);
+    i = num_components_t;
+  }
+  for (; i < size; i += num_components_t) {
+    ComputeDeltaWrapOriginalValue<num_components_t>(
+        out + i - num_components_t, corr + i, out + i, bounds);
+  }
+}
+
+template void ComputeDeltaWrapOriginalValues<1>(const int32_t *, int32_t *,
+                                                int, const DeltaWrapBounds &);
+template void ComputeDeltaWrapOriginalValues<2>(const int32_t *, int32_t *,
+                                                int, const DeltaWrapBounds &);
+template void ComputeDeltaWrapOriginalValues<3>(const int32_t *, int32_t *,
+                                                int, const DeltaWrapBounds &);
+template void ComputeDeltaWrapOriginalValues<4>(const int32_t *, int32_t *,
+                                                int, const DeltaWrapBounds &);
+
+}  // namespace draco
@@ -0,0 +1,88 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_DELTA_WRAP_KERNELS_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_DELTA_WRAP_KERNELS_H_
+
+#include <stdint.h>
+
+namespace draco {
+
+// Bounds of the PredictionSchemeWrapDecodingTransform used by the kernels.
+struct DeltaWrapBounds {
+  int32_t min_value;
+  int32_t max_value;
+  int32_t max_dif;
+  int32_t min_correction;
+  int32_t max_correction;
+};
+
+// Computes the original value |out| of |num_components_t| components from the
+// previous original value |prev| and the corrections |corr|. This is the same
+// computation as PredictionSchemeWrapDecodingTransform::ComputeOriginalValue().
+template <int num_components_t>
+inline void ComputeDeltaWrapOriginalValue(const int32_t *prev,
+                                          const int32_t *corr, int32_t *out,
+                                          const DeltaWrapBounds &bounds) {
+  for (int i = 0; i < num_components_t; ++i) {
+    int32_t pred = prev[i];
+    if (pred > bounds.max_value) {
+      pred = bounds.max_value;
+    } else if (pred < bounds.min_value) {
+      pred = bounds.min_value;
+    }
+    // Unsigned addition avoids signed overflows caused by malformed input.
+    int32_t value = static_cast<int32_t>(static_cast<uint32_t>(pred) +
+                                         static_cast<uint32_t>(corr[i]));
+    if (value > bounds.max_value) {
+      value -= bounds.max_dif;
+    } else if (value < bounds.min_value) {
+      value += bounds.max_dif;
+    }
+    out[i] = value;
+  }
+}
+
+// Reconstructs |size| values of |num_components_t| components encoded by
+// PredictionSchemeDeltaEncoder with PredictionSchemeWrapEncodingTransform,
+// i.e., D(i) = Wrap(Clamp(D(i - 1)) + corr(i)) with D(-1) = 0. |corr| and
+// |out| may point to the same memory. The result is identical to calling
+// ComputeDeltaWrapOriginalValue() for every value.
+//
+// Defined for 1 to 4 components. Uses SIMD kernels when available.
+template <int num_components_t>
+void ComputeDeltaWrapOriginalValues(const int32_t *corr, int32_t *out,
+                                    int size, const DeltaWrapBounds &bounds);
+
+// SIMD kernels used by ComputeDeltaWrapOriginalValues(). They reconstruct
+// values from the start of the input and return the number of reconstructed
+// values, which is a multiple of |num_components_t|. Whenever the corrections
+// of a group of values are out of the correction bounds, i.e., the input is
+// malformed, the group is reconstructed with ComputeDeltaWrapOriginalValue().
+#if DRACO_ENABLE_SSE4_1
+template <int num_components_t>
+int ComputeDeltaWrapOriginalValuesSse4(const int32_t *corr, int32_t *out,
+                                       int size,
+                                       const DeltaWrapBounds &bounds);
+#endif
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+template <int num_components_t>
+int ComputeDeltaWrapOriginalValuesNeon(const int32_t *corr, int32_t *out,
+                                       int size,
+                                       const DeltaWrapBounds &bounds);
+#endif
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_DELTA_WRAP_KERNELS_H_
@@ -0,0 +1,137 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+
+namespace draco {
+
+namespace {
+
+// See prediction_scheme_delta_wrap_kernels_sse4.cc for the description of the
+// residue arithmetic.
+
+// Returns (a + b) mod n for residues |a| and |b|.
+inline uint32x4_t AddResidues(uint32x4_t a, uint32x4_t b, uint32x4_t n) {
+  const uint32x4_t sum = vaddq_u32(a, b);
+  return vminq_u32(sum, vsubq_u32(sum, n));
+}
+
+// Returns residues of the clamped previous value |prev| placed in the lanes
+// of the matching components of the next group of values.
+template <int num_components_t>
+inline uint32x4_t LoadPreviousResidues(const int32_t *prev,
+                                       const DeltaWrapBounds &bounds) {
+  int32_t lanes[4];
+  for (int i = 0; i < 4; ++i) {
+    lanes[i] = num_components_t == 3 && i == 3
+                   ? 0
+                   : prev[i % num_components_t];
+  }
+  int32x4_t values = vld1q_s32(lanes);
+  const int32x4_t min_value = vdupq_n_s32(bounds.min_value);
+  values = vminq_s32(values, vdupq_n_s32(bounds.max_value));
+  values = vmaxq_s32(values, min_value);
+  return vreinterpretq_u32_s32(vsubq_s32(values, min_value));
+}
+
+}  // namespace
+
+template <int num_components_t>
+int ComputeDeltaWrapOriginalValuesNeon(const int32_t *corr, int32_t *out,
+                                       int size,
+                                       const DeltaWrapBounds &bounds) {
+  constexpr int kStep = num_components_t == 3 ? 3 : 4;
+  const uint32x4_t min_value =
+      vreinterpretq_u32_s32(vdupq_n_s32(bounds.min_value));
+  const uint32x4_t max_dif =
+      vreinterpretq_u32_s32(vdupq_n_s32(bounds.max_dif));
+  const int32x4_t min_correction = vdupq_n_s32(bounds.min_correction);
+  const int32x4_t max_correction = vdupq_n_s32(bounds.max_correction);
+  const uint32x4_t zero = vdupq_n_u32(0);
+  // With three components the last lane belongs to the next value and it is
+  // excluded from the bounds check.
+  const uint32_t lane_mask_data[4] = {~0u, ~0u, ~0u,
+                                      num_components_t == 3 ? 0u : ~0u};
+  const uint32x4_t lane_mask = vld1q_u32(lane_mask_data);
+  const int32_t zero_vals[4] = {};
+  uint32x4_t prev = LoadPreviousResidues<num_components_t>(zero_vals, bounds);
+
+  int i = 0;
+  for (; i + 4 <= size; i += kStep) {
+    const int32x4_t corrections = vld1q_s32(corr + i);
+    const uint32x4_t out_of_bounds =
+        vandq_u32(vorrq_u32(vcgtq_s32(corrections, max_correction),
+                            vcltq_s32(corrections, min_correction)),
+                  lane_mask);
+    if (vmaxvq_u32(out_of_bounds) != 0) {
+      for (int j = i; j < i + kStep; j += num_components_t) {
+        ComputeDeltaWrapOriginalValue<num_components_t>(
+            j == 0 ? zero_vals : out + j - num_components_t, corr + j, out + j,
+            bounds);
+      }
+      prev = LoadPreviousResidues<num_components_t>(
+          out + i + kStep - num_components_t, bounds);
+      continue;
+    }
+    // Negative corrections are mapped to their positive residues.
+    const uint32x4_t negative =
+        vreinterpretq_u32_s32(vshrq_n_s32(corrections, 31));
+    uint32x4_t residues = vaddq_u32(vreinterpretq_u32_s32(corrections),
+                                    vandq_u32(negative, max_dif));
+    // Prefix sum of the values within the group.
+    if (num_components_t == 1) {
+      residues = AddResidues(residues, vextq_u32(zero, residues, 3), max_dif);
+      residues = AddResidues(residues, vextq_u32(zero, residues, 2), max_dif);
+    } else if (num_components_t == 2) {
+      residues = AddResidues(residues, vextq_u32(zero, residues, 2), max_dif);
+    }
+    residues = AddResidues(residues, prev, max_dif);
+    uint32x4_t values = vaddq_u32(residues, min_value);
+    if (num_components_t == 3) {
+      values = vbslq_u32(lane_mask, values,
+                         vreinterpretq_u32_s32(corrections));
+    }
+    vst1q_s32(out + i, vreinterpretq_s32_u32(values));
+
+    // The last value of the group predicts the next group.
+    if (num_components_t == 1) {
+      prev = vdupq_laneq_u32(residues, 3);
+    } else if (num_components_t == 2) {
+      prev = vcombine_u32(vget_high_u32(residues), vget_high_u32(residues));
+    } else {
+      prev = residues;
+    }
+  }
+  return i;
+}
+
+template int ComputeDeltaWrapOriginalValuesNeon<1>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesNeon<2>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesNeon<3>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesNeon<4>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_NEON && defined(__aarch64__)
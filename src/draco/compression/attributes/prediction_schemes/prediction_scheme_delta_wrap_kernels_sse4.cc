@@ -0,0 +1,140 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+
+#if DRACO_ENABLE_SSE4_1
+#include <smmintrin.h>
+
+namespace draco {
+
+namespace {
+
+// When the predicted value P is within the bounds and the correction X is
+// within the correction bounds, the wrapped value P + X is equal to
+// MIN + ((P - MIN + X) mod N), where N is the size of the range of the values.
+// The kernels therefore work with residues modulo N that are always in <0, N)
+// and they can sum corrections of multiple values in parallel. Since N is
+// smaller than 2^31, the sum of two residues never overflows an unsigned
+// 32-bit integer.
+
+// Returns (a + b) mod n for residues |a| and |b|.
+inline __m128i AddResidues(__m128i a, __m128i b, __m128i n) {
+  const __m128i sum = _mm_add_epi32(a, b);
+  // When the sum is smaller than n, the subtraction wraps around to a larger
+  // unsigned value.
+  return _mm_min_epu32(sum, _mm_sub_epi32(sum, n));
+}
+
+// Returns residues of the clamped previous value |prev| placed in the lanes
+// of the matching components of the next group of values.
+template <int num_components_t>
+inline __m128i LoadPreviousResidues(const int32_t *prev,
+                                    const DeltaWrapBounds &bounds) {
+  __m128i values;
+  if (num_components_t == 1) {
+    values = _mm_set1_epi32(prev[0]);
+  } else if (num_components_t == 2) {
+    values = _mm_set_epi32(prev[1], prev[0], prev[1], prev[0]);
+  } else if (num_components_t == 3) {
+    values = _mm_set_epi32(0, prev[2], prev[1], prev[0]);
+  } else {
+    values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev));
+  }
+  const __m128i min_value = _mm_set1_epi32(bounds.min_value);
+  values = _mm_min_epi32(values, _mm_set1_epi32(bounds.max_value));
+  values = _mm_max_epi32(values, min_value);
+  return _mm_sub_epi32(values, min_value);
+}
+
+}  // namespace
+
+template <int num_components_t>
+int ComputeDeltaWrapOriginalValuesSse4(const int32_t *corr, int32_t *out,
+                                       int size,
+                                       const DeltaWrapBounds &bounds) {
+  // Every step loads four corrections and reconstructs all values whose
+  // components fit into them. With three components the last lane belongs to
+  // the next value and it is left unchanged.
+  constexpr int kStep = num_components_t == 3 ? 3 : 4;
+  constexpr int kLaneMask = num_components_t == 3 ? 0x7 : 0xf;
+  const __m128i min_value = _mm_set1_epi32(bounds.min_value);
+  const __m128i max_dif = _mm_set1_epi32(bounds.max_dif);
+  const __m128i min_correction = _mm_set1_epi32(bounds.min_correction);
+  const __m128i max_correction = _mm_set1_epi32(bounds.max_correction);
+  const int32_t zero_vals[4] = {};
+  __m128i prev = LoadPreviousResidues<num_components_t>(zero_vals, bounds);
+
+  int i = 0;
+  for (; i + 4 <= size; i += kStep) {
+    const __m128i corrections =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(corr + i));
+    const __m128i out_of_bounds =
+        _mm_or_si128(_mm_cmpgt_epi32(corrections, max_correction),
+                     _mm_cmplt_epi32(corrections, min_correction));
+    if (_mm_movemask_ps(_mm_castsi128_ps(out_of_bounds)) & kLaneMask) {
+      for (int j = i; j < i + kStep; j += num_components_t) {
+        ComputeDeltaWrapOriginalValue<num_components_t>(
+            j == 0 ? zero_vals : out + j - num_components_t, corr + j, out + j,
+            bounds);
+      }
+      prev = LoadPreviousResidues<num_components_t>(
+          out + i + kStep - num_components_t, bounds);
+      continue;
+    }
+    // Negative corrections are mapped to their positive residues.
+    __m128i residues = _mm_add_epi32(
+        corrections, _mm_and_si128(_mm_srai_epi32(corrections, 31), max_dif));
+    // Prefix sum of the values within the group.
+    if (num_components_t == 1) {
+      residues = AddResidues(residues, _mm_slli_si128(residues, 4), max_dif);
+      residues = AddResidues(residues, _mm_slli_si128(residues, 8), max_dif);
+    } else if (num_components_t == 2) {
+      residues = AddResidues(residues, _mm_slli_si128(residues, 8), max_dif);
+    }
+    residues = AddResidues(residues, prev, max_dif);
+    __m128i values = _mm_add_epi32(residues, min_value);
+    if (num_components_t == 3) {
+      values = _mm_blend_epi16(values, corrections, 0xc0);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), values);
+
+    // The last value of the group predicts the next group.
+    if (num_components_t == 1) {
+      prev = _mm_shuffle_epi32(residues, _MM_SHUFFLE(3, 3, 3, 3));
+    } else if (num_components_t == 2) {
+      prev = _mm_shuffle_epi32(residues, _MM_SHUFFLE(3, 2, 3, 2));
+    } else {
+      prev = residues;
+    }
+  }
+  return i;
+}
+
+template int ComputeDeltaWrapOriginalValuesSse4<1>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesSse4<2>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesSse4<3>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+template int ComputeDeltaWrapOriginalValuesSse4<4>(const int32_t *, int32_t *,
+                                                   int,
+                                                   const DeltaWrapBounds &);
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_SSE4_1
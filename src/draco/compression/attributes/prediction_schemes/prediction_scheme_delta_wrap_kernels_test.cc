@@ -0,0 +1,121 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
+
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace {
+
+class PredictionSchemeDeltaWrapKernelsTest : public ::testing::Test {
+ protected:
+  typedef draco::PredictionSchemeWrapDecodingTransform<int32_t> Transform;
+
+  void InitTransform(int32_t min_value, int32_t max_value) {
+    draco::EncoderBuffer eb;
+    eb.Encode(min_value);
+    eb.Encode(max_value);
+    draco::DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    ASSERT_TRUE(transform_.DecodeTransformData(&db));
+  }
+
+  // Returns corrections of |size| random values. |num_invalid| corrections
+  // are outside of the correction bounds.
+  std::vector<int32_t> GenerateCorrections(int size, int num_invalid) {
+    const draco::DeltaWrapBounds bounds = transform_.GetDeltaWrapBounds();
+    const uint32_t num_corrections = static_cast<uint32_t>(
+        static_cast<int64_t>(bounds.max_correction) - bounds.min_correction +
+        1);
+    std::vector<int32_t> corr(size);
+    for (int i = 0; i < size; ++i) {
+      corr[i] = bounds.min_correction +
+                static_cast<int32_t>(NextRandom() % num_corrections);
+    }
+    for (int i = 0; i < num_invalid; ++i) {
+      corr[NextRandom() % size] = static_cast<int32_t>(NextRandom());
+    }
+    return corr;
+  }
+
+  // Reconstructs the values the same way as PredictionSchemeDeltaDecoder with
+  // the generic transform interface.
+  std::vector<int32_t> ComputeReference(const std::vector<int32_t> &corr,
+                                        int num_components) {
+    std::vector<int32_t> out(corr.size());
+    transform_.Init(num_components);
+    const std::vector<int32_t> zero_vals(num_components, 0);
+    transform_.ComputeOriginalValue(zero_vals.data(), corr.data(), out.data());
+    for (int i = num_components; i < static_cast<int>(corr.size());
+         i += num_components) {
+      transform_.ComputeOriginalValue(out.data() + i - num_components,
+                                      corr.data() + i, out.data() + i);
+    }
+    return out;
+  }
+
+  template <int num_components_t>
+  void TestKernel(int32_t min_value, int32_t max_value, int num_invalid) {
+    InitTransform(min_value, max_value);
+    const draco::DeltaWrapBounds bounds = transform_.GetDeltaWrapBounds();
+    // Sizes that are and are not multiples of the SIMD group sizes.
+    for (const int num_entries : {1, 2, 3, 5, 64, 1001}) {
+      const int size = num_entries * num_components_t;
+      const std::vector<int32_t> corr = GenerateCorrections(size, num_invalid);
+      const std::vector<int32_t> reference =
+          ComputeReference(corr, num_components_t);
+      std::vector<int32_t> out(size);
+      draco::ComputeDeltaWrapOriginalValues<num_components_t>(
+          corr.data(), out.data(), size, bounds);
+      ASSERT_EQ(out, reference);
+      // In place reconstruction.
+      std::vector<int32_t> in_place = corr;
+      draco::ComputeDeltaWrapOriginalValues<num_components_t>(
+          in_place.data(), in_place.data(), size, bounds);
+      ASSERT_EQ(in_place, reference);
+    }
+  }
+
+  uint32_t NextRandom() {
+    seed_ = seed_ * 1664525u + 1013904223u;
+    return seed_ >> 1;
+  }
+
+  Transform transform_;
+  uint32_t seed_ = 1;
+};
+
+TEST_F(PredictionSchemeDeltaWrapKernelsTest, TestValidCorrections) {
+  TestKernel<1>(-5, 1000, 0);
+  TestKernel<2>(0, 4095, 0);
+  TestKernel<3>(100, 101, 0);
+  TestKernel<4>(7, 7, 0);
+  TestKernel<1>(-(1 << 30), (1 << 30) - 2, 0);
+  TestKernel<3>(-1000000, 1000000, 0);
+}
+
+TEST_F(PredictionSchemeDeltaWrapKernelsTest, TestMalformedCorrections) {
+  // Values reconstructed from corrections out of bounds must still match the
+  // generic implementation.
+  TestKernel<1>(-5, 1000, 10);
+  TestKernel<2>(0, 4095, 10);
+  TestKernel<3>(100, 101, 10);
+  TestKernel<4>(-1000000, 1000000, 10);
+}
+
+}  // namespace
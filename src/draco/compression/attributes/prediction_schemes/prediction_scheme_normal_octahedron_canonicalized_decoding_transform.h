@@ -15,6 +15,7 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_NORMAL_OCTAHEDRON_CANONICALIZED_DECODING_TRANSFORM_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_NORMAL_OCTAHEDRON_CANONICALIZED_DECODING_TRANSFORM_H_
 
+#include <algorithm>
 #include <cmath>
 
 #include "draco/compression/attributes/normal_compression_utils.h"
@@ -85,7 +86,43 @@ class PredictionSchemeNormalOctahedronCanonicalizedDecodingTransform
     out_orig_vals[1] = orig[1];
   }
 
+  // Computes original values of |num_entries| consecutive entries. Groups of
+  // entries are processed with SIMD kernels when they are available and the
+  // results are identical to calling ComputeOriginalValue() for every entry.
+  void ComputeOriginalValues(const DataType *pred_vals,
+                             const CorrType *corr_vals, DataType *out_orig_vals,
+                             int num_entries) const {
+    int i = 0;
+    while (i < num_entries) {
+      i += ComputeOriginalValuesInGroups(pred_vals + 2 * i, corr_vals + 2 * i,
+                                         out_orig_vals + 2 * i,
+                                         num_entries - i);
+      // Entries not handled by the kernels, i.e., the tail or a group with
+      // invalid values.
+      const int end = std::min(i + 4, num_entries);
+      for (; i < end; ++i) {
+        ComputeOriginalValue(pred_vals + 2 * i, corr_vals + 2 * i,
+                             out_orig_vals + 2 * i);
+      }
+    }
+  }
+
  private:
+  int ComputeOriginalValuesInGroups(const int32_t *pred_vals,
+                                    const int32_t *corr_vals,
+                                    int32_t *out_orig_vals,
+                                    int num_entries) const {
+    return ComputeCanonicalizedOctahedralCoords(
+        pred_vals, corr_vals, num_entries, this->center_value(),
+        this->max_quantized_value(), out_orig_vals);
+  }
+
+  // Other data types are not supported by the kernels.
+  template <typename T>
+  int ComputeOriginalValuesInGroups(const T *, const T *, T *, int) const {
+    return 0;
+  }
+
   Point2 ComputeOriginalValue(Point2 pred, Point2 corr) const {
     const Point2 t(this->center_value(), this->center_value());
     pred = pred - t;
@@ -12,8 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_decoding_transform.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_encoding_transform.h"
 #include "draco/core/draco_test_base.h"
+#include "draco/core/encoder_buffer.h"
 
 namespace {
 
@@ -54,6 +58,32 @@ class PredictionSchemeNormalOctahedronCanonicalizedTransformTest
     ASSERT_EQ(rot_pred[0], res_pred[0]);
     ASSERT_EQ(rot_pred[1], res_pred[1]);
   }
+
+  // Verifies that the batched decoding of |pred| and |corr| values matches
+  // decoding of the individual entries.
+  void TestComputeOriginalValues(int32_t max_quantized_value,
+                                 const std::vector<int32_t> &pred,
+                                 const std::vector<int32_t> &corr) {
+    draco::EncoderBuffer eb;
+    eb.Encode(max_quantized_value);
+    eb.Encode(max_quantized_value / 2);
+    draco::DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    draco::PredictionSchemeNormalOctahedronCanonicalizedDecodingTransform<
+        int32_t>
+        transform;
+    ASSERT_TRUE(transform.DecodeTransformData(&db));
+    const int num_entries = static_cast<int>(pred.size() / 2);
+    std::vector<int32_t> reference(pred.size());
+    for (int i = 0; i < num_entries; ++i) {
+      transform.ComputeOriginalValue(&pred[2 * i], &corr[2 * i],
+                                     &reference[2 * i]);
+    }
+    std::vector<int32_t> out(pred.size());
+    transform.ComputeOriginalValues(pred.data(), corr.data(), out.data(),
+                                    num_entries);
+    ASSERT_EQ(out, reference);
+  }
 };
 
 TEST_F(PredictionSchemeNormalOctahedronCanonicalizedTransformTest, Init) {
@@ -182,6 +212,43 @@ TEST_F(PredictionSchemeNormalOctahedronCanonicalizedTransformTest,
   TestComputeCorrection(transform, -1, -2, 0, -2, 0, 1);
 }
 
+TEST_F(PredictionSchemeNormalOctahedronCanonicalizedTransformTest,
+       ComputeOriginalValues) {
+  // All combinations of predictions and corrections for 4 bit quantization.
+  std::vector<int32_t> pred;
+  std::vector<int32_t> corr;
+  for (int32_t ps = 0; ps < 15; ++ps) {
+    for (int32_t pt = 0; pt < 15; ++pt) {
+      for (int32_t cs = 0; cs < 15; ++cs) {
+        for (int32_t ct = 0; ct < 15; ++ct) {
+          pred.insert(pred.end(), {ps, pt});
+          corr.insert(corr.end(), {cs, ct});
+        }
+      }
+    }
+  }
+  TestComputeOriginalValues(15, pred, corr);
+  // Random values with 10 bit quantization and a number of entries that is
+  // not a multiple of the SIMD group size.
+  uint32_t seed = 1;
+  pred.resize(2 * 1003);
+  corr.resize(2 * 1003);
+  for (size_t i = 0; i < pred.size(); ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    pred[i] = (seed >> 8) % 1023;
+    seed = seed * 1664525u + 1013904223u;
+    corr[i] = (seed >> 8) % 1023;
+  }
+  TestComputeOriginalValues(1023, pred, corr);
+#ifndef DRACO_DEBUG
+  // Corrections out of the expected range, e.g. in malformed input, must be
+  // decoded the same way as well.
+  corr[101] = 5000;
+  corr[502] = -3;
+  TestComputeOriginalValues(1023, pred, corr);
+#endif
+}
+
 TEST_F(PredictionSchemeNormalOctahedronCanonicalizedTransformTest, Interface) {
   const Transform transform(15);
   ASSERT_EQ(transform.max_quantized_value(), 15);
@@ -77,6 +77,15 @@ class PredictionSchemeNormalOctahedronDecodingTransform
     out_orig_vals[1] = orig[1];
   }
 
+  // Computes original values of |num_entries| consecutive entries.
+  void ComputeOriginalValues(const DataType *pred_vals,
+                             const CorrType *corr_vals, DataType *out_orig_vals,
+                             int num_entries) const {
+    for (int i = 0; i < 2 * num_entries; i += 2) {
+      ComputeOriginalValue(pred_vals + i, corr_vals + i, out_orig_vals + i);
+    }
+  }
+
  private:
   Point2 ComputeOriginalValue(Point2 pred, const Point2 &corr) const {
     const Point2 t(this->center_value(), this->center_value());
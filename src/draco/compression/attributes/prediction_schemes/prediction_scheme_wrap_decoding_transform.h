@@ -15,6 +15,7 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_WRAP_DECODING_TRANSFORM_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_WRAP_DECODING_TRANSFORM_H_
 
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_wrap_kernels.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_transform_base.h"
 #include "draco/core/decoder_buffer.h"
 
@@ -63,6 +64,30 @@ class PredictionSchemeWrapDecodingTransform
     }
   }
 
+  // Computes original values of |num_entries| consecutive entries.
+  void ComputeOriginalValues(const DataTypeT *predicted_vals,
+                             const CorrTypeT *corr_vals,
+                             DataTypeT *out_original_vals,
+                             int num_entries) const {
+    const int size = num_entries * this->num_components();
+    for (int i = 0; i < size; i += this->num_components()) {
+      ComputeOriginalValue(predicted_vals + i, corr_vals + i,
+                           out_original_vals + i);
+    }
+  }
+
+  // Returns the bounds of the transform for the delta decoding kernels (see
+  // prediction_scheme_delta_wrap_kernels.h).
+  DeltaWrapBounds GetDeltaWrapBounds() const {
+    DeltaWrapBounds bounds;
+    bounds.min_value = this->min_value();
+    bounds.max_value = this->max_value();
+    bounds.max_dif = this->max_dif();
+    bounds.min_correction = this->min_correction();
+    bounds.max_correction = this->max_correction();
+    return bounds;
+  }
+
   bool DecodeTransformData(DecoderBuffer *buffer) {
     DataTypeT min_value, max_value;
     if (!buffer->Decode(&min_value)) {
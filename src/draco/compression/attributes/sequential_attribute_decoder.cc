@@ -37,7 +37,7 @@ bool SequentialAttributeDecoder::InitializeStandalone(
 Status SequentialAttributeDecoder::DecodePortableAttribute(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   if (attribute_->num_components() <= 0 ||
-      !attribute_->Reset(point_ids.size())) {
+      !ResetAttribute(point_ids.size())) {
     return Status(Status::DRACO_ERROR, "Failed to decode sequential, num_components.");
   }
   Status status = DecodeValues(point_ids, in_buffer);
@@ -47,6 +47,15 @@ Status SequentialAttributeDecoder::DecodePortableAttribute(
   return Status(Status::OK, "Decode sequential.");
 }
 
+bool SequentialAttributeDecoder::ResetAttribute(size_t num_values) {
+  // Attributes of the decoded point cloud may be decoded into caller-owned
+  // memory.
+  if (attribute_id_ >= 0) {
+    return decoder_->ResetAttribute(attribute_, num_values);
+  }
+  return attribute_->Reset(num_values);
+}
+
 bool SequentialAttributeDecoder::DecodeDataNeededByPortableTransform(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   // Default implementation does not apply any transform.
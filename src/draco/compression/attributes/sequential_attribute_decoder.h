@@ -73,6 +73,9 @@ class SequentialAttributeDecoder {
   PointAttribute *portable_attribute() { return portable_attribute_.get(); }
 
  private:
+  // Resets the decoded attribute to |num_values| values.
+  bool ResetAttribute(size_t num_values);
+
   PointCloudDecoder *decoder_;
   PointAttribute *attribute_;
   int attribute_id_;
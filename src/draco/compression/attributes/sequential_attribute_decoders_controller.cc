@@ -33,11 +33,13 @@ bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
   // Decode unique ids of all sequential encoders and create them.
   const int32_t num_attributes = GetNumAttributes();
   sequential_decoders_.resize(num_attributes);
+  sequential_decoder_types_.resize(num_attributes);
   for (int i = 0; i < num_attributes; ++i) {
     uint8_t decoder_type;
     if (!buffer->Decode(&decoder_type)) {
       return false;
     }
+    sequential_decoder_types_[i] = decoder_type;
     // Create the decoder from the id.
     sequential_decoders_[i] = CreateSequentialDecoder(decoder_type);
     if (!sequential_decoders_[i]) {
@@ -50,8 +52,7 @@ bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
   return true;
 }
 
-Status SequentialAttributeDecodersController::DecodeAttributes(
-    DecoderBuffer *buffer) {
+Status SequentialAttributeDecodersController::GeneratePointSequence() {
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
     return Status(Status::DRACO_ERROR, "Failed to generate sequence.");
   }
@@ -61,9 +62,46 @@ Status SequentialAttributeDecodersController::DecodeAttributes(
     PointAttribute *const pa =
         GetDecoder()->point_cloud()->attribute(GetAttributeId(i));
     if (!sequencer_->UpdatePointToAttributeIndexMapping(pa)) {
-      return Status(Status::DRACO_ERROR, "Failed to initialize point to attribute value mapping.");
+      return Status(Status::DRACO_ERROR,
+                    "Failed to initialize point to attribute value mapping.");
+    }
+  }
+  return OkStatus();
+}
+
+std::unique_ptr<SequentialAttributeDecodersController>
+SequentialAttributeDecodersController::CreateCopy(
+    std::unique_ptr<PointsSequencer> sequencer, PointCloudDecoder *decoder,
+    PointCloud *pc) const {
+  std::unique_ptr<SequentialAttributeDecodersController> copy(
+      new SequentialAttributeDecodersController(std::move(sequencer)));
+  if (!copy->Init(decoder, pc)) {
+    return nullptr;
+  }
+  const int32_t num_attributes = GetNumAttributes();
+  std::vector<int32_t> point_attribute_ids(num_attributes);
+  for (int i = 0; i < num_attributes; ++i) {
+    point_attribute_ids[i] = GetAttributeId(i);
+  }
+  copy->SetAttributeIds(point_attribute_ids);
+  copy->sequential_decoders_.resize(num_attributes);
+  copy->sequential_decoder_types_ = sequential_decoder_types_;
+  for (int i = 0; i < num_attributes; ++i) {
+    copy->sequential_decoders_[i] =
+        copy->CreateSequentialDecoder(sequential_decoder_types_[i]);
+    if (!copy->sequential_decoders_[i]) {
+      return nullptr;
+    }
+    if (!copy->sequential_decoders_[i]->Init(decoder, point_attribute_ids[i])) {
+      return nullptr;
     }
   }
+  return copy;
+}
+
+Status SequentialAttributeDecodersController::DecodeAttributes(
+    DecoderBuffer *buffer) {
+  DRACO_RETURN_IF_ERROR(GeneratePointSequence())
   return AttributesDecoder::DecodeAttributes(buffer);
 }
 
@@ -43,6 +43,23 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
     return sequential_decoders_[loc_id]->GetPortableAttribute();
   }
 
+  // Generates the sequence of decoded points and sets up the point to
+  // attribute value mapping of all decoded attributes. No attribute values are
+  // decoded. Called automatically by DecodeAttributes().
+  Status GeneratePointSequence();
+
+  // Returns the point sequence generated by GeneratePointSequence().
+  const std::vector<PointIndex> &point_ids() const { return point_ids_; }
+
+  // Creates a new controller that decodes the same attributes with the same
+  // types of sequential decoders as this controller, but into the point cloud
+  // |pc| of |decoder|. Points are sequenced by |sequencer|. This allows to
+  // decode the attributes again without the attributes decoder data. Returns
+  // nullptr on error.
+  std::unique_ptr<SequentialAttributeDecodersController> CreateCopy(
+      std::unique_ptr<PointsSequencer> sequencer, PointCloudDecoder *decoder,
+      PointCloud *pc) const;
+
  protected:
   Status DecodePortableAttributes(DecoderBuffer *in_buffer) override;
   bool DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) override;
@@ -52,6 +69,7 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
 
  private:
   std::vector<std::unique_ptr<SequentialAttributeDecoder>> sequential_decoders_;
+  std::vector<uint8_t> sequential_decoder_types_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
 };
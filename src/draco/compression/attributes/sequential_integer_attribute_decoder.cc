@@ -149,8 +149,8 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
           num_bytes * num_values) {
         return false;
       }
-      if (in_buffer->remaining_size() <
-          static_cast<int64_t>(num_bytes) * static_cast<int64_t>(num_values)) {
+      if (!in_buffer->CheckRemainingSize(static_cast<uint64_t>(num_bytes) *
+                                         num_values)) {
         return false;
       }
       for (size_t i = 0; i < num_values; ++i) {
@@ -158,6 +158,9 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     if (encoder() != nullptr) {
       SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
                                         10 - encoder()->options()->GetSpeed());
+      SetSymbolEncodingInterleavedStates(
+          &symbol_encoding_options,
+          encoder()->options()->GetGlobalInt("interleaved_rans_states", 1));
     }
     if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
                        static_cast<int>(point_ids.size()) * num_components,
@@ -18,6 +18,7 @@
 #include "draco/compression/attributes/sequential_integer_attribute_encoder.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
 
 namespace draco {
 
@@ -50,7 +51,7 @@ TEST_F(SequentialIntegerAttributeEncodingTest, DoesCompress) {
   in_buf.set_bitstream_version(kDracoMeshBitstreamVersion);
   SequentialIntegerAttributeDecoder id;
   ASSERT_TRUE(id.InitializeStandalone(&pa));
-  ASSERT_TRUE(id.DecodePortableAttribute(point_ids, &in_buf));
+  DRACO_ASSERT_OK(id.DecodePortableAttribute(point_ids, &in_buf));
   ASSERT_TRUE(id.DecodeDataNeededByPortableTransform(point_ids, &in_buf));
   ASSERT_TRUE(id.TransformAttributeToOriginalFormat(point_ids));
 
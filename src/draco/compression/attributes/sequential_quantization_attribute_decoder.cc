@@ -39,7 +39,7 @@ bool SequentialQuantizationAttributeDecoder::DecodeIntegerValues(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder()->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0) &&
-      !DecodeQuantizedDataInfo()) {
+      !DecodeQuantizedDataInfo(in_buffer)) {
     return false;
   }
 #endif
@@ -51,9 +51,8 @@ bool SequentialQuantizationAttributeDecoder::
     DecodeDataNeededByPortableTransform(
         const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   if (decoder()->bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0)) {
-    decoder()->SetBuffer(in_buffer);
     // Decode quantization data here only for files with bitstream version 2.0+
-    if (!DecodeQuantizedDataInfo()) {
+    if (!DecodeQuantizedDataInfo(in_buffer)) {
       return false;
     }
   }
@@ -66,7 +65,8 @@ bool SequentialQuantizationAttributeDecoder::StoreValues(uint32_t num_points) {
   return DequantizeValues(num_points);
 }
 
-bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
+bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo(
+    DecoderBuffer *in_buffer) {
   // Get attribute used as source for decoding.
   auto att = GetPortableAttribute();
   if (att == nullptr) {
@@ -76,7 +76,7 @@ bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
     // and target attributes.
     att = attribute();
   }
-  return quantization_transform_.DecodeParameters(*att, decoder()->buffer());
+  return quantization_transform_.DecodeParameters(*att, in_buffer);
 }
 
 bool SequentialQuantizationAttributeDecoder::DequantizeValues(
@@ -37,8 +37,9 @@ class SequentialQuantizationAttributeDecoder
       DecoderBuffer *in_buffer) override;
   bool StoreValues(uint32_t num_points) override;
 
-  // Decodes data necessary for dequantizing the encoded values.
-  virtual bool DecodeQuantizedDataInfo();
+  // Decodes data necessary for dequantizing the encoded values from
+  // |in_buffer|.
+  virtual bool DecodeQuantizedDataInfo(DecoderBuffer *in_buffer);
 
   // Dequantizes all values and stores them into the output attribute.
   virtual bool DequantizeValues(uint32_t num_values);
@@ -0,0 +1,110 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/batch_decoder.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#include "draco/compression/decode.h"
+
+namespace draco {
+
+namespace {
+
+// Indices of the buffers assigned to one thread. The owner takes indices from
+// the front of the queue and other threads steal them from the back.
+struct WorkQueue {
+  std::mutex mutex;
+  std::deque<size_t> indices;
+};
+
+// Takes the next buffer index of thread |thread_id| from its own queue or,
+// when it is empty, from the queue of another thread. Returns false when all
+// queues are empty. No work is added once the threads are started, so an
+// empty scan means that the batch is finished.
+bool TakeIndex(std::vector<WorkQueue> *queues, int thread_id,
+               size_t *out_index) {
+  const int num_queues = static_cast<int>(queues->size());
+  for (int i = 0; i < num_queues; ++i) {
+    WorkQueue &queue = (*queues)[(thread_id + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.indices.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      *out_index = queue.indices.front();
+      queue.indices.pop_front();
+    } else {
+      *out_index = queue.indices.back();
+      queue.indices.pop_back();
+    }
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+constexpr size_t BatchDecoder::kMaxRetainedBytesPerThread;
+
+std::vector<StatusOr<std::unique_ptr<Mesh>>> BatchDecoder::DecodeAll(
+    DecoderBuffer *buffers, size_t num_buffers, const DecoderOptions &options,
+    int num_threads) {
+  std::vector<StatusOr<std::unique_ptr<Mesh>>> results(num_buffers);
+  if (num_buffers == 0) {
+    return results;
+  }
+  num_threads = static_cast<int>(std::min<size_t>(
+      std::max(num_threads, 1), num_buffers));
+
+  // Deal the buffers to the threads round-robin from the largest one, so that
+  // every thread starts with a similar amount of work and the small buffers
+  // left at the end balance the load.
+  std::vector<size_t> order(num_buffers);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [buffers](size_t a, size_t b) {
+    return buffers[a].remaining_size() > buffers[b].remaining_size();
+  });
+  std::vector<WorkQueue> queues(num_threads);
+  for (size_t i = 0; i < num_buffers; ++i) {
+    queues[i % num_threads].indices.push_back(order[i]);
+  }
+
+  // Each result is written by exactly one thread.
+  const auto run_thread = [&](int thread_id) {
+    Decoder decoder;
+    *decoder.options() = options;
+    decoder.SetRetainedMemoryLimit(kMaxRetainedBytesPerThread);
+    size_t index;
+    while (TakeIndex(&queues, thread_id, &index)) {
+      results[index] = decoder.DecodeMeshFromBuffer(&buffers[index]);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int i = 1; i < num_threads; ++i) {
+    threads.push_back(std::thread(run_thread, i));
+  }
+  run_thread(0);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+}  // namespace draco
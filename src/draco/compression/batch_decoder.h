@@ -0,0 +1,51 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_BATCH_DECODER_H_
+#define DRACO_COMPRESSION_BATCH_DECODER_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status_or.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decodes many independent meshes, such as the tiles of a scene, on a pool of
+// threads.
+class BatchDecoder {
+ public:
+  // Memory kept by each thread for warm decoding between two meshes of a
+  // batch (see Decoder::SetRetainedMemoryLimit()).
+  static constexpr size_t kMaxRetainedBytesPerThread = 16 * 1024 * 1024;
+
+  // Decodes the |num_buffers| meshes held in |buffers| using |num_threads|
+  // threads, including the calling thread, and returns the results in the
+  // order of the buffers. Each thread uses its own Decoder configured with
+  // |options|. The buffers are split between the threads, largest buffers
+  // first, and threads that run out of work steal buffers from the others, so
+  // that all threads stay busy even when the sizes of the meshes differ a lot.
+  // The buffers must not be accessed by other threads during the call.
+  static std::vector<StatusOr<std::unique_ptr<Mesh>>> DecodeAll(
+      DecoderBuffer *buffers, size_t num_buffers,
+      const DecoderOptions &options, int num_threads);
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_BATCH_DECODER_H_
@@ -0,0 +1,126 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/batch_decoder.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/file_utils.h"
+
+namespace {
+
+class BatchDecoderTest : public ::testing::Test {
+ protected:
+  BatchDecoderTest() {}
+
+  // Loads |num_buffers| encoded meshes of different sizes into |data| and
+  // initializes |buffers| with them.
+  void LoadBuffers(int num_buffers, std::vector<std::vector<char>> *data,
+                   std::vector<draco::DecoderBuffer> *buffers) {
+    const std::string files[] = {"test_nm.obj.edgebreaker.cl10.2.2.drc",
+                                 "test_nm.obj.sequential.cl3.2.2.drc",
+                                 "cube_att.obj.edgebreaker.cl4.2.2.drc",
+                                 "car.drc"};
+    data->resize(num_buffers);
+    buffers->resize(num_buffers);
+    for (int i = 0; i < num_buffers; ++i) {
+      ASSERT_TRUE(draco::ReadFileToBuffer(
+          draco::GetTestFileFullPath(files[i % 4]), &(*data)[i]));
+      (*buffers)[i].Init((*data)[i].data(), (*data)[i].size());
+    }
+  }
+
+  // Verifies that |mesh| is the same as the mesh decoded from |data| by a
+  // regular decoder.
+  void CompareWithDecoder(const std::vector<char> &data,
+                          const draco::Mesh &mesh) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    draco::Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                           decoder.DecodeMeshFromBuffer(&buffer));
+    ASSERT_EQ(mesh.num_faces(), ref_mesh->num_faces());
+    for (draco::FaceIndex f(0); f < ref_mesh->num_faces(); ++f) {
+      ASSERT_EQ(mesh.face(f), ref_mesh->face(f));
+    }
+    ASSERT_EQ(mesh.num_attributes(), ref_mesh->num_attributes());
+    for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+      const draco::PointAttribute *const ref_att = ref_mesh->attribute(i);
+      const draco::PointAttribute *const att = mesh.attribute(i);
+      for (draco::PointIndex p(0); p < ref_mesh->num_points(); ++p) {
+        ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(p),
+                         ref_att->GetAddressOfMappedIndex(p),
+                         att->byte_stride()),
+                  0);
+      }
+    }
+  }
+};
+
+TEST_F(BatchDecoderTest, TestDecodeAll) {
+  // Tests that meshes decoded in a batch are returned in the order of the
+  // input buffers and that they match the meshes decoded one by one.
+  std::vector<std::vector<char>> data;
+  std::vector<draco::DecoderBuffer> buffers;
+  ASSERT_NO_FATAL_FAILURE(LoadBuffers(23, &data, &buffers));
+  // One of the buffers is invalid.
+  const char kInvalidData[] = "DRACO invalid data";
+  buffers[5].Init(kInvalidData, sizeof(kInvalidData));
+
+  std::vector<draco::StatusOr<std::unique_ptr<draco::Mesh>>> results =
+      draco::BatchDecoder::DecodeAll(buffers.data(), buffers.size(),
+                                     draco::DecoderOptions(), 4);
+  ASSERT_EQ(results.size(), buffers.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (i == 5) {
+      ASSERT_FALSE(results[i].ok());
+      continue;
+    }
+    ASSERT_TRUE(results[i].ok()) << results[i].status().error_msg_string();
+    ASSERT_NO_FATAL_FAILURE(CompareWithDecoder(data[i], *results[i].value()));
+  }
+}
+
+TEST_F(BatchDecoderTest, TestNumThreads) {
+  // Tests batches decoded with more threads than buffers, with an invalid
+  // number of threads and empty batches.
+  std::vector<std::vector<char>> data;
+  std::vector<draco::DecoderBuffer> buffers;
+  ASSERT_NO_FATAL_FAILURE(LoadBuffers(3, &data, &buffers));
+  for (int num_threads : {0, 1, 8}) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      buffers[i].Init(data[i].data(), data[i].size());
+    }
+    std::vector<draco::StatusOr<std::unique_ptr<draco::Mesh>>> results =
+        draco::BatchDecoder::DecodeAll(buffers.data(), buffers.size(),
+                                       draco::DecoderOptions(), num_threads);
+    ASSERT_EQ(results.size(), buffers.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_TRUE(results[i].ok());
+      ASSERT_NO_FATAL_FAILURE(
+          CompareWithDecoder(data[i], *results[i].value()));
+    }
+    ASSERT_TRUE(draco::BatchDecoder::DecodeAll(nullptr, 0,
+                                               draco::DecoderOptions(),
+                                               num_threads)
+                    .empty());
+  }
+}
+
+}  // namespace
@@ -46,7 +46,7 @@ bool RAnsBitDecoder::StartDecoding(DecoderBuffer *source_buffer) {
     }
   }
 
-  if (size_in_bytes > source_buffer->remaining_size()) {
+  if (!source_buffer->CheckRemainingSize(size_in_bytes)) {
     return false;
   }
 
@@ -17,6 +17,9 @@
 
 #include <stdint.h>
 
+#include <string>
+#include <vector>
+
 #include "draco/core/macros.h"
 #include "draco/draco_features.h"
 
@@ -28,6 +31,18 @@ static constexpr uint8_t kDracoPointCloudBitstreamVersionMinor = 3;
 static constexpr uint8_t kDracoMeshBitstreamVersionMajor = 2;
 static constexpr uint8_t kDracoMeshBitstreamVersionMinor = 2;
 
+// Minor versions written instead of the latest ones when the encoder is allowed
+// to use SYMBOL_CODING_RAW_INTERLEAVED (see "interleaved_rans_states" encoder
+// option). Older decoders reject such bitstreams.
+static constexpr uint8_t kDracoPointCloudInterleavedRAnsVersionMinor = 4;
+static constexpr uint8_t kDracoMeshInterleavedRAnsVersionMinor = 3;
+
+// Minor versions written when the data of the attributes decoders is preceded
+// by their byte lengths (see ATTRIBUTE_SIZES_FLAG_MASK). Bitstreams of these
+// versions may also use SYMBOL_CODING_RAW_INTERLEAVED.
+static constexpr uint8_t kDracoPointCloudAttributeSizesVersionMinor = 5;
+static constexpr uint8_t kDracoMeshAttributeSizesVersionMinor = 4;
+
 // Concatenated latest bit-stream version.
 static constexpr uint16_t kDracoPointCloudBitstreamVersion =
     DRACO_BITSTREAM_VERSION(kDracoPointCloudBitstreamVersionMajor,
@@ -158,12 +173,69 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Same as SYMBOL_CODING_RAW, but the symbols are distributed between 4 or 8
+  // interleaved rANS states that can be decoded independently of each other.
+  SYMBOL_CODING_RAW_INTERLEAVED = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
 // Mask for setting and getting the bit for metadata in |flags| of header.
 #define METADATA_FLAG_MASK 0x8000
 
+// Mask for the bit in |flags| of header that is set when the data of every
+// attributes decoder is preceded by a table of their byte lengths (see the
+// "attribute_sizes" encoder option). It allows to decode the attributes in
+// parallel. The bit is used only by bitstreams of the versions listed by
+// kDracoMeshAttributeSizesVersionMinor and
+// kDracoPointCloudAttributeSizesVersionMinor or newer.
+#define ATTRIBUTE_SIZES_FLAG_MASK 0x4000
+
+// Split attribute container. A single file holding the base geometry (header,
+// metadata, connectivity and attribute decoder data) and every attribute chunk
+// produced by the "split_attr" encoding mode. The fixed-size header is
+// followed by a table of contents so that readers can fetch only the chunks
+// they need with ranged reads.
+static constexpr char kSplitContainerMagic[8] = {'D', 'R', 'C', 'S',
+                                                 'P', 'L', 'I', 'T'};
+static constexpr uint8_t kSplitContainerVersionMajor = 1;
+static constexpr uint8_t kSplitContainerVersionMinor = 1;
+// Magic string, version (major, minor) and the size of the table of contents.
+static constexpr size_t kSplitContainerHeaderSize = 8 + 2 + 4;
+// Name of the container entry holding the base geometry.
+static constexpr char kSplitContainerBaseName[] = "base";
+
+// Container of a mesh encoded as independent chunks (see ChunkedMeshEncoder).
+static constexpr char kChunkedMeshMagic[8] = {'D', 'R', 'C', 'C',
+                                              'H', 'U', 'N', 'K'};
+static constexpr uint8_t kChunkedMeshVersionMajor = 1;
+static constexpr uint8_t kChunkedMeshVersionMinor = 0;
+
+// Stream of a mesh encoded as progressive levels of detail (see
+// ProgressiveMeshEncoder).
+static constexpr char kProgressiveMeshMagic[8] = {'D', 'R', 'C', 'P',
+                                                  'R', 'O', 'G', 'M'};
+static constexpr uint8_t kProgressiveMeshVersionMajor = 1;
+static constexpr uint8_t kProgressiveMeshVersionMinor = 0;
+
+// Entry of the split attribute container table of contents.
+struct SplitContainerEntry {
+  SplitContainerEntry() : decoder_id(-1), offset(0), size(0) {}
+
+  // Name of the attribute chunk (see GetSplitAttributeName()), or
+  // kSplitContainerBaseName for the base geometry.
+  std::string name;
+  // Id of the attributes decoder that decodes the chunk (-1 for the base).
+  int32_t decoder_id;
+  // Ids of the attributes decoders whose chunks must be decoded before this
+  // chunk, because its prediction schemes use their attributes. Stored since
+  // container version 1.1.
+  std::vector<int32_t> parent_decoder_ids;
+  // Byte offset of the chunk from the beginning of the container.
+  uint64_t offset;
+  // Size of the chunk in bytes.
+  uint64_t size;
+};
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_CONFIG_COMPRESSION_SHARED_H_
@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 
+#include "draco/core/hash_utils.h"
 #include "draco/core/options.h"
 
 namespace draco {
@@ -130,6 +131,9 @@ class DracoOptions {
   const Options *FindAttributeOptions(const AttributeKeyT &att_key) const;
   const Options &GetGlobalOptions() const { return global_options_; }
 
+  // Returns a fingerprint of the global and all attribute options.
+  uint64_t Fingerprint() const;
+
  private:
   Options *GetAttributeOptions(const AttributeKeyT &att_key);
 
@@ -251,6 +255,16 @@ void DracoOptions<AttributeKeyT>::SetAttributeOptions(
   *att_options = options;
 }
 
+template <typename AttributeKeyT>
+uint64_t DracoOptions<AttributeKeyT>::Fingerprint() const {
+  uint64_t hash = global_options_.Fingerprint();
+  for (const auto &item : attribute_options_) {
+    hash = HashCombine(static_cast<uint64_t>(item.first), hash);
+    hash = HashCombine(item.second.Fingerprint(), hash);
+  }
+  return hash;
+}
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_CONFIG_DRACO_OPTIONS_H_
@@ -14,9 +14,18 @@
 //
 #include "draco/compression/decode.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+#include "draco/compression/point_cloud/split_attribute_names.h"
+#include "draco/compression/point_cloud/split_container_decoder.h"
+#include "draco/core/hash_utils.h"
+#include "draco/metadata/metadata_decoder.h"
 
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/mesh/chunked_mesh_decoder.h"
 #include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
 #include "draco/compression/mesh/mesh_sequential_decoder.h"
 #endif
@@ -117,6 +126,123 @@ StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeMeshFromBufferAttr(
   return std::move(mesh);
 }
 
+StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeChunkedMeshFromBuffer(
+    DecoderBuffer *in_buffer, int num_threads) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  return ChunkedMeshDecoder::Decode(options_, in_buffer, num_threads);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeMeshFromBufferAttrs(
+    DecoderBuffer *in_buffer, DracoHeader *header,
+    const std::vector<std::string> &attribute_names) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  DecoderBuffer container_buffer(*in_buffer);
+  SplitContainerDecoder container;
+  DRACO_RETURN_IF_ERROR(container.Decode(&container_buffer))
+
+  // Look up all requested chunks before decoding anything.
+  std::vector<const SplitContainerEntry *> entries;
+  for (const std::string &name : attribute_names) {
+    const SplitContainerEntry *const entry = container.FindEntry(name);
+    if (entry == nullptr || entry->decoder_id < 0) {
+      return Status(Status::DRACO_ERROR, "Unknown attribute " + name + ".");
+    }
+    if (std::find(entries.begin(), entries.end(), entry) == entries.end()) {
+      entries.push_back(entry);
+    }
+  }
+  // Chunks whose attributes are used by the prediction schemes of the
+  // requested chunks are decoded as well. |entries| grows while it is
+  // traversed, so that parents of the added chunks are added too.
+  for (size_t i = 0; i < entries.size(); ++i) {
+    for (const int32_t parent_id : entries[i]->parent_decoder_ids) {
+      const SplitContainerEntry *const parent =
+          container.FindEntryByDecoderId(parent_id);
+      if (parent == nullptr) {
+        return Status(Status::DRACO_ERROR,
+                      "Missing parent attribute of " + entries[i]->name + ".");
+      }
+      if (std::find(entries.begin(), entries.end(), parent) ==
+          entries.end()) {
+        entries.push_back(parent);
+      }
+    }
+  }
+  // Attributes decoders are stored in the order that resolves dependencies
+  // between attributes, so parents are decoded before their children.
+  std::sort(entries.begin(), entries.end(),
+            [](const SplitContainerEntry *a, const SplitContainerEntry *b) {
+              return a->decoder_id < b->decoder_id;
+            });
+
+  DecoderBuffer base_buffer;
+  DRACO_RETURN_IF_ERROR(
+      container.GetChunk(*in_buffer, kSplitContainerBaseName, &base_buffer))
+  DRACO_RETURN_IF_ERROR(GetDracoHeader(&base_buffer, header))
+  DRACO_ASSIGN_OR_RETURN(
+      std::unique_ptr<Mesh> mesh,
+      DecodeMeshFromBufferAttr(&base_buffer, header, kSplitContainerBaseName))
+
+  MeshDecoder *const decoder = static_cast<MeshDecoder *>(mesh->GetDecoder());
+  for (const SplitContainerEntry *entry : entries) {
+    DecoderBuffer chunk_buffer;
+    DRACO_RETURN_IF_ERROR(
+        container.GetChunk(*in_buffer, entry->name, &chunk_buffer))
+    DRACO_RETURN_IF_ERROR(
+        decoder->DecodeSplitAttributes(entry->decoder_id, &chunk_buffer))
+  }
+  return std::move(mesh);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+StatusOr<std::shared_ptr<const DecodedBase>> Decoder::DecodeBaseFromBuffer(
+    DecoderBuffer *in_buffer) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  DecoderBuffer container_buffer(*in_buffer);
+  SplitContainerDecoder container;
+  DRACO_RETURN_IF_ERROR(container.Decode(&container_buffer))
+  DecoderBuffer base_buffer;
+  DRACO_RETURN_IF_ERROR(
+      container.GetChunk(*in_buffer, kSplitContainerBaseName, &base_buffer))
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(GetDracoHeader(&base_buffer, &header))
+  if (header.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
+                         CreateMeshDecoder(header.encoder_method))
+  std::shared_ptr<DecodedBase> base(new DecodedBase());
+  DRACO_RETURN_IF_ERROR(base->Init(std::move(decoder), options_, in_buffer))
+  return std::shared_ptr<const DecodedBase>(std::move(base));
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+Status Decoder::DecodeMeshToBuffers(
+    DecoderBuffer *in_buffer, const MeshBufferLayoutCallback &get_layout) {
+  // Attribute transforms are skipped during decoding and they are applied by
+  // WriteMeshToBuffers() directly into the output buffers instead.
+  Decoder decoder;
+  *decoder.options() = options_;
+  decoder.SetArena(GetDecodingArena());
+  for (int i = 0; i < GeometryAttribute::NAMED_ATTRIBUTES_COUNT; ++i) {
+    decoder.SetSkipAttributeTransform(static_cast<GeometryAttribute::Type>(i));
+  }
+  Mesh mesh;
+  const Status status = decoder.DecodeBufferToGeometry(in_buffer, &mesh);
+  ReleaseDecodingMemory();
+  DRACO_RETURN_IF_ERROR(status)
+  MeshBufferLayout layout;
+  DRACO_RETURN_IF_ERROR(get_layout(mesh, &layout))
+  return WriteMeshToBuffers(mesh, layout);
+}
+
 Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
                                        PointCloud *out_geometry) {
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
@@ -129,8 +255,13 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloudDecoder> decoder,
                          CreatePointCloudDecoder(header.encoder_method))
 
-  DRACO_RETURN_IF_ERROR(decoder->Decode(options_, in_buffer, out_geometry))
-  return OkStatus();
+  decoder->set_arena(GetDecodingArena());
+  decoder->set_attribute_memory_callback(attribute_memory_callback_);
+  const Status status = decoder->Decode(options_, in_buffer, out_geometry);
+  // The decoder may still reference memory of the arena.
+  decoder.reset();
+  ReleaseDecodingMemory();
+  return status;
 #else
   return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
 #endif
@@ -148,8 +279,12 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
                          CreateMeshDecoder(header.encoder_method))
 
-  DRACO_RETURN_IF_ERROR(decoder->Decode(options_, in_buffer, out_geometry))
-  return OkStatus();
+  decoder->set_arena(GetDecodingArena());
+  decoder->set_attribute_memory_callback(attribute_memory_callback_);
+  const Status status = decoder->Decode(options_, in_buffer, out_geometry);
+  decoder.reset();
+  ReleaseDecodingMemory();
+  return status;
 #else
   return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
 #endif
@@ -163,13 +298,21 @@ Status Decoder::DecodeBufferAttrToGeometry(DecoderBuffer *in_buffer,
   if (out_geometry->GetDecoder() == nullptr) {
     StatusOr<MeshDecoder*> status_or = CreateMeshDecoderPointer(header->encoder_method);
     if (!status_or.ok()) return status_or.status();
+    status_or.value()->set_attribute_memory_callback(
+        attribute_memory_callback_);
     out_geometry->SetDecoder(status_or.value(), [](void *p) { delete ((MeshDecoder*)p); });
   }
 
+  // The split options only apply to this call, so that the decoder can be
+  // reused for any other decoding function.
   std::string name = attribute_name;
-  options_.SetGlobalBool("split_attr", !name.empty());
-  options_.SetGlobalString("attribute_name", name);
-  DRACO_RETURN_IF_ERROR(((MeshDecoder*)out_geometry->GetDecoder())->DecodeAttr(options_, in_buffer, header, out_geometry))
+  DecoderOptions options = options_;
+  options.SetGlobalBool("split_attr", !name.empty());
+  options.SetGlobalString("attribute_name", name);
+  MeshDecoder *const decoder =
+      static_cast<MeshDecoder *>(out_geometry->GetDecoder());
+  DRACO_RETURN_IF_ERROR(
+      decoder->DecodeAttr(options, in_buffer, header, out_geometry))
   return OkStatus();
 #else
   return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
@@ -180,4 +323,558 @@ void Decoder::SetSkipAttributeTransform(GeometryAttribute::Type att_type) {
   options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
 }
 
+void Decoder::SetRetainedMemoryLimit(size_t max_bytes) {
+  retained_memory_limit_ = max_bytes;
+  if (max_bytes == 0) {
+    retained_arena_.reset();
+  } else if (retained_arena_ == nullptr) {
+    retained_arena_.reset(new Arena());
+  } else {
+    retained_arena_->Reset(max_bytes);
+  }
+}
+
+size_t Decoder::num_retained_bytes() const {
+  return retained_arena_ == nullptr ? 0
+                                    : retained_arena_->num_reserved_bytes();
+}
+
+Arena *Decoder::GetDecodingArena() const {
+  return arena_ != nullptr ? arena_ : retained_arena_.get();
+}
+
+void Decoder::ReleaseDecodingMemory() {
+  if (arena_ == nullptr && retained_arena_ != nullptr) {
+    retained_arena_->Reset(retained_memory_limit_);
+  }
+}
+
+namespace {
+
+// Returns the estimated number of bytes used by |att|.
+size_t GetAttributeSize(const PointAttribute &att) {
+  size_t size = sizeof(PointAttribute);
+  if (att.buffer() != nullptr) {
+    size += att.buffer()->data_size();
+  }
+  if (!att.is_mapping_identity()) {
+    size += att.indices_map_size() * sizeof(AttributeValueIndex);
+  }
+  return size;
+}
+
+// Returns the estimated number of bytes used by |mesh|.
+size_t GetMeshSize(const Mesh &mesh) {
+  size_t size = sizeof(Mesh) + mesh.num_faces() * sizeof(Mesh::Face);
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    size += GetAttributeSize(*mesh.attribute(i));
+  }
+  return size;
+}
+
+// Returns the estimated number of bytes used by |base|.
+size_t GetBaseSize(const DecodedBase &base) {
+  size_t size = GetMeshSize(base.mesh());
+  const CornerTable *const corner_table = base.GetCornerTable();
+  if (corner_table != nullptr) {
+    size += 2 * corner_table->num_corners() * sizeof(CornerIndex) +
+            corner_table->num_vertices() * sizeof(CornerIndex);
+  }
+  for (int i = 0; i < base.num_attributes_decoders(); ++i) {
+    size += base.GetTraversalOrder(i).size() * sizeof(PointIndex);
+  }
+  return size;
+}
+
+// Finalization step of MurmurHash3 that spreads every bit of |h| over the
+// whole result.
+uint64_t MixBits(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+uint64_t RotateLeft(uint64_t value, int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+// Computes two independent 64-bit hashes of |data| in a single pass that
+// reads the data eight bytes at a time. The hashes depend on the byte order
+// of the host, which is fine for keys that never leave the process.
+void HashBytes(const char *data, size_t size, uint64_t *out_hash,
+               uint64_t *out_checksum) {
+  uint64_t h0 = 0x9e3779b97f4a7c15ull ^ size;
+  uint64_t h1 = 0xcbf29ce484222325ull + size;
+  const auto add_word = [&h0, &h1](uint64_t word) {
+    h0 = RotateLeft(h0 ^ (word * 0x87c37b91114253d5ull), 31) *
+         0x4cf5ad432745937full;
+    h1 = RotateLeft(h1 + (word * 0x52dce729da3ed9d3ull), 27) *
+             0x9ae16a3b2f90404full +
+         0x38495ab5;
+  };
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    add_word(word);
+  }
+  if (i < size) {
+    // The last bytes are padded with zeros. |size| is part of the seeds, so
+    // the padding does not collide with real zero bytes.
+    uint64_t word = 0;
+    memcpy(&word, data + i, size - i);
+    add_word(word);
+  }
+  *out_hash = MixBits(h0);
+  *out_checksum = MixBits(h1 ^ h0);
+}
+
+}  // namespace
+
+DecodeCache::DecodeCache(size_t max_bytes)
+    : max_bytes_(max_bytes), num_bytes_(0), num_hits_(0), num_misses_(0) {}
+
+StatusOr<std::shared_ptr<const Mesh>> DecodeCache::DecodeMesh(
+    Decoder *decoder, DecoderBuffer *in_buffer) {
+  const Key key = MakeKey(*decoder, *in_buffer, "");
+  Entry cached_entry;
+  if (Find(key, &cached_entry)) {
+    in_buffer->Advance(cached_entry.num_decoded_bytes);
+    return cached_entry.mesh;
+  }
+  const int64_t start_pos = in_buffer->decoded_size();
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> decoded_mesh,
+                         decoder->DecodeMeshFromBuffer(in_buffer))
+  Entry entry;
+  entry.key = key;
+  entry.num_bytes = GetMeshSize(*decoded_mesh);
+  entry.num_decoded_bytes = in_buffer->decoded_size() - start_pos;
+  entry.mesh = std::shared_ptr<const Mesh>(std::move(decoded_mesh));
+  const std::shared_ptr<const Mesh> mesh = entry.mesh;
+  Insert(std::move(entry));
+  return mesh;
+}
+
+StatusOr<std::shared_ptr<const DecodedBase>> DecodeCache::DecodeBase(
+    Decoder *decoder, DecoderBuffer *in_buffer) {
+  return DecodeBase(decoder, in_buffer,
+                    MakeKey(*decoder, *in_buffer, kSplitContainerBaseName));
+}
+
+StatusOr<std::shared_ptr<const DecodedBase>> DecodeCache::DecodeBase(
+    Decoder *decoder, DecoderBuffer *in_buffer, const Key &key) {
+  Entry cached_entry;
+  if (Find(key, &cached_entry)) {
+    in_buffer->Advance(cached_entry.num_decoded_bytes);
+    return cached_entry.base;
+  }
+  const int64_t start_pos = in_buffer->decoded_size();
+  Entry entry;
+  DRACO_ASSIGN_OR_RETURN(entry.base, decoder->DecodeBaseFromBuffer(in_buffer))
+  entry.key = key;
+  entry.num_bytes = GetBaseSize(*entry.base);
+  entry.num_decoded_bytes = in_buffer->decoded_size() - start_pos;
+  const std::shared_ptr<const DecodedBase> base = entry.base;
+  Insert(std::move(entry));
+  return base;
+}
+
+StatusOr<std::shared_ptr<const PointAttribute>> DecodeCache::DecodeAttribute(
+    Decoder *decoder, DecoderBuffer *in_buffer, const std::string &name) {
+  DRACO_ASSIGN_OR_RETURN(
+      std::vector<std::shared_ptr<const PointAttribute>> attributes,
+      DecodeAttributes(decoder, in_buffer, {name}))
+  return attributes[0];
+}
+
+StatusOr<std::vector<std::shared_ptr<const PointAttribute>>>
+DecodeCache::DecodeAttributes(Decoder *decoder, DecoderBuffer *in_buffer,
+                              const std::vector<std::string> &names) {
+  // All entries of the container share the hashes of its bytes.
+  const Key container_key = MakeKey(*decoder, *in_buffer, "");
+  std::shared_ptr<const DecodedBase> base;
+  std::vector<std::shared_ptr<const PointAttribute>> attributes;
+  for (const std::string &name : names) {
+    DRACO_ASSIGN_OR_RETURN(
+        std::shared_ptr<const PointAttribute> attribute,
+        DecodeAttribute(decoder, in_buffer, container_key, name, &base))
+    attributes.push_back(std::move(attribute));
+  }
+  return attributes;
+}
+
+StatusOr<std::shared_ptr<const PointAttribute>> DecodeCache::DecodeAttribute(
+    Decoder *decoder, DecoderBuffer *in_buffer, const Key &container_key,
+    const std::string &name, std::shared_ptr<const DecodedBase> *base) {
+  if (name.empty() || name == kSplitContainerBaseName) {
+    return Status(Status::DRACO_ERROR, "Invalid attribute name.");
+  }
+  Key key = container_key;
+  key.name = name;
+  Entry cached_entry;
+  if (Find(key, &cached_entry)) {
+    return cached_entry.attribute;
+  }
+  if (*base == nullptr) {
+    Key base_key = container_key;
+    base_key.name = kSplitContainerBaseName;
+    DRACO_ASSIGN_OR_RETURN(*base, DecodeBase(decoder, in_buffer, base_key))
+  }
+  DecoderBuffer container_buffer(*in_buffer);
+  SplitContainerDecoder container;
+  DRACO_RETURN_IF_ERROR(container.Decode(&container_buffer))
+  const int att_decoder_id = (*base)->GetAttributesDecoderId(name);
+  DecoderBuffer chunk_buffer;
+  if (att_decoder_id < 0 ||
+      !container.GetChunk(*in_buffer, name, &chunk_buffer).ok()) {
+    return Status(Status::DRACO_ERROR, "Unknown attribute " + name + ".");
+  }
+  std::vector<std::unique_ptr<PointAttribute>> attributes;
+  DRACO_RETURN_IF_ERROR(
+      (*base)->DecodeAttributes(att_decoder_id, &chunk_buffer, &attributes))
+  // The chunk is named after one of the attributes of its decoder.
+  const Mesh &mesh = (*base)->mesh();
+  int att_id = -1;
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    if (GetSplitAttributeName(mesh, i) == name) {
+      att_id = i;
+      break;
+    }
+  }
+  if (att_id < 0) {
+    return Status(Status::DRACO_ERROR, "Unknown attribute " + name + ".");
+  }
+  for (std::unique_ptr<PointAttribute> &att : attributes) {
+    if (att->unique_id() != mesh.attribute(att_id)->unique_id()) {
+      continue;
+    }
+    Entry entry;
+    entry.key = key;
+    entry.num_bytes = GetAttributeSize(*att);
+    entry.num_decoded_bytes = 0;
+    entry.attribute = std::shared_ptr<const PointAttribute>(std::move(att));
+    const std::shared_ptr<const PointAttribute> attribute = entry.attribute;
+    Insert(std::move(entry));
+    return attribute;
+  }
+  return Status(Status::DRACO_ERROR, "Unknown attribute " + name + ".");
+}
+
+void DecodeCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  entry_map_.clear();
+  num_bytes_ = 0;
+}
+
+size_t DecodeCache::num_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_bytes_;
+}
+
+size_t DecodeCache::num_entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+int64_t DecodeCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+int64_t DecodeCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+size_t DecodeCache::KeyHash::operator()(const Key &key) const {
+  // |data_checksum| only guards against collisions of |data_fingerprint|.
+  uint64_t hash = HashCombine(key.data_fingerprint, key.options_fingerprint);
+  hash = HashCombine(static_cast<uint64_t>(key.data_size), hash);
+  hash = HashCombine(FingerprintString(key.name.c_str(), key.name.size()), hash);
+  return static_cast<size_t>(hash);
+}
+
+DecodeCache::Key DecodeCache::MakeKey(const Decoder &decoder,
+                                      const DecoderBuffer &in_buffer,
+                                      const std::string &name) {
+  Key key;
+  HashBytes(in_buffer.data_head(), in_buffer.remaining_size(),
+            &key.data_fingerprint, &key.data_checksum);
+  key.options_fingerprint = decoder.options()->Fingerprint();
+  key.data_size = in_buffer.remaining_size();
+  key.name = name;
+  return key;
+}
+
+bool DecodeCache::Find(const Key &key, Entry *out_entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entry_map_.find(key);
+  if (it == entry_map_.end()) {
+    ++num_misses_;
+    return false;
+  }
+  ++num_hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  *out_entry = *it->second;
+  return true;
+}
+
+void DecodeCache::Insert(Entry entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entry.num_bytes > max_bytes_ || entry_map_.count(entry.key) > 0) {
+    return;
+  }
+  num_bytes_ += entry.num_bytes;
+  entries_.push_front(std::move(entry));
+  entry_map_[entries_.front().key] = entries_.begin();
+  while (num_bytes_ > max_bytes_) {
+    const Entry &last = entries_.back();
+    num_bytes_ -= last.num_bytes;
+    entry_map_.erase(last.key);
+    entries_.pop_back();
+  }
+}
+
+StreamingDecoder::StreamingDecoder()
+    : is_finished_(false),
+      stage_(STAGE_HEADER),
+      offset_(0),
+      next_attempt_size_(0),
+      num_decoded_attributes_decoders_(0) {}
+
+StreamingDecoder::~StreamingDecoder() = default;
+
+Status StreamingDecoder::Feed(const char *data, size_t data_size) {
+  if (!error_.ok()) {
+    return error_;
+  }
+  if (is_finished_) {
+    return Status(Status::DRACO_ERROR, "Data received after Finish().");
+  }
+  data_.insert(data_.end(), data, data + data_size);
+  return Decode();
+}
+
+Status StreamingDecoder::Finish() {
+  if (!error_.ok()) {
+    return error_;
+  }
+  is_finished_ = true;
+  return Decode();
+}
+
+int StreamingDecoder::num_attributes_decoders() const {
+  return has_connectivity() ? decoder_->num_attributes_decoders() : 0;
+}
+
+const PointCloud *StreamingDecoder::point_cloud() const {
+  return has_connectivity() ? geometry_.get() : nullptr;
+}
+
+StatusOr<std::unique_ptr<PointCloud>> StreamingDecoder::TakePointCloud() {
+  if (!is_complete() || geometry_ == nullptr) {
+    return Status(Status::DRACO_ERROR, "Decoding is not complete.");
+  }
+  decoder_.reset();
+  return std::move(geometry_);
+}
+
+StatusOr<std::unique_ptr<Mesh>> StreamingDecoder::TakeMesh() {
+  if (is_complete() && header_.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> geometry,
+                         TakePointCloud())
+  return std::unique_ptr<Mesh>(static_cast<Mesh *>(geometry.release()));
+}
+
+Status StreamingDecoder::Decode() {
+  while (stage_ != STAGE_COMPLETE) {
+    Status status;
+    switch (stage_) {
+      case STAGE_HEADER:
+        status = DecodeHeader();
+        break;
+      case STAGE_METADATA:
+        status = DecodeMetadata();
+        break;
+      case STAGE_GEOMETRY:
+        status = DecodeGeometry();
+        break;
+      case STAGE_ATTRIBUTE_SIZES:
+        status = DecodeAttributeSizes();
+        break;
+      default:
+        status = DecodeAttributes();
+        break;
+    }
+    if (!status.ok()) {
+      if (status.code() != Status::NEED_MORE_DATA) {
+        error_ = status;
+      }
+      return status;
+    }
+  }
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeHeader() {
+  if (!CanDecodePart()) {
+    return Status(Status::NEED_MORE_DATA, "Waiting for the header.");
+  }
+  InitBuffer(data_.size());
+  DRACO_RETURN_IF_ERROR(
+      GetPartStatus(PointCloudDecoder::DecodeHeader(&buffer_, &header_)))
+  if (header_.encoder_type == TRIANGULAR_MESH) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(decoder_, CreateMeshDecoder(header_.encoder_method))
+#else
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+  } else if (header_.encoder_type == POINT_CLOUD) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(decoder_,
+                           CreatePointCloudDecoder(header_.encoder_method))
+#else
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+  } else {
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+  }
+  offset_ = GetBufferOffset();
+  const bool has_metadata =
+      DRACO_BITSTREAM_VERSION(header_.version_major, header_.version_minor) >=
+          DRACO_BITSTREAM_VERSION(1, 3) &&
+      (header_.flags & METADATA_FLAG_MASK);
+  stage_ = has_metadata ? STAGE_METADATA : STAGE_GEOMETRY;
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeMetadata() {
+  if (!CanDecodePart()) {
+    return Status(Status::NEED_MORE_DATA, "Waiting for the metadata.");
+  }
+  InitBuffer(data_.size() - offset_);
+  std::unique_ptr<GeometryMetadata> metadata(new GeometryMetadata());
+  MetadataDecoder metadata_decoder;
+  DRACO_RETURN_IF_ERROR(GetPartStatus(
+      metadata_decoder.DecodeGeometryMetadata(&buffer_, metadata.get())
+          ? OkStatus()
+          : Status(Status::DRACO_ERROR, "Failed to decode metadata.")))
+  metadata_ = std::move(metadata);
+  offset_ = GetBufferOffset();
+  stage_ = STAGE_GEOMETRY;
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeGeometry() {
+  if (!CanDecodePart()) {
+    return Status(Status::NEED_MORE_DATA, "Waiting for the geometry data.");
+  }
+  // Every attempt fills in a new geometry, because a failed attempt may leave
+  // a partially decoded one behind.
+  if (header_.encoder_type == TRIANGULAR_MESH) {
+    geometry_.reset(new Mesh());
+  } else {
+    geometry_.reset(new PointCloud());
+  }
+  if (metadata_ != nullptr) {
+    geometry_->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*metadata_)));
+  }
+  InitBuffer(data_.size() - offset_);
+  Status status;
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  if (header_.encoder_type == TRIANGULAR_MESH) {
+    status = static_cast<MeshDecoder *>(decoder_.get())
+                 ->StartDecoding(options_, header_, &buffer_,
+                                 static_cast<Mesh *>(geometry_.get()));
+  } else
+#endif
+  {
+    status =
+        decoder_->StartDecoding(options_, header_, &buffer_, geometry_.get());
+  }
+  DRACO_RETURN_IF_ERROR(GetPartStatus(status))
+  // Decoders may re-initialize the buffer, e.g. at the end of the edgebreaker
+  // traversal, so the offset is computed from the current position.
+  offset_ = GetBufferOffset();
+  stage_ = decoder_->has_attribute_sizes() ? STAGE_ATTRIBUTE_SIZES
+                                           : STAGE_ATTRIBUTES;
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeAttributeSizes() {
+  if (!CanDecodePart()) {
+    return Status(Status::NEED_MORE_DATA, "Waiting for attribute sizes.");
+  }
+  InitBuffer(data_.size() - offset_);
+  DRACO_RETURN_IF_ERROR(GetPartStatus(
+      decoder_->DecodeAttributesDecoderSizes(&buffer_, &attribute_sizes_)))
+  offset_ = GetBufferOffset();
+  stage_ = STAGE_ATTRIBUTES;
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeAttributes() {
+  const int num_decoders = decoder_->num_attributes_decoders();
+  const bool has_sizes = decoder_->has_attribute_sizes();
+  while (num_decoded_attributes_decoders_ < num_decoders) {
+    const int dec_id = num_decoded_attributes_decoders_;
+    if (has_sizes) {
+      // The data of the decoder is decoded once it is complete.
+      const uint64_t size = attribute_sizes_[dec_id];
+      if (size > data_.size() - offset_) {
+        if (is_finished_) {
+          return Status(Status::DRACO_ERROR, "Unexpected end of data.");
+        }
+        return Status(Status::NEED_MORE_DATA, "Waiting for attribute data.");
+      }
+      InitBuffer(static_cast<size_t>(size));
+      DRACO_RETURN_IF_ERROR(decoder_->DecodeAttributesDecoder(dec_id, &buffer_))
+      offset_ += size;
+    } else {
+      // The end of the data of the decoder is known only once it is decoded.
+      if (!CanDecodePart()) {
+        return Status(Status::NEED_MORE_DATA, "Waiting for attribute data.");
+      }
+      InitBuffer(data_.size() - offset_);
+      DRACO_RETURN_IF_ERROR(
+          GetPartStatus(decoder_->DecodeAttributesDecoder(dec_id, &buffer_)))
+      offset_ = GetBufferOffset();
+    }
+    ++num_decoded_attributes_decoders_;
+  }
+  DRACO_RETURN_IF_ERROR(decoder_->FinishDecoding())
+  stage_ = STAGE_COMPLETE;
+  return OkStatus();
+}
+
+Status StreamingDecoder::GetPartStatus(const Status &status) {
+  if (!buffer_.out_of_data()) {
+    next_attempt_size_ = 0;
+    return status;
+  }
+  // The decoding needed data that was not received yet. Its result is not
+  // valid even when it succeeded, e.g. when missing bits were read as zeros.
+  if (is_finished_) {
+    return status.ok() ? Status(Status::DRACO_ERROR, "Unexpected end of data.")
+                       : status;
+  }
+  next_attempt_size_ = data_.size() + (data_.size() - offset_);
+  return Status(Status::NEED_MORE_DATA, status.ok()
+                                            ? "Waiting for more data."
+                                            : status.error_msg_string());
+}
+
+void StreamingDecoder::InitBuffer(size_t size) {
+  buffer_.Init(
+      data_.data() + offset_, size,
+      DRACO_BITSTREAM_VERSION(header_.version_major, header_.version_minor));
+}
+
 }  // namespace draco
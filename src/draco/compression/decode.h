@@ -15,8 +15,20 @@
 #ifndef DRACO_COMPRESSION_DECODE_H_
 #define DRACO_COMPRESSION_DECODE_H_
 
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
+#include "draco/compression/decoded_base.h"
+#include "draco/compression/mesh_buffer_writer.h"
+#include "draco/core/arena.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/status_or.h"
 #include "draco/draco_features.h"
@@ -25,9 +37,13 @@
 namespace draco {
 
 // Class responsible for decoding of meshes and point clouds that were
-// compressed by a Draco encoder.
+// compressed by a Draco encoder. A Decoder instance must not be used by
+// multiple threads at the same time, but separate instances can decode
+// concurrently (see BatchDecoder).
 class Decoder {
  public:
+  Decoder() : arena_(nullptr), retained_memory_limit_(0) {}
+
   // Returns the geometry type encoded in the input |in_buffer|.
   // The return value is one of POINT_CLOUD, MESH or INVALID_GEOMETRY in case
   // the input data is invalid.
@@ -56,6 +72,44 @@ class Decoder {
       DracoHeader *header,
       const char *attribute_name);
 
+  // Decodes a mesh encoded by Encoder::EncodeMeshToChunkedBuffer(). The
+  // chunks are decoded on |num_threads| threads and stitched into one mesh
+  // (see ChunkedMeshDecoder).
+  StatusOr<std::unique_ptr<Mesh>> DecodeChunkedMeshFromBuffer(
+      DecoderBuffer *in_buffer, int num_threads);
+
+  // Decodes a mesh from a split container (see SplitContainerEncoder) held in
+  // |in_buffer|. The base geometry and only the attributes whose "name"
+  // metadata entries are listed in |attribute_names| are decoded, all in one
+  // call. Chunks of parent attributes used for prediction by the listed
+  // attributes (usually "position") are decoded as well, chunks of other
+  // attributes are never read. The header of the base geometry is returned in
+  // |header|.
+  StatusOr<std::unique_ptr<Mesh>> DecodeMeshFromBufferAttrs(
+      DecoderBuffer *in_buffer, DracoHeader *header,
+      const std::vector<std::string> &attribute_names);
+
+  // Called by DecodeMeshToBuffers() once the mesh is decoded to get the
+  // layout of the output buffers. The callback can use |mesh| to query the
+  // number of points and faces and the available attributes, but attribute
+  // values of |mesh| may still be in their portable form, e.g. quantized.
+  typedef std::function<Status(const Mesh &mesh, MeshBufferLayout *layout)>
+      MeshBufferLayoutCallback;
+
+  // Decodes a mesh from |in_buffer| and writes the values of its points and
+  // its faces directly into caller-owned buffers described by the layout
+  // returned by |get_layout| (see WriteMeshToBuffers()). Attribute transforms
+  // such as dequantization are applied while the values are written, so the
+  // decoded mesh never allocates buffers for the transformed values.
+  Status DecodeMeshToBuffers(DecoderBuffer *in_buffer,
+                             const MeshBufferLayoutCallback &get_layout);
+
+  // Decodes the base geometry of a split container held in |in_buffer| into
+  // an immutable DecodedBase. Any number of attribute chunks of the container
+  // can then be decoded against it, also concurrently from multiple threads.
+  StatusOr<std::shared_ptr<const DecodedBase>> DecodeBaseFromBuffer(
+      DecoderBuffer *in_buffer);
+
   // Decodes the buffer into a provided geometry. If the geometry is
   // incompatible with the encoded data. For example, when |out_geometry| is
   // draco::Mesh while the data contains a point cloud, the function will return
@@ -80,9 +134,291 @@ class Decoder {
   // Returns the options instance used by the decoder that can be used by users
   // to control the decoding process.
   DecoderOptions *options() { return &options_; }
+  const DecoderOptions *options() const { return &options_; }
+
+  // Sets an arena that provides memory for transient data of the
+  // connectivity decoding, such as the edgebreaker traversal state and the
+  // vertex maps. The memory is not used by the decoded geometry, so the arena
+  // can be reset as soon as a decoding function returns, which makes
+  // repeated decoding of small meshes avoid most heap allocations. The arena
+  // must not be reset or used by other threads while a decoding function is
+  // running. Decoding of split containers keeps using the heap, because
+  // their decoders outlive the decoding functions. Set nullptr to stop using
+  // the arena.
+  void SetArena(Arena *arena) { arena_ = arena; }
+  Arena *arena() const { return arena_; }
+
+  // Enables warm decoding when |max_bytes| is greater than zero. The decoder
+  // then owns an arena (see SetArena()) that also holds the corner table and
+  // the decoded traversal symbols. The memory of the arena is kept after each
+  // decoding function, up to |max_bytes|, and it is reused by the following
+  // calls, so that repeated decoding of meshes of a similar size stops
+  // growing the same buffers again. Zero disables warm decoding and releases
+  // all retained memory. An arena set with SetArena() takes precedence.
+  void SetRetainedMemoryLimit(size_t max_bytes);
+  size_t retained_memory_limit() const { return retained_memory_limit_; }
+
+  // Returns the number of bytes retained for warm decoding.
+  size_t num_retained_bytes() const;
+
+  // Called when an attribute of the decoded geometry is allocated. Returns
+  // caller-owned memory of at least |size| bytes for the values of
+  // |attribute|, or nullptr when the attribute should use its own memory.
+  typedef std::function<uint8_t *(const PointAttribute &attribute,
+                                  int64_t size)>
+      AttributeMemoryCallback;
+
+  // Makes the decoding functions write attribute values directly into memory
+  // provided by |callback| (see DataBuffer::SetExternalData()), e.g. into a
+  // shared-memory segment or a mapped upload buffer. The memory must stay
+  // valid as long as the decoded geometry uses it. Attributes decoded with a
+  // skipped attribute transform hold their portable values in the memory.
+  // Attributes decoded by DecodedBase and by the chunked and streaming
+  // decoders always use their own memory. Set nullptr to stop using it.
+  void SetAttributeMemoryCallback(const AttributeMemoryCallback &callback) {
+    attribute_memory_callback_ = callback;
+  }
+
+ private:
+  // Returns the arena used by decoding functions, if any.
+  Arena *GetDecodingArena() const;
+
+  // Makes the memory of the owned arena available to the next decoding
+  // function and frees memory exceeding the retained memory limit.
+  void ReleaseDecodingMemory();
+
+  DecoderOptions options_;
+  Arena *arena_;
+  std::unique_ptr<Arena> retained_arena_;
+  size_t retained_memory_limit_;
+  AttributeMemoryCallback attribute_memory_callback_;
+};
+
+// Opt-in cache of decoded meshes, split container bases and attributes that
+// lets repeated decode requests of the same data skip decoding entirely.
+// Entries are keyed by the size and two independent hashes of the encoded
+// bytes and by a fingerprint of the options of the Decoder used to decode
+// them. Once the estimated size of the cached
+// data exceeds the byte budget, the least recently used entries are evicted.
+// All methods are thread-safe, but concurrent misses of the same entry may
+// decode it more than once.
+class DecodeCache {
+ public:
+  explicit DecodeCache(size_t max_bytes);
+
+  // Returns the mesh decoded from |in_buffer| by |decoder|. The mesh is
+  // decoded only when it is not cached yet. In both cases |in_buffer| is
+  // advanced past the mesh data.
+  StatusOr<std::shared_ptr<const Mesh>> DecodeMesh(Decoder *decoder,
+                                                   DecoderBuffer *in_buffer);
+
+  // Returns the base of the split container held in |in_buffer|, see
+  // Decoder::DecodeBaseFromBuffer().
+  StatusOr<std::shared_ptr<const DecodedBase>> DecodeBase(
+      Decoder *decoder, DecoderBuffer *in_buffer);
+
+  // Returns the attribute stored in the chunk |name| of the split container
+  // held in |in_buffer| (see GetSplitAttributeName()). The base of the
+  // container is cached as well.
+  StatusOr<std::shared_ptr<const PointAttribute>> DecodeAttribute(
+      Decoder *decoder, DecoderBuffer *in_buffer, const std::string &name);
+
+  // Same as DecodeAttribute() for each of |names|, but the container is
+  // hashed only once per call. The attributes are returned in the order of
+  // |names|.
+  StatusOr<std::vector<std::shared_ptr<const PointAttribute>>>
+  DecodeAttributes(Decoder *decoder, DecoderBuffer *in_buffer,
+                   const std::vector<std::string> &names);
+
+  // Removes all entries. Hit and miss counters are not reset.
+  void Clear();
+
+  size_t max_bytes() const { return max_bytes_; }
+  size_t num_bytes() const;
+  size_t num_entries() const;
+  int64_t num_hits() const;
+  int64_t num_misses() const;
+
+ private:
+  struct Key {
+    uint64_t data_fingerprint;
+    // Second hash of the encoded bytes, independent of |data_fingerprint|, so
+    // that a collision of a single hash does not return wrong data.
+    uint64_t data_checksum;
+    uint64_t options_fingerprint;
+    size_t data_size;
+    // Empty for meshes, "base" for bases and the attribute name otherwise.
+    std::string name;
+
+    bool operator==(const Key &other) const {
+      return data_fingerprint == other.data_fingerprint &&
+             data_checksum == other.data_checksum &&
+             options_fingerprint == other.options_fingerprint &&
+             data_size == other.data_size && name == other.name;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+  struct Entry {
+    Key key;
+    size_t num_bytes;
+    // Number of bytes of the input buffer consumed by the decoding.
+    int64_t num_decoded_bytes;
+    std::shared_ptr<const Mesh> mesh;
+    std::shared_ptr<const DecodedBase> base;
+    std::shared_ptr<const PointAttribute> attribute;
+  };
+  typedef std::list<Entry>::iterator EntryIterator;
+
+  static Key MakeKey(const Decoder &decoder, const DecoderBuffer &in_buffer,
+                     const std::string &name);
+
+  StatusOr<std::shared_ptr<const DecodedBase>> DecodeBase(
+      Decoder *decoder, DecoderBuffer *in_buffer, const Key &key);
+
+  // Decodes the attribute |name| of the container whose key is
+  // |container_key|. |base| is decoded on the first call and reused after.
+  StatusOr<std::shared_ptr<const PointAttribute>> DecodeAttribute(
+      Decoder *decoder, DecoderBuffer *in_buffer, const Key &container_key,
+      const std::string &name, std::shared_ptr<const DecodedBase> *base);
+
+  // Copies the cached entry of |key| to |out_entry| and marks it as the most
+  // recently used one. Returns false when the entry is not cached. Updates the
+  // hit and miss counters.
+  bool Find(const Key &key, Entry *out_entry);
+
+  // Adds |entry| to the cache and evicts least recently used entries that do
+  // not fit into the budget.
+  void Insert(Entry entry);
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Entries ordered from the most to the least recently used one.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, EntryIterator, KeyHash> entry_map_;
+  size_t num_bytes_;
+  int64_t num_hits_;
+  int64_t num_misses_;
+};
+
+class PointCloudDecoder;
+
+// Decodes a mesh or a point cloud from data that arrives in chunks, e.g. over
+// a network. Each part of the geometry is decoded as soon as all of its data
+// is received: the header, the metadata, the geometry data (the connectivity
+// of meshes) and then the attributes of each attributes decoder.
+//
+// All parts are decoded by a single decoder that continues from the end of
+// the last decoded part. A part whose size is not known in advance is decoded
+// from all data received so far. When its decoding runs out of data, it is
+// started again once the received data of the part has doubled, which keeps
+// the total decoding time linear in the size of the data. Any other failure
+// is reported as an error right away.
+class StreamingDecoder {
+ public:
+  StreamingDecoder();
+  ~StreamingDecoder();
+  StreamingDecoder(const StreamingDecoder &) = delete;
+  StreamingDecoder &operator=(const StreamingDecoder &) = delete;
+
+  // Appends |data_size| bytes of |data| to the received data and decodes all
+  // parts that are complete. Returns OkStatus() once the whole geometry is
+  // decoded and Status::NEED_MORE_DATA while more data is needed. Any other
+  // status is an error and it is returned by all following calls as well.
+  Status Feed(const char *data, size_t data_size);
+
+  // Marks the end of the data and decodes the remaining parts. Returns an
+  // error when the geometry cannot be decoded from the received data.
+  Status Finish();
+
+  bool has_header() const { return stage_ > STAGE_HEADER; }
+  // Valid only when has_header() is true.
+  const DracoHeader &header() const { return header_; }
+
+  // Returns the metadata of the geometry or nullptr when it has not been
+  // received yet or when the geometry has no metadata.
+  const GeometryMetadata *metadata() const { return metadata_.get(); }
+
+  // Returns true when the geometry data, e.g. the faces of a mesh, is
+  // decoded. The attributes then exist in point_cloud(), but only the
+  // attributes of decoded attributes decoders hold their values.
+  bool has_connectivity() const { return stage_ > STAGE_GEOMETRY; }
+  int num_attributes_decoders() const;
+  int num_decoded_attributes_decoders() const {
+    return num_decoded_attributes_decoders_;
+  }
+  bool is_complete() const { return stage_ == STAGE_COMPLETE; }
+
+  // Returns the geometry decoded so far, or nullptr before has_connectivity()
+  // is true. Meshes can be down-casted to Mesh.
+  const PointCloud *point_cloud() const;
+
+  // Returns the decoded geometry. The decoding must be complete.
+  StatusOr<std::unique_ptr<PointCloud>> TakePointCloud();
+  StatusOr<std::unique_ptr<Mesh>> TakeMesh();
+
+  DecoderOptions *options() { return &options_; }
+
+  // Returns the number of received bytes.
+  size_t num_received_bytes() const { return data_.size(); }
 
  private:
+  enum Stage {
+    STAGE_HEADER,
+    STAGE_METADATA,
+    STAGE_GEOMETRY,
+    STAGE_ATTRIBUTE_SIZES,
+    STAGE_ATTRIBUTES,
+    STAGE_COMPLETE,
+  };
+
+  // Decodes all parts whose data is received.
+  Status Decode();
+  Status DecodeHeader();
+  Status DecodeMetadata();
+  Status DecodeGeometry();
+  Status DecodeAttributeSizes();
+  Status DecodeAttributes();
+
+  // Returns true when a part whose size is not known in advance should be
+  // decoded from the data received so far.
+  bool CanDecodePart() const {
+    return is_finished_ || data_.size() >= next_attempt_size_;
+  }
+  // Returns the status of a part whose size is not known in advance and whose
+  // decoding from |buffer_| returned |status|.
+  Status GetPartStatus(const Status &status);
+
+  // Initializes |buffer_| with |size| bytes of the received data starting at
+  // |offset_|.
+  void InitBuffer(size_t size);
+
+  // Returns the offset of the current position of |buffer_| in |data_|.
+  size_t GetBufferOffset() const {
+    return static_cast<size_t>(buffer_.data_head() - data_.data());
+  }
+
   DecoderOptions options_;
+  std::vector<char> data_;
+  bool is_finished_;
+  Status error_;
+  Stage stage_;
+  DracoHeader header_;
+  std::unique_ptr<GeometryMetadata> metadata_;
+  // The decoder and the geometry it fills in. |decoder_| keeps pointers to
+  // |geometry_| and |buffer_| for the whole decoding.
+  std::unique_ptr<PointCloudDecoder> decoder_;
+  std::unique_ptr<PointCloud> geometry_;
+  // Buffer of the part that is being decoded.
+  DecoderBuffer buffer_;
+  // Offset of the data of the next part.
+  size_t offset_;
+  // Number of received bytes needed before the next attempt to decode a part
+  // that ran out of data.
+  size_t next_attempt_size_;
+  std::vector<uint64_t> attribute_sizes_;
+  int num_decoded_attributes_decoders_;
 };
 
 }  // namespace draco
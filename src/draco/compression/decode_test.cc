@@ -14,9 +14,14 @@
 //
 #include "draco/compression/decode.h"
 
+#include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <sstream>
+#include <thread>
 
+#include "draco/compression/encode.h"
+#include "draco/compression/point_cloud/split_container_decoder.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 #include "draco/io/file_utils.h"
@@ -26,6 +31,28 @@ namespace {
 class DecodeTest : public ::testing::Test {
  protected:
   DecodeTest() {}
+
+  // Verifies that |mesh| has the same faces and attribute values as
+  // |ref_mesh|.
+  void CompareMeshes(const draco::Mesh &mesh, const draco::Mesh &ref_mesh) {
+    ASSERT_EQ(mesh.num_faces(), ref_mesh.num_faces());
+    ASSERT_EQ(mesh.num_points(), ref_mesh.num_points());
+    for (draco::FaceIndex f(0); f < ref_mesh.num_faces(); ++f) {
+      ASSERT_EQ(mesh.face(f), ref_mesh.face(f));
+    }
+    ASSERT_EQ(mesh.num_attributes(), ref_mesh.num_attributes());
+    for (int i = 0; i < ref_mesh.num_attributes(); ++i) {
+      const draco::PointAttribute *const ref_att = ref_mesh.attribute(i);
+      const draco::PointAttribute *const att = mesh.attribute(i);
+      ASSERT_EQ(att->byte_stride(), ref_att->byte_stride());
+      for (draco::PointIndex p(0); p < ref_mesh.num_points(); ++p) {
+        ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(p),
+                         ref_att->GetAddressOfMappedIndex(p),
+                         att->byte_stride()),
+                  0);
+      }
+    }
+  }
 };
 
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -166,4 +193,943 @@ TEST_F(DecodeTest, TestSkipAttributeTransformWithNoQuantization) {
   ASSERT_EQ(pos_att->GetAttributeTransformData(), nullptr);
 }
 
+// Returns |mesh| with a "name" metadata entry added to every attribute, so that
+// the split attribute chunks are named after the attribute types.
+std::unique_ptr<draco::Mesh> ReadNamedMesh(const std::string &file_name) {
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile(file_name);
+  if (mesh == nullptr) {
+    return nullptr;
+  }
+  mesh->AddMetadata(
+      std::unique_ptr<draco::GeometryMetadata>(new draco::GeometryMetadata()));
+  for (int i = 0; i < mesh->num_attributes(); ++i) {
+    std::unique_ptr<draco::AttributeMetadata> att_metadata(
+        new draco::AttributeMetadata());
+    att_metadata->AddEntryString(
+        "name", draco::GeometryAttribute::TypeToString(
+                    mesh->attribute(i)->attribute_type()));
+    mesh->AddAttributeMetadata(i, std::move(att_metadata));
+  }
+  return mesh;
+}
+
+TEST_F(DecodeTest, TestDecodeMeshFromBufferAttrs) {
+  // Tests that a subset of attributes can be decoded from a split container
+  // and that it matches the regular decoding.
+  std::unique_ptr<draco::Mesh> mesh = ReadNamedMesh("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+  draco::EncoderBuffer ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer));
+  encoder.options().SetGlobalBool("split_attr", true);
+  encoder.options().SetGlobalBool("split_container", true);
+  draco::EncoderBuffer split_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &split_buffer));
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+
+  buffer.Init(split_buffer.data(), split_buffer.size());
+  draco::Decoder split_decoder;
+  draco::DracoHeader header;
+  // Children are listed before their parents on purpose.
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> split_mesh,
+                         split_decoder.DecodeMeshFromBufferAttrs(
+                             &buffer, &header, {"NORMAL", "POSITION"}));
+  ASSERT_EQ(header.encoder_type, draco::TRIANGULAR_MESH);
+  ASSERT_EQ(split_mesh->num_points(), ref_mesh->num_points());
+  ASSERT_EQ(split_mesh->num_faces(), ref_mesh->num_faces());
+
+  for (const draco::GeometryAttribute::Type type :
+       {draco::GeometryAttribute::POSITION, draco::GeometryAttribute::NORMAL}) {
+    const draco::PointAttribute *const ref_att =
+        ref_mesh->GetNamedAttribute(type);
+    const draco::PointAttribute *const att =
+        split_mesh->GetNamedAttribute(type);
+    ASSERT_NE(att, nullptr);
+    for (draco::PointIndex i(0); i < ref_mesh->num_points(); ++i) {
+      std::array<float, 3> ref_value, value;
+      ref_att->GetMappedValue(i, &ref_value[0]);
+      att->GetMappedValue(i, &value[0]);
+      ASSERT_EQ(ref_value, value);
+    }
+    // Decoded attributes are marked for output.
+    ASSERT_EQ(split_mesh->GetMetadataEntryIntByAttributeId(
+                  split_mesh->GetNamedAttributeId(type), "output"),
+              1);
+  }
+  // Attributes that were not requested are not decoded.
+  ASSERT_EQ(split_mesh->GetMetadataEntryIntByAttributeId(
+                split_mesh->GetNamedAttributeId(
+                    draco::GeometryAttribute::TEX_COORD),
+                "output"),
+            0);
+
+  // Parents of the requested attributes are decoded with them. Normals are
+  // predicted from positions at speed 0.
+  encoder.SetSpeedOptions(0, 0);
+  encoder.options().SetGlobalBool("split_attr", false);
+  encoder.options().SetGlobalBool("split_container", false);
+  draco::EncoderBuffer speed_ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &speed_ref_buffer));
+  encoder.options().SetGlobalBool("split_attr", true);
+  encoder.options().SetGlobalBool("split_container", true);
+  draco::EncoderBuffer speed_split_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &speed_split_buffer));
+  buffer.Init(speed_ref_buffer.data(), speed_ref_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(ref_mesh, decoder.DecodeMeshFromBuffer(&buffer));
+  buffer.Init(speed_split_buffer.data(), speed_split_buffer.size());
+  draco::Decoder child_decoder;
+  DRACO_ASSIGN_OR_ASSERT(split_mesh, child_decoder.DecodeMeshFromBufferAttrs(
+                                         &buffer, &header, {"NORMAL"}));
+  const int normal_att_id =
+      split_mesh->GetNamedAttributeId(draco::GeometryAttribute::NORMAL);
+  ASSERT_EQ(split_mesh->GetMetadataEntryIntByAttributeId(
+                split_mesh->GetNamedAttributeId(
+                    draco::GeometryAttribute::POSITION),
+                "output"),
+            1);
+  ASSERT_EQ(split_mesh->GetMetadataEntryIntByAttributeId(normal_att_id,
+                                                         "output"),
+            1);
+  const draco::PointAttribute *const ref_normal_att =
+      ref_mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+  for (draco::PointIndex i(0); i < ref_mesh->num_points(); ++i) {
+    std::array<float, 3> ref_value, value;
+    ref_normal_att->GetMappedValue(i, &ref_value[0]);
+    split_mesh->attribute(normal_att_id)->GetMappedValue(i, &value[0]);
+    ASSERT_EQ(ref_value, value);
+  }
+
+  // The split decoding leaves no options behind, so the same decoder can
+  // decode the regular encoding afterwards.
+  ASSERT_FALSE(child_decoder.options()->IsGlobalOptionSet("split_attr"));
+  ASSERT_FALSE(child_decoder.options()->IsGlobalOptionSet("attribute_name"));
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(ref_mesh, decoder.DecodeMeshFromBuffer(&buffer));
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> reused_mesh,
+                         child_decoder.DecodeMeshFromBuffer(&buffer));
+  ASSERT_EQ(reused_mesh->num_attributes(), ref_mesh->num_attributes());
+  for (int att_id = 0; att_id < ref_mesh->num_attributes(); ++att_id) {
+    const draco::PointAttribute *const ref_att = ref_mesh->attribute(att_id);
+    const draco::PointAttribute *const att = reused_mesh->attribute(att_id);
+    ASSERT_EQ(att->size(), ref_att->size());
+    for (draco::PointIndex i(0); i < ref_mesh->num_points(); ++i) {
+      std::array<float, 3> ref_value = {}, value = {};
+      ref_att->GetMappedValue(i, &ref_value[0]);
+      att->GetMappedValue(i, &value[0]);
+      ASSERT_EQ(ref_value, value);
+    }
+  }
+
+  // Unknown attributes are reported.
+  draco::Decoder bad_decoder;
+  buffer.Init(split_buffer.data(), split_buffer.size());
+  ASSERT_FALSE(
+      bad_decoder.DecodeMeshFromBufferAttrs(&buffer, &header, {"UNKNOWN"})
+          .ok());
+}
+
+TEST_F(DecodeTest, TestDecodeBaseFromBuffer) {
+  // Tests that attribute chunks can be decoded concurrently against a shared
+  // decoded base and that they match the regular decoding.
+  std::unique_ptr<draco::Mesh> mesh = ReadNamedMesh("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+  // Normals and texture coordinates are predicted from the position.
+  encoder.SetSpeedOptions(0, 0);
+  draco::EncoderBuffer ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer));
+  encoder.options().SetGlobalBool("split_attr", true);
+  encoder.options().SetGlobalBool("split_container", true);
+  draco::EncoderBuffer split_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &split_buffer));
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+
+  buffer.Init(split_buffer.data(), split_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::shared_ptr<const draco::DecodedBase> base,
+                         decoder.DecodeBaseFromBuffer(&buffer));
+  ASSERT_EQ(base->mesh().num_faces(), ref_mesh->num_faces());
+  ASSERT_NE(base->GetCornerTable(), nullptr);
+  const int pos_decoder_id = base->GetAttributesDecoderId("POSITION");
+  ASSERT_GE(pos_decoder_id, 0);
+  ASSERT_TRUE(base->IsDecodedWithBase(pos_decoder_id));
+  ASSERT_EQ(base->GetAttributesDecoderId("UNKNOWN"), -1);
+
+  draco::SplitContainerDecoder container;
+  draco::DecoderBuffer container_buffer(buffer);
+  DRACO_ASSERT_OK(container.Decode(&container_buffer));
+  // Exactly the parents of prediction schemes are decoded with the base.
+  std::vector<bool> is_parent(base->num_attributes_decoders(), false);
+  for (int i = 0; i < container.num_entries(); ++i) {
+    for (const int32_t parent : container.entry(i).parent_decoder_ids) {
+      is_parent[parent] = true;
+    }
+  }
+  for (int i = 0; i < base->num_attributes_decoders(); ++i) {
+    ASSERT_EQ(base->IsDecodedWithBase(i), is_parent[i]);
+  }
+
+  const std::vector<draco::GeometryAttribute::Type> types = {
+      draco::GeometryAttribute::POSITION, draco::GeometryAttribute::NORMAL,
+      draco::GeometryAttribute::TEX_COORD};
+  std::vector<std::vector<std::unique_ptr<draco::PointAttribute>>> attributes(
+      types.size());
+  std::vector<draco::Status> statuses(types.size(), draco::OkStatus());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < types.size(); ++i) {
+    const std::string name = draco::GeometryAttribute::TypeToString(types[i]);
+    threads.push_back(std::thread([&, i, name]() {
+      draco::DecoderBuffer chunk_buffer;
+      statuses[i] = container.GetChunk(buffer, name, &chunk_buffer);
+      if (statuses[i].ok()) {
+        statuses[i] = base->DecodeAttributes(
+            base->GetAttributesDecoderId(name), &chunk_buffer, &attributes[i]);
+      }
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < types.size(); ++i) {
+    DRACO_ASSERT_OK(statuses[i]);
+    ASSERT_EQ(attributes[i].size(), 1);
+    const draco::PointAttribute *const ref_att =
+        ref_mesh->GetNamedAttribute(types[i]);
+    const draco::PointAttribute *const att = attributes[i][0].get();
+    ASSERT_EQ(att->attribute_type(), types[i]);
+    for (draco::PointIndex p(0); p < ref_mesh->num_points(); ++p) {
+      std::array<float, 3> ref_value = {}, value = {};
+      ref_att->GetMappedValue(p, &ref_value[0]);
+      att->GetMappedValue(p, &value[0]);
+      ASSERT_EQ(ref_value, value);
+    }
+  }
+
+  // Chunks of unnamed attributes are found by their generated names.
+  std::unique_ptr<draco::Mesh> unnamed_mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(unnamed_mesh, nullptr);
+  draco::EncoderBuffer unnamed_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*unnamed_mesh, &unnamed_buffer));
+  buffer.Init(unnamed_buffer.data(), unnamed_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(base, decoder.DecodeBaseFromBuffer(&buffer));
+  draco::SplitContainerDecoder unnamed_container;
+  container_buffer = buffer;
+  DRACO_ASSERT_OK(unnamed_container.Decode(&container_buffer));
+  for (int att_id = 0; att_id < unnamed_mesh->num_attributes(); ++att_id) {
+    const std::string name = "attribute_" + std::to_string(att_id);
+    const int decoder_id = base->GetAttributesDecoderId(name);
+    ASSERT_GE(decoder_id, 0);
+    draco::DecoderBuffer chunk_buffer;
+    DRACO_ASSERT_OK(unnamed_container.GetChunk(buffer, name, &chunk_buffer));
+    std::vector<std::unique_ptr<draco::PointAttribute>> unnamed_attributes;
+    DRACO_ASSERT_OK(base->DecodeAttributes(decoder_id, &chunk_buffer,
+                                           &unnamed_attributes));
+    ASSERT_EQ(unnamed_attributes.size(), 1);
+    ASSERT_EQ(unnamed_attributes[0]->attribute_type(),
+              unnamed_mesh->attribute(att_id)->attribute_type());
+  }
+}
+
+TEST_F(DecodeTest, TestDecodeCache) {
+  // Tests that repeated decoding of the same data is served from the cache
+  // and that least recently used entries are evicted.
+  std::unique_ptr<draco::Mesh> mesh = ReadNamedMesh("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  draco::EncoderBuffer mesh_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &mesh_buffer));
+  encoder.options().SetGlobalBool("split_attr", true);
+  encoder.options().SetGlobalBool("split_container", true);
+  draco::EncoderBuffer split_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &split_buffer));
+
+  draco::DecodeCache cache(1 << 20);
+  draco::Decoder decoder;
+  draco::DecoderBuffer buffer;
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::shared_ptr<const draco::Mesh> mesh_0,
+                         cache.DecodeMesh(&decoder, &buffer));
+  const int64_t mesh_decoded_size = buffer.decoded_size();
+  ASSERT_GT(mesh_decoded_size, 0);
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::shared_ptr<const draco::Mesh> mesh_1,
+                         cache.DecodeMesh(&decoder, &buffer));
+  ASSERT_EQ(mesh_0, mesh_1);
+  // A hit consumes the same data as the decoding did.
+  ASSERT_EQ(buffer.decoded_size(), mesh_decoded_size);
+  ASSERT_EQ(cache.num_hits(), 1);
+  ASSERT_EQ(cache.num_misses(), 1);
+  const size_t mesh_bytes = cache.num_bytes();
+  ASSERT_GT(mesh_bytes, 0);
+
+  // Different decoder options produce a different entry.
+  draco::Decoder skip_decoder;
+  skip_decoder.SetSkipAttributeTransform(draco::GeometryAttribute::POSITION);
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::shared_ptr<const draco::Mesh> mesh_2,
+                         cache.DecodeMesh(&skip_decoder, &buffer));
+  ASSERT_NE(mesh_0, mesh_2);
+  ASSERT_EQ(cache.num_entries(), 2);
+
+  // Attributes of a split container are cached together with the base.
+  for (int i = 0; i < 2; ++i) {
+    buffer.Init(split_buffer.data(), split_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(
+        std::shared_ptr<const draco::PointAttribute> normal,
+        cache.DecodeAttribute(&decoder, &buffer, "NORMAL"));
+    ASSERT_EQ(normal->attribute_type(), draco::GeometryAttribute::NORMAL);
+  }
+  ASSERT_EQ(cache.num_entries(), 4);
+  ASSERT_EQ(cache.num_hits(), 2);
+  buffer.Init(split_buffer.data(), split_buffer.size());
+  ASSERT_FALSE(cache.DecodeAttribute(&decoder, &buffer, "UNKNOWN").ok());
+
+  // Attributes requested together share the base and the cached entries.
+  buffer.Init(split_buffer.data(), split_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(
+      std::vector<std::shared_ptr<const draco::PointAttribute>> attributes,
+      cache.DecodeAttributes(&decoder, &buffer, {"NORMAL", "TEX_COORD"}));
+  ASSERT_EQ(attributes.size(), 2);
+  ASSERT_EQ(attributes[0]->attribute_type(),
+            draco::GeometryAttribute::NORMAL);
+  ASSERT_EQ(attributes[1]->attribute_type(),
+            draco::GeometryAttribute::TEX_COORD);
+  ASSERT_EQ(cache.num_entries(), 5);
+
+  // Only the most recently used mesh fits into a small cache.
+  draco::DecodeCache small_cache(mesh_bytes);
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSERT_OK(small_cache.DecodeMesh(&decoder, &buffer).status());
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSERT_OK(small_cache.DecodeMesh(&skip_decoder, &buffer).status());
+  ASSERT_EQ(small_cache.num_entries(), 1);
+  ASSERT_LE(small_cache.num_bytes(), mesh_bytes);
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSERT_OK(small_cache.DecodeMesh(&decoder, &buffer).status());
+  ASSERT_EQ(small_cache.num_hits(), 0);
+  ASSERT_EQ(small_cache.num_misses(), 3);
+
+  // Data larger than the budget is never cached.
+  draco::DecodeCache tiny_cache(1);
+  buffer.Init(mesh_buffer.data(), mesh_buffer.size());
+  DRACO_ASSERT_OK(tiny_cache.DecodeMesh(&decoder, &buffer).status());
+  ASSERT_EQ(tiny_cache.num_entries(), 0);
+
+  // Chunks of unnamed attributes are decoded by their generated names.
+  std::unique_ptr<draco::Mesh> unnamed_mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(unnamed_mesh, nullptr);
+  draco::EncoderBuffer unnamed_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*unnamed_mesh, &unnamed_buffer));
+  for (int att_id = 0; att_id < unnamed_mesh->num_attributes(); ++att_id) {
+    buffer.Init(unnamed_buffer.data(), unnamed_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(
+        std::shared_ptr<const draco::PointAttribute> attribute,
+        cache.DecodeAttribute(&decoder, &buffer,
+                              "attribute_" + std::to_string(att_id)));
+    ASSERT_EQ(attribute->attribute_type(),
+              unnamed_mesh->attribute(att_id)->attribute_type());
+  }
+}
+
+TEST_F(DecodeTest, TestParallelAttributeDecoding) {
+  // Tests that attributes encoded with their byte lengths are decoded the same
+  // way serially and in parallel.
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  // The prediction schemes of normals and texture coordinates use positions at
+  // this speed, so their decoders must wait for the decoder of positions.
+  encoder.SetSpeedOptions(0, 0);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+  draco::EncoderBuffer ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer));
+  encoder.options().SetGlobalBool("attribute_sizes", true);
+  draco::EncoderBuffer sizes_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &sizes_buffer));
+  // The attribute sizes are marked with a new bitstream version.
+  ASSERT_EQ(ref_buffer.data()[6], draco::kDracoMeshBitstreamVersionMinor);
+  ASSERT_EQ(sizes_buffer.data()[6],
+            draco::kDracoMeshAttributeSizesVersionMinor);
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+
+  for (const int num_threads : {1, 4}) {
+    draco::Decoder parallel_decoder;
+    parallel_decoder.options()->SetGlobalInt("attribute_decoding_threads",
+                                             num_threads);
+    buffer.Init(sizes_buffer.data(), sizes_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                           parallel_decoder.DecodeMeshFromBuffer(&buffer));
+    ASSERT_EQ(decoded_mesh->num_points(), ref_mesh->num_points());
+    ASSERT_EQ(decoded_mesh->num_attributes(), ref_mesh->num_attributes());
+    for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+      const draco::PointAttribute *const ref_att = ref_mesh->attribute(i);
+      const draco::PointAttribute *const att = decoded_mesh->attribute(i);
+      ASSERT_EQ(att->attribute_type(), ref_att->attribute_type());
+      for (draco::PointIndex p(0); p < ref_mesh->num_points(); ++p) {
+        std::array<float, 3> ref_value = {}, value = {};
+        ref_att->GetMappedValue(p, &ref_value[0]);
+        att->GetMappedValue(p, &value[0]);
+        ASSERT_EQ(ref_value, value);
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestInterleavedRAnsDecoding) {
+  // Tests that a mesh encoded with interleaved rANS states is marked with the
+  // new bitstream version and decodes to the same values as the default
+  // encoding.
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+  draco::EncoderBuffer ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer));
+  ASSERT_EQ(ref_buffer.data()[6], draco::kDracoMeshBitstreamVersionMinor);
+  encoder.options().SetGlobalInt("interleaved_rans_states", 8);
+  draco::EncoderBuffer interleaved_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &interleaved_buffer));
+  ASSERT_EQ(interleaved_buffer.data()[6],
+            draco::kDracoMeshInterleavedRAnsVersionMinor);
+
+  draco::Decoder decoder;
+  draco::DecoderBuffer buffer;
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+  buffer.Init(interleaved_buffer.data(), interleaved_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+  ASSERT_EQ(decoded_mesh->num_points(), ref_mesh->num_points());
+  ASSERT_EQ(decoded_mesh->num_attributes(), ref_mesh->num_attributes());
+  for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+    const draco::PointAttribute *const ref_att = ref_mesh->attribute(i);
+    const draco::PointAttribute *const att = decoded_mesh->attribute(i);
+    for (draco::PointIndex p(0); p < ref_mesh->num_points(); ++p) {
+      std::array<float, 3> ref_value = {}, value = {};
+      ref_att->GetMappedValue(p, &ref_value[0]);
+      att->GetMappedValue(p, &value[0]);
+      ASSERT_EQ(ref_value, value);
+    }
+  }
+}
+
+// Decodes |file| with Decoder::DecodeMeshToBuffers() into an interleaved
+// vertex buffer holding all attributes and verifies that the written values
+// and indices match the regular decoding.
+void TestDecodeMeshToBuffers(const std::string &file,
+                             draco::DataType index_type) {
+  std::vector<char> data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(draco::GetTestFileFullPath(file), &data));
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+
+  // All attributes are stored with their original format one after another.
+  draco::MeshBufferLayout layout;
+  for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+    const draco::PointAttribute *const att = ref_mesh->attribute(i);
+    draco::VertexBufferAttribute out_att;
+    out_att.attribute_type = att->attribute_type();
+    for (int j = 0; j < i; ++j) {
+      if (ref_mesh->attribute(j)->attribute_type() == att->attribute_type()) {
+        out_att.attribute_index++;
+      }
+    }
+    out_att.data_type = att->data_type();
+    out_att.num_components = att->num_components();
+    out_att.byte_offset = layout.vertex_stride;
+    layout.attributes.push_back(out_att);
+    layout.vertex_stride +=
+        att->num_components() * draco::DataTypeLength(att->data_type());
+  }
+  std::vector<uint8_t> vertex_data;
+  std::vector<uint8_t> index_data;
+  buffer.Init(data.data(), data.size());
+  DRACO_ASSERT_OK(decoder.DecodeMeshToBuffers(
+      &buffer, [&](const draco::Mesh &mesh, draco::MeshBufferLayout *out) {
+        *out = layout;
+        vertex_data.resize(mesh.num_points() * layout.vertex_stride);
+        out->vertex_data = vertex_data.data();
+        out->vertex_data_size = vertex_data.size();
+        index_data.resize(mesh.num_faces() * 3 *
+                          draco::DataTypeLength(index_type));
+        out->index_data = index_data.data();
+        out->index_data_size = index_data.size();
+        out->index_type = index_type;
+        return draco::OkStatus();
+      }));
+  ASSERT_EQ(vertex_data.size(),
+            ref_mesh->num_points() * layout.vertex_stride);
+  ASSERT_EQ(index_data.size(), ref_mesh->num_faces() * 3 *
+                                   draco::DataTypeLength(index_type));
+
+  for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+    const draco::PointAttribute *const att = ref_mesh->attribute(i);
+    const int64_t value_size = att->byte_stride();
+    for (draco::PointIndex p(0); p < ref_mesh->num_points(); ++p) {
+      ASSERT_EQ(memcmp(att->GetAddress(att->mapped_index(p)),
+                       vertex_data.data() + p.value() * layout.vertex_stride +
+                           layout.attributes[i].byte_offset,
+                       value_size),
+                0);
+    }
+  }
+  for (draco::FaceIndex f(0); f < ref_mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      const int index = 3 * f.value() + c;
+      const uint32_t value =
+          index_type == draco::DT_UINT16
+              ? reinterpret_cast<const uint16_t *>(index_data.data())[index]
+              : reinterpret_cast<const uint32_t *>(index_data.data())[index];
+      ASSERT_EQ(value, ref_mesh->face(f)[c].value());
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestDecodeMeshToBuffers) {
+  TestDecodeMeshToBuffers("test_nm.obj.edgebreaker.cl10.2.2.drc",
+                          draco::DT_UINT32);
+  TestDecodeMeshToBuffers("test_nm.obj.sequential.cl3.2.2.drc",
+                          draco::DT_UINT16);
+  TestDecodeMeshToBuffers("cube_att.obj.edgebreaker.cl4.2.2.drc",
+                          draco::DT_UINT16);
+  TestDecodeMeshToBuffers("car.drc", draco::DT_UINT32);
+}
+
+TEST_F(DecodeTest, TestDecodeMeshToBuffersErrors) {
+  std::vector<char> data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("test_nm.obj.edgebreaker.cl10.2.2.drc"),
+      &data));
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  std::vector<float> positions(3);
+  // The vertex buffer is too small for all points.
+  const draco::Status status = decoder.DecodeMeshToBuffers(
+      &buffer, [&](const draco::Mesh &, draco::MeshBufferLayout *out) {
+        draco::VertexBufferAttribute out_att;
+        out_att.attribute_type = draco::GeometryAttribute::POSITION;
+        out_att.num_components = 3;
+        out->attributes.push_back(out_att);
+        out->vertex_data = reinterpret_cast<uint8_t *>(positions.data());
+        out->vertex_data_size = positions.size() * sizeof(float);
+        out->vertex_stride = 3 * sizeof(float);
+        return draco::OkStatus();
+      });
+  ASSERT_FALSE(status.ok());
+
+  // Errors of the callback are returned.
+  buffer.Init(data.data(), data.size());
+  ASSERT_FALSE(decoder
+                   .DecodeMeshToBuffers(
+                       &buffer,
+                       [](const draco::Mesh &, draco::MeshBufferLayout *) {
+                         return draco::Status(draco::Status::DRACO_ERROR,
+                                              "No buffers.");
+                       })
+                   .ok());
+}
+
+TEST_F(DecodeTest, TestDecodeWithArena) {
+  // Tests that meshes decoded with transient data allocated from an arena are
+  // the same as meshes decoded without it, and that the arena memory is
+  // reused after a reset.
+  const std::string files[] = {"test_nm.obj.edgebreaker.cl10.2.2.drc",
+                               "test_nm.obj.sequential.cl3.2.2.drc",
+                               "cube_att.obj.edgebreaker.cl4.2.2.drc",
+                               "car.drc"};
+  draco::Arena arena(1024);
+  size_t num_reserved_bytes = 0;
+  for (int round = 0; round < 2; ++round) {
+    for (const std::string &file : files) {
+      std::vector<char> data;
+      ASSERT_TRUE(
+          draco::ReadFileToBuffer(draco::GetTestFileFullPath(file), &data));
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      draco::Decoder decoder;
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                             decoder.DecodeMeshFromBuffer(&buffer));
+      buffer.Init(data.data(), data.size());
+      decoder.SetArena(&arena);
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> mesh,
+                             decoder.DecodeMeshFromBuffer(&buffer));
+      arena.Reset();
+      ASSERT_NO_FATAL_FAILURE(CompareMeshes(*mesh, *ref_mesh));
+    }
+    if (round == 0) {
+      num_reserved_bytes = arena.num_reserved_bytes();
+      ASSERT_GT(num_reserved_bytes, 0);
+    } else {
+      // Decoding the same data again fits into the blocks of the arena.
+      ASSERT_EQ(arena.num_reserved_bytes(), num_reserved_bytes);
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestAttributeMemoryCallback) {
+  // Tests that attribute values are decoded in place into memory provided by
+  // the caller.
+  std::vector<std::unique_ptr<std::vector<uint8_t>>> memory;
+  draco::Decoder decoder;
+  decoder.SetAttributeMemoryCallback(
+      [&memory](const draco::PointAttribute & /* attribute */, int64_t size) {
+        memory.emplace_back(new std::vector<uint8_t>(size));
+        return memory.back()->data();
+      });
+  const std::string files[] = {"test_nm.obj.edgebreaker.cl10.2.2.drc",
+                               "test_nm.obj.sequential.cl3.2.2.drc",
+                               "cube_att.obj.edgebreaker.cl4.2.2.drc",
+                               "pc_kd_color.drc"};
+  for (const std::string &file : files) {
+    SCOPED_TRACE(file);
+    std::vector<char> data;
+    ASSERT_TRUE(
+        draco::ReadFileToBuffer(draco::GetTestFileFullPath(file), &data));
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    draco::Decoder ref_decoder;
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> ref_pc,
+                           ref_decoder.DecodePointCloudFromBuffer(&buffer));
+    buffer.Init(data.data(), data.size());
+    memory.clear();
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> pc,
+                           decoder.DecodePointCloudFromBuffer(&buffer));
+    ASSERT_EQ(pc->num_attributes(), ref_pc->num_attributes());
+    ASSERT_EQ(memory.size(), pc->num_attributes());
+    for (int i = 0; i < pc->num_attributes(); ++i) {
+      const draco::PointAttribute *const ref_att = ref_pc->attribute(i);
+      const draco::PointAttribute *const att = pc->attribute(i);
+      ASSERT_TRUE(att->buffer()->is_external());
+      ASSERT_EQ(att->buffer()->data(), memory[i]->data());
+      for (draco::PointIndex p(0); p < ref_pc->num_points(); ++p) {
+        ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(p),
+                         ref_att->GetAddressOfMappedIndex(p),
+                         att->byte_stride()),
+                  0);
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestWarmDecoding) {
+  // Tests that a decoder with retained memory decodes the same meshes as a
+  // regular decoder and that it keeps at most the configured amount of memory.
+  const std::string files[] = {"test_nm.obj.edgebreaker.cl10.2.2.drc",
+                               "test_nm.obj.sequential.cl3.2.2.drc",
+                               "cube_att.obj.edgebreaker.cl4.2.2.drc",
+                               "car.drc"};
+  draco::Decoder warm_decoder;
+  ASSERT_EQ(warm_decoder.num_retained_bytes(), 0);
+  const size_t kMaxRetainedBytes = 1 << 20;
+  warm_decoder.SetRetainedMemoryLimit(kMaxRetainedBytes);
+  size_t num_retained_bytes = 0;
+  for (int round = 0; round < 2; ++round) {
+    for (const std::string &file : files) {
+      std::vector<char> data;
+      ASSERT_TRUE(
+          draco::ReadFileToBuffer(draco::GetTestFileFullPath(file), &data));
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      draco::Decoder decoder;
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                             decoder.DecodeMeshFromBuffer(&buffer));
+      buffer.Init(data.data(), data.size());
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> mesh,
+                             warm_decoder.DecodeMeshFromBuffer(&buffer));
+      ASSERT_NO_FATAL_FAILURE(CompareMeshes(*mesh, *ref_mesh));
+      ASSERT_GT(warm_decoder.num_retained_bytes(), 0);
+      ASSERT_LE(warm_decoder.num_retained_bytes(), kMaxRetainedBytes);
+    }
+    if (round == 0) {
+      num_retained_bytes = warm_decoder.num_retained_bytes();
+    } else {
+      // Decoding the same data again reuses the retained memory.
+      ASSERT_EQ(warm_decoder.num_retained_bytes(), num_retained_bytes);
+    }
+  }
+
+  // Memory over a lowered limit is released.
+  warm_decoder.SetRetainedMemoryLimit(1);
+  ASSERT_LE(warm_decoder.num_retained_bytes(), 1);
+  warm_decoder.SetRetainedMemoryLimit(0);
+  ASSERT_EQ(warm_decoder.num_retained_bytes(), 0);
+}
+
+TEST_F(DecodeTest, TestWarmDecoderReuse) {
+  // Tests that a reused warm decoder decodes the regular encoding the same
+  // way after split container decoding as before it.
+  std::unique_ptr<draco::Mesh> mesh = ReadNamedMesh("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+  draco::EncoderBuffer ref_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer));
+  encoder.options().SetGlobalBool("split_attr", true);
+  encoder.options().SetGlobalBool("split_container", true);
+  draco::EncoderBuffer split_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &split_buffer));
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(ref_buffer.data(), ref_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+
+  draco::Decoder warm_decoder;
+  warm_decoder.SetRetainedMemoryLimit(1 << 20);
+  const uint64_t options_fingerprint = warm_decoder.options()->Fingerprint();
+  for (int round = 0; round < 2; ++round) {
+    buffer.Init(ref_buffer.data(), ref_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                           warm_decoder.DecodeMeshFromBuffer(&buffer));
+    ASSERT_NO_FATAL_FAILURE(CompareMeshes(*decoded_mesh, *ref_mesh));
+
+    buffer.Init(split_buffer.data(), split_buffer.size());
+    draco::DracoHeader header;
+    DRACO_ASSIGN_OR_ASSERT(
+        std::unique_ptr<draco::Mesh> split_mesh,
+        warm_decoder.DecodeMeshFromBufferAttrs(&buffer, &header, {"NORMAL"}));
+    ASSERT_EQ(split_mesh->num_points(), ref_mesh->num_points());
+
+    buffer.Init(split_buffer.data(), split_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(std::shared_ptr<const draco::DecodedBase> base,
+                           warm_decoder.DecodeBaseFromBuffer(&buffer));
+    ASSERT_EQ(base->mesh().num_faces(), ref_mesh->num_faces());
+
+    // No per-call state is left in the options.
+    ASSERT_EQ(warm_decoder.options()->Fingerprint(), options_fingerprint);
+  }
+}
+
+
+// Feeds |data| to |decoder| in chunks of |chunk_size| bytes and returns the
+// status of the last call.
+draco::Status FeedInChunks(const std::vector<char> &data, size_t chunk_size,
+                           draco::StreamingDecoder *decoder) {
+  draco::Status status(draco::Status::NEED_MORE_DATA);
+  for (size_t i = 0; i < data.size(); i += chunk_size) {
+    status = decoder->Feed(data.data() + i,
+                           std::min(chunk_size, data.size() - i));
+    if (status.code() != draco::Status::NEED_MORE_DATA) {
+      break;
+    }
+  }
+  return status;
+}
+
+TEST_F(DecodeTest, TestStreamingDecoder) {
+  // Tests that meshes fed in small chunks are decoded the same way as with a
+  // regular decoder and that each part is available once its data arrives.
+  std::unique_ptr<draco::Mesh> mesh = ReadNamedMesh("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  std::unique_ptr<draco::GeometryMetadata> metadata(
+      new draco::GeometryMetadata());
+  metadata->AddEntryString("name", "cube");
+  mesh->AddMetadata(std::move(metadata));
+  for (const int speed : {0, 10}) {
+    for (const bool attribute_sizes : {false, true}) {
+      draco::Encoder encoder;
+      encoder.SetSpeedOptions(speed, speed);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+      encoder.options().SetGlobalBool("attribute_sizes", attribute_sizes);
+      draco::EncoderBuffer encoder_buffer;
+      DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+      const std::vector<char> data(
+          encoder_buffer.data(), encoder_buffer.data() + encoder_buffer.size());
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      draco::Decoder decoder;
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                             decoder.DecodeMeshFromBuffer(&buffer));
+
+      draco::StreamingDecoder streaming_decoder;
+      ASSERT_FALSE(streaming_decoder.has_header());
+      ASSERT_EQ(streaming_decoder.Feed(data.data(), 4).code(),
+                draco::Status::NEED_MORE_DATA);
+      ASSERT_FALSE(streaming_decoder.has_header());
+      ASSERT_EQ(streaming_decoder.Feed(data.data() + 4, 12).code(),
+                draco::Status::NEED_MORE_DATA);
+      ASSERT_TRUE(streaming_decoder.has_header());
+      ASSERT_EQ(streaming_decoder.header().encoder_type,
+                draco::TRIANGULAR_MESH);
+      ASSERT_FALSE(streaming_decoder.has_connectivity());
+
+      // Feed the rest byte by byte and record when each part was decoded.
+      size_t connectivity_size = 0;
+      std::vector<size_t> attribute_decoder_sizes;
+      draco::Status status(draco::Status::NEED_MORE_DATA);
+      for (size_t i = 16; i < data.size(); ++i) {
+        status = streaming_decoder.Feed(data.data() + i, 1);
+        if (status.code() != draco::Status::NEED_MORE_DATA) {
+          break;
+        }
+        if (connectivity_size == 0 && streaming_decoder.has_connectivity()) {
+          connectivity_size = i + 1;
+          ASSERT_NE(streaming_decoder.metadata(), nullptr);
+          std::string name;
+          ASSERT_TRUE(streaming_decoder.metadata()->GetEntryString("name",
+                                                                  &name));
+          ASSERT_EQ(name, "cube");
+          const draco::Mesh *const partial_mesh =
+              static_cast<const draco::Mesh *>(
+                  streaming_decoder.point_cloud());
+          ASSERT_EQ(partial_mesh->num_faces(), ref_mesh->num_faces());
+        }
+        if (streaming_decoder.num_decoded_attributes_decoders() >
+            static_cast<int>(attribute_decoder_sizes.size())) {
+          attribute_decoder_sizes.push_back(i + 1);
+        }
+      }
+      ASSERT_GT(connectivity_size, 0);
+      ASSERT_LT(connectivity_size, data.size());
+      if (attribute_sizes) {
+        // The attributes were decoded as their data arrived.
+        DRACO_ASSERT_OK(status);
+        ASSERT_TRUE(streaming_decoder.is_complete());
+        ASSERT_EQ(attribute_decoder_sizes.size() + 1,
+                  streaming_decoder.num_attributes_decoders());
+        for (const size_t size : attribute_decoder_sizes) {
+          ASSERT_LT(size, data.size());
+        }
+      } else {
+        // The end of the data of an attributes decoder is known only once it
+        // is decoded, so only the last one may need to wait for Finish().
+        ASSERT_GE(attribute_decoder_sizes.size() + 1,
+                  streaming_decoder.num_attributes_decoders());
+      }
+      DRACO_ASSERT_OK(streaming_decoder.Finish());
+      ASSERT_EQ(streaming_decoder.num_decoded_attributes_decoders(),
+                streaming_decoder.num_attributes_decoders());
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                             streaming_decoder.TakeMesh());
+      ASSERT_NO_FATAL_FAILURE(CompareMeshes(*decoded_mesh, *ref_mesh));
+
+      // All data received at once is decoded without waiting for Finish().
+      draco::StreamingDecoder whole_decoder;
+      DRACO_ASSERT_OK(whole_decoder.Feed(data.data(), data.size()));
+      ASSERT_TRUE(whole_decoder.is_complete());
+
+      // Larger chunks give the same result.
+      draco::StreamingDecoder chunk_decoder;
+      status = FeedInChunks(data, 100, &chunk_decoder);
+      if (attribute_sizes) {
+        DRACO_ASSERT_OK(status);
+      }
+      DRACO_ASSERT_OK(chunk_decoder.Finish());
+      DRACO_ASSIGN_OR_ASSERT(decoded_mesh, chunk_decoder.TakeMesh());
+      ASSERT_NO_FATAL_FAILURE(CompareMeshes(*decoded_mesh, *ref_mesh));
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestStreamingDecoderPointCloud) {
+  // Tests streaming decoding of point clouds.
+  std::vector<char> data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("pc_kd_color.drc"), &data));
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> ref_pc,
+                         decoder.DecodePointCloudFromBuffer(&buffer));
+
+  draco::StreamingDecoder streaming_decoder;
+  ASSERT_EQ(FeedInChunks(data, 64, &streaming_decoder).code(),
+            draco::Status::NEED_MORE_DATA);
+  DRACO_ASSERT_OK(streaming_decoder.Finish());
+  ASSERT_FALSE(streaming_decoder.TakeMesh().ok());
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> pc,
+                         streaming_decoder.TakePointCloud());
+  ASSERT_EQ(pc->num_points(), ref_pc->num_points());
+  ASSERT_EQ(pc->num_attributes(), ref_pc->num_attributes());
+  for (int i = 0; i < ref_pc->num_attributes(); ++i) {
+    const draco::PointAttribute *const ref_att = ref_pc->attribute(i);
+    const draco::PointAttribute *const att = pc->attribute(i);
+    for (draco::PointIndex p(0); p < ref_pc->num_points(); ++p) {
+      ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(p),
+                       ref_att->GetAddressOfMappedIndex(p),
+                       att->byte_stride()),
+                0);
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestStreamingDecoderErrors) {
+  // Tests that invalid and truncated data is reported as an error.
+  std::vector<char> data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("cube_att.obj.edgebreaker.cl4.2.2.drc"),
+      &data));
+
+  draco::StreamingDecoder invalid_decoder;
+  const char kInvalidData[] = "NOT A DRACO FILE";
+  const draco::Status status =
+      invalid_decoder.Feed(kInvalidData, sizeof(kInvalidData));
+  ASSERT_FALSE(status.ok());
+  ASSERT_NE(status.code(), draco::Status::NEED_MORE_DATA);
+  // The error is final.
+  ASSERT_EQ(invalid_decoder.Feed(data.data(), data.size()).code(),
+            status.code());
+
+  for (const size_t size : {size_t(5), size_t(40), data.size() - 10}) {
+    draco::StreamingDecoder truncated_decoder;
+    ASSERT_EQ(truncated_decoder.Feed(data.data(), size).code(),
+              draco::Status::NEED_MORE_DATA);
+    const draco::Status finish_status = truncated_decoder.Finish();
+    ASSERT_FALSE(finish_status.ok());
+    ASSERT_NE(finish_status.code(), draco::Status::NEED_MORE_DATA);
+    ASSERT_FALSE(truncated_decoder.TakeMesh().ok());
+  }
+
+  // Corrupted data is reported right away and not as missing data. The byte
+  // after the header selects the edgebreaker traversal decoder.
+  std::vector<char> corrupted_data = data;
+  corrupted_data[11] = 0x7f;
+  draco::StreamingDecoder corrupted_decoder;
+  const draco::Status corrupted_status =
+      corrupted_decoder.Feed(corrupted_data.data(), 40);
+  ASSERT_FALSE(corrupted_status.ok());
+  ASSERT_NE(corrupted_status.code(), draco::Status::NEED_MORE_DATA);
+}
+
 }  // namespace
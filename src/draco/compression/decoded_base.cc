@@ -0,0 +1,261 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/decoded_base.h"
+
+#include "draco/compression/attributes/points_sequencer.h"
+#include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
+
+namespace draco {
+
+namespace {
+
+// Sequencer that returns a sequence of points generated by the base decoder.
+// The point to attribute value mapping is copied from the matching attribute
+// of the base point cloud.
+class CachedPointsSequencer : public PointsSequencer {
+ public:
+  CachedPointsSequencer(const std::vector<PointIndex> *point_ids,
+                        const PointCloud *base)
+      : point_ids_(point_ids), base_(base) {}
+
+  bool UpdatePointToAttributeIndexMapping(PointAttribute *attribute) override {
+    const PointAttribute *const base_att =
+        base_->GetAttributeByUniqueId(attribute->unique_id());
+    if (base_att == nullptr) {
+      return false;
+    }
+    if (base_att->is_mapping_identity()) {
+      attribute->SetIdentityMapping();
+      return true;
+    }
+    const size_t num_points = base_att->indices_map_size();
+    attribute->SetExplicitMapping(num_points);
+    for (PointIndex i(0); i < static_cast<uint32_t>(num_points); ++i) {
+      attribute->SetPointMapEntry(i, base_att->mapped_index(i));
+    }
+    return true;
+  }
+
+ protected:
+  bool GenerateSequenceInternal() override {
+    *out_point_ids() = *point_ids_;
+    return true;
+  }
+
+ private:
+  const std::vector<PointIndex> *point_ids_;
+  const PointCloud *base_;
+};
+
+// Mesh decoder that decodes attributes into its own mesh while the
+// connectivity and the parent attributes are provided by an already decoded
+// base decoder. The base decoder is accessed only for reading.
+class BaseAttributesDecoder : public MeshDecoder {
+ public:
+  BaseAttributesDecoder(MeshDecoder *base_decoder, Mesh *out_mesh)
+      : base_decoder_(base_decoder) {
+    InitFromDecoder(*base_decoder, out_mesh);
+  }
+
+  const CornerTable *GetCornerTable() const override {
+    return base_decoder_->GetCornerTable();
+  }
+  const MeshAttributeCornerTable *GetAttributeCornerTable(
+      int att_id) const override {
+    return base_decoder_->GetAttributeCornerTable(att_id);
+  }
+  const MeshAttributeIndicesEncodingData *GetAttributeEncodingData(
+      int att_id) const override {
+    return base_decoder_->GetAttributeEncodingData(att_id);
+  }
+  const PointAttribute *GetPortableAttribute(
+      int32_t point_attribute_id) override {
+    return base_decoder_->GetPortableAttribute(point_attribute_id);
+  }
+
+ protected:
+  Status CreateAttributesDecoder(int32_t /* att_decoder_id */) override {
+    return Status(Status::DRACO_ERROR, "Attributes decoders are not decoded.");
+  }
+  bool DecodeConnectivity() override { return false; }
+
+ private:
+  MeshDecoder *const base_decoder_;
+};
+
+}  // namespace
+
+DecodedBase::DecodedBase() {}
+
+Status DecodedBase::Init(std::unique_ptr<MeshDecoder> decoder,
+                         const DecoderOptions &options,
+                         DecoderBuffer *in_buffer) {
+  DecoderBuffer container_buffer(*in_buffer);
+  DRACO_RETURN_IF_ERROR(container_.Decode(&container_buffer))
+  DecoderBuffer base_buffer;
+  DRACO_RETURN_IF_ERROR(
+      container_.GetChunk(*in_buffer, kSplitContainerBaseName, &base_buffer))
+
+  options_ = options;
+  options_.SetGlobalBool("split_attr", true);
+  options_.SetGlobalString("attribute_name", kSplitContainerBaseName);
+  mesh_ = std::unique_ptr<Mesh>(new Mesh());
+  decoder_ = std::move(decoder);
+  DRACO_RETURN_IF_ERROR(
+      decoder_->DecodeAttr(options_, &base_buffer, &header_, mesh_.get()))
+  // Older bitstreams use the final parent attributes for prediction which
+  // would have to be decoded into every mesh.
+  if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0)) {
+    return Status(Status::DRACO_ERROR, "Unsupported bitstream version.");
+  }
+
+  // Attributes used as parents by prediction schemes of other attributes are
+  // decoded together with the base. Points of all other attributes are
+  // sequenced now, because the traversal updates the encoding data that is
+  // later shared by all decoded chunks.
+  const int num_decoders = decoder_->num_attributes_decoders();
+  decoded_with_base_.assign(num_decoders, false);
+  if (container_.has_parent_decoder_ids()) {
+    for (int i = 0; i < container_.num_entries(); ++i) {
+      for (const int32_t parent : container_.entry(i).parent_decoder_ids) {
+        if (parent < 0 || parent >= num_decoders) {
+          return Status(Status::DRACO_ERROR, "Invalid parent decoder id.");
+        }
+        decoded_with_base_[parent] = true;
+      }
+    }
+    // Parents are always decoded before their children, so parents of the
+    // parents can be collected in a single backward pass.
+    for (int i = num_decoders - 1; i >= 0; --i) {
+      const SplitContainerEntry *const entry =
+          decoded_with_base_[i] ? container_.FindEntryByDecoderId(i) : nullptr;
+      if (entry == nullptr) {
+        continue;
+      }
+      for (const int32_t parent : entry->parent_decoder_ids) {
+        if (parent >= i) {
+          return Status(Status::DRACO_ERROR, "Invalid parent decoder id.");
+        }
+        decoded_with_base_[parent] = true;
+      }
+    }
+  } else {
+    // Older containers do not list the parents. All prediction schemes of
+    // these bitstreams use the position as the only parent attribute.
+    const int pos_att_id =
+        mesh_->GetNamedAttributeId(GeometryAttribute::POSITION);
+    for (int i = 0; i < num_decoders; ++i) {
+      const AttributesDecoderInterface *const att_decoder =
+          decoder_->attributes_decoder(i);
+      for (int j = 0; j < att_decoder->GetNumAttributes(); ++j) {
+        if (att_decoder->GetAttributeId(j) == pos_att_id) {
+          decoded_with_base_[i] = true;
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < num_decoders; ++i) {
+    // All mesh decoders use sequential attribute decoders.
+    SequentialAttributeDecodersController *const controller =
+        static_cast<SequentialAttributeDecodersController *>(
+            decoder_->attributes_decoder(i));
+    const SplitContainerEntry *const entry =
+        decoded_with_base_[i] ? container_.FindEntryByDecoderId(i) : nullptr;
+    if (entry == nullptr) {
+      decoded_with_base_[i] = false;
+      DRACO_RETURN_IF_ERROR(controller->GeneratePointSequence())
+      continue;
+    }
+    DecoderBuffer chunk_buffer;
+    DRACO_RETURN_IF_ERROR(
+        container_.GetChunk(*in_buffer, entry->name, &chunk_buffer))
+    DRACO_RETURN_IF_ERROR(decoder_->DecodeSplitAttributes(i, &chunk_buffer))
+    // The first call sets up the point mapping of the portable attributes.
+    // Doing it here keeps later concurrent calls read-only.
+    for (int j = 0; j < controller->GetNumAttributes(); ++j) {
+      decoder_->GetPortableAttribute(controller->GetAttributeId(j));
+    }
+  }
+  return OkStatus();
+}
+
+Status DecodedBase::DecodeAttributes(
+    int att_decoder_id, DecoderBuffer *in_buffer,
+    std::vector<std::unique_ptr<PointAttribute>> *out_attributes) const {
+  if (att_decoder_id < 0 || att_decoder_id >= num_attributes_decoders()) {
+    return Status(Status::DRACO_ERROR, "Invalid attributes decoder id.");
+  }
+  const SequentialAttributeDecodersController *const base_controller =
+      static_cast<const SequentialAttributeDecodersController *>(
+          decoder_->attributes_decoder(att_decoder_id));
+  const int num_attributes = base_controller->GetNumAttributes();
+  if (decoded_with_base_[att_decoder_id]) {
+    for (int i = 0; i < num_attributes; ++i) {
+      std::unique_ptr<PointAttribute> pa(new PointAttribute());
+      pa->CopyFrom(*mesh_->attribute(base_controller->GetAttributeId(i)));
+      out_attributes->push_back(std::move(pa));
+    }
+    return OkStatus();
+  }
+
+  // Attributes are decoded into a mesh without faces that has the same
+  // attributes as the base mesh, so that all attribute ids stay valid.
+  Mesh mesh;
+  mesh.set_num_points(mesh_->num_points());
+  for (int i = 0; i < mesh_->num_attributes(); ++i) {
+    const GeometryAttribute &att = *mesh_->attribute(i);
+    mesh.AddAttribute(std::unique_ptr<PointAttribute>(new PointAttribute(att)));
+  }
+  BaseAttributesDecoder decoder(decoder_.get(), &mesh);
+  std::unique_ptr<SequentialAttributeDecodersController> controller =
+      base_controller->CreateCopy(
+          std::unique_ptr<PointsSequencer>(new CachedPointsSequencer(
+              &base_controller->point_ids(), mesh_.get())),
+          &decoder, &mesh);
+  if (controller == nullptr) {
+    return Status(Status::DRACO_ERROR, "Failed to create attributes decoder.");
+  }
+  in_buffer->set_bitstream_version(decoder_->bitstream_version());
+  DRACO_RETURN_IF_ERROR(controller->DecodeAttributes(in_buffer))
+  for (int i = 0; i < num_attributes; ++i) {
+    out_attributes->push_back(std::unique_ptr<PointAttribute>(
+        new PointAttribute(std::move(
+            *mesh.attribute(base_controller->GetAttributeId(i))))));
+  }
+  return OkStatus();
+}
+
+int DecodedBase::GetAttributesDecoderId(const std::string &name) const {
+  const SplitContainerEntry *const entry = container_.FindEntry(name);
+  if (entry == nullptr || entry->decoder_id < 0 ||
+      entry->decoder_id >= num_attributes_decoders()) {
+    return -1;
+  }
+  return entry->decoder_id;
+}
+
+bool DecodedBase::IsDecodedWithBase(int att_decoder_id) const {
+  return decoded_with_base_[att_decoder_id];
+}
+
+const std::vector<PointIndex> &DecodedBase::GetTraversalOrder(
+    int att_decoder_id) const {
+  return static_cast<const SequentialAttributeDecodersController *>(
+             decoder_->attributes_decoder(att_decoder_id))
+      ->point_ids();
+}
+
+}  // namespace draco
@@ -0,0 +1,107 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_DECODED_BASE_H_
+#define DRACO_COMPRESSION_DECODED_BASE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/attributes/point_attribute.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/config/decoder_options.h"
+#include "draco/compression/mesh/mesh_decoder.h"
+#include "draco/compression/point_cloud/split_container_decoder.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Base geometry of a split container (see SplitContainerEncoder) decoded once
+// and kept for decoding of any number of attribute chunks. It holds the mesh
+// connectivity, the attribute corner tables and the traversal order of points
+// of every attributes decoder, so that the chunks can be decoded without
+// repeating the Edgebreaker pass. Attributes used as parents for prediction of
+// other attributes are decoded together with the base.
+//
+// After Init() the object is immutable and all const methods can be called
+// concurrently from multiple threads. Use Decoder::DecodeBaseFromBuffer() to
+// create a shared instance.
+class DecodedBase {
+ public:
+  DecodedBase();
+
+  // Decodes the base geometry and the parent attribute chunks of the split
+  // container held in |in_buffer| using |decoder| created for the encoding
+  // method of the base. |options| are copied.
+  Status Init(std::unique_ptr<MeshDecoder> decoder,
+              const DecoderOptions &options, DecoderBuffer *in_buffer);
+
+  // Decodes the attributes of the attributes decoder |att_decoder_id| from
+  // |in_buffer| that holds the chunk of the decoder. The decoded attributes
+  // are appended to |out_attributes| in the order of their attribute ids.
+  // Attributes decoded together with the base are copied. Thread-safe.
+  Status DecodeAttributes(
+      int att_decoder_id, DecoderBuffer *in_buffer,
+      std::vector<std::unique_ptr<PointAttribute>> *out_attributes) const;
+
+  // Returns the id of the attributes decoder of the chunk |name| of the split
+  // container (see GetSplitAttributeName()) or -1 when there is no such
+  // chunk. Accepts the same names as Decoder::DecodeMeshFromBufferAttrs().
+  int GetAttributesDecoderId(const std::string &name) const;
+
+  // Returns true when the attributes of |att_decoder_id| were decoded together
+  // with the base and are available in mesh().
+  bool IsDecodedWithBase(int att_decoder_id) const;
+
+  // Returns the sequence in which points of attributes decoded by
+  // |att_decoder_id| are traversed.
+  const std::vector<PointIndex> &GetTraversalOrder(int att_decoder_id) const;
+
+  // Returns the connectivity of the base mesh or nullptr if the base was not
+  // encoded with Edgebreaker.
+  const CornerTable *GetCornerTable() const {
+    return decoder_->GetCornerTable();
+  }
+  const MeshAttributeCornerTable *GetAttributeCornerTable(int att_id) const {
+    return decoder_->GetAttributeCornerTable(att_id);
+  }
+
+  int num_attributes_decoders() const {
+    return decoder_->num_attributes_decoders();
+  }
+  const DracoHeader &header() const { return header_; }
+
+  // Returns the base mesh. It contains the faces and all attributes, but only
+  // the attributes decoded together with the base hold any values.
+  const Mesh &mesh() const { return *mesh_; }
+
+ private:
+  std::unique_ptr<Mesh> mesh_;
+  std::unique_ptr<MeshDecoder> decoder_;
+  DecoderOptions options_;
+  DracoHeader header_;
+
+  // Table of contents of the split container.
+  SplitContainerDecoder container_;
+
+  // Attributes decoders whose attributes are decoded with the base.
+  std::vector<bool> decoded_with_base_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_DECODED_BASE_H_
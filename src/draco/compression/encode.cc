@@ -15,6 +15,8 @@
 #include "draco/compression/encode.h"
 
 #include "draco/compression/expert_encode.h"
+#include "draco/compression/mesh/chunked_mesh_encoder.h"
+#include "draco/compression/mesh/progressive_mesh_encoder.h"
 
 namespace draco {
 
@@ -36,6 +38,23 @@ Status Encoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer) {
   return OkStatus();
 }
 
+Status Encoder::EncodeMeshToChunkedBuffer(const Mesh &m, int num_chunks,
+                                          int num_threads,
+                                          EncoderBuffer *out_buffer) {
+  ChunkedMeshEncoder encoder;
+  encoder.SetNumChunks(num_chunks);
+  encoder.SetNumThreads(num_threads);
+  return encoder.EncodeToBuffer(m, CreateExpertEncoderOptions(m), out_buffer);
+}
+
+Status Encoder::EncodeMeshToProgressiveBuffer(const Mesh &m,
+                                              float base_point_ratio,
+                                              EncoderBuffer *out_buffer) {
+  ProgressiveMeshEncoder encoder;
+  encoder.SetBasePointRatio(base_point_ratio);
+  return encoder.EncodeToBuffer(m, CreateExpertEncoderOptions(m), out_buffer);
+}
+
 EncoderOptions Encoder::CreateExpertEncoderOptions(const PointCloud &pc) const {
   EncoderOptions ret_options = EncoderOptions::CreateEmptyOptions();
   ret_options.SetGlobalOptions(options().GetGlobalOptions());
@@ -47,6 +47,21 @@ class Encoder
   // Encodes a mesh to the provided buffer.
   virtual Status EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer);
 
+  // Encodes a mesh split into |num_chunks| spatial clusters that are encoded
+  // on |num_threads| threads as independent meshes (see ChunkedMeshEncoder).
+  // The result can be decoded in parallel with
+  // Decoder::DecodeChunkedMeshFromBuffer().
+  Status EncodeMeshToChunkedBuffer(const Mesh &m, int num_chunks,
+                                   int num_threads, EncoderBuffer *out_buffer);
+
+  // Encodes a mesh as a progressive stream that starts with a coarse base
+  // mesh holding about |base_point_ratio| of the points, followed by batches
+  // of vertex splits restoring the rest of the mesh (see
+  // ProgressiveMeshEncoder). The stream is decoded while it arrives by
+  // ProgressiveMeshDecoder.
+  Status EncodeMeshToProgressiveBuffer(const Mesh &m, float base_point_ratio,
+                                       EncoderBuffer *out_buffer);
+
   // Set encoder options used during the geometry encoding. Note that this call
   // overwrites any modifications to the options done with the functions below,
   // i.e., it resets the encoder.
@@ -346,133 +346,151 @@ struct rans_sym {
 // The max number of precision bits is currently 19. The actual number of
 // symbols in the input alphabet should be (much) smaller than that, otherwise
 // the compression rate may suffer.
-template <int rans_precision_bits_t>
+//
+// The encoder can use |num_states_t| interleaved rANS states that share a
+// single output buffer. The caller selects the state of every symbol, usually
+// in a round robin fashion, and the decoder needs to use the same state for
+// the symbol. Symbols coded with different states do not depend on each other
+// during decoding. With a single state the output is the classic rANS stream.
+template <int rans_precision_bits_t, int num_states_t = 1>
 class RAnsEncoder {
  public:
-  RAnsEncoder() {}
+  RAnsEncoder() : buf_(nullptr), buf_offset_(0) {}
 
   // Provides the input buffer where the data is going to be stored.
   inline void write_init(uint8_t *const buf) {
-    ans_.buf = buf;
-    ans_.buf_offset = 0;
-    ans_.state = l_rans_base;
+    buf_ = buf;
+    buf_offset_ = 0;
+    for (int i = 0; i < num_states_t; ++i) {
+      states_[i] = l_rans_base;
+    }
   }
 
-  // Needs to be called after all symbols are encoded.
+  // Needs to be called after all symbols are encoded. The final states are
+  // stored in the reverse order so that the decoder reads the first state
+  // first.
   inline int write_end() {
-    uint32_t state;
-    DRACO_DCHECK_GE(ans_.state, l_rans_base);
-    DRACO_DCHECK_LT(ans_.state, l_rans_base * DRACO_ANS_IO_BASE);
-    state = ans_.state - l_rans_base;
-    if (state < (1 << 6)) {
-      ans_.buf[ans_.buf_offset] = (0x00 << 6) + state;
-      return ans_.buf_offset + 1;
-    } else if (state < (1 << 14)) {
-      mem_put_le16(ans_.buf + ans_.buf_offset, (0x01 << 14) + state);
-      return ans_.buf_offset + 2;
-    } else if (state < (1 << 22)) {
-      mem_put_le24(ans_.buf + ans_.buf_offset, (0x02 << 22) + state);
-      return ans_.buf_offset + 3;
-    } else if (state < (1 << 30)) {
-      mem_put_le32(ans_.buf + ans_.buf_offset, (0x03u << 30u) + state);
-      return ans_.buf_offset + 4;
-    } else {
-      DRACO_DCHECK(0 && "State is too large to be serialized");
-      return ans_.buf_offset;
+    for (int i = num_states_t - 1; i >= 0; --i) {
+      const int num_bytes = write_state(states_[i]);
+      if (num_bytes == 0) {
+        return buf_offset_;
+      }
+      buf_offset_ += num_bytes;
     }
+    return buf_offset_;
   }
 
   // rANS with normalization.
   // sym->prob takes the place of l_s from the paper.
   // rans_precision is m.
-  inline void rans_write(const struct rans_sym *const sym) {
+  inline void rans_write(const struct rans_sym *const sym,
+                         int state_id = 0) {
     const uint32_t p = sym->prob;
-    while (ans_.state >= l_rans_base / rans_precision * DRACO_ANS_IO_BASE * p) {
-      ans_.buf[ans_.buf_offset++] = ans_.state % DRACO_ANS_IO_BASE;
-      ans_.state /= DRACO_ANS_IO_BASE;
+    uint32_t state = states_[state_id];
+    while (state >= l_rans_base / rans_precision * DRACO_ANS_IO_BASE * p) {
+      buf_[buf_offset_++] = state % DRACO_ANS_IO_BASE;
+      state /= DRACO_ANS_IO_BASE;
     }
     // TODO(ostava): The division and multiplication should be optimized.
-    ans_.state =
-        (ans_.state / p) * rans_precision + ans_.state % p + sym->cum_prob;
+    states_[state_id] =
+        (state / p) * rans_precision + state % p + sym->cum_prob;
   }
 
  private:
+  // Writes |state| at the current buffer offset and returns the number of
+  // written bytes.
+  inline int write_state(uint32_t state) {
+    DRACO_DCHECK_GE(state, l_rans_base);
+    DRACO_DCHECK_LT(state, l_rans_base * DRACO_ANS_IO_BASE);
+    state -= l_rans_base;
+    if (state < (1 << 6)) {
+      buf_[buf_offset_] = (0x00 << 6) + state;
+      return 1;
+    } else if (state < (1 << 14)) {
+      mem_put_le16(buf_ + buf_offset_, (0x01 << 14) + state);
+      return 2;
+    } else if (state < (1 << 22)) {
+      mem_put_le24(buf_ + buf_offset_, (0x02 << 22) + state);
+      return 3;
+    } else if (state < (1 << 30)) {
+      mem_put_le32(buf_ + buf_offset_, (0x03u << 30u) + state);
+      return 4;
+    } else {
+      DRACO_DCHECK(0 && "State is too large to be serialized");
+      return 0;
+    }
+  }
+
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
-  AnsCoder ans_;
+  uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
 };
 
 struct rans_dec_sym {
   uint32_t val;
   uint32_t prob;
-  uint32_t cum_prob;  // not-inclusive.
+  uint32_t bias;  // Offset of the decoded slot from the cumulative probability.
 };
 
 // Class for performing rANS decoding using a desired number of precision bits.
-// The number of precision bits needs to be the same as with the RAnsEncoder
-// that was used to encode the input data.
-template <int rans_precision_bits_t>
+// The number of precision bits and the number of interleaved states need to be
+// the same as with the RAnsEncoder that was used to encode the input data.
+template <int rans_precision_bits_t, int num_states_t = 1>
 class RAnsDecoder {
  public:
-  RAnsDecoder() {}
+  RAnsDecoder() : buf_(nullptr), buf_offset_(0) {}
 
   // Initializes the decoder from the input buffer. The |offset| specifies the
   // number of bytes encoded by the encoder. A non zero return value is an
   // error.
   inline int read_init(const uint8_t *const buf, int offset) {
-    unsigned x;
-    if (offset < 1) {
-      return 1;
-    }
-    ans_.buf = buf;
-    x = buf[offset - 1] >> 6;
-    if (x == 0) {
-      ans_.buf_offset = offset - 1;
-      ans_.state = buf[offset - 1] & 0x3F;
-    } else if (x == 1) {
-      if (offset < 2) {
+    buf_ = buf;
+    buf_offset_ = offset;
+    for (int i = 0; i < num_states_t; ++i) {
+      if (read_state(&states_[i]) != 0) {
         return 1;
       }
-      ans_.buf_offset = offset - 2;
-      ans_.state = mem_get_le16(buf + offset - 2) & 0x3FFF;
-    } else if (x == 2) {
-      if (offset < 3) {
-        return 1;
-      }
-      ans_.buf_offset = offset - 3;
-      ans_.state = mem_get_le24(buf + offset - 3) & 0x3FFFFF;
-    } else if (x == 3) {
-      ans_.buf_offset = offset - 4;
-      ans_.state = mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
-    } else {
-      return 1;
-    }
-    ans_.state += l_rans_base;
-    if (ans_.state >= l_rans_base * DRACO_ANS_IO_BASE) {
-      return 1;
     }
     return 0;
   }
 
-  inline int read_end() { return ans_.state == l_rans_base; }
+  inline int read_end() {
+    for (int i = 0; i < num_states_t; ++i) {
+      if (states_[i] != l_rans_base) {
+        return 0;
+      }
+    }
+    return 1;
+  }
 
   inline int reader_has_error() {
-    return ans_.state < l_rans_base && ans_.buf_offset == 0;
+    if (buf_offset_ != 0) {
+      return 0;
+    }
+    for (int i = 0; i < num_states_t; ++i) {
+      if (states_[i] < l_rans_base) {
+        return 1;
+      }
+    }
+    return 0;
   }
 
-  inline int rans_read() {
+  inline int rans_read(int state_id = 0) {
     unsigned rem;
     unsigned quo;
     struct rans_dec_sym sym;
-    while (ans_.state < l_rans_base && ans_.buf_offset > 0) {
-      ans_.state = ans_.state * DRACO_ANS_IO_BASE + ans_.buf[--ans_.buf_offset];
+    uint32_t state = states_[state_id];
+    while (state < l_rans_base && buf_offset_ > 0) {
+      state = state * DRACO_ANS_IO_BASE + buf_[--buf_offset_];
     }
     // |rans_precision| is a power of two compile time constant, and the below
     // division and modulo are going to be optimized by the compiler.
-    quo = ans_.state / rans_precision;
-    rem = ans_.state % rans_precision;
+    quo = state / rans_precision;
+    rem = state % rans_precision;
     fetch_sym(&sym, rem);
-    ans_.state = quo * sym.prob + rem - sym.cum_prob;
+    states_[state_id] = quo * sym.prob + sym.bias;
     return sym.val;
   }
 
@@ -480,41 +498,168 @@ class RAnsDecoder {
   // Returns false if the table couldn't be built (because of wrong input data).
   inline bool rans_build_look_up_table(const uint32_t token_probs[],
                                        uint32_t num_symbols) {
-    lut_table_.resize(rans_precision);
-    probability_table_.resize(num_symbols);
+    lut_table_.clear();
+    prob_table_.clear();
+    symbol_table_.clear();
+    bucket_table_.clear();
+    if (kUseBuckets) {
+      bucket_table_.resize(kNumBuckets + 1);
+    } else {
+      lut_table_.resize(rans_precision);
+      prob_table_.resize(num_symbols);
+    }
     uint32_t cum_prob = 0;
-    uint32_t act_prob = 0;
     for (uint32_t i = 0; i < num_symbols; ++i) {
-      probability_table_[i].prob = token_probs[i];
-      probability_table_[i].cum_prob = cum_prob;
-      cum_prob += token_probs[i];
-      if (cum_prob > rans_precision) {
+      const uint32_t prob = token_probs[i];
+      if (prob == 0) {
+        continue;
+      }
+      if (prob > rans_precision - cum_prob) {
         return false;
       }
-      for (uint32_t j = act_prob; j < cum_prob; ++j) {
-        lut_table_[j] = i;
+      if (kUseBuckets) {
+        if (i > kMaxLutSymbol) {
+          return false;
+        }
+        // The symbol is the first candidate of all buckets starting within its
+        // slots.
+        const uint32_t index = static_cast<uint32_t>(symbol_table_.size());
+        for (uint32_t bucket = (cum_prob + kBucketSize - 1) >> kBucketShift;
+             (bucket << kBucketShift) < cum_prob + prob; ++bucket) {
+          bucket_table_[bucket] = index;
+        }
+        symbol_table_.push_back(
+            (static_cast<uint64_t>(i) << kLutSymbolShift) |
+            (static_cast<uint64_t>(prob - 1) << kLutProbShift) | cum_prob);
+      } else {
+        if (i > kMaxSlotSymbol) {
+          return false;
+        }
+        prob_table_[i] = prob;
+        for (uint32_t j = 0; j < prob; ++j) {
+          lut_table_[cum_prob + j] = (i << kSlotSymbolShift) | j;
+        }
       }
-      act_prob = cum_prob;
+      cum_prob += prob;
     }
     if (cum_prob != rans_precision) {
       return false;
     }
+    if (kUseBuckets) {
+      bucket_table_[kNumBuckets] =
+          static_cast<uint32_t>(symbol_table_.size()) - 1;
+    }
     return true;
   }
 
  private:
+  // Reads a state stored in front of the current buffer offset. A non zero
+  // return value is an error.
+  inline int read_state(uint32_t *state) {
+    const int offset = buf_offset_;
+    if (offset < 1) {
+      return 1;
+    }
+    const unsigned x = buf_[offset - 1] >> 6;
+    if (x == 0) {
+      buf_offset_ = offset - 1;
+      *state = buf_[offset - 1] & 0x3F;
+    } else if (x == 1) {
+      if (offset < 2) {
+        return 1;
+      }
+      buf_offset_ = offset - 2;
+      *state = mem_get_le16(buf_ + offset - 2) & 0x3FFF;
+    } else if (x == 2) {
+      if (offset < 3) {
+        return 1;
+      }
+      buf_offset_ = offset - 3;
+      *state = mem_get_le24(buf_ + offset - 3) & 0x3FFFFF;
+    } else if (x == 3) {
+      if (offset < 4) {
+        return 1;
+      }
+      buf_offset_ = offset - 4;
+      *state = mem_get_le32(buf_ + offset - 4) & 0x3FFFFFFF;
+    } else {
+      return 1;
+    }
+    *state += l_rans_base;
+    if (*state >= l_rans_base * DRACO_ANS_IO_BASE) {
+      return 1;
+    }
+    return 0;
+  }
+
   inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) {
-    uint32_t symbol = lut_table_[rem];
-    out->val = symbol;
-    out->prob = probability_table_[symbol].prob;
-    out->cum_prob = probability_table_[symbol].cum_prob;
+    if (kUseBuckets) {
+      // The symbol of |rem| is the last candidate of the bucket whose slots
+      // start at or before |rem|. All candidates are between the first ones of
+      // this and the next bucket.
+      const uint32_t bucket = rem >> kBucketShift;
+      uint32_t first = bucket_table_[bucket];
+      uint32_t last = bucket_table_[bucket + 1];
+      while (first < last) {
+        const uint32_t mid = (first + last + 1) / 2;
+        if ((symbol_table_[mid] & kLutMask) <= rem) {
+          first = mid;
+        } else {
+          last = mid - 1;
+        }
+      }
+      const uint64_t entry = symbol_table_[first];
+      out->val = static_cast<uint32_t>(entry >> kLutSymbolShift);
+      out->prob =
+          static_cast<uint32_t>((entry >> kLutProbShift) & kLutMask) + 1;
+      out->bias = rem - static_cast<uint32_t>(entry & kLutMask);
+    } else {
+      const uint32_t entry = lut_table_[rem];
+      out->val = entry >> kSlotSymbolShift;
+      out->prob = prob_table_[out->val];
+      out->bias = entry & kSlotOffsetMask;
+    }
   }
 
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
+
+  // With precisions up to 16 bits there is one 32-bit entry for every slot in
+  // |lut_table_|. It holds the symbol in the upper 16 bits and the offset of
+  // the slot within the slots of the symbol in the lower 16 bits. The
+  // probability of the symbol is stored in |prob_table_|, which is small
+  // enough to stay in the cache.
+  static constexpr bool kUseBuckets = rans_precision_bits_t > 16;
+  static constexpr int kSlotSymbolShift = 16;
+  static constexpr uint32_t kSlotOffsetMask = (1 << kSlotSymbolShift) - 1;
+  static constexpr uint32_t kMaxSlotSymbol =
+      (1 << (32 - kSlotSymbolShift)) - 1;
+
+  // Higher precisions would need a table that does not fit into the cache, so
+  // there is one 64-bit entry per symbol in |symbol_table_| and the slots are
+  // grouped into buckets. From the least significant bit, every entry holds
+  // the cumulative probability of the symbol, its probability minus one and
+  // the symbol itself. |bucket_table_| stores the first symbol of every bucket
+  // and the symbol is found by a binary search within the bucket.
+  static_assert(rans_precision_bits_t <= 20,
+                "Unsupported rANS precision for the packed look up table.");
+  static constexpr int kLutProbShift = 20;
+  static constexpr int kLutSymbolShift = 40;
+  static constexpr uint64_t kLutMask = (1 << kLutProbShift) - 1;
+  static constexpr uint32_t kMaxLutSymbol = (1 << (64 - kLutSymbolShift)) - 1;
+  static constexpr int kBucketBits = 16;
+  static constexpr int kNumBuckets = 1 << kBucketBits;
+  static constexpr int kBucketShift =
+      kUseBuckets ? rans_precision_bits_t - kBucketBits : 0;
+  static constexpr uint32_t kBucketSize = 1 << kBucketShift;
+
   std::vector<uint32_t> lut_table_;
-  std::vector<rans_sym> probability_table_;
-  AnsDecoder ans_;
+  std::vector<uint32_t> prob_table_;
+  std::vector<uint64_t> symbol_table_;
+  std::vector<uint32_t> bucket_table_;
+  const uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
 };
 
 #undef DRACO_ANS_DIVREM
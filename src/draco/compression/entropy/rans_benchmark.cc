@@ -0,0 +1,219 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Microbenchmark of RAnsDecoder::rans_read() with the packed look up table
+// compared to the decoder that looked up the symbol and its probability in two
+// separate tables. The benchmark runs for all precisions used by
+// RAnsSymbolDecoder for the given alphabet sizes.
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "draco/compression/entropy/ans.h"
+#include "draco/compression/entropy/rans_symbol_coding.h"
+#include "draco/core/cycle_timer.h"
+
+namespace {
+
+// Decodes symbols the same way as RAnsDecoder did before the look up table was
+// packed.
+template <int rans_precision_bits_t>
+class TwoTableRAnsDecoder {
+ public:
+  bool rans_build_look_up_table(const uint32_t token_probs[],
+                                uint32_t num_symbols) {
+    lut_table_.resize(rans_precision);
+    probability_table_.resize(num_symbols);
+    uint32_t cum_prob = 0;
+    uint32_t act_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      probability_table_[i].prob = token_probs[i];
+      probability_table_[i].cum_prob = cum_prob;
+      cum_prob += token_probs[i];
+      if (cum_prob > rans_precision) {
+        return false;
+      }
+      for (uint32_t j = act_prob; j < cum_prob; ++j) {
+        lut_table_[j] = i;
+      }
+      act_prob = cum_prob;
+    }
+    return cum_prob == rans_precision;
+  }
+
+  bool read_init(const uint8_t *buf, int offset) {
+    if (offset < 1) {
+      return false;
+    }
+    buf_ = buf;
+    const unsigned x = buf[offset - 1] >> 6;
+    if (x == 0) {
+      buf_offset_ = offset - 1;
+      state_ = buf[offset - 1] & 0x3F;
+    } else if (x == 1 && offset >= 2) {
+      buf_offset_ = offset - 2;
+      state_ = draco::mem_get_le16(buf + offset - 2) & 0x3FFF;
+    } else if (x == 2 && offset >= 3) {
+      buf_offset_ = offset - 3;
+      state_ = draco::mem_get_le24(buf + offset - 3) & 0x3FFFFF;
+    } else if (x == 3 && offset >= 4) {
+      buf_offset_ = offset - 4;
+      state_ = draco::mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
+    } else {
+      return false;
+    }
+    state_ += l_rans_base;
+    return true;
+  }
+
+  int rans_read() {
+    while (state_ < l_rans_base && buf_offset_ > 0) {
+      state_ = state_ * kIoBase + buf_[--buf_offset_];
+    }
+    const uint32_t quo = state_ / rans_precision;
+    const uint32_t rem = state_ % rans_precision;
+    const uint32_t symbol = lut_table_[rem];
+    const draco::rans_sym &sym = probability_table_[symbol];
+    state_ = quo * sym.prob + rem - sym.cum_prob;
+    return symbol;
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  static constexpr int l_rans_base = rans_precision * 4;
+  // Same as DRACO_ANS_IO_BASE that is not exported by ans.h.
+  static constexpr int kIoBase = 256;
+  std::vector<uint32_t> lut_table_;
+  std::vector<draco::rans_sym> probability_table_;
+  const uint8_t *buf_ = nullptr;
+  int buf_offset_ = 0;
+  uint32_t state_ = 0;
+};
+
+// Encodes |num_values| symbols from an alphabet of 2^|unique_symbols_bit_length|
+// symbols with Zipf-like distribution and measures the decoding time.
+template <int unique_symbols_bit_length>
+bool RunBenchmark(int num_iterations, int num_values) {
+  constexpr int precision_bits =
+      draco::ComputeRAnsPrecisionFromUniqueSymbolsBitLength(
+          unique_symbols_bit_length);
+  constexpr uint32_t precision = 1 << precision_bits;
+  const uint32_t num_symbols = 1 << unique_symbols_bit_length;
+
+  // Every symbol gets at least one slot and the rest is distributed according
+  // to the weights 1 / (i + 1).
+  double total_weight = 0.0;
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    total_weight += 1.0 / (i + 1);
+  }
+  std::vector<uint32_t> probs(num_symbols, 1);
+  uint32_t cum_prob = num_symbols;
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    const uint32_t extra = static_cast<uint32_t>(
+        (precision - num_symbols) / (total_weight * (i + 1)));
+    probs[i] += extra;
+    cum_prob += extra;
+  }
+  probs[0] += precision - cum_prob;
+  std::vector<draco::rans_sym> syms(num_symbols);
+  std::vector<uint32_t> slot_symbols(precision);
+  cum_prob = 0;
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    syms[i].prob = probs[i];
+    syms[i].cum_prob = cum_prob;
+    for (uint32_t j = 0; j < probs[i]; ++j) {
+      slot_symbols[cum_prob + j] = i;
+    }
+    cum_prob += probs[i];
+  }
+
+  std::vector<uint32_t> values(num_values);
+  uint32_t seed = 1;
+  for (int i = 0; i < num_values; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    values[i] = slot_symbols[seed >> (32 - precision_bits)];
+  }
+  std::vector<uint8_t> data(4 * static_cast<size_t>(num_values) + 16);
+  draco::RAnsEncoder<precision_bits> encoder;
+  encoder.write_init(data.data());
+  for (int i = num_values - 1; i >= 0; --i) {
+    encoder.rans_write(&syms[values[i]]);
+  }
+  const int num_bytes = encoder.write_end();
+
+  draco::CycleTimer timer;
+  uint32_t reference_sum = 0;
+  TwoTableRAnsDecoder<precision_bits> reference_decoder;
+  if (!reference_decoder.rans_build_look_up_table(probs.data(), num_symbols)) {
+    return false;
+  }
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    if (!reference_decoder.read_init(data.data(), num_bytes)) {
+      return false;
+    }
+    for (int i = 0; i < num_values; ++i) {
+      reference_sum += reference_decoder.rans_read();
+    }
+  }
+  timer.Stop();
+  const int64_t reference_ms = timer.GetInMs();
+
+  uint32_t sum = 0;
+  draco::RAnsDecoder<precision_bits> decoder;
+  if (!decoder.rans_build_look_up_table(probs.data(), num_symbols)) {
+    return false;
+  }
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    if (decoder.read_init(data.data(), num_bytes) != 0) {
+      return false;
+    }
+    for (int i = 0; i < num_values; ++i) {
+      sum += decoder.rans_read();
+    }
+  }
+  timer.Stop();
+  const int64_t ms = timer.GetInMs();
+
+  if (sum != reference_sum) {
+    printf("Decoded values do not match.\n");
+    return false;
+  }
+  printf("%2d-bit alphabet, %2d-bit precision: two tables %5" PRId64
+         " ms, packed %5" PRId64 " ms\n",
+         unique_symbols_bit_length, precision_bits, reference_ms, ms);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_iterations = 10;
+  if (argc > 1) {
+    num_iterations = atoi(argv[1]);
+  }
+  const int num_values = 1 << 22;
+  printf("Decoded %d symbols %d times.\n", num_values, num_iterations);
+  if (!RunBenchmark<8>(num_iterations, num_values) ||
+      !RunBenchmark<10>(num_iterations, num_values) ||
+      !RunBenchmark<12>(num_iterations, num_values) ||
+      !RunBenchmark<13>(num_iterations, num_values) ||
+      !RunBenchmark<14>(num_iterations, num_values) ||
+      !RunBenchmark<18>(num_iterations, num_values)) {
+    return -1;
+  }
+  return 0;
+}
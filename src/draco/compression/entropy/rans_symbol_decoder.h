@@ -25,9 +25,9 @@ namespace draco {
 
 // A helper class for decoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to decode the probability table and the data encoded
-// by the RAnsSymbolEncoder. |unique_symbols_bit_length_t| must be the same as
-// the one used for the corresponding RAnsSymbolEncoder.
-template <int unique_symbols_bit_length_t>
+// by the RAnsSymbolEncoder. |unique_symbols_bit_length_t| and |num_states_t|
+// must be the same as the ones used for the corresponding RAnsSymbolEncoder.
+template <int unique_symbols_bit_length_t, int num_states_t = 1>
 class RAnsSymbolDecoder {
  public:
   RAnsSymbolDecoder() : num_symbols_(0) {}
@@ -36,11 +36,13 @@ class RAnsSymbolDecoder {
   bool Create(DecoderBuffer *buffer);
 
   uint32_t num_symbols() const { return num_symbols_; }
+  static constexpr int num_states() { return num_states_t; }
 
   // Starts decoding from the buffer. The buffer will be advanced past the
   // encoded data after this call.
   bool StartDecoding(DecoderBuffer *buffer);
-  uint32_t DecodeSymbol() { return ans_.rans_read(); }
+  // Decodes a symbol using the interleaved state |state_id|.
+  uint32_t DecodeSymbol(int state_id = 0) { return ans_.rans_read(state_id); }
   void EndDecoding();
 
  private:
@@ -51,11 +53,11 @@ class RAnsSymbolDecoder {
 
   std::vector<uint32_t> probability_table_;
   uint32_t num_symbols_;
-  RAnsDecoder<rans_precision_bits_> ans_;
+  RAnsDecoder<rans_precision_bits_, num_states_t> ans_;
 };
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoder<unique_symbols_bit_length_t, num_states_t>::Create(
     DecoderBuffer *buffer) {
   // Check that the DecoderBuffer version is set.
   if (buffer->bitstream_version() == 0) {
@@ -123,9 +125,9 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
-    DecoderBuffer *buffer) {
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoder<unique_symbols_bit_length_t,
+                       num_states_t>::StartDecoding(DecoderBuffer *buffer) {
   uint64_t bytes_encoded;
   // Decode the number of bytes encoded by the encoder.
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -141,7 +143,7 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
       return false;
     }
   }
-  if (bytes_encoded > static_cast<uint64_t>(buffer->remaining_size())) {
+  if (!buffer->CheckRemainingSize(bytes_encoded)) {
     return false;
   }
   const uint8_t *const data_head =
@@ -154,8 +156,9 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolDecoder<unique_symbols_bit_length_t>::EndDecoding() {
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolDecoder<unique_symbols_bit_length_t,
+                       num_states_t>::EndDecoding() {
   ans_.read_end();
 }
 
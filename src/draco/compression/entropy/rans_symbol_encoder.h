@@ -29,7 +29,8 @@ namespace draco {
 // A helper class for encoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to initialize and encode probability table needed by
 // rANS, and to perform encoding of symbols into the provided EncoderBuffer.
-template <int unique_symbols_bit_length_t>
+// Symbols can be distributed between |num_states_t| interleaved rANS states.
+template <int unique_symbols_bit_length_t, int num_states_t = 1>
 class RAnsSymbolEncoder {
  public:
   RAnsSymbolEncoder()
@@ -41,13 +42,15 @@ class RAnsSymbolEncoder {
               EncoderBuffer *buffer);
 
   void StartEncoding(EncoderBuffer *buffer);
-  void EncodeSymbol(uint32_t symbol) {
-    ans_.rans_write(&probability_table_[symbol]);
+  // Encodes |symbol| using the interleaved state |state_id|.
+  void EncodeSymbol(uint32_t symbol, int state_id = 0) {
+    ans_.rans_write(&probability_table_[symbol], state_id);
   }
   void EndEncoding(EncoderBuffer *buffer);
 
   // rANS requires to encode the input symbols in the reverse order.
   static constexpr bool needs_reverse_encoding() { return true; }
+  static constexpr int num_states() { return num_states_t; }
 
  private:
   // Functor used for sorting symbol ids according to their probabilities.
@@ -78,13 +81,13 @@ class RAnsSymbolEncoder {
   // Expected number of bits that is needed to encode the input.
   uint64_t num_expected_bits_;
 
-  RAnsEncoder<rans_precision_bits_> ans_;
+  RAnsEncoder<rans_precision_bits_, num_states_t> ans_;
   // Initial offset of the encoder buffer before any ans data was encoded.
   uint64_t buffer_offset_;
 };
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::Create(
     const uint64_t *frequencies, int num_symbols, EncoderBuffer *buffer) {
   // Compute the total of the input frequencies.
   uint64_t total_freq = 0;
@@ -202,8 +205,8 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::EncodeTable(
     EncoderBuffer *buffer) {
   EncodeVarint(num_symbols_, buffer);
   // Use varint encoding for the probabilities (first two bits represent the
@@ -250,11 +253,11 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
-    EncoderBuffer *buffer) {
-  // Allocate extra storage just in case.
-  const uint64_t required_bits = 2 * num_expected_bits_ + 32;
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoder<unique_symbols_bit_length_t,
+                       num_states_t>::StartEncoding(EncoderBuffer *buffer) {
+  // Allocate extra storage just in case. Every state needs up to 32 bits.
+  const uint64_t required_bits = 2 * num_expected_bits_ + 32 * num_states_t;
 
   buffer_offset_ = buffer->size();
   const int64_t required_bytes = (required_bits + 7) / 8;
@@ -264,8 +267,8 @@ void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
   ans_.write_init(data + buffer_offset_);
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::EndEncoding(
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::EndEncoding(
     EncoderBuffer *buffer) {
   char *const src = const_cast<char *>(buffer->data()) + buffer_offset_;
 
@@ -158,6 +158,102 @@ TEST_F(SymbolCodingTest, TestLargeNumberCondition) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestLargeAlphabet) {
+  // This test verifies that large alphabets are decoded correctly with all
+  // rANS precisions selected by the compression level, including those where
+  // the decoder looks up symbols by buckets of slots.
+  std::vector<uint32_t> in(50000);
+  uint32_t seed = 7;
+  for (uint32_t i = 0; i < in.size(); ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    // Mostly small values with a long tail of rare values.
+    in[i] = (seed >> 8) % ((seed >> 28) == 0 ? 12000 : 64);
+  }
+  for (int level = 0; level <= 10; ++level) {
+    Options options;
+    SetSymbolEncodingMethod(&options, SYMBOL_CODING_RAW);
+    ASSERT_TRUE(SetSymbolEncodingCompressionLevel(&options, level));
+    EncoderBuffer eb;
+    ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+
+    std::vector<uint32_t> out(in.size());
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(in.size(), 1, &db, &out[0]));
+    ASSERT_EQ(in, out);
+  }
+}
+
+TEST_F(SymbolCodingTest, TestInterleavedStates) {
+  // This test verifies that symbols distributed between multiple interleaved
+  // rANS states are decoded correctly, including the values of the last
+  // incomplete group of states.
+  std::vector<uint32_t> in(10007);
+  uint32_t seed = 1;
+  for (uint32_t i = 0; i < in.size(); ++i) {
+    seed = seed * 1103515245 + 12345;
+    // Skewed distribution of small values, so that the raw scheme is used.
+    in[i] = ((seed >> 16) % 64) * ((seed >> 24) % 4) / 4;
+  }
+  for (int num_states : {4, 8}) {
+    Options options;
+    ASSERT_TRUE(SetSymbolEncodingInterleavedStates(&options, num_states));
+    EncoderBuffer eb;
+    ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+    ASSERT_EQ(eb.data()[0], SYMBOL_CODING_RAW_INTERLEAVED);
+    ASSERT_EQ(eb.data()[1], num_states);
+
+    std::vector<uint32_t> out(in.size());
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(in.size(), 1, &db, &out[0]));
+    ASSERT_EQ(in, out);
+  }
+
+  // Short inputs are not interleaved.
+  Options options;
+  ASSERT_TRUE(SetSymbolEncodingInterleavedStates(&options, 8));
+  EncoderBuffer eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), 100, 1, &options, &eb));
+  ASSERT_NE(eb.data()[0], SYMBOL_CODING_RAW_INTERLEAVED);
+  ASSERT_FALSE(SetSymbolEncodingInterleavedStates(&options, 3));
+}
+
+TEST_F(SymbolCodingTest, TestTaggedRuns) {
+  // Tests tagged symbols with short and long runs of entries with the same bit
+  // length, including runs that span multiple blocks of decoded tags.
+  for (const int num_components : {1, 3}) {
+    std::vector<uint32_t> in;
+    uint32_t seed = 1;
+    for (int run_length : {1, 2, 3, 5, 300, 1, 700, 4}) {
+      for (int bit_length = 1; bit_length <= 32; bit_length += 7) {
+        for (int i = 0; i < run_length * num_components; ++i) {
+          seed = seed * 1664525u + 1013904223u;
+          // The first component of each entry sets the bit length.
+          const uint32_t msb =
+              i % num_components == 0 ? 1u << (bit_length - 1) : 0;
+          in.push_back(msb | (seed >> (32 - bit_length)));
+        }
+      }
+    }
+    Options options;
+    SetSymbolEncodingMethod(&options, SYMBOL_CODING_TAGGED);
+    EncoderBuffer eb;
+    ASSERT_TRUE(
+        EncodeSymbols(in.data(), in.size(), num_components, &options, &eb));
+    ASSERT_EQ(eb.data()[0], SYMBOL_CODING_TAGGED);
+
+    std::vector<uint32_t> out(in.size());
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(in.size(), num_components, &db, &out[0]));
+    ASSERT_EQ(in, out);
+  }
+}
+
 TEST_F(SymbolCodingTest, TestConversionFullRange) {
   TestConvertToSymbolAndBack(static_cast<int8_t>(-128));
   TestConvertToSymbolAndBack(static_cast<int8_t>(-127));
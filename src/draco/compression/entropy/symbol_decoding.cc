@@ -16,16 +16,21 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "draco/compression/entropy/rans_symbol_decoder.h"
 
 namespace draco {
 
-template <template <int> class SymbolDecoderT>
+// Runs of tagged values shorter than this are decoded one value at a time,
+// which is faster than DecodeLeastSignificantBitsBulk() for them.
+constexpr uint32_t kMinBulkDecodedValues = 8;
+
+template <template <int, int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
                          DecoderBuffer *src_buffer, uint32_t *out_values);
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT, int num_states_t>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values);
 
@@ -43,17 +48,30 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
     return DecodeTaggedSymbols<RAnsSymbolDecoder>(num_values, num_components,
                                                   src_buffer, out_values);
   } else if (scheme == SYMBOL_CODING_RAW) {
-    return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
-                                               out_values);
+    return DecodeRawSymbols<RAnsSymbolDecoder, 1>(num_values, src_buffer,
+                                                  out_values);
+  } else if (scheme == SYMBOL_CODING_RAW_INTERLEAVED) {
+    uint8_t num_states;
+    if (!src_buffer->Decode(&num_states)) {
+      return false;
+    }
+    if (num_states == 4) {
+      return DecodeRawSymbols<RAnsSymbolDecoder, 4>(num_values, src_buffer,
+                                                    out_values);
+    }
+    if (num_states == 8) {
+      return DecodeRawSymbols<RAnsSymbolDecoder, 8>(num_values, src_buffer,
+                                                    out_values);
+    }
   }
   return false;
 }
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
                          DecoderBuffer *src_buffer, uint32_t *out_values) {
   // Decode the encoded data.
-  SymbolDecoderT<5> tag_decoder;
+  SymbolDecoderT<5, 1> tag_decoder;
   if (!tag_decoder.Create(src_buffer)) {
     return false;
   }
@@ -69,17 +87,40 @@ bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
   // src_buffer now points behind the encoded tag data (to the place where the
   // values are encoded).
   src_buffer->StartBitDecoding(false, nullptr);
-  int value_id = 0;
-  for (uint32_t i = 0; i < num_values; i += num_components) {
-    // Decode the tag.
-    const int bit_length = tag_decoder.DecodeSymbol();
-    // Decode the actual value.
-    for (int j = 0; j < num_components; ++j) {
-      uint32_t val;
-      if (!src_buffer->DecodeLeastSignificantBits32(bit_length, &val)) {
+  // The tags are stored separately from the values. Tags are decoded in
+  // blocks so that the values of runs of entries with the same bit length can
+  // be unpacked together.
+  constexpr uint32_t kNumTagsPerBlock = 256;
+  uint8_t bit_lengths[kNumTagsPerBlock];
+  const uint32_t num_entries = (num_values + num_components - 1) /
+                               static_cast<uint32_t>(num_components);
+  uint32_t *out_value = out_values;
+  for (uint32_t first = 0; first < num_entries; first += kNumTagsPerBlock) {
+    const uint32_t num_tags = std::min(kNumTagsPerBlock, num_entries - first);
+    for (uint32_t i = 0; i < num_tags; ++i) {
+      bit_lengths[i] = static_cast<uint8_t>(tag_decoder.DecodeSymbol());
+    }
+    for (uint32_t i = 0; i < num_tags;) {
+      // All components of all entries in the run share the same bit length.
+      const int bit_length = bit_lengths[i];
+      uint32_t run_end = i + 1;
+      while (run_end < num_tags && bit_lengths[run_end] == bit_length) {
+        ++run_end;
+      }
+      const uint32_t num_run_values = (run_end - i) * num_components;
+      if (num_run_values < kMinBulkDecodedValues) {
+        for (uint32_t j = 0; j < num_run_values; ++j) {
+          if (!src_buffer->DecodeLeastSignificantBits32(bit_length,
+                                                        out_value + j)) {
+            return false;
+          }
+        }
+      } else if (!src_buffer->DecodeLeastSignificantBitsBulk(
+                     bit_length, out_value, num_run_values)) {
         return false;
       }
-      out_values[value_id++] = val;
+      out_value += num_run_values;
+      i = run_end;
     }
   }
   tag_decoder.EndDecoding();
@@ -102,16 +143,25 @@ bool DecodeRawSymbolsInternal(uint32_t num_values, DecoderBuffer *src_buffer,
   if (!decoder.StartDecoding(src_buffer)) {
     return false;
   }
-  for (uint32_t i = 0; i < num_values; ++i) {
-    // Decode a symbol into the value.
-    const uint32_t value = decoder.DecodeSymbol();
-    out_values[i] = value;
+  // Value |i| is decoded by the interleaved state i % num_states. Full groups
+  // of values are decoded with a fixed sequence of states, which lets the
+  // compiler overlap the independent state updates.
+  constexpr int num_states = SymbolDecoderT::num_states();
+  uint32_t i = 0;
+  for (; i + num_states <= num_values; i += num_states) {
+    for (int state_id = 0; state_id < num_states; ++state_id) {
+      // Decode a symbol into the value.
+      out_values[i + state_id] = decoder.DecodeSymbol(state_id);
+    }
+  }
+  for (int state_id = 0; i < num_values; ++i, ++state_id) {
+    out_values[i] = decoder.DecodeSymbol(state_id);
   }
   decoder.EndDecoding();
   return true;
 }
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT, int num_states_t>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values) {
   uint8_t max_bit_length;
@@ -120,58 +170,58 @@ bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
   }
   switch (max_bit_length) {
     case 1:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<1>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<1, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 2:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<2>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<2, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 3:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<3>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<3, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 4:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<4>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<4, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 5:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<5>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<5, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 6:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<6>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<6, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 7:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<7>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<7, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 8:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<8>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<8, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 9:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<9>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<9, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 10:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<10>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<10, num_states_t>>(
           num_values, src_buffer, out_values);
     case 11:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<11>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<11, num_states_t>>(
           num_values, src_buffer, out_values);
     case 12:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<12>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<12, num_states_t>>(
           num_values, src_buffer, out_values);
     case 13:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<13>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<13, num_states_t>>(
           num_values, src_buffer, out_values);
     case 14:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<14>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<14, num_states_t>>(
           num_values, src_buffer, out_values);
     case 15:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<15>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<15, num_states_t>>(
           num_values, src_buffer, out_values);
     case 16:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<16>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<16, num_states_t>>(
           num_values, src_buffer, out_values);
     case 17:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<17>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<17, num_states_t>>(
           num_values, src_buffer, out_values);
     case 18:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<18>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<18, num_states_t>>(
           num_values, src_buffer, out_values);
     default:
       return false;
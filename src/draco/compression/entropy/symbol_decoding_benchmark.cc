@@ -0,0 +1,154 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Microbenchmark of DecodeSymbols() for symbols encoded with the tagged
+// scheme compared to a decoder that unpacks the components of every entry
+// separately. Entries are either drawn with similar magnitudes, which produces
+// long runs of entries with the same bit length, or with random magnitudes.
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/entropy/rans_symbol_decoder.h"
+#include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/options.h"
+
+namespace {
+
+// Decodes tagged symbols the same way as DecodeTaggedSymbols() did before the
+// entries were decoded in runs.
+bool DecodeTaggedSymbolsPerEntry(uint32_t num_values, int num_components,
+                                 draco::DecoderBuffer *src_buffer,
+                                 uint32_t *out_values) {
+  uint8_t scheme;
+  if (!src_buffer->Decode(&scheme) || scheme != draco::SYMBOL_CODING_TAGGED) {
+    return false;
+  }
+  draco::RAnsSymbolDecoder<5, 1> tag_decoder;
+  if (!tag_decoder.Create(src_buffer) ||
+      !tag_decoder.StartDecoding(src_buffer)) {
+    return false;
+  }
+  src_buffer->StartBitDecoding(false, nullptr);
+  int value_id = 0;
+  for (uint32_t i = 0; i < num_values; i += num_components) {
+    const int bit_length = tag_decoder.DecodeSymbol();
+    if (!src_buffer->DecodeLeastSignificantBitsBulk(
+            bit_length, out_values + value_id, num_components)) {
+      return false;
+    }
+    value_id += num_components;
+  }
+  tag_decoder.EndDecoding();
+  src_buffer->EndBitDecoding();
+  return true;
+}
+
+// Encodes |num_entries| entries of |num_components| values with the tagged
+// scheme and measures the decoding time. Entries have either a random bit
+// length or, when |similar_magnitudes| is set, mostly 12 bits.
+bool RunBenchmark(int num_iterations, int num_entries, int num_components,
+                  bool similar_magnitudes) {
+  const uint32_t num_values = num_entries * num_components;
+  std::vector<uint32_t> values(num_values);
+  uint32_t seed = 1;
+  const auto random = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return seed;
+  };
+  for (int i = 0; i < num_entries; ++i) {
+    const int bit_length = similar_magnitudes ? 12 : 1 + (random() >> 8) % 20;
+    for (int c = 0; c < num_components; ++c) {
+      values[i * num_components + c] =
+          (random() >> 8) & ((1u << bit_length) - 1);
+    }
+  }
+  draco::Options options;
+  draco::SetSymbolEncodingMethod(&options, draco::SYMBOL_CODING_TAGGED);
+  draco::EncoderBuffer encoder_buffer;
+  if (!draco::EncodeSymbols(values.data(), num_values, num_components,
+                            &options, &encoder_buffer)) {
+    return false;
+  }
+
+  std::vector<uint32_t> decoded_values(num_values);
+  draco::CycleTimer timer;
+  uint64_t reference_sum = 0;
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    buffer.set_bitstream_version(draco::kDracoMeshBitstreamVersion);
+    if (!DecodeTaggedSymbolsPerEntry(num_values, num_components, &buffer,
+                                     decoded_values.data())) {
+      return false;
+    }
+    reference_sum += decoded_values[it % num_values];
+  }
+  timer.Stop();
+  const int64_t reference_ms = timer.GetInMs();
+  if (decoded_values != values) {
+    printf("Reference decoder failed.\n");
+    return false;
+  }
+
+  uint64_t sum = 0;
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    buffer.set_bitstream_version(draco::kDracoMeshBitstreamVersion);
+    if (!draco::DecodeSymbols(num_values, num_components, &buffer,
+                              decoded_values.data())) {
+      return false;
+    }
+    sum += decoded_values[it % num_values];
+  }
+  timer.Stop();
+  const int64_t ms = timer.GetInMs();
+  if (decoded_values != values || sum != reference_sum) {
+    printf("Decoded values do not match.\n");
+    return false;
+  }
+  printf("%d x %d components, %s magnitudes: per entry %5" PRId64
+         " ms, runs %5" PRId64 " ms\n",
+         num_entries, num_components,
+         similar_magnitudes ? "similar" : "random ", reference_ms, ms);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_iterations = 20;
+  if (argc > 1) {
+    num_iterations = atoi(argv[1]);
+  }
+  const int num_entries = 1 << 20;
+  for (const int num_components : {1, 3}) {
+    for (const bool similar_magnitudes : {true, false}) {
+      if (!RunBenchmark(num_iterations, num_entries, num_components,
+                        similar_magnitudes)) {
+        printf("Benchmark failed.\n");
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
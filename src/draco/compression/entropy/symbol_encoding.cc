@@ -27,6 +27,9 @@ namespace draco {
 constexpr int32_t kMaxTagSymbolBitLength = 32;
 constexpr int kMaxRawEncodingBitLength = 18;
 constexpr int kDefaultSymbolCodingCompressionLevel = 7;
+constexpr int kDefaultInterleavedRAnsStates = 4;
+// Interleaving is not worth the extra stored states for short inputs.
+constexpr int kMinInterleavedRAnsSymbolsPerState = 32;
 
 typedef uint64_t TaggedBitLengthFrequencies[kMaxTagSymbolBitLength];
 
@@ -43,6 +46,14 @@ bool SetSymbolEncodingCompressionLevel(Options *options,
   return true;
 }
 
+bool SetSymbolEncodingInterleavedStates(Options *options, int num_states) {
+  if (num_states != 1 && num_states != 4 && num_states != 8) {
+    return false;
+  }
+  options->SetInt("symbol_encoding_interleaved_states", num_states);
+  return true;
+}
+
 // Computes bit lengths of the input values. If num_components > 1, the values
 // are processed in "num_components" sized chunks and the bit length is always
 // computed for the largest value from the chunk.
@@ -102,13 +113,13 @@ static int64_t ApproximateRawSchemeBits(const uint32_t *symbols,
   return table_bits + data_bits;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT>
 bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
                          int num_components,
                          const std::vector<uint32_t> &bit_lengths,
                          EncoderBuffer *target_buffer);
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT, int num_states_t>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
                       uint32_t max_entry_value, int32_t num_unique_symbols,
                       const Options *options, EncoderBuffer *target_buffer);
@@ -145,13 +156,24 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
   const int max_value_bit_length =
       MostSignificantBit(std::max(1u, max_value)) + 1;
 
+  int num_states = 1;
+  if (options != nullptr) {
+    num_states = options->GetInt("symbol_encoding_interleaved_states", 1);
+  }
+
   int method = -1;
   if (options != nullptr && options->IsOptionSet("symbol_encoding_method")) {
     method = options->GetInt("symbol_encoding_method");
+    if (method == SYMBOL_CODING_RAW_INTERLEAVED && num_states <= 1) {
+      num_states = kDefaultInterleavedRAnsStates;
+    }
   } else {
     if (tagged_scheme_total_bits < raw_scheme_total_bits ||
         max_value_bit_length > kMaxRawEncodingBitLength) {
       method = SYMBOL_CODING_TAGGED;
+    } else if (num_states > 1 &&
+               num_values >= num_states * kMinInterleavedRAnsSymbolsPerState) {
+      method = SYMBOL_CODING_RAW_INTERLEAVED;
     } else {
       method = SYMBOL_CODING_RAW;
     }
@@ -163,15 +185,29 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
         symbols, num_values, num_components, bit_lengths, target_buffer);
   }
   if (method == SYMBOL_CODING_RAW) {
-    return EncodeRawSymbols<RAnsSymbolEncoder>(symbols, num_values, max_value,
-                                               num_unique_symbols, options,
-                                               target_buffer);
+    return EncodeRawSymbols<RAnsSymbolEncoder, 1>(symbols, num_values,
+                                                  max_value, num_unique_symbols,
+                                                  options, target_buffer);
+  }
+  if (method == SYMBOL_CODING_RAW_INTERLEAVED) {
+    target_buffer->Encode(static_cast<uint8_t>(num_states));
+    if (num_states == 4) {
+      return EncodeRawSymbols<RAnsSymbolEncoder, 4>(
+          symbols, num_values, max_value, num_unique_symbols, options,
+          target_buffer);
+    }
+    if (num_states == 8) {
+      return EncodeRawSymbols<RAnsSymbolEncoder, 8>(
+          symbols, num_values, max_value, num_unique_symbols, options,
+          target_buffer);
+    }
+    return false;
   }
   // Unknown method selected.
   return false;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT>
 bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
                          int num_components,
                          const std::vector<uint32_t> &bit_lengths,
@@ -200,7 +236,7 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
       kMaxTagSymbolBitLength * static_cast<uint64_t>(num_values);
 
   // Create encoder for encoding the bit tags.
-  SymbolEncoderT<5> tag_encoder;
+  SymbolEncoderT<5, 1> tag_encoder;
   tag_encoder.Create(frequencies, kMaxTagSymbolBitLength, target_buffer);
 
   // Start encoding bit tags.
@@ -212,27 +248,25 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
   if (tag_encoder.needs_reverse_encoding()) {
     // Encoder needs the values to be encoded in the reverse order.
     for (int i = num_values - num_components; i >= 0; i -= num_components) {
-      const int bit_length = bit_lengths[i / num_components];
-      tag_encoder.EncodeSymbol(bit_length);
-
-      // Values are always encoded in the normal order
-      const int j = num_values - num_components - i;
-      const int value_bit_length = bit_lengths[j / num_components];
-      for (int c = 0; c < num_components; ++c) {
-        value_buffer.EncodeLeastSignificantBits32(value_bit_length,
-                                                  symbols[j + c]);
-      }
+      tag_encoder.EncodeSymbol(bit_lengths[i / num_components]);
     }
   } else {
     for (int i = 0; i < num_values; i += num_components) {
-      const int bit_length = bit_lengths[i / num_components];
-      // First encode the tag.
-      tag_encoder.EncodeSymbol(bit_length);
-      // Now encode all values using the stored bit_length.
-      for (int j = 0; j < num_components; ++j) {
-        value_buffer.EncodeLeastSignificantBits32(bit_length, symbols[i + j]);
-      }
+      tag_encoder.EncodeSymbol(bit_lengths[i / num_components]);
+    }
+  }
+  // Values are always encoded in the normal order. All components of all
+  // entries in a run of entries with the same bit length are encoded at once.
+  for (size_t i = 0; i < bit_lengths.size();) {
+    size_t run_end = i + 1;
+    while (run_end < bit_lengths.size() &&
+           bit_lengths[run_end] == bit_lengths[i]) {
+      ++run_end;
     }
+    value_buffer.EncodeLeastSignificantBitsBulk(
+        bit_lengths[i], symbols + i * num_components,
+        (run_end - i) * num_components);
+    i = run_end;
   }
   tag_encoder.EndEncoding(target_buffer);
   value_buffer.EndBitEncoding();
@@ -256,21 +290,23 @@ bool EncodeRawSymbolsInternal(const uint32_t *symbols, int num_values,
   encoder.Create(frequencies.data(), static_cast<int>(frequencies.size()),
                  target_buffer);
   encoder.StartEncoding(target_buffer);
-  // Encode all values.
+  // Encode all values. Value |i| is always encoded by the interleaved state
+  // i % num_states.
+  constexpr int num_states = SymbolEncoderT::num_states();
   if (SymbolEncoderT::needs_reverse_encoding()) {
     for (int i = num_values - 1; i >= 0; --i) {
-      encoder.EncodeSymbol(symbols[i]);
+      encoder.EncodeSymbol(symbols[i], i % num_states);
     }
   } else {
     for (int i = 0; i < num_values; ++i) {
-      encoder.EncodeSymbol(symbols[i]);
+      encoder.EncodeSymbol(symbols[i], i % num_states);
     }
   }
   encoder.EndEncoding(target_buffer);
   return true;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT, int num_states_t>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
                       uint32_t max_entry_value, int32_t num_unique_symbols,
                       const Options *options, EncoderBuffer *target_buffer) {
@@ -315,58 +351,58 @@ bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
     case 0:
       FALLTHROUGH_INTENDED;
     case 1:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<1>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<1, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 2:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<2>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<2, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 3:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<3>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<3, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 4:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<4>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<4, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 5:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<5>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<5, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 6:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<6>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<6, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 7:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<7>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<7, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 8:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<8>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<8, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 9:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<9>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<9, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 10:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<10>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<10, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 11:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<11>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<11, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 12:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<12>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<12, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 13:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<13>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<13, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 14:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<14>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<14, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 15:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<15>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<15, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 16:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<16>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<16, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 17:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<17>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<17, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     case 18:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<18>>(
+      return EncodeRawSymbolsInternal<SymbolEncoderT<18, num_states_t>>(
           symbols, num_values, max_entry_value, target_buffer);
     default:
       return false;
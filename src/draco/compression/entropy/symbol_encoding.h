@@ -42,6 +42,14 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 // Returns false if an invalid level has been set.
 bool SetSymbolEncodingCompressionLevel(Options *options, int compression_level);
 
+// Allows the symbol encoder to distribute the symbols encoded with the raw
+// scheme between |num_states| interleaved rANS states (see
+// SYMBOL_CODING_RAW_INTERLEAVED). Valid values are 4 and 8, or 1 to disable
+// the interleaving which is the default. Interleaved data can be decoded only
+// by decoders supporting kDracoMeshInterleavedRAnsVersionMinor.
+// Returns false if an invalid number of states has been set.
+bool SetSymbolEncodingInterleavedStates(Options *options, int num_states);
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_ENCODING_H_
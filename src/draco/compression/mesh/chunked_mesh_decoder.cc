@@ -0,0 +1,239 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/chunked_mesh_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "draco/compression/batch_decoder.h"
+#include "draco/compression/config/compression_shared.h"
+
+namespace draco {
+
+namespace {
+
+// Returns the attributes of |chunk| in the order of the attributes of
+// |first_chunk|. The boundary index attribute is not included.
+Status GetChunkAttributes(const Mesh &first_chunk, const Mesh &chunk,
+                          uint32_t boundary_id_unique_id,
+                          std::vector<const PointAttribute *> *out_attributes) {
+  out_attributes->clear();
+  if (chunk.num_attributes() != first_chunk.num_attributes()) {
+    return Status(Status::DRACO_ERROR, "Chunks have different attributes.");
+  }
+  for (int i = 0; i < first_chunk.num_attributes(); ++i) {
+    const PointAttribute &first_att = *first_chunk.attribute(i);
+    if (first_att.unique_id() == boundary_id_unique_id) {
+      continue;
+    }
+    const PointAttribute *const att =
+        chunk.GetAttributeByUniqueId(first_att.unique_id());
+    if (att == nullptr || att->data_type() != first_att.data_type() ||
+        att->num_components() != first_att.num_components()) {
+      return Status(Status::DRACO_ERROR, "Chunks have different attributes.");
+    }
+    out_attributes->push_back(att);
+  }
+  return OkStatus();
+}
+
+// Maps points of |chunks| to the points of the stitched mesh. Boundary points
+// come first, followed by the remaining points of each chunk in the order of
+// the chunks. Returns the number of points of the stitched mesh.
+StatusOr<uint32_t> MapChunkPoints(
+    const std::vector<std::unique_ptr<Mesh>> &chunks,
+    uint32_t num_boundary_points, uint32_t boundary_id_unique_id,
+    std::vector<std::vector<PointIndex>> *point_maps) {
+  // Every boundary point is stored in at least two chunks.
+  uint64_t num_chunk_points = 0;
+  for (const std::unique_ptr<Mesh> &chunk : chunks) {
+    num_chunk_points += chunk->num_points();
+  }
+  if (2 * static_cast<uint64_t>(num_boundary_points) > num_chunk_points) {
+    return Status(Status::DRACO_ERROR, "Invalid number of boundary points.");
+  }
+  std::vector<bool> is_boundary_point_decoded(num_boundary_points, false);
+  uint64_t num_points = num_boundary_points;
+  point_maps->resize(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const Mesh &chunk = *chunks[i];
+    const PointAttribute *const id_att =
+        chunk.GetAttributeByUniqueId(boundary_id_unique_id);
+    if (id_att == nullptr || id_att->data_type() != DT_UINT32 ||
+        id_att->num_components() != 1) {
+      return Status(Status::DRACO_ERROR, "Missing chunk boundary indices.");
+    }
+    std::vector<PointIndex> &point_map = (*point_maps)[i];
+    point_map.resize(chunk.num_points());
+    for (PointIndex p(0); p < chunk.num_points(); ++p) {
+      uint32_t boundary_id;
+      id_att->GetMappedValue(p, &boundary_id);
+      if (boundary_id == 0) {
+        point_map[p.value()] = PointIndex(static_cast<uint32_t>(num_points++));
+        continue;
+      }
+      if (boundary_id > num_boundary_points) {
+        return Status(Status::DRACO_ERROR, "Invalid chunk boundary index.");
+      }
+      point_map[p.value()] = PointIndex(boundary_id - 1);
+      is_boundary_point_decoded[boundary_id - 1] = true;
+    }
+  }
+  if (std::find(is_boundary_point_decoded.begin(),
+                is_boundary_point_decoded.end(),
+                false) != is_boundary_point_decoded.end()) {
+    return Status(Status::DRACO_ERROR, "Chunks are missing some points.");
+  }
+  return static_cast<uint32_t>(num_points);
+}
+
+// Stitches decoded |chunks| into a single mesh.
+StatusOr<std::unique_ptr<Mesh>> StitchChunks(
+    const std::vector<std::unique_ptr<Mesh>> &chunks,
+    uint32_t num_boundary_points, uint32_t boundary_id_unique_id) {
+  std::vector<std::vector<PointIndex>> point_maps;
+  DRACO_ASSIGN_OR_RETURN(const uint32_t num_points,
+                         MapChunkPoints(chunks, num_boundary_points,
+                                        boundary_id_unique_id, &point_maps));
+  const Mesh &first_chunk = *chunks[0];
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->set_num_points(num_points);
+  for (int i = 0; i < first_chunk.num_attributes(); ++i) {
+    const PointAttribute &src_att = *first_chunk.attribute(i);
+    if (src_att.unique_id() == boundary_id_unique_id) {
+      continue;
+    }
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->Init(src_att.attribute_type(), src_att.num_components(),
+              src_att.data_type(), src_att.normalized(), num_points);
+    // Attributes decoded without their attribute transform use the same
+    // transform parameters in all chunks.
+    if (src_att.GetAttributeTransformData() != nullptr) {
+      att->SetAttributeTransformData(std::unique_ptr<AttributeTransformData>(
+          new AttributeTransformData(*src_att.GetAttributeTransformData())));
+    }
+    const int att_id = mesh->AddAttribute(std::move(att));
+    mesh->attribute(att_id)->set_unique_id(src_att.unique_id());
+  }
+  if (first_chunk.GetMetadata() != nullptr) {
+    mesh->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*first_chunk.GetMetadata())));
+  }
+
+  size_t num_faces = 0;
+  for (const std::unique_ptr<Mesh> &chunk : chunks) {
+    num_faces += chunk->num_faces();
+  }
+  mesh->SetNumFaces(num_faces);
+
+  std::vector<const PointAttribute *> chunk_attributes;
+  FaceIndex mesh_face(0);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const Mesh &chunk = *chunks[i];
+    const std::vector<PointIndex> &point_map = point_maps[i];
+    DRACO_RETURN_IF_ERROR(GetChunkAttributes(
+        first_chunk, chunk, boundary_id_unique_id, &chunk_attributes))
+    for (int j = 0; j < static_cast<int>(chunk_attributes.size()); ++j) {
+      const PointAttribute &src_att = *chunk_attributes[j];
+      PointAttribute *const att = mesh->attribute(j);
+      const size_t value_size = att->byte_stride();
+      for (PointIndex p(0); p < chunk.num_points(); ++p) {
+        std::memcpy(att->GetAddress(AttributeValueIndex(
+                        point_map[p.value()].value())),
+                    src_att.GetAddressOfMappedIndex(p), value_size);
+      }
+    }
+    for (FaceIndex f(0); f < chunk.num_faces(); ++f) {
+      const Mesh::Face &face = chunk.face(f);
+      Mesh::Face stitched_face;
+      for (int c = 0; c < 3; ++c) {
+        stitched_face[c] = point_map[face[c].value()];
+      }
+      mesh->SetFace(mesh_face++, stitched_face);
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+bool ChunkedMeshDecoder::IsChunkedMesh(const DecoderBuffer &in_buffer) {
+  if (in_buffer.remaining_size() <
+      static_cast<int64_t>(sizeof(kChunkedMeshMagic))) {
+    return false;
+  }
+  return memcmp(in_buffer.data_head(), kChunkedMeshMagic,
+                sizeof(kChunkedMeshMagic)) == 0;
+}
+
+StatusOr<std::unique_ptr<Mesh>> ChunkedMeshDecoder::Decode(
+    const DecoderOptions &options, DecoderBuffer *in_buffer,
+    int num_threads) {
+  constexpr char kIoErrorMsg[] = "Failed to parse chunked mesh header.";
+  if (!IsChunkedMesh(*in_buffer)) {
+    return Status(Status::DRACO_ERROR, "Not a chunked mesh.");
+  }
+  in_buffer->Advance(sizeof(kChunkedMeshMagic));
+  uint8_t version_major, version_minor;
+  if (!in_buffer->Decode(&version_major) ||
+      !in_buffer->Decode(&version_minor)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (version_major != kChunkedMeshVersionMajor) {
+    return Status(Status::UNKNOWN_VERSION,
+                  "Unsupported chunked mesh version.");
+  }
+  uint32_t num_boundary_points, boundary_id_unique_id, num_chunks;
+  if (!in_buffer->Decode(&num_boundary_points) ||
+      !in_buffer->Decode(&boundary_id_unique_id) ||
+      !in_buffer->Decode(&num_chunks)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  // Reject corrupted counts before anything is allocated.
+  if (num_chunks == 0 ||
+      static_cast<uint64_t>(num_chunks) * sizeof(uint64_t) >
+          static_cast<uint64_t>(in_buffer->remaining_size())) {
+    return Status(Status::DRACO_ERROR, kIoErrorMsg);
+  }
+  std::vector<uint64_t> chunk_sizes(num_chunks);
+  for (uint64_t &chunk_size : chunk_sizes) {
+    if (!in_buffer->Decode(&chunk_size)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+  }
+  std::vector<DecoderBuffer> chunk_buffers(num_chunks);
+  for (uint32_t i = 0; i < num_chunks; ++i) {
+    if (chunk_sizes[i] >
+        static_cast<uint64_t>(in_buffer->remaining_size())) {
+      return Status(Status::IO_ERROR, "Chunked mesh chunk out of bounds.");
+    }
+    chunk_buffers[i].Init(in_buffer->data_head(), chunk_sizes[i]);
+    in_buffer->Advance(chunk_sizes[i]);
+  }
+
+  std::vector<StatusOr<std::unique_ptr<Mesh>>> results =
+      BatchDecoder::DecodeAll(chunk_buffers.data(), chunk_buffers.size(),
+                              options, num_threads);
+  std::vector<std::unique_ptr<Mesh>> chunks;
+  chunks.reserve(num_chunks);
+  for (StatusOr<std::unique_ptr<Mesh>> &result : results) {
+    DRACO_RETURN_IF_ERROR(result.status())
+    chunks.push_back(std::move(result).value());
+  }
+  return StitchChunks(chunks, num_boundary_points, boundary_id_unique_id);
+}
+
+}  // namespace draco
@@ -0,0 +1,47 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_CHUNKED_MESH_DECODER_H_
+#define DRACO_COMPRESSION_MESH_CHUNKED_MESH_DECODER_H_
+
+#include <memory>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status_or.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decodes meshes encoded by ChunkedMeshEncoder. The chunks are decoded in
+// parallel and stitched into a single mesh. Points shared by several chunks
+// are merged and they are stored first in the order of the encoded mesh,
+// followed by the other points of each chunk in the decoded order of the
+// chunk.
+class ChunkedMeshDecoder {
+ public:
+  // Returns true when |in_buffer| holds a chunked mesh. The buffer is not
+  // modified.
+  static bool IsChunkedMesh(const DecoderBuffer &in_buffer);
+
+  // Decodes the chunked mesh held in |in_buffer| using |num_threads| threads
+  // and |options| for all chunks.
+  static StatusOr<std::unique_ptr<Mesh>> Decode(const DecoderOptions &options,
+                                                DecoderBuffer *in_buffer,
+                                                int num_threads);
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_CHUNKED_MESH_DECODER_H_
@@ -0,0 +1,255 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/chunked_mesh_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/vector_d.h"
+
+namespace draco {
+
+namespace {
+
+// Reorders |faces| in range [|begin|, |end|) into |num_chunks| spatially
+// coherent groups of a similar size and appends the end of each group to
+// |chunk_ends|. Each range is split at the median of the face centroids along
+// the longest axis of their bounding box.
+void PartitionFaces(const IndexTypeVector<FaceIndex, Vector3f> &centroids,
+                    size_t begin, size_t end, int num_chunks,
+                    std::vector<FaceIndex> *faces,
+                    std::vector<size_t> *chunk_ends) {
+  if (num_chunks == 1) {
+    chunk_ends->push_back(end);
+    return;
+  }
+  Vector3f min_point = centroids[(*faces)[begin]];
+  Vector3f max_point = min_point;
+  for (size_t i = begin + 1; i < end; ++i) {
+    const Vector3f &centroid = centroids[(*faces)[i]];
+    for (int c = 0; c < 3; ++c) {
+      min_point[c] = std::min(min_point[c], centroid[c]);
+      max_point[c] = std::max(max_point[c], centroid[c]);
+    }
+  }
+  const Vector3f extent = max_point - min_point;
+  int axis = 0;
+  for (int c = 1; c < 3; ++c) {
+    if (extent[c] > extent[axis]) {
+      axis = c;
+    }
+  }
+  const int num_left_chunks = num_chunks / 2;
+  const size_t middle = begin + (end - begin) * num_left_chunks / num_chunks;
+  std::nth_element(faces->begin() + begin, faces->begin() + middle,
+                   faces->begin() + end, [&](FaceIndex a, FaceIndex b) {
+                     return centroids[a][axis] < centroids[b][axis];
+                   });
+  PartitionFaces(centroids, begin, middle, num_left_chunks, faces, chunk_ends);
+  PartitionFaces(centroids, middle, end, num_chunks - num_left_chunks, faces,
+                 chunk_ends);
+}
+
+// Creates the mesh of a chunk holding |num_faces| faces of |mesh| listed in
+// |faces|. |boundary_ids| of the points are stored in a new attribute with
+// |boundary_id_unique_id|.
+std::unique_ptr<Mesh> CreateChunkMesh(
+    const Mesh &mesh, const FaceIndex *faces, size_t num_faces,
+    const IndexTypeVector<PointIndex, uint32_t> &boundary_ids,
+    uint32_t boundary_id_unique_id) {
+  // Points of the chunk sorted by their index in |mesh|.
+  std::vector<PointIndex> points;
+  points.reserve(3 * num_faces);
+  for (size_t i = 0; i < num_faces; ++i) {
+    const Mesh::Face &face = mesh.face(faces[i]);
+    points.insert(points.end(), face.begin(), face.end());
+  }
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  const auto local_index = [&points](PointIndex point) {
+    return PointIndex(static_cast<uint32_t>(
+        std::lower_bound(points.begin(), points.end(), point) -
+        points.begin()));
+  };
+
+  std::unique_ptr<Mesh> chunk(new Mesh());
+  chunk->SetNumFaces(num_faces);
+  for (size_t i = 0; i < num_faces; ++i) {
+    const Mesh::Face &face = mesh.face(faces[i]);
+    Mesh::Face chunk_face;
+    for (int c = 0; c < 3; ++c) {
+      chunk_face[c] = local_index(face[c]);
+    }
+    chunk->SetFace(FaceIndex(static_cast<uint32_t>(i)), chunk_face);
+  }
+  chunk->set_num_points(static_cast<uint32_t>(points.size()));
+
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const PointAttribute &src_att = *mesh.attribute(i);
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->Init(src_att.attribute_type(), src_att.num_components(),
+              src_att.data_type(), src_att.normalized(), points.size());
+    const size_t value_size =
+        DataTypeLength(src_att.data_type()) * src_att.num_components();
+    for (size_t p = 0; p < points.size(); ++p) {
+      std::memcpy(att->GetAddress(AttributeValueIndex(p)),
+                  src_att.GetAddressOfMappedIndex(points[p]), value_size);
+    }
+    const int att_id = chunk->AddAttribute(std::move(att));
+    chunk->attribute(att_id)->set_unique_id(src_att.unique_id());
+  }
+
+  std::unique_ptr<PointAttribute> id_att(new PointAttribute());
+  id_att->Init(GeometryAttribute::GENERIC, 1, DT_UINT32, false,
+               points.size());
+  for (size_t p = 0; p < points.size(); ++p) {
+    id_att->SetAttributeValue(AttributeValueIndex(p),
+                              &boundary_ids[points[p]]);
+  }
+  const int id_att_id = chunk->AddAttribute(std::move(id_att));
+  chunk->attribute(id_att_id)->set_unique_id(boundary_id_unique_id);
+  return chunk;
+}
+
+}  // namespace
+
+ChunkedMeshEncoder::ChunkedMeshEncoder() : num_chunks_(1), num_threads_(1) {}
+
+Status ChunkedMeshEncoder::EncodeToBuffer(const Mesh &mesh,
+                                          const EncoderOptions &options,
+                                          EncoderBuffer *out_buffer) const {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || mesh.num_faces() == 0) {
+    return Status(Status::DRACO_ERROR, "Mesh without positions or faces.");
+  }
+  const int num_chunks = static_cast<int>(
+      std::min<uint32_t>(std::max(num_chunks_, 1), mesh.num_faces()));
+
+  // Partition the faces using their centroids.
+  IndexTypeVector<FaceIndex, Vector3f> centroids(mesh.num_faces());
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      Vector3f position;
+      pos_att->ConvertValue<float, 3>(pos_att->mapped_index(mesh.face(f)[c]),
+                                      &position[0]);
+      centroids[f] = centroids[f] + position / 3.f;
+    }
+  }
+  std::vector<FaceIndex> faces(mesh.num_faces());
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    faces[f.value()] = f;
+  }
+  std::vector<size_t> chunk_ends;
+  PartitionFaces(centroids, 0, faces.size(), num_chunks, &faces, &chunk_ends);
+
+  // Find the points shared by more than one chunk. The faces of each chunk
+  // are listed consecutively in |faces|.
+  IndexTypeVector<PointIndex, int> point_chunks(mesh.num_points(), -1);
+  IndexTypeVector<PointIndex, uint32_t> boundary_ids(mesh.num_points(), 0);
+  for (int i = 0; i < num_chunks; ++i) {
+    const size_t begin = i == 0 ? 0 : chunk_ends[i - 1];
+    for (size_t j = begin; j < chunk_ends[i]; ++j) {
+      for (int c = 0; c < 3; ++c) {
+        const PointIndex point = mesh.face(faces[j])[c];
+        if (point_chunks[point] >= 0 && point_chunks[point] != i) {
+          boundary_ids[point] = 1;
+        }
+        point_chunks[point] = i;
+      }
+    }
+  }
+  // Boundary points are numbered from 1 in the order of |mesh|. Other points
+  // have id 0.
+  uint32_t num_boundary_points = 0;
+  for (PointIndex p(0); p < mesh.num_points(); ++p) {
+    if (boundary_ids[p] != 0) {
+      boundary_ids[p] = ++num_boundary_points;
+    }
+  }
+  uint32_t boundary_id_unique_id = 0;
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    boundary_id_unique_id =
+        std::max(boundary_id_unique_id, mesh.attribute(i)->unique_id() + 1);
+  }
+
+  // All chunks use the quantization grid of the whole mesh.
+  EncoderOptions chunk_options = options;
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const PointAttribute &att = *mesh.attribute(i);
+    const int quantization_bits =
+        options.GetAttributeInt(i, "quantization_bits", -1);
+    if (att.data_type() != DT_FLOAT32 || quantization_bits < 1 ||
+        (options.IsAttributeOptionSet(i, "quantization_origin") &&
+         options.IsAttributeOptionSet(i, "quantization_range"))) {
+      continue;
+    }
+    AttributeQuantizationTransform transform;
+    if (!transform.ComputeParameters(att, quantization_bits)) {
+      return Status(Status::DRACO_ERROR, "Failed to quantize attribute.");
+    }
+    chunk_options.SetAttributeVector(i, "quantization_origin",
+                                     att.num_components(),
+                                     transform.min_values().data());
+    chunk_options.SetAttributeFloat(i, "quantization_range", transform.range());
+  }
+
+  std::vector<EncoderBuffer> chunk_buffers(num_chunks);
+  std::vector<Status> chunk_statuses(num_chunks);
+  {
+    ThreadPool pool(std::min(num_threads_, num_chunks));
+    for (int i = 0; i < num_chunks; ++i) {
+      pool.Schedule([&, i]() {
+        const size_t begin = i == 0 ? 0 : chunk_ends[i - 1];
+        std::unique_ptr<Mesh> chunk =
+            CreateChunkMesh(mesh, faces.data() + begin, chunk_ends[i] - begin,
+                            boundary_ids, boundary_id_unique_id);
+        if (i == 0 && mesh.GetMetadata() != nullptr) {
+          chunk->AddMetadata(std::unique_ptr<GeometryMetadata>(
+              new GeometryMetadata(*mesh.GetMetadata())));
+        }
+        ExpertEncoder encoder(*chunk);
+        encoder.Reset(chunk_options);
+        chunk_statuses[i] = encoder.EncodeToBuffer(&chunk_buffers[i]);
+      });
+    }
+  }
+  for (const Status &status : chunk_statuses) {
+    DRACO_RETURN_IF_ERROR(status)
+  }
+
+  out_buffer->Encode(kChunkedMeshMagic, sizeof(kChunkedMeshMagic));
+  out_buffer->Encode(kChunkedMeshVersionMajor);
+  out_buffer->Encode(kChunkedMeshVersionMinor);
+  out_buffer->Encode(num_boundary_points);
+  out_buffer->Encode(boundary_id_unique_id);
+  out_buffer->Encode(static_cast<uint32_t>(num_chunks));
+  for (const EncoderBuffer &chunk_buffer : chunk_buffers) {
+    out_buffer->Encode(static_cast<uint64_t>(chunk_buffer.size()));
+  }
+  for (const EncoderBuffer &chunk_buffer : chunk_buffers) {
+    out_buffer->Encode(chunk_buffer.data(), chunk_buffer.size());
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
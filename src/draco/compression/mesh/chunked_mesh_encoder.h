@@ -0,0 +1,69 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_CHUNKED_MESH_ENCODER_H_
+#define DRACO_COMPRESSION_MESH_CHUNKED_MESH_ENCODER_H_
+
+#include "draco/compression/config/encoder_options.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Encodes a mesh as a number of independent chunks that can be encoded and
+// decoded in parallel (see ChunkedMeshDecoder). The faces of the mesh are
+// split into spatially coherent clusters by recursive bisection of the face
+// centroids. Each cluster is encoded as a separate Draco mesh with all
+// attributes of its points. Points on the boundary between clusters are
+// stored in every cluster that uses them. Every chunk carries an extra
+// attribute that holds the index of each boundary point (starting from 1) and
+// 0 for all other points, which is used to stitch the chunks back together.
+//
+// Quantized attributes of all chunks share the quantization grid computed from
+// the whole mesh, so the decoded values are the same as the values of the
+// mesh encoded without chunks.
+//
+// Container layout:
+//   kChunkedMeshMagic, kChunkedMeshVersionMajor, kChunkedMeshVersionMinor
+//   uint32 number of boundary points
+//   uint32 unique id of the boundary index attribute of the chunks
+//   uint32 number of chunks
+//   uint64 size of each chunk
+//   encoded chunks
+class ChunkedMeshEncoder {
+ public:
+  ChunkedMeshEncoder();
+
+  // Sets the number of chunks. The number of chunks is limited by the number
+  // of faces of the encoded mesh. Default is 1.
+  void SetNumChunks(int num_chunks) { num_chunks_ = num_chunks; }
+
+  // Sets the number of threads used to encode the chunks. Default is 1.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  // Encodes |mesh| into |out_buffer|. |options| are the options of
+  // ExpertEncoder for |mesh| and they are used for all chunks. Points that are
+  // not used by any face are not encoded.
+  Status EncodeToBuffer(const Mesh &mesh, const EncoderOptions &options,
+                        EncoderBuffer *out_buffer) const;
+
+ private:
+  int num_chunks_;
+  int num_threads_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_CHUNKED_MESH_ENCODER_H_
@@ -0,0 +1,108 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/chunked_mesh_decoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class ChunkedMeshEncodingTest : public ::testing::Test {
+ protected:
+  ChunkedMeshEncodingTest() {
+    encoder_.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder_.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+    encoder_.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+  }
+
+  // Encodes |mesh| with |num_chunks| chunks on |num_threads| threads and
+  // returns the decoded mesh.
+  std::unique_ptr<draco::Mesh> EncodeAndDecode(const draco::Mesh &mesh,
+                                               int num_chunks,
+                                               int num_threads) {
+    draco::EncoderBuffer buffer;
+    const draco::Status status = encoder_.EncodeMeshToChunkedBuffer(
+        mesh, num_chunks, num_threads, &buffer);
+    EXPECT_TRUE(status.ok()) << status.error_msg_string();
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    EXPECT_TRUE(draco::ChunkedMeshDecoder::IsChunkedMesh(in_buffer));
+    draco::Decoder decoder;
+    draco::StatusOr<std::unique_ptr<draco::Mesh>> status_or =
+        decoder.DecodeChunkedMeshFromBuffer(&in_buffer, num_threads);
+    EXPECT_TRUE(status_or.ok()) << status_or.status().error_msg_string();
+    if (!status_or.ok()) {
+      return nullptr;
+    }
+    return std::move(status_or).value();
+  }
+
+  // Verifies that |file_name| encoded in chunks decodes to the same faces,
+  // points and attribute values as the mesh encoded without chunks.
+  void TestChunkedEncoding(const std::string &file_name) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder_.EncodeMeshToBuffer(*mesh, &buffer));
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                           decoder.DecodeMeshFromBuffer(&in_buffer));
+    const std::vector<std::string> ref_faces =
+        draco::GetSortedFaces(*ref_mesh, *ref_mesh);
+
+    for (int num_chunks : {1, 2, 3, 8}) {
+      for (int num_threads : {1, 4}) {
+        const std::unique_ptr<draco::Mesh> decoded_mesh =
+            EncodeAndDecode(*mesh, num_chunks, num_threads);
+        ASSERT_NE(decoded_mesh, nullptr);
+        ASSERT_EQ(decoded_mesh->num_points(), ref_mesh->num_points());
+        ASSERT_EQ(decoded_mesh->num_attributes(), ref_mesh->num_attributes());
+        ASSERT_EQ(draco::GetSortedFaces(*decoded_mesh, *ref_mesh), ref_faces);
+      }
+    }
+  }
+
+  draco::Encoder encoder_;
+};
+
+TEST_F(ChunkedMeshEncodingTest, TestChunkedEncoding) {
+  TestChunkedEncoding("bun_zipper.ply");
+  TestChunkedEncoding("cube_att.obj");
+}
+
+TEST_F(ChunkedMeshEncodingTest, TestCorruptedData) {
+  // Tests that truncated chunked meshes are rejected.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder_.EncodeMeshToChunkedBuffer(*mesh, 4, 1, &buffer));
+  for (size_t size : {size_t(4), size_t(20), buffer.size() / 2,
+                      buffer.size() - 1}) {
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), size);
+    draco::Decoder decoder;
+    ASSERT_FALSE(decoder.DecodeChunkedMeshFromBuffer(&in_buffer, 2).ok());
+  }
+}
+
+}  // namespace
@@ -30,6 +30,24 @@ Status MeshDecoder::DecodeAttr(const DecoderOptions &options, DecoderBuffer *in_
   return PointCloudDecoder::DecodeAttr(options, in_buffer, out_header, out_mesh);
 }
 
+Status MeshDecoder::StartDecoding(const DecoderOptions &options,
+                                  DecoderBuffer *in_buffer, Mesh *out_mesh) {
+  mesh_ = out_mesh;
+  return PointCloudDecoder::StartDecoding(options, in_buffer, out_mesh);
+}
+
+Status MeshDecoder::StartDecoding(const DecoderOptions &options,
+                                  const DracoHeader &header,
+                                  DecoderBuffer *in_buffer, Mesh *out_mesh) {
+  mesh_ = out_mesh;
+  return PointCloudDecoder::StartDecoding(options, header, in_buffer, out_mesh);
+}
+
+void MeshDecoder::InitFromDecoder(const MeshDecoder &decoder, Mesh *out_mesh) {
+  mesh_ = out_mesh;
+  PointCloudDecoder::InitFromDecoder(decoder, out_mesh);
+}
+
 bool MeshDecoder::DecodeGeometryData() {
   if (mesh_ == nullptr) {
     return false;
@@ -39,6 +39,12 @@ class MeshDecoder : public PointCloudDecoder {
   Status DecodeAttr(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 DracoHeader *out_header, Mesh *out_mesh);
 
+  // See PointCloudDecoder::StartDecoding().
+  Status StartDecoding(const DecoderOptions &options, DecoderBuffer *in_buffer,
+                       Mesh *out_mesh);
+  Status StartDecoding(const DecoderOptions &options, const DracoHeader &header,
+                       DecoderBuffer *in_buffer, Mesh *out_mesh);
+
   // Returns the base connectivity of the decoded mesh (or nullptr if it is not
   // initialized).
   virtual const CornerTable *GetCornerTable() const { return nullptr; }
@@ -62,6 +68,10 @@ class MeshDecoder : public PointCloudDecoder {
   bool DecodeGeometryData() override;
   virtual bool DecodeConnectivity() = 0;
 
+  // Sets up the decoder to fill |out_mesh| using the bitstream version and
+  // options of |decoder|. See PointCloudDecoder::InitFromDecoder().
+  void InitFromDecoder(const MeshDecoder &decoder, Mesh *out_mesh);
+
  private:
   Mesh *mesh_;
 };
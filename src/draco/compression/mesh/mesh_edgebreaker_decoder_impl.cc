@@ -248,8 +248,12 @@ Status MeshEdgebreakerDecoderImpl<TraversalDecoder>::CreateAttributesDecoder(
 
 template <class TraversalDecoder>
 bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
+  // Transient data of the connectivity decoding is allocated from the arena
+  // of the decoder when there is one.
+  const ArenaAllocator<int> allocator(decoder_->arena());
   num_new_vertices_ = 0;
-  new_to_parent_vertex_map_.clear();
+  new_to_parent_vertex_map_ = ArenaUnorderedMap<int, int>(
+      0, std::hash<int>(), std::equal_to<int>(), allocator);
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 2)) {
     uint32_t num_new_verts;
@@ -358,19 +362,21 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   }
 
   // Decode topology (connectivity).
-  vertex_traversal_length_.clear();
-  corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
+  vertex_traversal_length_ = ArenaVector<int>(allocator);
+  corner_table_ =
+      std::unique_ptr<CornerTable>(new CornerTable(decoder_->arena()));
   if (corner_table_ == nullptr) {
     return false;
   }
-  processed_corner_ids_.clear();
+  processed_corner_ids_ = ArenaVector<int32_t>(allocator);
   processed_corner_ids_.reserve(num_faces);
-  processed_connectivity_corners_.clear();
+  processed_connectivity_corners_ = ArenaVector<int>(allocator);
   processed_connectivity_corners_.reserve(num_faces);
-  topology_split_data_.clear();
-  hole_event_data_.clear();
-  init_face_configurations_.clear();
-  init_corners_.clear();
+  topology_split_data_ = ArenaVector<TopologySplitEventData>(allocator);
+  hole_event_data_ = ArenaVector<HoleEventData>(allocator);
+  init_face_configurations_ = ArenaVector<bool>(allocator);
+  init_corners_ = ArenaVector<CornerIndex>(allocator);
+  is_vert_hole_ = ArenaVector<bool>(allocator);
 
   last_symbol_id_ = -1;
   last_face_id_ = -1;
@@ -379,6 +385,9 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   attribute_data_.clear();
   // Add one attribute data for each attribute decoder.
   attribute_data_.resize(num_attribute_data);
+  for (AttributeData &data : attribute_data_) {
+    data.attribute_seam_corners = ArenaVector<int32_t>(allocator);
+  }
 
   if (!corner_table_->Reset(
           num_faces, num_encoded_vertices_ + num_encoded_split_symbols)) {
@@ -406,7 +415,7 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
       }
     }
     if (encoded_connectivity_size == 0 ||
-        encoded_connectivity_size > decoder_->buffer()->remaining_size()) {
+        !decoder_->buffer()->CheckRemainingSize(encoded_connectivity_size)) {
       return false;
     }
     DecoderBuffer event_buffer;
@@ -418,6 +427,9 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
     topology_split_decoded_bytes =
         DecodeHoleAndTopologySplitEvents(&event_buffer);
     if (topology_split_decoded_bytes == -1) {
+      if (event_buffer.out_of_data()) {
+        decoder_->buffer()->set_out_of_data();
+      }
       return false;
     }
 
@@ -437,11 +449,17 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
 
   DecoderBuffer traversal_end_buffer;
   if (!traversal_decoder_.Start(&traversal_end_buffer)) {
+    if (traversal_decoder_.out_of_data()) {
+      decoder_->buffer()->set_out_of_data();
+    }
     return false;
   }
 
   const int num_connectivity_verts = DecodeConnectivity(num_encoded_symbols);
   if (num_connectivity_verts == -1) {
+    if (traversal_decoder_.out_of_data()) {
+      decoder_->buffer()->set_out_of_data();
+    }
     return false;
   }
 
@@ -449,6 +467,11 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   decoder_->buffer()->Init(traversal_end_buffer.data_head(),
                            traversal_end_buffer.remaining_size(),
                            decoder_->buffer()->bitstream_version());
+  // The traversal data was decoded from sub-buffers that end where the main
+  // buffer ends.
+  if (traversal_decoder_.out_of_data()) {
+    decoder_->buffer()->set_out_of_data();
+  }
 
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 2)) {
@@ -528,17 +551,19 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
   // decoder always processes only the latest active edge. TOPOLOGY_S then
   // removes the top edge from the stack and TOPOLOGY_E adds a new edge to the
   // stack.
-  std::vector<CornerIndex> active_corner_stack;
+  const ArenaAllocator<int> allocator(decoder_->arena());
+  ArenaVector<CornerIndex> active_corner_stack(allocator);
 
   // Additional active edges may be added as a result of topology split events.
   // They can be added in arbitrary order, but we always know the split symbol
   // id they belong to, so we can address them using this symbol id.
-  std::unordered_map<int, CornerIndex> topology_split_active_corners;
+  ArenaUnorderedMap<int, CornerIndex> topology_split_active_corners(
+      0, std::hash<int>(), std::equal_to<int>(), allocator);
 
   // Vector used for storing vertices that were marked as isolated during the
   // decoding process. Currently used only when the mesh doesn't contain any
   // non-position connectivity data.
-  std::vector<VertexIndex> invalid_vertices;
+  ArenaVector<VertexIndex> invalid_vertices(allocator);
   const bool remove_invalid_vertices = attribute_data_.empty();
 
   int max_num_vertices = static_cast<int>(is_vert_hole_.size());
@@ -1131,9 +1156,11 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
   // Map between point id and an associated corner id. Only one corner for
   // each point is stored. The corners are used to sample the attribute values
   // in the last stage of the deduplication.
-  std::vector<int32_t> point_to_corner_map;
+  const ArenaAllocator<int32_t> allocator(decoder_->arena());
+  ArenaVector<int32_t> point_to_corner_map(allocator);
   // Map between every corner and their new point ids.
-  std::vector<int32_t> corner_to_point_map(corner_table_->num_corners());
+  ArenaVector<int32_t> corner_to_point_map(corner_table_->num_corners(), 0,
+                                           allocator);
   for (int v = 0; v < corner_table_->num_vertices(); ++v) {
     CornerIndex c = corner_table_->LeftMostCorner(VertexIndex(v));
     if (c == kInvalidCornerIndex) {
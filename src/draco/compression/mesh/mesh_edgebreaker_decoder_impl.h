@@ -22,6 +22,7 @@
 #include "draco/compression/mesh/mesh_edgebreaker_decoder_impl_interface.h"
 #include "draco/compression/mesh/mesh_edgebreaker_shared.h"
 #include "draco/compression/mesh/traverser/mesh_traversal_sequencer.h"
+#include "draco/core/arena.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/status.h"
 #include "draco/draco_features.h"
@@ -152,19 +153,19 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   std::vector<CornerIndex> corner_traversal_stack_;
 
   // Array stores the number of visited visited for each mesh traversal.
-  std::vector<int> vertex_traversal_length_;
+  ArenaVector<int> vertex_traversal_length_;
 
   // List of decoded topology split events.
-  std::vector<TopologySplitEventData> topology_split_data_;
+  ArenaVector<TopologySplitEventData> topology_split_data_;
 
   // List of decoded hole events.
-  std::vector<HoleEventData> hole_event_data_;
+  ArenaVector<HoleEventData> hole_event_data_;
 
   // Configuration of the initial face for each mesh component.
-  std::vector<bool> init_face_configurations_;
+  ArenaVector<bool> init_face_configurations_;
 
   // Initial corner for each traversal.
-  std::vector<CornerIndex> init_corners_;
+  ArenaVector<CornerIndex> init_corners_;
 
   // Id of the last processed input symbol.
   int last_symbol_id_;
@@ -180,7 +181,7 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // Array for marking visited vertices.
   std::vector<bool> visited_verts_;
   // Array for marking vertices on open boundaries.
-  std::vector<bool> is_vert_hole_;
+  ArenaVector<bool> is_vert_hole_;
 
   // The number of new vertices added by the encoder (because of non-manifold
   // vertices on the input mesh).
@@ -189,19 +190,19 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   int num_new_vertices_;
   // For every newly added vertex, this array stores it's mapping to the
   // parent vertex id of the encoded mesh.
-  std::unordered_map<int, int> new_to_parent_vertex_map_;
+  ArenaUnorderedMap<int, int> new_to_parent_vertex_map_;
   // The number of vertices that were encoded (can be different from the number
   // of vertices of the input mesh).
   int num_encoded_vertices_;
 
   // Array for storing the encoded corner ids in the order their associated
   // vertices were decoded.
-  std::vector<int32_t> processed_corner_ids_;
+  ArenaVector<int32_t> processed_corner_ids_;
 
   // Array storing corners in the order they were visited during the
   // connectivity decoding (always storing the tip corner of each newly visited
   // face).
-  std::vector<int> processed_connectivity_corners_;
+  ArenaVector<int> processed_connectivity_corners_;
 
   MeshAttributeIndicesEncodingData pos_encoding_data_;
 
@@ -219,7 +220,7 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
     bool is_connectivity_used;
     MeshAttributeIndicesEncodingData encoding_data;
     // Opposite corners to attribute seam edges.
-    std::vector<int32_t> attribute_seam_corners;
+    ArenaVector<int32_t> attribute_seam_corners;
   };
   std::vector<AttributeData> attribute_data_;
 
@@ -273,10 +273,14 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // together, unless the option |use_single_connectivity_| is set in which case
   // we break the mesh along attribute seams and use the same connectivity for
   // all attributes.
+  // The corner table can be computed by multiple threads. The table is the
+  // same for any number of threads.
+  const int num_threads =
+      encoder_->options()->GetGlobalInt("corner_table_threads", 1);
   if (use_single_connectivity_) {
-    corner_table_ = CreateCornerTableFromAllAttributes(mesh_);
+    corner_table_ = CreateCornerTableFromAllAttributes(mesh_, num_threads);
   } else {
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_, num_threads);
   }
   if (corner_table_ == nullptr ||
       corner_table_->num_faces() == corner_table_->NumDegeneratedFaces()) {
@@ -112,6 +112,27 @@ TEST_F(MeshEdgebreakerEncodingTest, TestEncoderReuse) {
   }
 }
 
+TEST_F(MeshEdgebreakerEncodingTest, TestParallelCornerTable) {
+  // Tests that the encoded mesh doesn't depend on the number of threads used
+  // to compute the corner table.
+  const std::string file_name = "test_nm.obj";
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+  ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+
+  EncoderBuffer buffers[2];
+  for (int i = 0; i < 2; ++i) {
+    MeshEdgebreakerEncoder encoder;
+    EncoderOptions encoder_options = EncoderOptions::CreateDefaultOptions();
+    encoder_options.SetGlobalInt("corner_table_threads", i == 0 ? 1 : 4);
+    encoder.SetMesh(*mesh);
+    ASSERT_TRUE(encoder.Encode(encoder_options, &buffers[i]).ok());
+  }
+  ASSERT_EQ(buffers[0].size(), buffers[1].size());
+  for (int i = 0; i < buffers[0].size(); ++i) {
+    ASSERT_EQ(buffers[0].data()[i], buffers[1].data()[i]);
+  }
+}
+
 TEST_F(MeshEdgebreakerEncodingTest, TestDecoderReuse) {
   // Tests whether the edgebreaker decoder can be reused multiple times to
   // decode a given mesh.
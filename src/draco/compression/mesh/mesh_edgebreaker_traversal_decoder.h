@@ -38,6 +38,16 @@ class MeshEdgebreakerTraversalDecoder {
     buffer_.Init(decoder->GetDecoder()->buffer()->data_head(),
                  decoder->GetDecoder()->buffer()->remaining_size(),
                  decoder->GetDecoder()->buffer()->bitstream_version());
+    // Drop the state of the sub-buffers of any previous decoding.
+    symbol_buffer_ = buffer_;
+    start_face_buffer_ = buffer_;
+  }
+
+  // Returns true when the traversal data ended prematurely, i.e. when the
+  // decoding needed more data than the buffer of the main decoder holds.
+  bool out_of_data() const {
+    return buffer_.out_of_data() || symbol_buffer_.out_of_data() ||
+           start_face_buffer_.out_of_data();
   }
 
   // Returns the Draco bitstream version.
@@ -144,7 +154,7 @@ class MeshEdgebreakerTraversalDecoder {
       return false;
     }
     buffer_ = symbol_buffer_;
-    if (traversal_size > static_cast<uint64_t>(buffer_.remaining_size())) {
+    if (!buffer_.CheckRemainingSize(traversal_size)) {
       return false;
     }
     buffer_.Advance(traversal_size);
@@ -161,7 +171,7 @@ class MeshEdgebreakerTraversalDecoder {
         return false;
       }
       buffer_ = start_face_buffer_;
-      if (traversal_size > static_cast<uint64_t>(buffer_.remaining_size())) {
+      if (!buffer_.CheckRemainingSize(traversal_size)) {
         return false;
       }
       buffer_.Advance(traversal_size);
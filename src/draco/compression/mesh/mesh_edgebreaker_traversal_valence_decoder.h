@@ -17,6 +17,7 @@
 
 #include "draco/compression/entropy/symbol_decoding.h"
 #include "draco/compression/mesh/mesh_edgebreaker_traversal_decoder.h"
+#include "draco/core/arena.h"
 #include "draco/core/varint_decoding.h"
 #include "draco/draco_features.h"
 
@@ -31,6 +32,7 @@ class MeshEdgebreakerTraversalValenceDecoder
  public:
   MeshEdgebreakerTraversalValenceDecoder()
       : corner_table_(nullptr),
+        arena_(nullptr),
         num_vertices_(0),
         last_symbol_(-1),
         active_context_(-1),
@@ -39,6 +41,7 @@ class MeshEdgebreakerTraversalValenceDecoder
   void Init(MeshEdgebreakerDecoderImplInterface *decoder) {
     MeshEdgebreakerTraversalDecoder::Init(decoder);
     corner_table_ = decoder->GetCornerTable();
+    arena_ = decoder->GetDecoder()->arena();
   }
   void SetNumEncodedVertices(int num_vertices) { num_vertices_ = num_vertices; }
 
@@ -97,12 +100,17 @@ class MeshEdgebreakerTraversalValenceDecoder
       return false;
     }
     // Set the valences of all initial vertices to 0.
+    vertex_valences_ =
+        IndexTypeVector<VertexIndex, int, ArenaAllocator<int>>(
+            ArenaAllocator<int>(arena_));
     vertex_valences_.resize(num_vertices_, 0);
 
     const int num_unique_valences = max_valence_ - min_valence_ + 1;
 
     // Decode all symbols for all contexts.
-    context_symbols_.resize(num_unique_valences);
+    context_symbols_.resize(
+        num_unique_valences,
+        ArenaVector<uint32_t>(ArenaAllocator<uint32_t>(arena_)));
     context_counters_.resize(context_symbols_.size());
     for (int i = 0; i < context_symbols_.size(); ++i) {
       uint32_t num_symbols;
@@ -198,14 +206,16 @@ class MeshEdgebreakerTraversalValenceDecoder
 
  private:
   const CornerTable *corner_table_;
+  // Optional arena for the valences and the decoded symbols.
+  Arena *arena_;
   int num_vertices_;
-  IndexTypeVector<VertexIndex, int> vertex_valences_;
+  IndexTypeVector<VertexIndex, int, ArenaAllocator<int>> vertex_valences_;
   int last_symbol_;
   int active_context_;
 
   int min_valence_;
   int max_valence_;
-  std::vector<std::vector<uint32_t>> context_symbols_;
+  std::vector<ArenaVector<uint32_t>> context_symbols_;
   // Points to the active symbol in each context.
   std::vector<int> context_counters_;
 };
@@ -17,6 +17,7 @@
 #include "draco/compression/attributes/linear_sequencer.h"
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
 #include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/core/arena.h"
 #include "draco/core/varint_decoding.h"
 
 namespace draco {
@@ -53,7 +54,7 @@ bool MeshSequentialDecoder::DecodeConnectivity() {
   if (faces_64 > 0xffffffff / 3) {
     return false;
   }
-  if (faces_64 > buffer()->remaining_size() / 3) {
+  if (!buffer()->CheckRemainingSize(3 * faces_64)) {
     // The number of faces is unreasonably high, because face indices do not
     // fit in the remaining size of the buffer.
     return false;
@@ -141,7 +142,8 @@ Status MeshSequentialDecoder::CreateAttributesDecoder(int32_t att_decoder_id) {
 
 bool MeshSequentialDecoder::DecodeAndDecompressIndices(uint32_t num_faces) {
   // Get decoded indices differences that were encoded with an entropy code.
-  std::vector<uint32_t> indices_buffer(num_faces * 3);
+  ArenaVector<uint32_t> indices_buffer(num_faces * 3, 0,
+                                       ArenaAllocator<uint32_t>(arena()));
   if (!DecodeSymbols(num_faces * 3, 1, buffer(), indices_buffer.data())) {
     return false;
   }
@@ -0,0 +1,377 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/progressive_mesh_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+namespace {
+
+constexpr int64_t kHeaderSize =
+    sizeof(kProgressiveMeshMagic) + 2 * sizeof(uint8_t);
+
+bool DecodeSymbolStream(uint32_t num_values, int num_components,
+                        DecoderBuffer *buffer, std::vector<uint32_t> *out) {
+  out->resize(num_values);
+  if (num_values == 0) {
+    return true;
+  }
+  return DecodeSymbols(num_values, num_components, buffer, out->data());
+}
+
+}  // namespace
+
+ProgressiveMeshDecoder::ProgressiveMeshDecoder()
+    : num_decoded_bytes_(0),
+      num_batches_(0),
+      num_decoded_batches_(0),
+      is_failed_(false) {}
+
+Status ProgressiveMeshDecoder::Decode(DecoderBuffer *in_buffer) {
+  if (is_failed_) {
+    return Status(Status::DRACO_ERROR, "Failed to decode progressive mesh.");
+  }
+  if (in_buffer->size() < num_decoded_bytes_) {
+    return Status(Status::DRACO_ERROR, "Progressive mesh data was removed.");
+  }
+  in_buffer->StartDecodingFrom(num_decoded_bytes_);
+  if (num_decoded_bytes_ == 0) {
+    if (in_buffer->remaining_size() < kHeaderSize) {
+      return OkStatus();
+    }
+    if (memcmp(in_buffer->data_head(), kProgressiveMeshMagic,
+               sizeof(kProgressiveMeshMagic)) != 0) {
+      is_failed_ = true;
+      return Status(Status::DRACO_ERROR, "Not a progressive mesh.");
+    }
+    in_buffer->Advance(sizeof(kProgressiveMeshMagic));
+    uint8_t version_major, version_minor;
+    in_buffer->Decode(&version_major);
+    in_buffer->Decode(&version_minor);
+    if (version_major != kProgressiveMeshVersionMajor) {
+      is_failed_ = true;
+      return Status(Status::UNKNOWN_VERSION,
+                    "Unsupported progressive mesh version.");
+    }
+    num_decoded_bytes_ = in_buffer->decoded_size();
+  }
+
+  while (!is_complete()) {
+    uint32_t unit_size;
+    if (!in_buffer->Decode(&unit_size) ||
+        in_buffer->remaining_size() < unit_size) {
+      // Wait for the rest of the unit.
+      return OkStatus();
+    }
+    DecoderBuffer unit_buffer;
+    unit_buffer.Init(in_buffer->data_head(), unit_size,
+                     DRACO_BITSTREAM_VERSION(kDracoMeshBitstreamVersionMajor,
+                                             kDracoMeshBitstreamVersionMinor));
+    const Status status = has_base_mesh() ? DecodeBatch(&unit_buffer)
+                                          : DecodeBaseMesh(&unit_buffer);
+    if (!status.ok()) {
+      is_failed_ = true;
+      return status;
+    }
+    in_buffer->Advance(unit_size);
+    num_decoded_bytes_ = in_buffer->decoded_size();
+  }
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::DecodeBaseMesh(DecoderBuffer *buffer) {
+  constexpr char kIoErrorMsg[] = "Failed to parse progressive mesh header.";
+  uint32_t num_batches, num_attributes;
+  if (!buffer->Decode(&num_batches) || !buffer->Decode(&num_attributes) ||
+      num_attributes > buffer->remaining_size()) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  modes_.resize(num_attributes);
+  transforms_.resize(num_attributes);
+  for (uint32_t i = 0; i < num_attributes; ++i) {
+    uint8_t mode;
+    if (!buffer->Decode(&mode) || mode > PROGRESSIVE_ATTRIBUTE_QUANTIZED) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    modes_[i] = static_cast<ProgressiveAttributeMode>(mode);
+    if (modes_[i] == PROGRESSIVE_ATTRIBUTE_QUANTIZED) {
+      uint8_t num_components;
+      if (!buffer->Decode(&num_components) || num_components == 0) {
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      }
+      PointAttribute att;
+      att.Init(GeometryAttribute::GENERIC, num_components, DT_FLOAT32, false,
+               0);
+      if (!transforms_[i].DecodeParameters(att, buffer)) {
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      }
+    }
+  }
+
+  Decoder decoder;
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> base_mesh,
+                         decoder.DecodeMeshFromBuffer(buffer));
+  if (base_mesh->num_attributes() != static_cast<int>(num_attributes)) {
+    return Status(Status::DRACO_ERROR, "Invalid progressive base mesh.");
+  }
+  std::vector<int> num_components(num_attributes);
+  std::vector<std::vector<int32_t>> values(num_attributes);
+  for (uint32_t i = 0; i < num_attributes; ++i) {
+    const PointAttribute &att = *base_mesh->attribute(i);
+    bool is_valid;
+    switch (modes_[i]) {
+      case PROGRESSIVE_ATTRIBUTE_INTEGER:
+        is_valid = att.data_type() != DT_INVALID &&
+                   att.data_type() != DT_FLOAT32 &&
+                   DataTypeLength(att.data_type()) <= 4;
+        break;
+      case PROGRESSIVE_ATTRIBUTE_FLOAT_BITS:
+        is_valid = att.data_type() == DT_FLOAT32;
+        break;
+      default:
+        is_valid = att.data_type() == DT_INT32 &&
+                   transforms_[i].min_values().size() ==
+                       static_cast<size_t>(att.num_components());
+        break;
+    }
+    if (!is_valid) {
+      return Status(Status::DRACO_ERROR, "Invalid progressive attribute.");
+    }
+    num_components[i] = att.num_components();
+    GetProgressiveValues(att, base_mesh->num_points(), &values[i]);
+  }
+
+  std::unique_ptr<ProgressiveMeshState> state(
+      new ProgressiveMeshState(num_components));
+  std::vector<int32_t> point_values(
+      std::accumulate(num_components.begin(), num_components.end(), 0));
+  for (PointIndex p(0); p < base_mesh->num_points(); ++p) {
+    int32_t *value = point_values.data();
+    for (uint32_t i = 0; i < num_attributes; ++i) {
+      const int32_t *const att_values =
+          &values[i][p.value() * num_components[i]];
+      value = std::copy(att_values, att_values + num_components[i], value);
+    }
+    state->AddPoint(point_values.data());
+  }
+  for (FaceIndex f(0); f < base_mesh->num_faces(); ++f) {
+    state->AddFace(base_mesh->face(f));
+  }
+  num_batches_ = num_batches;
+  state_ = std::move(state);
+  return InitMesh(*base_mesh);
+}
+
+Status ProgressiveMeshDecoder::DecodeBatch(DecoderBuffer *buffer) {
+  constexpr char kIoErrorMsg[] = "Failed to decode vertex splits.";
+  uint32_t num_splits, num_moved_faces;
+  if (!DecodeVarint(&num_splits, buffer) ||
+      !DecodeVarint(&num_moved_faces, buffer) ||
+      num_splits > state_->num_points() ||
+      num_moved_faces > 3 * static_cast<uint64_t>(state_->num_faces())) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  std::vector<uint32_t> point_deltas, moved_faces, num_new_faces;
+  if (!DecodeSymbolStream(num_splits, 1, buffer, &point_deltas) ||
+      !DecodeSymbolStream(num_moved_faces, 1, buffer, &moved_faces) ||
+      !DecodeSymbolStream(num_splits, 1, buffer, &num_new_faces)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  uint64_t total_new_faces = 0;
+  for (const uint32_t n : num_new_faces) {
+    total_new_faces += n;
+  }
+  // Every split restores at most two faces.
+  if (total_new_faces > 2 * static_cast<uint64_t>(num_splits)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  std::vector<uint32_t> new_face_neighbors, new_face_orientations;
+  if (!DecodeSymbolStream(static_cast<uint32_t>(total_new_faces), 1, buffer,
+                          &new_face_neighbors) ||
+      !DecodeSymbolStream(static_cast<uint32_t>(total_new_faces), 1, buffer,
+                          &new_face_orientations)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  const int num_attributes = state_->num_attributes();
+  std::vector<std::vector<int32_t>> att_deltas(num_attributes);
+  std::vector<uint32_t> symbols;
+  for (int i = 0; i < num_attributes; ++i) {
+    const int num_components = state_->num_components(i);
+    if (modes_[i] == PROGRESSIVE_ATTRIBUTE_FLOAT_BITS) {
+      att_deltas[i].resize(num_splits * num_components);
+      if (!buffer->Decode(att_deltas[i].data(),
+                          att_deltas[i].size() * sizeof(int32_t))) {
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      }
+      continue;
+    }
+    if (!DecodeSymbolStream(num_splits * num_components, num_components,
+                            buffer, &symbols)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    att_deltas[i].resize(symbols.size());
+    ConvertSymbolsToSignedInts(symbols.data(),
+                               static_cast<int>(symbols.size()),
+                               att_deltas[i].data());
+  }
+
+  std::vector<int32_t> predicted_values;
+  uint64_t point = 0;
+  size_t moved_face = 0;
+  size_t new_face = 0;
+  for (uint32_t i = 0; i < num_splits; ++i) {
+    point += point_deltas[i];
+    if (point >= state_->num_points() ||
+        moved_face + state_->point_faces(PointIndex(point)).size() >
+            moved_faces.size()) {
+      return Status(Status::DRACO_ERROR, kIoErrorMsg);
+    }
+    const size_t num_point_faces =
+        state_->point_faces(PointIndex(point)).size();
+    const PointIndex new_point = state_->SplitPoint(
+        PointIndex(point), moved_faces.data() + moved_face, num_new_faces[i],
+        new_face_neighbors.data() + new_face,
+        new_face_orientations.data() + new_face);
+    if (new_point == kInvalidPointIndex) {
+      return Status(Status::DRACO_ERROR, kIoErrorMsg);
+    }
+    moved_face += num_point_faces;
+    new_face += num_new_faces[i];
+    // Values are added as unsigned integers so that all deltas of float bits
+    // are well defined.
+    for (int j = 0; j < num_attributes; ++j) {
+      const int num_components = state_->num_components(j);
+      predicted_values.resize(num_components);
+      state_->PredictValues(new_point, j, modes_[j], predicted_values.data());
+      const int32_t *const deltas = &att_deltas[j][i * num_components];
+      int32_t *const values =
+          state_->point_values(new_point) + state_->value_offset(j);
+      for (int c = 0; c < num_components; ++c) {
+        values[c] = static_cast<int32_t>(
+            static_cast<uint32_t>(predicted_values[c]) +
+            static_cast<uint32_t>(deltas[c]));
+      }
+    }
+  }
+  UpdateMesh();
+  ++num_decoded_batches_;
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::InitMesh(const Mesh &base_mesh) {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  dequantizers_.resize(modes_.size());
+  for (int i = 0; i < base_mesh.num_attributes(); ++i) {
+    const PointAttribute &base_att = *base_mesh.attribute(i);
+    const DataType data_type = modes_[i] == PROGRESSIVE_ATTRIBUTE_INTEGER
+                                   ? base_att.data_type()
+                                   : DT_FLOAT32;
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->Init(base_att.attribute_type(), base_att.num_components(), data_type,
+              base_att.normalized(), 0);
+    att->set_unique_id(base_att.unique_id());
+    mesh->AddAttribute(std::move(att));
+    if (modes_[i] == PROGRESSIVE_ATTRIBUTE_QUANTIZED) {
+      const int32_t max_quantized_value =
+          (1u << static_cast<uint32_t>(transforms_[i].quantization_bits())) -
+          1;
+      if (!dequantizers_[i].Init(transforms_[i].range(),
+                                 max_quantized_value)) {
+        return Status(Status::DRACO_ERROR, "Failed to dequantize attribute.");
+      }
+    }
+  }
+  if (base_mesh.GetMetadata() != nullptr) {
+    mesh->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*base_mesh.GetMetadata())));
+  }
+  mesh_ = std::move(mesh);
+  UpdateMesh();
+  return OkStatus();
+}
+
+void ProgressiveMeshDecoder::UpdateMesh() {
+  const uint32_t num_points = state_->num_points();
+  const PointIndex first_new_point(mesh_->num_points());
+  const FaceIndex first_new_face(mesh_->num_faces());
+  mesh_->set_num_points(num_points);
+  for (int i = 0; i < mesh_->num_attributes(); ++i) {
+    mesh_->attribute(i)->Resize(num_points);
+    for (PointIndex p = first_new_point; p < num_points; ++p) {
+      StorePointValues(i, p);
+    }
+  }
+  mesh_->SetNumFaces(state_->num_faces());
+  for (FaceIndex f = first_new_face; f < state_->num_faces(); ++f) {
+    mesh_->SetFace(f, state_->face(f));
+  }
+  // Every face changed by a vertex split holds one of the new points.
+  for (PointIndex p = first_new_point; p < num_points; ++p) {
+    for (const auto &f : state_->point_faces(p)) {
+      if (f < first_new_face) {
+        mesh_->SetFace(f, state_->face(f));
+      }
+    }
+  }
+}
+
+void ProgressiveMeshDecoder::StorePointValues(int att_id, PointIndex point) {
+  PointAttribute *const att = mesh_->attribute(att_id);
+  const int32_t *const values =
+      state_->point_values(point) + state_->value_offset(att_id);
+  uint8_t *const out_data = att->GetAddress(AttributeValueIndex(point.value()));
+  if (modes_[att_id] == PROGRESSIVE_ATTRIBUTE_QUANTIZED) {
+    dequantizers_[att_id].DequantizeFloats(
+        values, 1, att->num_components(),
+        transforms_[att_id].min_values().data(),
+        reinterpret_cast<float *>(out_data));
+    return;
+  }
+  StoreProgressiveValues(values, att->num_components(), att->data_type(),
+                         out_data);
+}
+
+StatusOr<std::unique_ptr<Mesh>> ProgressiveMeshDecoder::GetMesh() const {
+  if (!has_base_mesh()) {
+    return Status(Status::DRACO_ERROR, "Base mesh is not decoded yet.");
+  }
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->set_num_points(mesh_->num_points());
+  mesh->SetNumFaces(mesh_->num_faces());
+  for (FaceIndex f(0); f < mesh_->num_faces(); ++f) {
+    mesh->SetFace(f, mesh_->face(f));
+  }
+  for (int i = 0; i < mesh_->num_attributes(); ++i) {
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->CopyFrom(*mesh_->attribute(i));
+    mesh->AddAttribute(std::move(att));
+  }
+  if (mesh_->GetMetadata() != nullptr) {
+    mesh->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*mesh_->GetMetadata())));
+  }
+  return mesh;
+}
+
+}  // namespace draco
@@ -0,0 +1,101 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/mesh/progressive_mesh_shared.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/core/status_or.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decodes meshes encoded by ProgressiveMeshEncoder while their data arrives.
+// The base mesh is available as soon as its data is decoded and each decoded
+// batch of vertex splits refines it to the next level of detail.
+//
+// Usage:
+//   ProgressiveMeshDecoder decoder;
+//   while (!decoder.is_complete()) {
+//     // Append received data to |data|.
+//     buffer.Init(data.data(), data.size());
+//     DRACO_RETURN_IF_ERROR(decoder.Decode(&buffer));
+//     if (decoder.num_decoded_batches() > rendered_batches) {
+//       // Render decoder.mesh().
+//     }
+//   }
+class ProgressiveMeshDecoder {
+ public:
+  ProgressiveMeshDecoder();
+
+  // Decodes all parts of the stream in |in_buffer| that are complete and that
+  // were not decoded by previous calls. |in_buffer| holds the stream from its
+  // start and it can hold more data on each call. Incomplete data is not an
+  // error, it is decoded by a later call once the rest of it arrives.
+  Status Decode(DecoderBuffer *in_buffer);
+
+  // Returns the mesh at the current level of detail, or nullptr before the
+  // base mesh is decoded. The attributes hold the original values, i.e.
+  // quantized attributes are dequantized. The mesh is owned by the decoder and
+  // each decoded batch only appends its new points and faces and updates the
+  // faces moved to the new points.
+  const Mesh *mesh() const { return mesh_.get(); }
+
+  // Returns a copy of mesh().
+  StatusOr<std::unique_ptr<Mesh>> GetMesh() const;
+
+  bool has_base_mesh() const { return mesh_ != nullptr; }
+  bool is_complete() const {
+    return has_base_mesh() && num_decoded_batches_ == num_batches_;
+  }
+  // Number of batches of vertex splits. Available with the base mesh.
+  int num_batches() const { return num_batches_; }
+  int num_decoded_batches() const { return num_decoded_batches_; }
+  // Number of bytes of the stream consumed by the decoder.
+  int64_t num_decoded_bytes() const { return num_decoded_bytes_; }
+
+ private:
+  Status DecodeBaseMesh(DecoderBuffer *buffer);
+  Status DecodeBatch(DecoderBuffer *buffer);
+
+  // Creates |mesh_| with the attributes of |base_mesh| and the points and
+  // faces of |state_|.
+  Status InitMesh(const Mesh &base_mesh);
+  // Adds points and faces added to |state_| since the last update to |mesh_|
+  // and updates the faces of the added points.
+  void UpdateMesh();
+  // Stores the values of attribute |att_id| of |point| in |mesh_|.
+  void StorePointValues(int att_id, PointIndex point);
+
+  int64_t num_decoded_bytes_;
+  int num_batches_;
+  int num_decoded_batches_;
+  bool is_failed_;
+  std::vector<ProgressiveAttributeMode> modes_;
+  std::vector<AttributeQuantizationTransform> transforms_;
+  std::vector<Dequantizer> dequantizers_;
+  std::unique_ptr<ProgressiveMeshState> state_;
+  // Mesh at the current level of detail.
+  std::unique_ptr<Mesh> mesh_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
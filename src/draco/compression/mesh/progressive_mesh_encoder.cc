@@ -0,0 +1,724 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/progressive_mesh_encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/compression/mesh/progressive_mesh_shared.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/varint_encoding.h"
+#include "draco/core/vector_d.h"
+
+namespace draco {
+
+namespace {
+
+// Attribute values of all points of the encoded mesh converted to int32.
+struct PortableAttribute {
+  ProgressiveAttributeMode mode;
+  AttributeQuantizationTransform transform;
+  std::vector<int32_t> values;
+};
+
+Status CreatePortableAttribute(const Mesh &mesh, int att_id,
+                               const EncoderOptions &options,
+                               PortableAttribute *out_att) {
+  const PointAttribute &att = *mesh.attribute(att_id);
+  const int num_points = mesh.num_points();
+  switch (att.data_type()) {
+    case DT_INT8:
+    case DT_UINT8:
+    case DT_INT16:
+    case DT_UINT16:
+    case DT_INT32:
+    case DT_UINT32:
+    case DT_BOOL:
+      out_att->mode = PROGRESSIVE_ATTRIBUTE_INTEGER;
+      GetProgressiveValues(att, num_points, &out_att->values);
+      return OkStatus();
+    case DT_FLOAT32:
+      break;
+    default:
+      return Status(Status::DRACO_ERROR,
+                    "Unsupported attribute type for progressive encoding.");
+  }
+  const int quantization_bits =
+      options.GetAttributeInt(att_id, "quantization_bits", -1);
+  if (quantization_bits < 1) {
+    out_att->mode = PROGRESSIVE_ATTRIBUTE_FLOAT_BITS;
+    GetProgressiveValues(att, num_points, &out_att->values);
+    return OkStatus();
+  }
+  out_att->mode = PROGRESSIVE_ATTRIBUTE_QUANTIZED;
+  bool parameters_set;
+  if (options.IsAttributeOptionSet(att_id, "quantization_origin") &&
+      options.IsAttributeOptionSet(att_id, "quantization_range")) {
+    std::vector<float> origin(att.num_components());
+    options.GetAttributeVector(att_id, "quantization_origin",
+                               att.num_components(), origin.data());
+    parameters_set = out_att->transform.SetParameters(
+        quantization_bits, origin.data(), att.num_components(),
+        options.GetAttributeFloat(att_id, "quantization_range", 1.f));
+  } else {
+    parameters_set =
+        out_att->transform.ComputeParameters(att, quantization_bits);
+  }
+  if (!parameters_set) {
+    return Status(Status::DRACO_ERROR, "Failed to quantize attribute.");
+  }
+  std::unique_ptr<PointAttribute> portable_att =
+      out_att->transform.InitTransformedAttribute(att, num_points);
+  out_att->transform.TransformAttribute(att, std::vector<PointIndex>(),
+                                        portable_att.get());
+  GetProgressiveValues(*portable_att, num_points, &out_att->values);
+  return OkStatus();
+}
+
+// Returns the values of all attributes of |point|, one attribute after
+// another.
+void GetPointValues(const std::vector<PortableAttribute> &attributes,
+                    const std::vector<int> &num_components, PointIndex point,
+                    std::vector<int32_t> *out_values) {
+  out_values->clear();
+  for (size_t i = 0; i < attributes.size(); ++i) {
+    const int32_t *const values =
+        &attributes[i].values[point.value() * num_components[i]];
+    out_values->insert(out_values->end(), values, values + num_components[i]);
+  }
+}
+
+// Half-edge collapse that merges |removed_point| into |point|.
+struct Collapse {
+  PointIndex point;
+  PointIndex removed_point;
+  // Faces where |removed_point| was replaced by |point|.
+  std::vector<FaceIndex> moved_faces;
+  // Faces that contained both points and their corners before the collapse.
+  std::vector<FaceIndex> removed_faces;
+  std::vector<Mesh::Face> removed_face_corners;
+};
+
+// Simplifies a mesh by rounds of half-edge collapses with disjoint
+// neighborhoods. The collapses of one round can be reverted in any order.
+class MeshSimplifier {
+ public:
+  MeshSimplifier(const Mesh &mesh, const PointAttribute &pos_att);
+
+  // Collapses at most |max_collapses| edges, shortest edges first.
+  void CollapseRound(int max_collapses, std::vector<Collapse> *out_collapses);
+
+  bool is_face_alive(FaceIndex face) const { return is_face_alive_[face]; }
+  const Mesh::Face &face(FaceIndex face) const { return faces_[face]; }
+  uint32_t num_faces() const { return faces_.size(); }
+  int num_points() const { return num_points_; }
+
+ private:
+  void BuildAdjacency();
+  const FaceIndex *point_faces_begin(PointIndex point) const {
+    return &adjacent_faces_[face_offsets_[point.value()]];
+  }
+  const FaceIndex *point_faces_end(PointIndex point) const {
+    return &adjacent_faces_[0] + face_offsets_[point.value() + 1];
+  }
+  void GetNeighbors(PointIndex point, std::vector<PointIndex> *out_neighbors);
+  bool IsBoundaryPoint(PointIndex point);
+  // Returns true when |point| has a face with |other_point| but without
+  // |excluded_point|.
+  bool HasFaceWith(PointIndex point, PointIndex other_point,
+                   PointIndex excluded_point) const;
+  bool CanCollapse(PointIndex point, PointIndex removed_point);
+  void PerformCollapse(PointIndex point, PointIndex removed_point,
+                       Collapse *out_collapse);
+
+  IndexTypeVector<FaceIndex, Mesh::Face> faces_;
+  IndexTypeVector<FaceIndex, bool> is_face_alive_;
+  IndexTypeVector<PointIndex, Vector3f> positions_;
+  // Points of degenerate faces are never collapsed.
+  IndexTypeVector<PointIndex, bool> is_point_fixed_;
+  IndexTypeVector<PointIndex, bool> is_point_locked_;
+  int num_points_;
+
+  // Faces of each point at the start of a round.
+  std::vector<uint32_t> face_offsets_;
+  std::vector<FaceIndex> adjacent_faces_;
+
+  std::vector<PointIndex> neighbors_;
+  std::vector<PointIndex> removed_neighbors_;
+  std::vector<PointIndex> shared_neighbors_;
+  std::vector<PointIndex> third_points_;
+};
+
+MeshSimplifier::MeshSimplifier(const Mesh &mesh, const PointAttribute &pos_att)
+    : faces_(mesh.num_faces()),
+      is_face_alive_(mesh.num_faces(), true),
+      positions_(mesh.num_points()),
+      is_point_fixed_(mesh.num_points(), false),
+      is_point_locked_(mesh.num_points(), false),
+      num_points_(0) {
+  IndexTypeVector<PointIndex, bool> is_point_used(mesh.num_points(), false);
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const Mesh::Face &face = mesh.face(f);
+    faces_[f] = face;
+    const bool is_degenerate =
+        face[0] == face[1] || face[1] == face[2] || face[2] == face[0];
+    for (int c = 0; c < 3; ++c) {
+      is_point_used[face[c]] = true;
+      if (is_degenerate) {
+        is_point_fixed_[face[c]] = true;
+      }
+    }
+  }
+  for (PointIndex p(0); p < mesh.num_points(); ++p) {
+    if (is_point_used[p]) {
+      ++num_points_;
+    }
+    pos_att.ConvertValue<float, 3>(pos_att.mapped_index(p), &positions_[p][0]);
+  }
+}
+
+void MeshSimplifier::BuildAdjacency() {
+  face_offsets_.assign(positions_.size() + 1, 0);
+  for (FaceIndex f(0); f < num_faces(); ++f) {
+    if (is_face_alive_[f]) {
+      for (int c = 0; c < 3; ++c) {
+        ++face_offsets_[faces_[f][c].value() + 1];
+      }
+    }
+  }
+  std::partial_sum(face_offsets_.begin(), face_offsets_.end(),
+                   face_offsets_.begin());
+  adjacent_faces_.resize(face_offsets_.back() + 1);
+  std::vector<uint32_t> next_face(face_offsets_.begin(),
+                                  face_offsets_.end() - 1);
+  for (FaceIndex f(0); f < num_faces(); ++f) {
+    if (is_face_alive_[f]) {
+      for (int c = 0; c < 3; ++c) {
+        adjacent_faces_[next_face[faces_[f][c].value()]++] = f;
+      }
+    }
+  }
+}
+
+void MeshSimplifier::GetNeighbors(PointIndex point,
+                                  std::vector<PointIndex> *out_neighbors) {
+  out_neighbors->clear();
+  for (const FaceIndex *f = point_faces_begin(point);
+       f != point_faces_end(point); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[*f][c] != point) {
+        out_neighbors->push_back(faces_[*f][c]);
+      }
+    }
+  }
+  std::sort(out_neighbors->begin(), out_neighbors->end());
+  out_neighbors->erase(
+      std::unique(out_neighbors->begin(), out_neighbors->end()),
+      out_neighbors->end());
+}
+
+bool MeshSimplifier::IsBoundaryPoint(PointIndex point) {
+  // An edge used by a single face is a boundary edge.
+  neighbors_.clear();
+  for (const FaceIndex *f = point_faces_begin(point);
+       f != point_faces_end(point); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[*f][c] != point) {
+        neighbors_.push_back(faces_[*f][c]);
+      }
+    }
+  }
+  std::sort(neighbors_.begin(), neighbors_.end());
+  for (size_t i = 0; i < neighbors_.size();) {
+    size_t j = i + 1;
+    while (j < neighbors_.size() && neighbors_[j] == neighbors_[i]) {
+      ++j;
+    }
+    if (j - i == 1) {
+      return true;
+    }
+    i = j;
+  }
+  return false;
+}
+
+bool MeshSimplifier::HasFaceWith(PointIndex point, PointIndex other_point,
+                                  PointIndex excluded_point) const {
+  for (const FaceIndex *f = point_faces_begin(point);
+       f != point_faces_end(point); ++f) {
+    const Mesh::Face &face = faces_[*f];
+    if (std::find(face.begin(), face.end(), other_point) != face.end() &&
+        std::find(face.begin(), face.end(), excluded_point) == face.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MeshSimplifier::CanCollapse(PointIndex point, PointIndex removed_point) {
+  if (is_point_fixed_[point] || is_point_fixed_[removed_point]) {
+    return false;
+  }
+  third_points_.clear();
+  for (const FaceIndex *f = point_faces_begin(removed_point);
+       f != point_faces_end(removed_point); ++f) {
+    const Mesh::Face &face = faces_[*f];
+    if (std::find(face.begin(), face.end(), point) == face.end()) {
+      continue;
+    }
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] != point && face[c] != removed_point) {
+        third_points_.push_back(face[c]);
+      }
+    }
+  }
+  // Only manifold edges are collapsed. Boundary points are merged only along
+  // the boundary so that the boundary is preserved.
+  if (third_points_.empty() || third_points_.size() > 2) {
+    return false;
+  }
+  if (third_points_.size() == 2 && IsBoundaryPoint(removed_point)) {
+    return false;
+  }
+  std::sort(third_points_.begin(), third_points_.end());
+
+  // Link condition: the points share no neighbors other than the third points
+  // of their shared faces.
+  GetNeighbors(point, &neighbors_);
+  GetNeighbors(removed_point, &removed_neighbors_);
+  shared_neighbors_.clear();
+  std::set_intersection(neighbors_.begin(), neighbors_.end(),
+                        removed_neighbors_.begin(), removed_neighbors_.end(),
+                        std::back_inserter(shared_neighbors_));
+  if (shared_neighbors_ != third_points_) {
+    return false;
+  }
+
+  // Every third point must remain a neighbor of |point| so that the removed
+  // faces can be restored from the neighbors of |point|.
+  for (const auto &third_point : third_points_) {
+    if (!HasFaceWith(point, third_point, removed_point) &&
+        !HasFaceWith(removed_point, third_point, point)) {
+      return false;
+    }
+  }
+
+  // Faces moved to |point| must not flip.
+  for (const FaceIndex *f = point_faces_begin(removed_point);
+       f != point_faces_end(removed_point); ++f) {
+    const Mesh::Face &face = faces_[*f];
+    if (std::find(face.begin(), face.end(), point) != face.end()) {
+      continue;
+    }
+    Vector3f corners[3];
+    for (int c = 0; c < 3; ++c) {
+      corners[c] = positions_[face[c]];
+    }
+    const Vector3f normal =
+        CrossProduct(corners[1] - corners[0], corners[2] - corners[0]);
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] == removed_point) {
+        corners[c] = positions_[point];
+      }
+    }
+    const Vector3f new_normal =
+        CrossProduct(corners[1] - corners[0], corners[2] - corners[0]);
+    if (normal.Dot(new_normal) <= 0.f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MeshSimplifier::PerformCollapse(PointIndex point,
+                                     PointIndex removed_point,
+                                     Collapse *out_collapse) {
+  out_collapse->point = point;
+  out_collapse->removed_point = removed_point;
+  for (const FaceIndex *f = point_faces_begin(removed_point);
+       f != point_faces_end(removed_point); ++f) {
+    Mesh::Face &face = faces_[*f];
+    if (std::find(face.begin(), face.end(), point) != face.end()) {
+      out_collapse->removed_faces.push_back(*f);
+      out_collapse->removed_face_corners.push_back(face);
+      is_face_alive_[*f] = false;
+      continue;
+    }
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] == removed_point) {
+        face[c] = point;
+      }
+    }
+    out_collapse->moved_faces.push_back(*f);
+  }
+  --num_points_;
+
+  // Points around the collapse can't be used by other collapses in this
+  // round.
+  GetNeighbors(point, &neighbors_);
+  GetNeighbors(removed_point, &removed_neighbors_);
+  for (const auto &p : neighbors_) {
+    is_point_locked_[p] = true;
+  }
+  for (const auto &p : removed_neighbors_) {
+    is_point_locked_[p] = true;
+  }
+  is_point_locked_[point] = true;
+  is_point_locked_[removed_point] = true;
+}
+
+void MeshSimplifier::CollapseRound(int max_collapses,
+                                   std::vector<Collapse> *out_collapses) {
+  out_collapses->clear();
+  BuildAdjacency();
+  is_point_locked_.assign(positions_.size(), false);
+
+  // Edges sorted by their squared length.
+  std::vector<std::pair<float, std::pair<PointIndex, PointIndex>>> edges;
+  edges.reserve(3 * num_faces());
+  for (FaceIndex f(0); f < num_faces(); ++f) {
+    if (!is_face_alive_[f]) {
+      continue;
+    }
+    for (int c = 0; c < 3; ++c) {
+      const PointIndex a = faces_[f][c];
+      const PointIndex b = faces_[f][(c + 1) % 3];
+      if (a < b) {
+        edges.push_back(std::make_pair((positions_[a] - positions_[b])
+                                           .SquaredNorm(),
+                                       std::make_pair(a, b)));
+      } else if (b < a) {
+        edges.push_back(std::make_pair((positions_[a] - positions_[b])
+                                           .SquaredNorm(),
+                                       std::make_pair(b, a)));
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  for (const auto &edge : edges) {
+    if (static_cast<int>(out_collapses->size()) >= max_collapses) {
+      break;
+    }
+    const PointIndex a = edge.second.first;
+    const PointIndex b = edge.second.second;
+    if (is_point_locked_[a] || is_point_locked_[b]) {
+      continue;
+    }
+    Collapse collapse;
+    if (CanCollapse(a, b)) {
+      PerformCollapse(a, b, &collapse);
+    } else if (CanCollapse(b, a)) {
+      PerformCollapse(b, a, &collapse);
+    } else {
+      continue;
+    }
+    out_collapses->push_back(std::move(collapse));
+  }
+}
+
+// Appends |payload| to |out_buffer| as one unit of the stream.
+void EncodeUnit(const EncoderBuffer &payload, EncoderBuffer *out_buffer) {
+  out_buffer->Encode(static_cast<uint32_t>(payload.size()));
+  out_buffer->Encode(payload.data(), payload.size());
+}
+
+bool EncodeSymbolStream(const std::vector<uint32_t> &symbols,
+                        int num_components, EncoderBuffer *out_buffer) {
+  if (symbols.empty()) {
+    return true;
+  }
+  return EncodeSymbols(symbols.data(), static_cast<int>(symbols.size()),
+                       num_components, nullptr, out_buffer);
+}
+
+// Vertex splits of one batch, stored as separate streams.
+struct SplitBatch {
+  std::vector<uint32_t> point_deltas;
+  std::vector<uint32_t> moved_faces;
+  std::vector<uint32_t> num_new_faces;
+  std::vector<uint32_t> new_face_neighbors;
+  std::vector<uint32_t> new_face_orientations;
+  // Value deltas of each attribute.
+  std::vector<std::vector<int32_t>> value_deltas;
+};
+
+Status EncodeBatch(const SplitBatch &batch,
+                   const std::vector<PortableAttribute> &attributes,
+                   const Mesh &mesh, EncoderBuffer *out_buffer) {
+  EncoderBuffer payload;
+  EncodeVarint(static_cast<uint32_t>(batch.point_deltas.size()), &payload);
+  EncodeVarint(static_cast<uint32_t>(batch.moved_faces.size()), &payload);
+  bool ok = EncodeSymbolStream(batch.point_deltas, 1, &payload) &&
+            EncodeSymbolStream(batch.moved_faces, 1, &payload) &&
+            EncodeSymbolStream(batch.num_new_faces, 1, &payload) &&
+            EncodeSymbolStream(batch.new_face_neighbors, 1, &payload) &&
+            EncodeSymbolStream(batch.new_face_orientations, 1, &payload);
+  std::vector<uint32_t> symbols;
+  for (size_t i = 0; ok && i < attributes.size(); ++i) {
+    const std::vector<int32_t> &deltas = batch.value_deltas[i];
+    symbols.resize(deltas.size());
+    if (attributes[i].mode == PROGRESSIVE_ATTRIBUTE_FLOAT_BITS) {
+      // Deltas of float bits are too sparse for the entropy coder.
+      payload.Encode(deltas.data(), deltas.size() * sizeof(int32_t));
+      continue;
+    }
+    ConvertSignedIntsToSymbols(deltas.data(), static_cast<int>(deltas.size()),
+                               symbols.data());
+    ok = EncodeSymbolStream(symbols, mesh.attribute(i)->num_components(),
+                            &payload);
+  }
+  if (!ok) {
+    return Status(Status::DRACO_ERROR, "Failed to encode vertex splits.");
+  }
+  EncodeUnit(payload, out_buffer);
+  return OkStatus();
+}
+
+}  // namespace
+
+ProgressiveMeshEncoder::ProgressiveMeshEncoder()
+    : base_point_ratio_(0.05f), max_batch_ratio_(0.25f) {}
+
+Status ProgressiveMeshEncoder::EncodeToBuffer(const Mesh &mesh,
+                                              const EncoderOptions &options,
+                                              EncoderBuffer *out_buffer) const {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || mesh.num_faces() == 0) {
+    return Status(Status::DRACO_ERROR, "Mesh without positions or faces.");
+  }
+  const int num_attributes = mesh.num_attributes();
+  std::vector<PortableAttribute> attributes(num_attributes);
+  for (int i = 0; i < num_attributes; ++i) {
+    DRACO_RETURN_IF_ERROR(
+        CreatePortableAttribute(mesh, i, options, &attributes[i]))
+  }
+
+  // Simplify the mesh.
+  MeshSimplifier simplifier(mesh, *pos_att);
+  const int num_base_points = std::max(
+      3, static_cast<int>(std::ceil(simplifier.num_points() *
+                                    std::max(base_point_ratio_, 0.f))));
+  std::vector<std::vector<Collapse>> rounds;
+  while (simplifier.num_points() > num_base_points) {
+    const int max_collapses = std::min(
+        simplifier.num_points() - num_base_points,
+        std::max(1, static_cast<int>(simplifier.num_points() *
+                                     max_batch_ratio_)));
+    rounds.push_back(std::vector<Collapse>());
+    simplifier.CollapseRound(max_collapses, &rounds.back());
+    if (rounds.back().empty()) {
+      rounds.pop_back();
+      break;
+    }
+  }
+
+  // Create the base mesh. Points are stored in the order of |mesh| and
+  // MeshSequentialEncoder keeps the order of the points and faces.
+  IndexTypeVector<PointIndex, PointIndex> point_map(mesh.num_points(),
+                                                    kInvalidPointIndex);
+  for (FaceIndex f(0); f < simplifier.num_faces(); ++f) {
+    if (simplifier.is_face_alive(f)) {
+      for (int c = 0; c < 3; ++c) {
+        point_map[simplifier.face(f)[c]] = PointIndex(0);
+      }
+    }
+  }
+  std::vector<PointIndex> base_points;
+  for (PointIndex p(0); p < mesh.num_points(); ++p) {
+    if (point_map[p] != kInvalidPointIndex) {
+      point_map[p] = PointIndex(static_cast<uint32_t>(base_points.size()));
+      base_points.push_back(p);
+    }
+  }
+  std::vector<int> num_components(num_attributes);
+  for (int i = 0; i < num_attributes; ++i) {
+    num_components[i] = mesh.attribute(i)->num_components();
+  }
+  ProgressiveMeshState state(num_components);
+  // Faces of |mesh| for the faces of |state|.
+  std::vector<FaceIndex> state_faces;
+  Mesh base_mesh;
+  base_mesh.set_num_points(static_cast<uint32_t>(base_points.size()));
+  std::vector<int32_t> point_values;
+  for (const auto &point : base_points) {
+    GetPointValues(attributes, num_components, point, &point_values);
+    state.AddPoint(point_values.data());
+  }
+  for (FaceIndex f(0); f < simplifier.num_faces(); ++f) {
+    if (!simplifier.is_face_alive(f)) {
+      continue;
+    }
+    Mesh::Face face;
+    for (int c = 0; c < 3; ++c) {
+      face[c] = point_map[simplifier.face(f)[c]];
+    }
+    base_mesh.AddFace(face);
+    state.AddFace(face);
+    state_faces.push_back(f);
+  }
+  for (int i = 0; i < num_attributes; ++i) {
+    const PointAttribute &src_att = *mesh.attribute(i);
+    const int num_components = src_att.num_components();
+    const DataType data_type =
+        attributes[i].mode == PROGRESSIVE_ATTRIBUTE_QUANTIZED
+            ? DT_INT32
+            : src_att.data_type();
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->Init(src_att.attribute_type(), num_components, data_type,
+              src_att.normalized(), base_points.size());
+    for (size_t j = 0; j < base_points.size(); ++j) {
+      StoreProgressiveValues(
+          &attributes[i].values[base_points[j].value() * num_components],
+          num_components, data_type,
+          att->GetAddress(AttributeValueIndex(static_cast<uint32_t>(j))));
+    }
+    const int att_id = base_mesh.AddAttribute(std::move(att));
+    base_mesh.attribute(att_id)->set_unique_id(src_att.unique_id());
+  }
+  if (mesh.GetMetadata() != nullptr) {
+    base_mesh.AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*mesh.GetMetadata())));
+  }
+  EncoderOptions base_options = EncoderOptions::CreateDefaultOptions();
+  base_options.SetSpeed(options.GetEncodingSpeed(),
+                        options.GetDecodingSpeed());
+  base_options.SetGlobalBool("compress_connectivity", true);
+  ExpertEncoder base_encoder(base_mesh);
+  base_encoder.Reset(base_options);
+  base_encoder.SetEncodingMethod(MESH_SEQUENTIAL_ENCODING);
+
+  EncoderBuffer payload;
+  payload.Encode(static_cast<uint32_t>(rounds.size()));
+  payload.Encode(static_cast<uint32_t>(num_attributes));
+  for (int i = 0; i < num_attributes; ++i) {
+    const PortableAttribute &att = attributes[i];
+    payload.Encode(static_cast<uint8_t>(att.mode));
+    if (att.mode == PROGRESSIVE_ATTRIBUTE_QUANTIZED) {
+      payload.Encode(
+          static_cast<uint8_t>(mesh.attribute(i)->num_components()));
+      if (!att.transform.EncodeParameters(&payload)) {
+        return Status(Status::DRACO_ERROR, "Failed to encode quantization.");
+      }
+    }
+  }
+  DRACO_RETURN_IF_ERROR(base_encoder.EncodeToBuffer(&payload))
+  out_buffer->Encode(kProgressiveMeshMagic, sizeof(kProgressiveMeshMagic));
+  out_buffer->Encode(kProgressiveMeshVersionMajor);
+  out_buffer->Encode(kProgressiveMeshVersionMinor);
+  EncodeUnit(payload, out_buffer);
+
+  // Encode vertex splits that revert the rounds of collapses starting from
+  // the last round. Splits of one batch are sorted by the split point.
+  IndexTypeVector<FaceIndex, int> moved_face_marks(mesh.num_faces(), -1);
+  std::vector<PointIndex> neighbors;
+  std::vector<uint32_t> moved_faces;
+  std::vector<std::pair<PointIndex, const Collapse *>> splits;
+  std::vector<int32_t> predicted_values(
+      *std::max_element(num_components.begin(), num_components.end()));
+  SplitBatch batch;
+  batch.value_deltas.resize(num_attributes);
+  int num_splits = 0;
+  for (auto round = rounds.rbegin(); round != rounds.rend(); ++round) {
+    splits.clear();
+    for (const Collapse &collapse : *round) {
+      splits.push_back(std::make_pair(point_map[collapse.point], &collapse));
+    }
+    std::sort(splits.begin(), splits.end(),
+              [](const std::pair<PointIndex, const Collapse *> &a,
+                 const std::pair<PointIndex, const Collapse *> &b) {
+                return a.first < b.first;
+              });
+    batch.point_deltas.clear();
+    batch.moved_faces.clear();
+    batch.num_new_faces.clear();
+    batch.new_face_neighbors.clear();
+    batch.new_face_orientations.clear();
+    for (std::vector<int32_t> &deltas : batch.value_deltas) {
+      deltas.clear();
+    }
+    PointIndex last_point(0);
+    for (const auto &split : splits) {
+      const PointIndex point = split.first;
+      const Collapse &collapse = *split.second;
+      batch.point_deltas.push_back(point.value() - last_point.value());
+      last_point = point;
+
+      for (const auto &f : collapse.moved_faces) {
+        moved_face_marks[f] = num_splits;
+      }
+      const size_t first_moved_face = batch.moved_faces.size();
+      for (const auto &f : state.point_faces(point)) {
+        batch.moved_faces.push_back(
+            moved_face_marks[state_faces[f.value()]] == num_splits ? 1 : 0);
+      }
+      ++num_splits;
+
+      state.GetNeighbors(point, &neighbors);
+      const size_t first_new_face = batch.new_face_neighbors.size();
+      batch.num_new_faces.push_back(
+          static_cast<uint32_t>(collapse.removed_faces.size()));
+      for (const Mesh::Face &face : collapse.removed_face_corners) {
+        const int c = static_cast<int>(
+            std::find(face.begin(), face.end(), collapse.point) -
+            face.begin());
+        const bool is_flipped = face[(c + 1) % 3] != collapse.removed_point;
+        const PointIndex neighbor =
+            point_map[face[is_flipped ? (c + 1) % 3 : (c + 2) % 3]];
+        batch.new_face_neighbors.push_back(static_cast<uint32_t>(
+            std::lower_bound(neighbors.begin(), neighbors.end(), neighbor) -
+            neighbors.begin()));
+        batch.new_face_orientations.push_back(is_flipped ? 1 : 0);
+      }
+      const PointIndex new_point = state.SplitPoint(
+          point, &batch.moved_faces[first_moved_face],
+          static_cast<int>(collapse.removed_faces.size()),
+          batch.new_face_neighbors.data() + first_new_face,
+          batch.new_face_orientations.data() + first_new_face);
+      point_map[collapse.removed_point] = new_point;
+      GetPointValues(attributes, num_components, collapse.removed_point,
+                     &point_values);
+      int32_t *const new_values = state.point_values(new_point);
+      for (int i = 0; i < num_attributes; ++i) {
+        const int offset = state.value_offset(i);
+        state.PredictValues(new_point, i, attributes[i].mode,
+                            predicted_values.data());
+        for (int c = 0; c < num_components[i]; ++c) {
+          batch.value_deltas[i].push_back(static_cast<int32_t>(
+              static_cast<uint32_t>(point_values[offset + c]) -
+              static_cast<uint32_t>(predicted_values[c])));
+        }
+      }
+      std::copy(point_values.begin(), point_values.end(), new_values);
+      state_faces.insert(state_faces.end(), collapse.removed_faces.begin(),
+                         collapse.removed_faces.end());
+    }
+    DRACO_RETURN_IF_ERROR(EncodeBatch(batch, attributes, mesh, out_buffer))
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,79 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
+
+#include "draco/compression/config/encoder_options.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Encodes a mesh as a stream of increasing levels of detail that can be
+// decoded as the data arrives (see ProgressiveMeshDecoder).
+//
+// The mesh is simplified by rounds of half-edge collapses, each of which
+// merges a point into one of its neighbors. Collapses of one round have
+// disjoint neighborhoods and they are ordered by the length of the collapsed
+// edge. The simplified base mesh is encoded with MeshSequentialEncoder and
+// every round is encoded as a batch of vertex splits that reverts it, with
+// the finest batch stored last. A vertex split stores the split point, which
+// of its faces move to the new point, the new faces and the attribute values
+// of the new point as deltas from their prediction (see
+// ProgressiveMeshState::PredictValues()).
+//
+// Float attributes with "quantization_bits" are encoded as quantized values
+// using the quantization grid of the whole mesh, so the decoded values are the
+// same as the values of a non-progressive encoding. Other float attributes are
+// encoded losslessly and the deltas of their bits are stored uncompressed.
+// Points of the decoded mesh are ordered by the level of detail in which they
+// appear. Points that are not used by any face are not encoded.
+//
+// Stream layout:
+//   kProgressiveMeshMagic, kProgressiveMeshVersionMajor,
+//   kProgressiveMeshVersionMinor
+//   uint32 size of the base mesh unit, base mesh unit:
+//     uint32 number of batches, uint32 number of attributes
+//     for each attribute: uint8 ProgressiveAttributeMode, and for quantized
+//     attributes uint8 number of components and the quantization parameters
+//     base mesh encoded by MeshSequentialEncoder
+//   uint32 size of each batch, batch
+class ProgressiveMeshEncoder {
+ public:
+  ProgressiveMeshEncoder();
+
+  // Sets the target number of points of the base mesh as a fraction of the
+  // points of the encoded mesh. The base mesh can be larger when no more
+  // points can be collapsed. Default is 0.05.
+  void SetBasePointRatio(float ratio) { base_point_ratio_ = ratio; }
+
+  // Sets the maximum number of collapses in one batch as a fraction of the
+  // points of the mesh refined by the batch. Default is 0.25.
+  void SetMaxBatchRatio(float ratio) { max_batch_ratio_ = ratio; }
+
+  // Encodes |mesh| into |out_buffer|. |options| are the options of
+  // ExpertEncoder for |mesh|.
+  Status EncodeToBuffer(const Mesh &mesh, const EncoderOptions &options,
+                        EncoderBuffer *out_buffer) const;
+
+ private:
+  float base_point_ratio_;
+  float max_batch_ratio_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
@@ -0,0 +1,152 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/progressive_mesh_decoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class ProgressiveMeshEncodingTest : public ::testing::Test {
+ protected:
+  // Returns the number of points of |mesh| that are used by its faces.
+  static int GetNumUsedPoints(const draco::Mesh &mesh) {
+    std::vector<bool> is_used(mesh.num_points(), false);
+    for (draco::FaceIndex f(0); f < mesh.num_faces(); ++f) {
+      for (int c = 0; c < 3; ++c) {
+        is_used[mesh.face(f)[c].value()] = true;
+      }
+    }
+    return static_cast<int>(std::count(is_used.begin(), is_used.end(), true));
+  }
+
+  // Verifies that |file_name| encoded progressively decodes to the same faces
+  // and attribute values as the mesh encoded by |encoder_|. The stream is
+  // decoded while it is received in chunks of |chunk_size| bytes.
+  void TestProgressiveEncoding(const std::string &file_name,
+                               int chunk_size) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder_.EncodeMeshToBuffer(*mesh, &buffer));
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> ref_mesh,
+                           decoder.DecodeMeshFromBuffer(&in_buffer));
+
+    draco::EncoderBuffer progressive_buffer;
+    DRACO_ASSERT_OK(encoder_.EncodeMeshToProgressiveBuffer(
+        *mesh, 0.05f, &progressive_buffer));
+    draco::ProgressiveMeshDecoder progressive_decoder;
+    int num_rendered_batches = -1;
+    int num_faces = 0;
+    size_t size = 0;
+    while (!progressive_decoder.is_complete()) {
+      ASSERT_LT(size, progressive_buffer.size());
+      size = std::min(size + chunk_size, progressive_buffer.size());
+      in_buffer.Init(progressive_buffer.data(), size);
+      DRACO_ASSERT_OK(progressive_decoder.Decode(&in_buffer));
+      if (!progressive_decoder.has_base_mesh() ||
+          progressive_decoder.num_decoded_batches() == num_rendered_batches) {
+        continue;
+      }
+      const draco::Mesh *const lod_mesh = progressive_decoder.mesh();
+      ASSERT_NE(lod_mesh, nullptr);
+      if (num_rendered_batches < 0 && ref_mesh->num_points() > 1000) {
+        // The base mesh of a large mesh holds a small part of the points.
+        ASSERT_LT(lod_mesh->num_points(), ref_mesh->num_points() / 5);
+      }
+      ASSERT_GT(lod_mesh->num_faces(), num_faces);
+      ASSERT_EQ(GetNumUsedPoints(*lod_mesh), lod_mesh->num_points());
+      num_faces = lod_mesh->num_faces();
+      num_rendered_batches = progressive_decoder.num_decoded_batches();
+    }
+    ASSERT_EQ(progressive_decoder.num_decoded_bytes(),
+              progressive_buffer.size());
+
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                           progressive_decoder.GetMesh());
+    // The incrementally updated mesh holds the same data as its copy.
+    const draco::Mesh &lod_mesh = *progressive_decoder.mesh();
+    ASSERT_EQ(draco::GetSortedFaces(lod_mesh, lod_mesh),
+              draco::GetSortedFaces(*decoded_mesh, *decoded_mesh));
+    for (int i = 0; i < lod_mesh.num_attributes(); ++i) {
+      const draco::PointAttribute &att = *lod_mesh.attribute(i);
+      ASSERT_EQ(memcmp(att.buffer()->data(),
+                       decoded_mesh->attribute(i)->buffer()->data(),
+                       att.size() * att.byte_stride()),
+                0);
+    }
+    ASSERT_EQ(decoded_mesh->num_points(), GetNumUsedPoints(*ref_mesh));
+    ASSERT_EQ(decoded_mesh->num_attributes(), ref_mesh->num_attributes());
+    ASSERT_EQ(draco::GetSortedFaces(*decoded_mesh, *ref_mesh),
+              draco::GetSortedFaces(*ref_mesh, *ref_mesh));
+  }
+
+  draco::Encoder encoder_;
+};
+
+TEST_F(ProgressiveMeshEncodingTest, TestQuantizedEncoding) {
+  encoder_.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder_.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+  TestProgressiveEncoding("bun_zipper.ply", 4096);
+  TestProgressiveEncoding("cube_att.obj", 16);
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestLosslessEncoding) {
+  // Attributes are encoded without quantization.
+  TestProgressiveEncoding("bun_zipper.ply", 100000);
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestCorruptedData) {
+  // Tests that corrupted progressive streams are rejected.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder_.EncodeMeshToProgressiveBuffer(*mesh, 0.05f,
+                                                         &buffer));
+  std::vector<char> data(buffer.data(), buffer.data() + buffer.size());
+  draco::DecoderBuffer in_buffer;
+  // Invalid magic.
+  data[0] = 'X';
+  in_buffer.Init(data.data(), data.size());
+  draco::ProgressiveMeshDecoder decoder;
+  ASSERT_FALSE(decoder.Decode(&in_buffer).ok());
+
+  // Invalid number of vertex splits in the first batch.
+  data[0] = buffer.data()[0];
+  uint32_t base_size;
+  std::memcpy(&base_size, data.data() + 10, sizeof(base_size));
+  const size_t batch_start = 10 + 4 + base_size + 4;
+  ASSERT_LT(batch_start + 5, data.size());
+  const char num_splits[5] = {'\xff', '\xff', '\xff', '\xff', '\x0f'};
+  std::memcpy(data.data() + batch_start, num_splits, sizeof(num_splits));
+  draco::ProgressiveMeshDecoder base_decoder;
+  in_buffer.Init(data.data(), data.size());
+  ASSERT_FALSE(base_decoder.Decode(&in_buffer).ok());
+  ASSERT_TRUE(base_decoder.has_base_mesh());
+  ASSERT_FALSE(base_decoder.is_complete());
+}
+
+}  // namespace
@@ -0,0 +1,222 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/progressive_mesh_shared.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace draco {
+
+namespace {
+
+template <typename T>
+void GetValues(const PointAttribute &att, int num_points,
+               std::vector<int32_t> *out_values) {
+  const int num_components = att.num_components();
+  std::vector<T> value(num_components);
+  out_values->resize(num_points * num_components);
+  for (PointIndex p(0); p < num_points; ++p) {
+    att.GetMappedValue(p, value.data());
+    for (int c = 0; c < num_components; ++c) {
+      (*out_values)[p.value() * num_components + c] =
+          static_cast<int32_t>(value[c]);
+    }
+  }
+}
+
+template <typename T>
+void StoreValues(const int32_t *values, int num_values, uint8_t *out_data) {
+  for (int i = 0; i < num_values; ++i) {
+    const T value = static_cast<T>(values[i]);
+    memcpy(out_data + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
+}  // namespace
+
+void GetProgressiveValues(const PointAttribute &att, int num_points,
+                          std::vector<int32_t> *out_values) {
+  switch (att.data_type()) {
+    case DT_INT8:
+      GetValues<int8_t>(att, num_points, out_values);
+      break;
+    case DT_UINT8:
+    case DT_BOOL:
+      GetValues<uint8_t>(att, num_points, out_values);
+      break;
+    case DT_INT16:
+      GetValues<int16_t>(att, num_points, out_values);
+      break;
+    case DT_UINT16:
+      GetValues<uint16_t>(att, num_points, out_values);
+      break;
+    case DT_UINT32:
+      GetValues<uint32_t>(att, num_points, out_values);
+      break;
+    default:
+      // DT_INT32 and DT_FLOAT32 are copied as they are.
+      GetValues<int32_t>(att, num_points, out_values);
+      break;
+  }
+}
+
+void StoreProgressiveValues(const int32_t *values, int num_values,
+                            DataType data_type, uint8_t *out_data) {
+  switch (data_type) {
+    case DT_INT8:
+      StoreValues<int8_t>(values, num_values, out_data);
+      break;
+    case DT_UINT8:
+    case DT_BOOL:
+      StoreValues<uint8_t>(values, num_values, out_data);
+      break;
+    case DT_INT16:
+      StoreValues<int16_t>(values, num_values, out_data);
+      break;
+    case DT_UINT16:
+      StoreValues<uint16_t>(values, num_values, out_data);
+      break;
+    case DT_UINT32:
+      StoreValues<uint32_t>(values, num_values, out_data);
+      break;
+    default:
+      StoreValues<int32_t>(values, num_values, out_data);
+      break;
+  }
+}
+
+ProgressiveMeshState::ProgressiveMeshState(
+    const std::vector<int> &num_components)
+    : num_components_(num_components),
+      value_offsets_(num_components.size(), 0),
+      num_point_values_(std::accumulate(num_components.begin(),
+                                        num_components.end(), 0)) {
+  for (size_t i = 1; i < num_components.size(); ++i) {
+    value_offsets_[i] = value_offsets_[i - 1] + num_components[i - 1];
+  }
+}
+
+PointIndex ProgressiveMeshState::AddPoint(const int32_t *values) {
+  values_.insert(values_.end(), values, values + num_point_values_);
+  point_faces_.push_back(std::vector<FaceIndex>());
+  return PointIndex(num_points() - 1);
+}
+
+void ProgressiveMeshState::AddFace(const Mesh::Face &face) {
+  const FaceIndex face_index(num_faces());
+  faces_.push_back(face);
+  for (int c = 0; c < 3; ++c) {
+    point_faces_[face[c]].push_back(face_index);
+  }
+}
+
+void ProgressiveMeshState::GetNeighbors(
+    PointIndex point, std::vector<PointIndex> *out_neighbors) {
+  out_neighbors->clear();
+  for (const auto &f : point_faces_[point]) {
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[f][c] != point) {
+        out_neighbors->push_back(faces_[f][c]);
+      }
+    }
+  }
+  std::sort(out_neighbors->begin(), out_neighbors->end());
+  out_neighbors->erase(
+      std::unique(out_neighbors->begin(), out_neighbors->end()),
+      out_neighbors->end());
+}
+
+PointIndex ProgressiveMeshState::SplitPoint(
+    PointIndex point, const uint32_t *moved_faces, int num_new_faces,
+    const uint32_t *new_face_neighbors,
+    const uint32_t *new_face_orientations) {
+  if (point >= num_points()) {
+    return kInvalidPointIndex;
+  }
+  GetNeighbors(point, &neighbors_);
+  for (int i = 0; i < num_new_faces; ++i) {
+    if (new_face_neighbors[i] >= neighbors_.size() ||
+        new_face_orientations[i] > 1) {
+      return kInvalidPointIndex;
+    }
+  }
+
+  const PointIndex new_point(num_points());
+  values_.resize(values_.size() + num_point_values_);
+  std::copy(point_values(point), point_values(point) + num_point_values_,
+            point_values(new_point));
+  point_faces_.push_back(std::vector<FaceIndex>());
+
+  std::vector<FaceIndex> &faces = point_faces_[point];
+  std::vector<FaceIndex> &new_faces = point_faces_[new_point];
+  size_t num_kept_faces = 0;
+  for (size_t i = 0; i < faces.size(); ++i) {
+    const FaceIndex f = faces[i];
+    if (moved_faces[i] == 0) {
+      faces[num_kept_faces++] = f;
+      continue;
+    }
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[f][c] == point) {
+        faces_[f][c] = new_point;
+      }
+    }
+    new_faces.push_back(f);
+  }
+  faces.resize(num_kept_faces);
+
+  for (int i = 0; i < num_new_faces; ++i) {
+    const PointIndex neighbor = neighbors_[new_face_neighbors[i]];
+    if (new_face_orientations[i] == 0) {
+      AddFace({{point, new_point, neighbor}});
+    } else {
+      AddFace({{point, neighbor, new_point}});
+    }
+  }
+  return new_point;
+}
+
+void ProgressiveMeshState::PredictValues(PointIndex point, int att_id,
+                                         ProgressiveAttributeMode mode,
+                                         int32_t *out_values) {
+  const int num_components = num_components_[att_id];
+  const int32_t *const values = point_values(point) + value_offsets_[att_id];
+  GetNeighbors(point, &neighbors_);
+  if (mode != PROGRESSIVE_ATTRIBUTE_QUANTIZED || neighbors_.empty()) {
+    std::copy(values, values + num_components, out_values);
+    return;
+  }
+  value_sums_.assign(num_components, 0);
+  for (const auto &neighbor : neighbors_) {
+    const int32_t *const neighbor_values =
+        point_values(neighbor) + value_offsets_[att_id];
+    for (int c = 0; c < num_components; ++c) {
+      value_sums_[c] += neighbor_values[c];
+    }
+  }
+  const int64_t num_neighbors = static_cast<int64_t>(neighbors_.size());
+  for (int c = 0; c < num_components; ++c) {
+    // Rounds towards negative infinity so that the prediction does not depend
+    // on the sign of the values.
+    int64_t mean = value_sums_[c] / num_neighbors;
+    if (mean * num_neighbors > value_sums_[c]) {
+      --mean;
+    }
+    out_values[c] = static_cast<int32_t>(mean);
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,119 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Shared declarations used by both progressive mesh encoder and decoder.
+
+// Conversion of attribute values to the int32 values that are refined by
+// vertex splits.
+enum ProgressiveAttributeMode {
+  // Integer attributes stored as they are.
+  PROGRESSIVE_ATTRIBUTE_INTEGER = 0,
+  // Float attributes stored as the bits of their values.
+  PROGRESSIVE_ATTRIBUTE_FLOAT_BITS,
+  // Float attributes stored as quantized values.
+  PROGRESSIVE_ATTRIBUTE_QUANTIZED,
+};
+
+// Returns the values of all points of |att| as int32. The attribute must have
+// an integer data type or DT_FLOAT32, whose bits are returned.
+void GetProgressiveValues(const PointAttribute &att, int num_points,
+                          std::vector<int32_t> *out_values);
+
+// Stores |num_values| int32 |values| into |out_data| as values of
+// |data_type|, which is an integer data type or DT_FLOAT32 for float bits.
+void StoreProgressiveValues(const int32_t *values, int num_values,
+                            DataType data_type, uint8_t *out_data);
+
+// Connectivity and int32 attribute values of a progressive mesh at one level
+// of detail. Both the encoder and the decoder refine the state with the same
+// vertex splits, so the encoder can describe every split using the point and
+// face indices seen by the decoder.
+class ProgressiveMeshState {
+ public:
+  // Creates an empty state for attributes with |num_components| per point.
+  explicit ProgressiveMeshState(const std::vector<int> &num_components);
+
+  // Adds a point with attribute values |values| that hold the values of all
+  // attributes, one attribute after another.
+  PointIndex AddPoint(const int32_t *values);
+  void AddFace(const Mesh::Face &face);
+
+  // Sorted indices of points that share a face with |point|.
+  void GetNeighbors(PointIndex point, std::vector<PointIndex> *out_neighbors);
+
+  // Splits |point| by adding a new point with the attribute values of
+  // |point|. Faces of |point| selected by |moved_faces| (one entry in the
+  // order of point_faces(|point|)) are moved to the new point. New faces are
+  // added for |num_new_faces| neighbors of |point| with indices
+  // |new_face_neighbors| into GetNeighbors(). A new face with
+  // |new_face_orientations| 0 is {point, new point, neighbor} and
+  // {point, neighbor, new point} otherwise. Returns the index of the new point
+  // or an invalid index for invalid input.
+  PointIndex SplitPoint(PointIndex point, const uint32_t *moved_faces,
+                        int num_new_faces, const uint32_t *new_face_neighbors,
+                        const uint32_t *new_face_orientations);
+
+  // Predicts the values of attribute |att_id| of |point| that was just added
+  // by SplitPoint(). Quantized values are predicted by the mean of the values
+  // of the neighbors of |point|. Other values are predicted by the values of
+  // the split point.
+  void PredictValues(PointIndex point, int att_id,
+                     ProgressiveAttributeMode mode, int32_t *out_values);
+
+  // Faces of |point| in increasing order.
+  const std::vector<FaceIndex> &point_faces(PointIndex point) const {
+    return point_faces_[point];
+  }
+  const Mesh::Face &face(FaceIndex face) const { return faces_[face]; }
+  const int32_t *point_values(PointIndex point) const {
+    return values_.data() + point.value() * num_point_values_;
+  }
+  int32_t *point_values(PointIndex point) {
+    return values_.data() + point.value() * num_point_values_;
+  }
+  // Offset of the values of attribute |att_id| in point_values().
+  int value_offset(int att_id) const { return value_offsets_[att_id]; }
+  int num_attributes() const {
+    return static_cast<int>(num_components_.size());
+  }
+  int num_components(int att_id) const { return num_components_[att_id]; }
+  uint32_t num_points() const { return point_faces_.size(); }
+  uint32_t num_faces() const { return faces_.size(); }
+
+ private:
+  std::vector<int> num_components_;
+  std::vector<int> value_offsets_;
+  // Number of attribute values of each point.
+  int num_point_values_;
+  std::vector<int32_t> values_;
+  IndexTypeVector<FaceIndex, Mesh::Face> faces_;
+  IndexTypeVector<PointIndex, std::vector<FaceIndex>> point_faces_;
+  std::vector<PointIndex> neighbors_;
+  std::vector<int64_t> value_sums_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
@@ -46,7 +46,7 @@ namespace draco {
 // please see depth_first_traverser.h.
 template <class CornerTableT, class TraversalObserverT>
 class MaxPredictionDegreeTraverser
-    : public TraverserBase<CornerTable, TraversalObserverT> {
+    : public TraverserBase<CornerTableT, TraversalObserverT> {
  public:
   typedef CornerTableT CornerTable;
   typedef TraversalObserverT TraversalObserver;
@@ -0,0 +1,262 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh_buffer_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "draco/attributes/attribute_octahedron_transform.h"
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/attributes/normal_compression_utils.h"
+#include "draco/core/quantization_utils.h"
+
+namespace draco {
+
+namespace {
+
+// Number of points whose values are transformed together.
+constexpr int kNumPointsPerChunk = 256;
+
+// Copies |num_points| values of |num_components| floats from |values| to
+// |out_data| that holds one value every |stride| bytes. Missing components
+// are filled with zeros.
+void StoreFloatValues(const float *values, int num_components, int num_points,
+                      int out_num_components, int64_t stride,
+                      uint8_t *out_data) {
+  const int num_copied = std::min(num_components, out_num_components);
+  const int num_zeros = out_num_components - num_copied;
+  for (int i = 0; i < num_points; ++i) {
+    std::memcpy(out_data, values, num_copied * sizeof(float));
+    if (num_zeros > 0) {
+      std::memset(out_data + num_copied * sizeof(float), 0,
+                  num_zeros * sizeof(float));
+    }
+    values += num_components;
+    out_data += stride;
+  }
+}
+
+// Returns the portable values of |num_points| points starting at
+// |first_point|. The values are gathered into |scratch| when they are not
+// stored in the order of the points.
+const int32_t *GetPortableValues(const PointAttribute &att,
+                                 PointIndex first_point, int num_points,
+                                 int32_t *scratch) {
+  const int num_components = att.num_components();
+  const int64_t value_size = num_components * sizeof(int32_t);
+  if (att.is_mapping_identity() && att.byte_stride() == value_size) {
+    return reinterpret_cast<const int32_t *>(
+        att.GetAddress(AttributeValueIndex(first_point.value())));
+  }
+  for (int i = 0; i < num_points; ++i) {
+    std::memcpy(scratch + i * num_components,
+                att.GetAddress(att.mapped_index(first_point + i)), value_size);
+  }
+  return scratch;
+}
+
+// Writes original values of attribute |att| holding portable values of an
+// attribute transform.
+Status WriteTransformedAttribute(const PointAttribute &att,
+                                 const VertexBufferAttribute &out_att,
+                                 int num_points, int64_t stride,
+                                 uint8_t *out_data) {
+  if (out_att.data_type != DT_FLOAT32) {
+    return Status(Status::DRACO_ERROR,
+                  "Transformed attributes can be written only as floats.");
+  }
+  if (att.data_type() != DT_INT32 && att.data_type() != DT_UINT32) {
+    return Status(Status::DRACO_ERROR, "Unsupported portable attribute.");
+  }
+  const int num_components = att.num_components();
+  std::vector<int32_t> scratch(kNumPointsPerChunk * num_components);
+  std::vector<float> values(kNumPointsPerChunk * 3);
+  const AttributeTransformType transform_type =
+      att.GetAttributeTransformData()->transform_type();
+
+  if (transform_type == ATTRIBUTE_QUANTIZATION_TRANSFORM) {
+    AttributeQuantizationTransform transform;
+    if (!transform.InitFromAttribute(att)) {
+      return Status(Status::DRACO_ERROR, "Invalid quantization transform.");
+    }
+    const int32_t max_quantized_value =
+        (1u << static_cast<uint32_t>(transform.quantization_bits())) - 1;
+    Dequantizer dequantizer;
+    if (!dequantizer.Init(transform.range(), max_quantized_value)) {
+      return Status(Status::DRACO_ERROR, "Invalid quantization transform.");
+    }
+    values.resize(kNumPointsPerChunk * num_components);
+    for (int first = 0; first < num_points; first += kNumPointsPerChunk) {
+      const int n = std::min(kNumPointsPerChunk, num_points - first);
+      const int32_t *const portable_values =
+          GetPortableValues(att, PointIndex(first), n, scratch.data());
+      dequantizer.DequantizeFloats(portable_values, n, num_components,
+                                   transform.min_values().data(),
+                                   values.data());
+      StoreFloatValues(values.data(), num_components, n,
+                       out_att.num_components, stride,
+                       out_data + first * stride);
+    }
+    return OkStatus();
+  }
+  if (transform_type == ATTRIBUTE_OCTAHEDRON_TRANSFORM) {
+    AttributeOctahedronTransform transform;
+    OctahedronToolBox octahedron_tool_box;
+    if (!transform.InitFromAttribute(att) || num_components != 2 ||
+        !octahedron_tool_box.SetQuantizationBits(
+            transform.quantization_bits())) {
+      return Status(Status::DRACO_ERROR, "Invalid octahedron transform.");
+    }
+    for (int first = 0; first < num_points; first += kNumPointsPerChunk) {
+      const int n = std::min(kNumPointsPerChunk, num_points - first);
+      const int32_t *const portable_values =
+          GetPortableValues(att, PointIndex(first), n, scratch.data());
+      octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+          portable_values, n, values.data());
+      StoreFloatValues(values.data(), 3, n, out_att.num_components, stride,
+                       out_data + first * stride);
+    }
+    return OkStatus();
+  }
+  return Status(Status::DRACO_ERROR, "Unsupported attribute transform.");
+}
+
+// Writes values of attribute |att| converted to OutT.
+template <typename OutT>
+Status WriteConvertedAttribute(const PointAttribute &att,
+                               const VertexBufferAttribute &out_att,
+                               int num_points, int64_t stride,
+                               uint8_t *out_data) {
+  const int num_components = out_att.num_components;
+  const size_t value_size = num_components * sizeof(OutT);
+  std::vector<OutT> values(kNumPointsPerChunk * num_components);
+  for (int first = 0; first < num_points; first += kNumPointsPerChunk) {
+    const int n = std::min(kNumPointsPerChunk, num_points - first);
+    if (!att.ConvertMappedValues<OutT>(PointIndex(first), n, num_components,
+                                       values.data())) {
+      return Status(Status::DRACO_ERROR, "Failed to convert attribute value.");
+    }
+    uint8_t *out = out_data + first * stride;
+    for (int i = 0; i < n; ++i) {
+      std::memcpy(out, values.data() + i * num_components, value_size);
+      out += stride;
+    }
+  }
+  return OkStatus();
+}
+
+Status WriteAttribute(const PointAttribute &att,
+                      const VertexBufferAttribute &out_att, int num_points,
+                      int64_t stride, uint8_t *out_data) {
+  if (att.GetAttributeTransformData() != nullptr) {
+    return WriteTransformedAttribute(att, out_att, num_points, stride,
+                                     out_data);
+  }
+  switch (out_att.data_type) {
+    case DT_INT8:
+      return WriteConvertedAttribute<int8_t>(att, out_att, num_points, stride,
+                                             out_data);
+    case DT_UINT8:
+      return WriteConvertedAttribute<uint8_t>(att, out_att, num_points, stride,
+                                              out_data);
+    case DT_INT16:
+      return WriteConvertedAttribute<int16_t>(att, out_att, num_points, stride,
+                                              out_data);
+    case DT_UINT16:
+      return WriteConvertedAttribute<uint16_t>(att, out_att, num_points,
+                                               stride, out_data);
+    case DT_INT32:
+      return WriteConvertedAttribute<int32_t>(att, out_att, num_points, stride,
+                                              out_data);
+    case DT_UINT32:
+      return WriteConvertedAttribute<uint32_t>(att, out_att, num_points,
+                                               stride, out_data);
+    case DT_FLOAT32:
+      return WriteConvertedAttribute<float>(att, out_att, num_points, stride,
+                                            out_data);
+    default:
+      return Status(Status::DRACO_ERROR, "Unsupported output data type.");
+  }
+}
+
+template <typename IndexT>
+void WriteFaces(const Mesh &mesh, IndexT *out_indices) {
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const Mesh::Face &face = mesh.face(f);
+    for (int c = 0; c < 3; ++c) {
+      *out_indices++ = static_cast<IndexT>(face[c].value());
+    }
+  }
+}
+
+}  // namespace
+
+Status WriteMeshToBuffers(const Mesh &mesh, const MeshBufferLayout &layout) {
+  const int num_points = mesh.num_points();
+  if (!layout.attributes.empty() && num_points > 0) {
+    if (layout.vertex_data == nullptr || layout.vertex_stride <= 0 ||
+        layout.vertex_data_size < num_points * layout.vertex_stride) {
+      return Status(Status::DRACO_ERROR, "Vertex buffer is too small.");
+    }
+  }
+  for (const VertexBufferAttribute &out_att : layout.attributes) {
+    const PointAttribute *const att =
+        mesh.GetNamedAttribute(out_att.attribute_type, out_att.attribute_index);
+    if (att == nullptr) {
+      return Status(Status::DRACO_ERROR, "Missing attribute.");
+    }
+    const int32_t component_size = DataTypeLength(out_att.data_type);
+    if (component_size <= 0 || out_att.num_components <= 0 ||
+        out_att.num_components > std::numeric_limits<int8_t>::max() ||
+        out_att.byte_offset < 0 ||
+        out_att.byte_offset + out_att.num_components * component_size >
+            layout.vertex_stride) {
+      return Status(Status::DRACO_ERROR, "Invalid vertex buffer attribute.");
+    }
+    if (num_points == 0) {
+      continue;
+    }
+    DRACO_RETURN_IF_ERROR(WriteAttribute(
+        *att, out_att, num_points, layout.vertex_stride,
+        layout.vertex_data + out_att.byte_offset))
+  }
+
+  if (layout.index_data == nullptr) {
+    return OkStatus();
+  }
+  const int64_t num_indices = 3 * static_cast<int64_t>(mesh.num_faces());
+  if (layout.index_type == DT_UINT16) {
+    if (num_points > (1 << 16)) {
+      return Status(Status::DRACO_ERROR, "Too many points for 16-bit indices.");
+    }
+    if (layout.index_data_size <
+        num_indices * static_cast<int64_t>(sizeof(uint16_t))) {
+      return Status(Status::DRACO_ERROR, "Index buffer is too small.");
+    }
+    WriteFaces(mesh, static_cast<uint16_t *>(layout.index_data));
+  } else if (layout.index_type == DT_UINT32) {
+    if (layout.index_data_size <
+        num_indices * static_cast<int64_t>(sizeof(uint32_t))) {
+      return Status(Status::DRACO_ERROR, "Index buffer is too small.");
+    }
+    WriteFaces(mesh, static_cast<uint32_t *>(layout.index_data));
+  } else {
+    return Status(Status::DRACO_ERROR, "Unsupported index type.");
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,91 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_BUFFER_WRITER_H_
+#define DRACO_COMPRESSION_MESH_BUFFER_WRITER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/core/draco_types.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Location and format of one attribute within a caller-owned interleaved
+// vertex buffer.
+struct VertexBufferAttribute {
+  VertexBufferAttribute()
+      : attribute_type(GeometryAttribute::INVALID),
+        attribute_index(0),
+        data_type(DT_FLOAT32),
+        num_components(0),
+        byte_offset(0) {}
+
+  // The written attribute is the |attribute_index|-th attribute of
+  // |attribute_type| (see PointCloud::GetNamedAttribute()).
+  GeometryAttribute::Type attribute_type;
+  int attribute_index;
+
+  // Format of the written values. Components missing in the attribute are
+  // filled with zeros and extra components of the attribute are dropped.
+  // Attributes decoded with a skipped attribute transform, such as quantized
+  // positions or octahedral normals, can be written only as DT_FLOAT32.
+  DataType data_type;
+  int num_components;
+
+  // Offset of the first component from the start of each vertex.
+  int64_t byte_offset;
+};
+
+// Caller-owned output buffers of a mesh. Vertex |i| is written at
+// |vertex_data| + i * |vertex_stride| and it holds the values of point |i| of
+// the mesh. Separate (non-interleaved) arrays can be described by one layout
+// per array.
+struct MeshBufferLayout {
+  MeshBufferLayout()
+      : vertex_data(nullptr),
+        vertex_data_size(0),
+        vertex_stride(0),
+        index_data(nullptr),
+        index_data_size(0),
+        index_type(DT_UINT32) {}
+
+  uint8_t *vertex_data;
+  // Size of |vertex_data| in bytes.
+  int64_t vertex_data_size;
+  int64_t vertex_stride;
+  std::vector<VertexBufferAttribute> attributes;
+
+  // Point indices of the faces, three per face. Faces are not written when
+  // |index_data| is null.
+  void *index_data;
+  // Size of |index_data| in bytes.
+  int64_t index_data_size;
+  // Either DT_UINT16 or DT_UINT32.
+  DataType index_type;
+};
+
+// Writes point values of the attributes and the faces of |mesh| into the
+// buffers described by |layout|. Attributes that hold portable values and
+// the data of their attribute transform, i.e. attributes decoded with
+// Decoder::SetSkipAttributeTransform(), are transformed back to their
+// original values while they are written.
+Status WriteMeshToBuffers(const Mesh &mesh, const MeshBufferLayout &layout);
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_BUFFER_WRITER_H_
@@ -14,17 +14,65 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+
+#include "draco/compression/point_cloud/split_attribute_names.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/varint_decoding.h"
 #include "draco/io/file_utils.h"
 #include "draco/metadata/metadata_decoder.h"
 
 namespace draco {
 
+namespace {
+
+// Returns an error when the bitstream version |major|.|minor| of geometry
+// |encoder_type| cannot be decoded.
+Status CheckBitstreamVersion(uint8_t encoder_type, uint8_t major,
+                             uint8_t minor) {
+  const uint8_t max_supported_major_version =
+      encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMajor
+                                  : kDracoMeshBitstreamVersionMajor;
+  const uint8_t latest_minor_version =
+      encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMinor
+                                  : kDracoMeshBitstreamVersionMinor;
+  // Interleaved rANS and attribute sizes bitstreams are the only ones newer
+  // than the latest version that is written by default.
+  const uint8_t max_supported_minor_version =
+      encoder_type == POINT_CLOUD ? kDracoPointCloudAttributeSizesVersionMinor
+                                  : kDracoMeshAttributeSizesVersionMinor;
+
+  // Check for version compatibility.
+#ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
+  (void)latest_minor_version;
+  if (major < 1 || major > max_supported_major_version) {
+    return Status(Status::UNKNOWN_VERSION, "Unknown major version.");
+  }
+  if (major == max_supported_major_version &&
+      minor > max_supported_minor_version) {
+    return Status(Status::UNKNOWN_VERSION, "Unknown minor version.");
+  }
+#else
+  if (major != max_supported_major_version) {
+    return Status(Status::UNKNOWN_VERSION, "Unsupported major version.");
+  }
+  if (minor < latest_minor_version || minor > max_supported_minor_version) {
+    return Status(Status::UNKNOWN_VERSION, "Unsupported minor version.");
+  }
+#endif
+  return OkStatus();
+}
+
+}  // namespace
+
 PointCloudDecoder::PointCloudDecoder()
     : point_cloud_(nullptr),
       buffer_(nullptr),
       version_major_(0),
       version_minor_(0),
-      options_(nullptr) {}
+      flags_(0),
+      options_(nullptr),
+      arena_(nullptr) {}
 
 Status PointCloudDecoder::DecodeHeader(DecoderBuffer *buffer,
                                        DracoHeader *out_header) {
@@ -67,11 +115,41 @@ Status PointCloudDecoder::DecodeMetadata() {
 Status PointCloudDecoder::Decode(const DecoderOptions &options,
                                  DecoderBuffer *in_buffer,
                                  PointCloud *out_point_cloud) {
-  options_ = &options;
+  DRACO_RETURN_IF_ERROR(StartDecoding(options, in_buffer, out_point_cloud))
+  DRACO_RETURN_IF_ERROR(DecodeAllAttributes())
+  return FinishDecoding();
+}
+
+Status PointCloudDecoder::StartDecoding(const DecoderOptions &options,
+                                        DecoderBuffer *in_buffer,
+                                        PointCloud *out_point_cloud) {
+  split_options_ = options;
+  options_ = &split_options_;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
   DracoHeader header;
   DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
+  DRACO_RETURN_IF_ERROR(InitFromHeader(header))
+  if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
+      (header.flags & METADATA_FLAG_MASK)) {
+    DRACO_RETURN_IF_ERROR(DecodeMetadata())
+  }
+  return DecodeGeometryAndAttributesDecodersData();
+}
+
+Status PointCloudDecoder::StartDecoding(const DecoderOptions &options,
+                                        const DracoHeader &header,
+                                        DecoderBuffer *in_buffer,
+                                        PointCloud *out_point_cloud) {
+  split_options_ = options;
+  options_ = &split_options_;
+  buffer_ = in_buffer;
+  point_cloud_ = out_point_cloud;
+  DRACO_RETURN_IF_ERROR(InitFromHeader(header))
+  return DecodeGeometryAndAttributesDecodersData();
+}
+
+Status PointCloudDecoder::InitFromHeader(const DracoHeader &header) {
   // Sanity check that we are really using the right decoder (mostly for cases
   // where the Decode method was called manually outside of our main API.
   if (header.encoder_type != GetGeometryType()) {
@@ -82,47 +160,81 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   // don't expose the decoding method id.
   version_major_ = header.version_major;
   version_minor_ = header.version_minor;
+  flags_ = header.flags;
 
-  const uint8_t max_supported_major_version =
-      header.encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMajor
-                                         : kDracoMeshBitstreamVersionMajor;
-  const uint8_t max_supported_minor_version =
-      header.encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMinor
-                                         : kDracoMeshBitstreamVersionMinor;
-
-  // Check for version compatibility.
-#ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
-  if (version_major_ < 1 || version_major_ > max_supported_major_version) {
-    return Status(Status::UNKNOWN_VERSION, "Unknown major version.");
-  }
-  if (version_major_ == max_supported_major_version &&
-      version_minor_ > max_supported_minor_version) {
-    return Status(Status::UNKNOWN_VERSION, "Unknown minor version.");
-  }
-#else
-  if (version_major_ != max_supported_major_version) {
-    return Status(Status::UNKNOWN_VERSION, "Unsupported major version.");
-  }
-  if (version_minor_ != max_supported_minor_version) {
-    return Status(Status::UNKNOWN_VERSION, "Unsupported minor version.");
-  }
-#endif
+  DRACO_RETURN_IF_ERROR(
+      CheckBitstreamVersion(header.encoder_type, version_major_, version_minor_))
   buffer_->set_bitstream_version(
       DRACO_BITSTREAM_VERSION(version_major_, version_minor_));
+  return OkStatus();
+}
 
-  if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
-      (header.flags & METADATA_FLAG_MASK)) {
-    DRACO_RETURN_IF_ERROR(DecodeMetadata())
-  }
+Status PointCloudDecoder::DecodeGeometryAndAttributesDecodersData() {
   if (!InitializeDecoder()) {
     return Status(Status::DRACO_ERROR, "Failed to initialize the decoder.");
   }
   if (!DecodeGeometryData()) {
     return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
   }
-  Status status = DecodePointAttributes();
-  if (!status.ok()) {
-    return status;
+  return DecodeAttributesDecodersData();
+}
+
+Status PointCloudDecoder::DecodeAttributesDecoder(int att_decoder_id,
+                                                  DecoderBuffer *in_buffer) {
+  if (att_decoder_id < 0 || att_decoder_id >= num_attributes_decoders()) {
+    return Status(Status::DRACO_ERROR, "Invalid attributes decoder id.");
+  }
+  in_buffer->set_bitstream_version(bitstream_version());
+  DRACO_RETURN_IF_ERROR(
+      attributes_decoders_[att_decoder_id]->DecodeAttributes(in_buffer))
+  PreparePortableAttributes(att_decoder_id);
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeAttributesDecoderSizes(
+    DecoderBuffer *in_buffer, std::vector<uint64_t> *out_sizes) {
+  const int num_decoders = num_attributes_decoders();
+  out_sizes->resize(num_decoders);
+  for (uint64_t &size : *out_sizes) {
+    if (!DecodeVarint(&size, in_buffer)) {
+      return Status(Status::DRACO_ERROR, "Failed to decode attribute sizes.");
+    }
+  }
+  attributes_decoder_parents_.assign(num_decoders, std::vector<int>());
+  for (int i = 0; i < num_decoders; ++i) {
+    uint32_t num_parents;
+    if (!DecodeVarint(&num_parents, in_buffer) ||
+        num_parents > static_cast<uint32_t>(i)) {
+      return Status(Status::DRACO_ERROR,
+                    "Failed to decode attribute dependencies.");
+    }
+    for (uint32_t p = 0; p < num_parents; ++p) {
+      uint32_t parent;
+      // Parents are always decoded before their children.
+      if (!DecodeVarint(&parent, in_buffer) ||
+          parent >= static_cast<uint32_t>(i)) {
+        return Status(Status::DRACO_ERROR,
+                      "Failed to decode attribute dependencies.");
+      }
+      attributes_decoder_parents_[i].push_back(parent);
+    }
+  }
+  return OkStatus();
+}
+
+bool PointCloudDecoder::has_attribute_sizes() const {
+  const uint8_t min_minor_version =
+      GetGeometryType() == POINT_CLOUD
+          ? kDracoPointCloudAttributeSizesVersionMinor
+          : kDracoMeshAttributeSizesVersionMinor;
+  return bitstream_version() >=
+             DRACO_BITSTREAM_VERSION(version_major_, min_minor_version) &&
+         (flags_ & ATTRIBUTE_SIZES_FLAG_MASK);
+}
+
+Status PointCloudDecoder::FinishDecoding() {
+  if (!OnAttributesDecoded()) {
+    return Status(Status::DRACO_ERROR, "Failed OnAttributesDecoded.");
   }
   return OkStatus();
 }
@@ -131,7 +243,8 @@ Status PointCloudDecoder::DecodeAttr(const DecoderOptions &options,
                                  DecoderBuffer *in_buffer,
                                  DracoHeader *header,
                                  PointCloud *out_point_cloud) {
-  options_ = &options;
+  split_options_ = options;
+  options_ = &split_options_;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
 
@@ -140,46 +253,7 @@ Status PointCloudDecoder::DecodeAttr(const DecoderOptions &options,
     // Skip header size
     // buffer_->Advance(11);
     DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, header))
-
-    // Sanity check that we are really using the right decoder (mostly for cases
-    // where the Decode method was called manually outside of our main API.
-    if (header->encoder_type != GetGeometryType()) {
-      return Status(Status::DRACO_ERROR,
-                    "Using incompatible decoder for the input geometry.");
-    }
-    
-    // TODO(ostava): We should check the method as well, but currently decoders
-    // don't expose the decoding method id.
-    version_major_ = header->version_major;
-    version_minor_ = header->version_minor;
-
-    const uint8_t max_supported_major_version =
-        header->encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMajor
-                                          : kDracoMeshBitstreamVersionMajor;
-    const uint8_t max_supported_minor_version =
-        header->encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMinor
-                                          : kDracoMeshBitstreamVersionMinor;
-
-    // Check for version compatibility.
-#ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
-    if (version_major_ < 1 || version_major_ > max_supported_major_version) {
-      return Status(Status::UNKNOWN_VERSION, "Unknown major version.");
-    }
-    if (version_major_ == max_supported_major_version &&
-        version_minor_ > max_supported_minor_version) {
-      return Status(Status::UNKNOWN_VERSION, "Unknown minor version.");
-    }
-#else
-    if (version_major_ != max_supported_major_version) {
-      return Status(Status::UNKNOWN_VERSION, "Unsupported major version.");
-    }
-    if (version_minor_ != max_supported_minor_version) {
-      return Status(Status::UNKNOWN_VERSION, "Unsupported minor version.");
-    }
-#endif
-    buffer_->set_bitstream_version(
-        DRACO_BITSTREAM_VERSION(version_major_, version_minor_));
-
+    DRACO_RETURN_IF_ERROR(InitFromHeader(*header))
     if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
         (header->flags & METADATA_FLAG_MASK)) {
       DRACO_RETURN_IF_ERROR(DecodeMetadata())
@@ -204,11 +278,14 @@ Status PointCloudDecoder::DecodeAttr(const DecoderOptions &options,
   return OkStatus();
 }
 
-Status PointCloudDecoder::DecodePointAttributes() {
+Status PointCloudDecoder::DecodeAttributesDecodersData() {
   uint8_t num_attributes_decoders;
   if (!buffer_->Decode(&num_attributes_decoders)) {
     return Status(Status::DRACO_ERROR, "Failed to decode num_attributes_decoders.");
   }
+  // Decoders of any previous decoding are replaced.
+  attributes_decoders_.clear();
+  attributes_decoder_parents_.clear();
   // Create all attribute decoders. This is implementation specific and the
   // derived classes can use any data encoded in the
   // PointCloudEncoder::EncodeAttributesEncoderIdentifier() call.
@@ -244,17 +321,7 @@ Status PointCloudDecoder::DecodePointAttributes() {
       attribute_to_decoder_map_[att_id] = i;
     }
   }
-
-  // Decode the actual attributes using the created attribute decoders.
-  Status status = DecodeAllAttributes();
-  if (!status.ok()) {
-    return status;
-  }
-
-  if (!OnAttributesDecoded()) {
-    return Status(Status::DRACO_ERROR, "Failed OnAttributesDecoded.");
-  }
-  return Status(Status::OK, "Decode point attributes.");
+  return OkStatus();
 }
 
 Status PointCloudDecoder::DecodePointAttributesAttr() {
@@ -317,16 +384,21 @@ Status PointCloudDecoder::DecodeAllAttributes() {
   bool split_attr = options_->GetGlobalBool("split_attr", false);
   std::string attribute_name = options_->GetGlobalString("attribute_name", "");
   uint16_t bitstream_version = buffer_->bitstream_version();
+  if (!split_attr && has_attribute_sizes()) {
+    return DecodeAllAttributesWithSizes();
+  }
 
-  for (auto &att_dec : attributes_decoders_) {
-    // TODO: Support multi attr loading
+  for (int i = 0; i < num_attributes_decoders(); ++i) {
+    auto &att_dec = attributes_decoders_[i];
+    // Use Decoder::DecodeMeshFromBufferAttrs() to load multiple attributes
+    // from a split container.
     int32_t attr_id = att_dec->GetAttributeId(0);
     if (split_attr) {
-      std::string name = point_cloud_->GetMetadataEntryStringByAttributeId(
-        attr_id, "name");
-      if (attribute_name != name) continue;
+      if (attribute_name != GetSplitAttributeName(*point_cloud_, attr_id)) {
+        continue;
+      }
 
-      point_cloud_->metadata()->attribute_metadata(attr_id)->AddEntryInt("output", 1);
+      MarkAttributesOutput(i);
       //attr_buffer_->set_bitstream_version(bitstream_version);
       Status status = att_dec->DecodeAttributes(buffer_);
       if (!status.ok()) {
@@ -343,6 +415,146 @@ Status PointCloudDecoder::DecodeAllAttributes() {
   return Status(Status::OK, "Decode the actual attributes.");
 }
 
+Status PointCloudDecoder::DecodeAllAttributesWithSizes() {
+  const int num_decoders = num_attributes_decoders();
+  std::vector<uint64_t> sizes;
+  DRACO_RETURN_IF_ERROR(DecodeAttributesDecoderSizes(buffer_, &sizes))
+  std::vector<DecoderBuffer> buffers(num_decoders);
+  for (int i = 0; i < num_decoders; ++i) {
+    if (!buffer_->CheckRemainingSize(sizes[i])) {
+      return Status(Status::DRACO_ERROR, "Invalid attribute size.");
+    }
+    buffers[i].Init(buffer_->data_head(), sizes[i],
+                    buffer_->bitstream_version());
+    buffer_->Advance(sizes[i]);
+  }
+
+  const int num_threads =
+      options_->GetGlobalInt("attribute_decoding_threads", 1);
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_decoders; ++i) {
+      DRACO_RETURN_IF_ERROR(DecodeAttributesDecoder(i, &buffers[i]))
+    }
+    return OkStatus();
+  }
+
+  // A decoder can run once the decoders of all its parent attributes are
+  // finished. Decoders are grouped into levels where each level depends only
+  // on the previous ones and all decoders of a level run concurrently.
+  std::vector<int> decoder_levels(num_decoders, 0);
+  std::vector<std::vector<int>> levels;
+  for (int i = 0; i < num_decoders; ++i) {
+    int level = 0;
+    for (const int parent : attributes_decoder_parents_[i]) {
+      level = std::max(level, decoder_levels[parent] + 1);
+    }
+    decoder_levels[i] = level;
+    if (level >= static_cast<int>(levels.size())) {
+      levels.resize(level + 1);
+    }
+    levels[level].push_back(i);
+  }
+
+  ThreadPool pool(num_threads);
+  std::vector<Status> statuses(num_decoders, OkStatus());
+  for (const std::vector<int> &level : levels) {
+    for (const int i : level) {
+      pool.Schedule([this, i, &buffers, &statuses]() {
+        statuses[i] = attributes_decoders_[i]->DecodeAttributes(&buffers[i]);
+      });
+    }
+    pool.Wait();
+    for (const int i : level) {
+      DRACO_RETURN_IF_ERROR(statuses[i])
+      PreparePortableAttributes(i);
+    }
+  }
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeSplitAttributes(int att_decoder_id,
+                                                DecoderBuffer *in_buffer) {
+  if (point_cloud_ == nullptr || att_decoder_id < 0 ||
+      att_decoder_id >= num_attributes_decoders()) {
+    return Status(Status::DRACO_ERROR, "Invalid attributes decoder id.");
+  }
+  buffer_ = in_buffer;
+  buffer_->set_bitstream_version(
+      DRACO_BITSTREAM_VERSION(version_major_, version_minor_));
+
+  MarkAttributesOutput(att_decoder_id);
+  DRACO_RETURN_IF_ERROR(
+      attributes_decoders_[att_decoder_id]->DecodeAttributes(buffer_));
+  if (!OnAttributesDecoded()) {
+    return Status(Status::DRACO_ERROR, "Failed OnAttributesDecoded.");
+  }
+  return OkStatus();
+}
+
+bool PointCloudDecoder::IsParentDecoder(int att_decoder_id) const {
+  for (const std::vector<int> &parents : attributes_decoder_parents_) {
+    if (std::find(parents.begin(), parents.end(), att_decoder_id) !=
+        parents.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PointCloudDecoder::PreparePortableAttributes(int att_decoder_id) {
+  if (!IsParentDecoder(att_decoder_id)) {
+    return;
+  }
+  // The first call sets up the point mapping of the portable attributes.
+  const AttributesDecoderInterface &att_dec =
+      *attributes_decoders_[att_decoder_id];
+  for (int i = 0; i < att_dec.GetNumAttributes(); ++i) {
+    GetPortableAttribute(att_dec.GetAttributeId(i));
+  }
+}
+
+void PointCloudDecoder::MarkAttributesOutput(int att_decoder_id) {
+  if (point_cloud_->metadata() == nullptr) {
+    return;
+  }
+  const AttributesDecoderInterface *const att_dec =
+      attributes_decoders_[att_decoder_id].get();
+  for (int i = 0; i < att_dec->GetNumAttributes(); ++i) {
+    AttributeMetadata *const att_metadata =
+        point_cloud_->metadata()->attribute_metadata(att_dec->GetAttributeId(i));
+    if (att_metadata) {
+      att_metadata->AddEntryInt("output", 1);
+    }
+  }
+}
+
+void PointCloudDecoder::InitFromDecoder(const PointCloudDecoder &decoder,
+                                        PointCloud *out_point_cloud) {
+  point_cloud_ = out_point_cloud;
+  version_major_ = decoder.version_major_;
+  version_minor_ = decoder.version_minor_;
+  options_ = decoder.options_;
+  arena_ = decoder.arena_;
+  attribute_memory_callback_ = decoder.attribute_memory_callback_;
+}
+
+bool PointCloudDecoder::ResetAttribute(PointAttribute *attribute,
+                                       size_t num_values) const {
+  if (attribute_memory_callback_) {
+    const int64_t size = num_values * attribute->num_components() *
+                         DataTypeLength(attribute->data_type());
+    uint8_t *const data = attribute_memory_callback_(*attribute, size);
+    if (data != nullptr) {
+      // Creates the buffer of the attribute when it has none yet.
+      if (attribute->buffer() == nullptr && !attribute->Reset(0)) {
+        return false;
+      }
+      attribute->buffer()->SetExternalData(data, size);
+    }
+  }
+  return attribute->Reset(num_values);
+}
+
 const PointAttribute *PointCloudDecoder::GetPortableAttribute(
     int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes()) {
@@ -15,9 +15,13 @@
 #ifndef DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 
+#include <functional>
+#include <vector>
+
 #include "draco/compression/attributes/attributes_decoder_interface.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
+#include "draco/core/arena.h"
 #include "draco/core/status.h"
 #include "draco/point_cloud/point_cloud.h"
 
@@ -40,10 +44,56 @@ class PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 PointCloud *out_point_cloud);
 
+  // Incremental decoding of the same data as Decode(), used by
+  // StreamingDecoder. StartDecoding() decodes everything that precedes the
+  // data of the attributes decoders: the header, the metadata, the geometry
+  // data (e.g. the connectivity) and the data needed by all attributes
+  // decoders. The attributes are then decoded either at once by
+  // DecodeAttributes() or by DecodeAttributesDecoder() called for every
+  // decoder in the order of their ids. FinishDecoding() completes the
+  // decoding.
+  Status StartDecoding(const DecoderOptions &options, DecoderBuffer *in_buffer,
+                       PointCloud *out_point_cloud);
+  // Same as above, but |in_buffer| starts after the header and the metadata.
+  // |header| is the already decoded header and the metadata, if any, must be
+  // already added to |out_point_cloud|. When the decoding fails because
+  // |in_buffer| ran out of data (see DecoderBuffer::out_of_data()), it can be
+  // started again with more data and a new |out_point_cloud|.
+  Status StartDecoding(const DecoderOptions &options, const DracoHeader &header,
+                       DecoderBuffer *in_buffer, PointCloud *out_point_cloud);
+  // Decodes the byte lengths of the data of all attributes decoders and the
+  // dependencies between the decoders that follow the data decoded by
+  // StartDecoding() when has_attribute_sizes() is true.
+  Status DecodeAttributesDecoderSizes(DecoderBuffer *in_buffer,
+                                      std::vector<uint64_t> *out_sizes);
+  // Decodes the attributes of |att_decoder_id| from |in_buffer|. The buffer
+  // either holds the data of this decoder only (ATTRIBUTE_SIZES_FLAG_MASK) or
+  // it starts with the data of this decoder. In the latter case, the buffer
+  // is left at the end of the data of this decoder.
+  Status DecodeAttributesDecoder(int att_decoder_id, DecoderBuffer *in_buffer);
+  // Decodes the attributes of all decoders from |in_buffer|.
+  Status DecodeAttributes(DecoderBuffer *in_buffer) {
+    buffer_ = in_buffer;
+    return DecodeAllAttributes();
+  }
+  Status FinishDecoding();
+  uint16_t flags() const { return flags_; }
+  // Returns true when the data of every attributes decoder is preceded by its
+  // byte length, i.e. when ATTRIBUTE_SIZES_FLAG_MASK is set in a bitstream
+  // version that supports it.
+  bool has_attribute_sizes() const;
+
   // The main entry point for point cloud attr decoding.
   Status DecodeAttr(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 DracoHeader *header, PointCloud *out_point_cloud);
 
+  // Decodes the attributes of the attributes decoder |att_decoder_id| from
+  // |in_buffer| that holds the data of this decoder only (e.g. a split
+  // container chunk). The base must have already been decoded with
+  // DecodeAttr(). Parent attributes (usually the position) must be decoded
+  // before their children.
+  Status DecodeSplitAttributes(int att_decoder_id, DecoderBuffer *in_buffer);
+
   Status SetAttributesDecoder(
       int att_decoder_id, std::unique_ptr<AttributesDecoderInterface> decoder) {
     if (att_decoder_id < 0) {
@@ -62,13 +112,17 @@ class PointCloudDecoder {
   // be slightly different (non-portable) across platforms. For example, for
   // attributes encoded with quantization, this method returns an attribute
   // that contains the quantized values (before the dequantization step).
-  const PointAttribute *GetPortableAttribute(int32_t point_attribute_id);
+  virtual const PointAttribute *GetPortableAttribute(
+      int32_t point_attribute_id);
 
   uint16_t bitstream_version() const {
     return DRACO_BITSTREAM_VERSION(version_major_, version_minor_);
   }
 
-  const AttributesDecoderInterface *attributes_decoder(int dec_id) {
+  AttributesDecoderInterface *attributes_decoder(int dec_id) {
+    return attributes_decoders_[dec_id].get();
+  }
+  const AttributesDecoderInterface *attributes_decoder(int dec_id) const {
     return attributes_decoders_[dec_id].get();
   }
   int32_t num_attributes_decoders() const {
@@ -85,6 +139,26 @@ class PointCloudDecoder {
 
   void SetBuffer(DecoderBuffer *buffer) { buffer_ = buffer; }
 
+  // Arena for transient data of the decoder, or nullptr when the data should
+  // be allocated on the heap. The arena must outlive the decoder and it must
+  // not be used by anything else while the decoder is alive.
+  void set_arena(Arena *arena) { arena_ = arena; }
+  Arena *arena() const { return arena_; }
+
+  // Returns caller-owned memory of at least |size| bytes for the values of
+  // |attribute|, or nullptr when the attribute should use its own memory.
+  typedef std::function<uint8_t *(const PointAttribute &attribute,
+                                  int64_t size)>
+      AttributeMemoryCallback;
+  void set_attribute_memory_callback(const AttributeMemoryCallback &callback) {
+    attribute_memory_callback_ = callback;
+  }
+
+  // Resets |attribute| of the decoded point cloud to |num_values| values. The
+  // values are stored in the memory provided by the attribute memory
+  // callback, if any, so that they are decoded in place.
+  bool ResetAttribute(PointAttribute *attribute, size_t num_values) const;
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the decoder. Called in the Decode() method.
@@ -93,7 +167,9 @@ class PointCloudDecoder {
   // Creates an attribute decoder.
   virtual Status CreateAttributesDecoder(int32_t att_decoder_id) = 0;
   virtual bool DecodeGeometryData() { return true; }
-  virtual Status DecodePointAttributes();
+  // Creates the attributes decoders and decodes the data they need before
+  // any attribute is decoded.
+  Status DecodeAttributesDecodersData();
   Status DecodePointAttributesAttr();
 
   virtual Status DecodeAllAttributes();
@@ -101,7 +177,36 @@ class PointCloudDecoder {
 
   Status DecodeMetadata();
 
+  // Sets up the decoder for the data described by |header|.
+  Status InitFromHeader(const DracoHeader &header);
+  // Decodes the geometry data and the data needed by the attributes decoders.
+  Status DecodeGeometryAndAttributesDecodersData();
+
+  // Sets up the decoder to fill |out_point_cloud| using the bitstream version
+  // and options of |decoder| without decoding any header. Used by decoders
+  // that decode attributes against an already decoded base geometry.
+  void InitFromDecoder(const PointCloudDecoder &decoder,
+                       PointCloud *out_point_cloud);
+
  private:
+  // Returns true when other attributes decoders depend on the attributes of
+  // |att_decoder_id|. Known only for bitstreams with attribute sizes.
+  bool IsParentDecoder(int att_decoder_id) const;
+
+  // Sets up the point mapping of the portable attributes of the decoder
+  // |att_decoder_id| before they are used by other decoders. Doing it once
+  // keeps the calls from the decoders running in parallel read-only.
+  void PreparePortableAttributes(int att_decoder_id);
+
+  // Marks all attributes of the decoder |att_decoder_id| for output.
+  void MarkAttributesOutput(int att_decoder_id);
+
+  // Decodes attributes stored together with the byte lengths of all attributes
+  // decoders (see ATTRIBUTE_SIZES_FLAG_MASK). When the
+  // "attribute_decoding_threads" option is larger than one, decoders are
+  // decoded in parallel once the decoders they depend on are finished.
+  Status DecodeAllAttributesWithSizes();
+
   // Point cloud that is being filled in by the decoder.
   PointCloud *point_cloud_;
 
@@ -110,6 +215,10 @@ class PointCloudDecoder {
   // Map between attribute id and decoder id.
   std::vector<int32_t> attribute_to_decoder_map_;
 
+  // Ids of the decoders holding the parent attributes of the prediction
+  // schemes of every attributes decoder, see DecodeAttributesDecoderSizes().
+  std::vector<std::vector<int>> attributes_decoder_parents_;
+
   // Input buffer holding the encoded data.
   DecoderBuffer *buffer_;
 
@@ -117,8 +226,20 @@ class PointCloudDecoder {
   uint8_t version_major_;
   uint8_t version_minor_;
 
+  // Flags of the Draco header.
+  uint16_t flags_;
+
   const DecoderOptions *options_;
 
+  // Copy of the options passed to DecodeAttr(). The decoder of a split
+  // container outlives the call, so it must not point to the caller's
+  // options.
+  DecoderOptions split_options_;
+
+  Arena *arena_;
+
+  AttributeMemoryCallback attribute_memory_callback_;
+
   uint8_t num_attributes_decoders_;
 };
 
@@ -14,6 +14,11 @@
 //
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
 
+#include <algorithm>
+
+#include "draco/compression/point_cloud/split_attribute_names.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/varint_encoding.h"
 #include "draco/io/file_utils.h"
 #include "draco/metadata/metadata_encoder.h"
 
@@ -30,11 +35,13 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
                                  EncoderBuffer *out_buffer) {
   options_ = &options;
   buffer_ = out_buffer;
+  const size_t base_offset = buffer_->size();
 
   // Cleanup from previous runs.
   attributes_encoders_.clear();
   attribute_to_encoder_map_.clear();
   attributes_encoder_ids_order_.clear();
+  split_container_.Clear();
 
   if (!point_cloud_) {
     return Status(Status::DRACO_ERROR, "Invalid input geometry.");
@@ -51,6 +58,10 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
   if (!EncodePointAttributes()) {
     return Status(Status::DRACO_ERROR, "Failed to encode point attributes.");
   }
+  if (options.GetGlobalBool("split_attr", false) &&
+      options.GetGlobalBool("split_container", false)) {
+    DRACO_RETURN_IF_ERROR(EncodeSplitContainer(base_offset));
+  }
   if (options.GetGlobalBool("store_number_of_encoded_points", false)) {
     ComputeNumberOfEncodedPoints();
   }
@@ -70,6 +81,20 @@ Status PointCloudEncoder::EncodeHeader() {
   version_minor = encoder_type == POINT_CLOUD
                       ? kDracoPointCloudBitstreamVersionMinor
                       : kDracoMeshBitstreamVersionMinor;
+  if (options_->GetGlobalInt("interleaved_rans_states", 1) > 1) {
+    // Attribute values may be encoded with SYMBOL_CODING_RAW_INTERLEAVED.
+    version_minor = encoder_type == POINT_CLOUD
+                        ? kDracoPointCloudInterleavedRAnsVersionMinor
+                        : kDracoMeshInterleavedRAnsVersionMinor;
+  }
+  const bool attribute_sizes =
+      options_->GetGlobalBool("attribute_sizes", false) &&
+      !options_->GetGlobalBool("split_attr", false);
+  if (attribute_sizes) {
+    version_minor = encoder_type == POINT_CLOUD
+                        ? kDracoPointCloudAttributeSizesVersionMinor
+                        : kDracoMeshAttributeSizesVersionMinor;
+  }
 
   buffer_->Encode(version_major);
   buffer_->Encode(version_minor);
@@ -83,6 +108,9 @@ Status PointCloudEncoder::EncodeHeader() {
   if (point_cloud_->GetMetadata()) {
     flags |= METADATA_FLAG_MASK;
   }
+  if (attribute_sizes) {
+    flags |= ATTRIBUTE_SIZES_FLAG_MASK;
+  }
   buffer_->Encode(flags);
   return OkStatus();
 }
@@ -160,42 +188,190 @@ bool PointCloudEncoder::GenerateAttributesEncoders() {
 }
 
 bool PointCloudEncoder::EncodeAllAttributes() {
-  bool split_attr = options_->GetGlobalBool("split_attr", false);
-  bool format_output = options_->GetGlobalBool("format_output", false);
-  std::string output = options_->GetGlobalString("output", "");
-  const std::string extension = output.size() > 4 ? output.substr(output.size() - 4) : ".drc";
-  output = output.size() > 4 ? output.substr(0, output.size() - 4) : "output";
-  
-  for (int att_encoder_id : attributes_encoder_ids_order_) {
-    auto &encoder = attributes_encoders_[att_encoder_id];
-    if (split_attr) {
-      EncoderBuffer buffer;
+  const bool split_attr = options_->GetGlobalBool("split_attr", false);
+  const bool attribute_sizes =
+      !split_attr && options_->GetGlobalBool("attribute_sizes", false);
+  const int num_threads =
+      options_->GetGlobalInt("attribute_encoding_threads", 1);
+  const int num_encoders =
+      static_cast<int>(attributes_encoder_ids_order_.size());
+  if (!split_attr && !attribute_sizes && num_threads <= 1) {
+    for (int i = 0; i < num_encoders; ++i) {
+      if (!attributes_encoders_[attributes_encoder_ids_order_[i]]
+               ->EncodeAttributes(buffer_)) {
+        return false;
+      }
+    }
+    return true;
+  }
 
-      if (!encoder->EncodeAttributes(&buffer)) {
+  // Every attributes encoder is encoded into its own buffer. The buffers are
+  // written out in the encoding order, so the output is the same for any
+  // number of threads.
+  std::vector<EncoderBuffer> buffers(num_encoders);
+  if (!EncodeAttributesToBuffers(num_threads, &buffers)) {
+    return false;
+  }
+  if (split_attr) {
+    return WriteSplitAttributes(buffers);
+  }
+  if (attribute_sizes) {
+    for (int i = 0; i < num_encoders; ++i) {
+      EncodeVarint(static_cast<uint64_t>(buffers[i].size()), buffer_);
+    }
+    // The dependencies between the encoders let the decoder schedule them.
+    for (const std::vector<int> &parents : GetAttributesEncoderParents()) {
+      EncodeVarint(static_cast<uint32_t>(parents.size()), buffer_);
+      for (const int parent : parents) {
+        EncodeVarint(static_cast<uint32_t>(parent), buffer_);
+      }
+    }
+  }
+  for (int i = 0; i < num_encoders; ++i) {
+    buffer_->Encode(buffers[i].data(), buffers[i].size());
+  }
+  return true;
+}
+
+bool PointCloudEncoder::EncodeAttributesToBuffers(
+    int num_threads, std::vector<EncoderBuffer> *out_buffers) {
+  const int num_encoders =
+      static_cast<int>(attributes_encoder_ids_order_.size());
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_encoders; ++i) {
+      if (!attributes_encoders_[attributes_encoder_ids_order_[i]]
+               ->EncodeAttributes(&(*out_buffers)[i])) {
         return false;
       }
+    }
+    return true;
+  }
 
-      std::string name = point_cloud_->GetMetadataEntryStringByAttributeId(
-        encoder->GetAttributeId(0), "name");
+  // An encoder can run once the encoders of all its parent attributes are
+  // finished. Encoders are grouped into levels where each level depends only
+  // on the previous ones and all encoders of a level run concurrently.
+  const std::vector<std::vector<int>> parents = GetAttributesEncoderParents();
+  std::vector<int> encoder_levels(num_encoders, 0);
+  std::vector<std::vector<int>> levels;
+  for (int i = 0; i < num_encoders; ++i) {
+    int level = 0;
+    for (const int parent : parents[i]) {
+      level = std::max(level, encoder_levels[parent] + 1);
+    }
+    encoder_levels[i] = level;
+    if (level >= static_cast<int>(levels.size())) {
+      levels.resize(level + 1);
+    }
+    levels[level].push_back(i);
+  }
 
-      // Save the encoded geometry into a file.
-      std::string filename = output + '_' + name + extension;
-      if (format_output) std::cout << "{\"file\":\"" << filename << '"';
-      if (!WriteBufferToFile(buffer.data(), buffer.size(), filename)) {
-        if (format_output) std::cout << ",\"err\":\"io\"}" << std::endl;
-        else std::cout << "Failed to create the generic output file." << std::endl;
+  ThreadPool pool(num_threads);
+  std::vector<uint8_t> results(num_encoders, 0);
+  for (const std::vector<int> &level : levels) {
+    for (const int i : level) {
+      pool.Schedule([this, i, out_buffers, &results]() {
+        results[i] = attributes_encoders_[attributes_encoder_ids_order_[i]]
+                         ->EncodeAttributes(&(*out_buffers)[i]);
+      });
+    }
+    pool.Wait();
+    for (const int i : level) {
+      if (!results[i]) {
         return false;
       }
-      if (format_output) std::cout << '}' << std::endl;
-    } else {
-      if (!encoder->EncodeAttributes(buffer_)) {
+    }
+  }
+  return true;
+}
+
+std::vector<std::vector<int>> PointCloudEncoder::GetAttributesEncoderParents()
+    const {
+  const int num_encoders =
+      static_cast<int>(attributes_encoder_ids_order_.size());
+  std::vector<int> encoder_order(attributes_encoders_.size());
+  for (int i = 0; i < num_encoders; ++i) {
+    encoder_order[attributes_encoder_ids_order_[i]] = i;
+  }
+  std::vector<std::vector<int>> parents(num_encoders);
+  for (int i = 0; i < num_encoders; ++i) {
+    const int encoder_id = attributes_encoder_ids_order_[i];
+    const AttributesEncoder *const encoder =
+        attributes_encoders_[encoder_id].get();
+    for (uint32_t j = 0; j < encoder->num_attributes(); ++j) {
+      const int32_t att_id = encoder->GetAttributeId(j);
+      for (int p = 0; p < encoder->NumParentAttributes(att_id); ++p) {
+        const int32_t parent_encoder_id =
+            attribute_to_encoder_map_[encoder->GetParentAttributeId(att_id, p)];
+        const int parent = encoder_order[parent_encoder_id];
+        if (parent_encoder_id != encoder_id &&
+            std::find(parents[i].begin(), parents[i].end(), parent) ==
+                parents[i].end()) {
+          parents[i].push_back(parent);
+        }
+      }
+    }
+  }
+  return parents;
+}
+
+bool PointCloudEncoder::WriteSplitAttributes(
+    const std::vector<EncoderBuffer> &buffers) {
+  const bool split_container =
+      options_->GetGlobalBool("split_container", false);
+  const bool format_output = options_->GetGlobalBool("format_output", false);
+  std::string output = options_->GetGlobalString("output", "");
+  const std::string extension = output.size() > 4 ? output.substr(output.size() - 4) : ".drc";
+  output = output.size() > 4 ? output.substr(0, output.size() - 4) : "output";
+  const std::vector<std::vector<int>> parents = GetAttributesEncoderParents();
+
+  for (int i = 0; i < static_cast<int>(buffers.size()); ++i) {
+    const EncoderBuffer &buffer = buffers[i];
+    const std::string name = GetSplitAttributeName(
+        *point_cloud_,
+        attributes_encoders_[attributes_encoder_ids_order_[i]]->GetAttributeId(
+            0));
+
+    if (split_container) {
+      // Attribute decoders are created in the encoding order so |i| is also
+      // the id of the decoder of this chunk.
+      const std::vector<int32_t> parent_ids(parents[i].begin(),
+                                            parents[i].end());
+      if (!split_container_.AddChunk(name, i, parent_ids, buffer.data(),
+                                     buffer.size())) {
         return false;
       }
+      continue;
     }
+
+    // Save the encoded geometry into a file.
+    std::string filename = output + '_' + name + extension;
+    if (format_output) std::cout << "{\"file\":\"" << filename << '"';
+    if (!WriteBufferToFile(buffer.data(), buffer.size(), filename)) {
+      if (format_output) std::cout << ",\"err\":\"io\"}" << std::endl;
+      else std::cout << "Failed to create the generic output file." << std::endl;
+      return false;
+    }
+    if (format_output) std::cout << '}' << std::endl;
   }
   return true;
 }
 
+Status PointCloudEncoder::EncodeSplitContainer(size_t base_offset) {
+  // Everything encoded so far into |buffer_| (starting at |base_offset|) is
+  // the base geometry. Replace it with the container holding the base and all
+  // attribute chunks.
+  split_container_.SetBase(buffer_->data() + base_offset,
+                           buffer_->size() - base_offset);
+  EncoderBuffer container_buffer;
+  if (!split_container_.Encode(&container_buffer)) {
+    return Status(Status::DRACO_ERROR, "Failed to encode split container.");
+  }
+  buffer_->Resize(base_offset);
+  buffer_->Encode(container_buffer.data(), container_buffer.size());
+  split_container_.Clear();
+  return OkStatus();
+}
+
 bool PointCloudEncoder::MarkParentAttribute(int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes()) {
     return false;
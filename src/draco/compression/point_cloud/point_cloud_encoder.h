@@ -18,6 +18,7 @@
 #include "draco/compression/attributes/attributes_encoder.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
+#include "draco/compression/point_cloud/split_container_encoder.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
 #include "draco/point_cloud/point_cloud.h"
@@ -129,6 +130,27 @@ class PointCloudEncoder {
   // Encode metadata.
   Status EncodeMetadata();
 
+  // Packs the base geometry stored in |buffer_| from |base_offset| and all
+  // attribute chunks collected in the "split_attr" mode into a single split
+  // container that replaces the base in |buffer_|. Used when the
+  // "split_container" option is set.
+  Status EncodeSplitContainer(size_t base_offset);
+
+  // Encodes every attributes encoder into its own buffer in |out_buffers|,
+  // indexed by the encoding order. With |num_threads| larger than one,
+  // encoders that do not depend on each other run concurrently.
+  bool EncodeAttributesToBuffers(int num_threads,
+                                 std::vector<EncoderBuffer> *out_buffers);
+
+  // Returns the attributes encoders that hold the parent attributes of the
+  // prediction schemes of every attributes encoder. Both the encoders and
+  // their parents are given by their index in the encoding order.
+  std::vector<std::vector<int>> GetAttributesEncoderParents() const;
+
+  // Writes attribute data encoded in the "split_attr" mode either to separate
+  // files or to the split container.
+  bool WriteSplitAttributes(const std::vector<EncoderBuffer> &buffers);
+
   // Rearranges attribute encoders and their attributes to reflect the
   // underlying attribute dependencies. This ensures that the attributes are
   // encoded in the correct order (parent attributes before their children).
@@ -151,6 +173,9 @@ class PointCloudEncoder {
   const EncoderOptions *options_;
 
   size_t num_encoded_points_;
+
+  // Attribute chunks collected when encoding into a split container.
+  SplitContainerEncoder split_container_;
 };
 
 }  // namespace draco
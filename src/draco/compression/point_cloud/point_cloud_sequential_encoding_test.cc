@@ -22,10 +22,12 @@ namespace draco {
 
 class PointCloudSequentialEncodingTest : public ::testing::Test {
  protected:
-  std::unique_ptr<PointCloud> EncodeAndDecodePointCloud(const PointCloud *pc) {
+  std::unique_ptr<PointCloud> EncodeAndDecodePointCloud(
+      const PointCloud *pc, int interleaved_rans_states = 1) {
     EncoderBuffer buffer;
     PointCloudSequentialEncoder encoder;
     EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+    options.SetGlobalInt("interleaved_rans_states", interleaved_rans_states);
     encoder.SetPointCloud(*pc);
     if (!encoder.Encode(options, &buffer).ok()) {
       return nullptr;
@@ -86,6 +88,46 @@ TEST_F(PointCloudSequentialEncodingTest, EncodingPointCloudWithMetadata) {
             pc->attribute(pos_att_id)->unique_id());
 }
 
+TEST_F(PointCloudSequentialEncodingTest, DoesDecodeLargeIntegerAttribute) {
+  // Test verifies that integer attributes with many values are decoded
+  // losslessly with both single and interleaved rANS states.
+  const int num_points = 5000;
+  const int num_components = 3;
+  PointCloud pc;
+  pc.set_num_points(num_points);
+  GeometryAttribute va;
+  va.Init(GeometryAttribute::GENERIC, nullptr, num_components, DT_INT32, false,
+          sizeof(int32_t) * num_components, 0);
+  const int att_id = pc.AddAttribute(va, true, num_points);
+  int32_t value[num_components] = {0, 100, -100};
+  uint32_t seed = 1;
+  for (PointIndex i(0); i < num_points; ++i) {
+    for (int c = 0; c < num_components; ++c) {
+      seed = seed * 1664525u + 1013904223u;
+      value[c] += static_cast<int32_t>(seed >> 28) - 8;
+    }
+    pc.attribute(att_id)->SetAttributeValue(AttributeValueIndex(i.value()),
+                                            value);
+  }
+  for (const int interleaved_rans_states : {1, 8}) {
+    std::unique_ptr<PointCloud> decoded_pc =
+        EncodeAndDecodePointCloud(&pc, interleaved_rans_states);
+    ASSERT_NE(decoded_pc.get(), nullptr);
+    ASSERT_EQ(decoded_pc->num_points(), num_points);
+    const PointAttribute *const att = pc.attribute(att_id);
+    const PointAttribute *const decoded_att = decoded_pc->attribute(att_id);
+    for (PointIndex i(0); i < num_points; ++i) {
+      int32_t expected[num_components];
+      int32_t decoded[num_components];
+      att->GetMappedValue(i, expected);
+      decoded_att->GetMappedValue(i, decoded);
+      for (int c = 0; c < num_components; ++c) {
+        ASSERT_EQ(decoded[c], expected[c]);
+      }
+    }
+  }
+}
+
 // TODO(ostava): Test the reusability of a single instance of the encoder and
 // decoder class.
 
@@ -0,0 +1,62 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_SPLIT_ATTRIBUTE_NAMES_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_SPLIT_ATTRIBUTE_NAMES_H_
+
+#include <string>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Prefix of the chunk names generated for attributes that can't be stored
+// under their own name.
+static constexpr char kSplitAttributeNamePrefix[] = "attribute_";
+// Maximum length of a chunk name in the split attribute container.
+static constexpr size_t kSplitAttributeMaxNameLength = 255;
+
+// Returns the name of the chunk holding attribute |att_id| of |pc| in the
+// "split_attr" encoding mode. This is the "name" metadata entry of the
+// attribute when it identifies the attribute unambiguously. Otherwise, e.g.
+// when the name is missing, shared by several attributes, too long or equal
+// to kSplitContainerBaseName, the name is generated from the attribute id as
+// "attribute_<id>". Names starting with kSplitAttributeNamePrefix are
+// reserved for the generated names. The name depends only on |pc| so that
+// encoders, decoders and tools compute the same name for the same attribute.
+inline std::string GetSplitAttributeName(const PointCloud &pc,
+                                         int32_t att_id) {
+  const std::string generated_name =
+      kSplitAttributeNamePrefix + std::to_string(att_id);
+  const std::string name =
+      pc.GetMetadataEntryStringByAttributeId(att_id, "name");
+  if (name.empty() || name.size() > kSplitAttributeMaxNameLength ||
+      name == kSplitContainerBaseName ||
+      name.compare(0, sizeof(kSplitAttributeNamePrefix) - 1,
+                   kSplitAttributeNamePrefix) == 0) {
+    return generated_name;
+  }
+  for (int32_t i = 0; i < pc.num_attributes(); ++i) {
+    if (i != att_id &&
+        pc.GetMetadataEntryStringByAttributeId(i, "name") == name) {
+      return generated_name;
+    }
+  }
+  return name;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_SPLIT_ATTRIBUTE_NAMES_H_
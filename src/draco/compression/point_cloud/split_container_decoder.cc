@@ -0,0 +1,147 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/point_cloud/split_container_decoder.h"
+
+#include <cstring>
+
+namespace draco {
+
+bool SplitContainerDecoder::IsSplitContainer(const char *data,
+                                             size_t data_size) {
+  if (data_size < sizeof(kSplitContainerMagic)) {
+    return false;
+  }
+  return memcmp(data, kSplitContainerMagic, sizeof(kSplitContainerMagic)) ==
+         0;
+}
+
+Status SplitContainerDecoder::DecodeHeader(DecoderBuffer *in_buffer,
+                                           uint32_t *out_toc_size) {
+  constexpr char kIoErrorMsg[] = "Failed to parse split container header.";
+  char magic[sizeof(kSplitContainerMagic)];
+  if (!in_buffer->Decode(magic, sizeof(magic))) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (!IsSplitContainer(magic, sizeof(magic))) {
+    return Status(Status::DRACO_ERROR, "Not a split container.");
+  }
+  uint8_t version_major;
+  if (!in_buffer->Decode(&version_major) ||
+      !in_buffer->Decode(&version_minor_)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (version_major != kSplitContainerVersionMajor) {
+    return Status(Status::UNKNOWN_VERSION,
+                  "Unsupported split container version.");
+  }
+  if (!in_buffer->Decode(&toc_size_)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  *out_toc_size = toc_size_;
+  return OkStatus();
+}
+
+Status SplitContainerDecoder::DecodeTableOfContents(DecoderBuffer *in_buffer) {
+  constexpr char kIoErrorMsg[] = "Failed to parse split container contents.";
+  entries_.clear();
+  if (in_buffer->remaining_size() < static_cast<int64_t>(toc_size_)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  uint32_t num_entries;
+  if (!in_buffer->Decode(&num_entries)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  // Each entry takes at least 21 bytes, use it to reject corrupted counts
+  // before we allocate anything.
+  if (static_cast<uint64_t>(num_entries) * 21 > toc_size_) {
+    return Status(Status::DRACO_ERROR, kIoErrorMsg);
+  }
+  entries_.resize(num_entries);
+  for (SplitContainerEntry &entry : entries_) {
+    uint8_t name_length;
+    if (!in_buffer->Decode(&name_length)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    entry.name.resize(name_length);
+    if (name_length > 0 && !in_buffer->Decode(&entry.name[0], name_length)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    if (!in_buffer->Decode(&entry.decoder_id) ||
+        !in_buffer->Decode(&entry.offset) || !in_buffer->Decode(&entry.size)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    if (version_minor_ >= 1) {
+      uint8_t num_parents;
+      if (!in_buffer->Decode(&num_parents)) {
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      }
+      entry.parent_decoder_ids.resize(num_parents);
+      if (num_parents > 0 &&
+          !in_buffer->Decode(&entry.parent_decoder_ids[0],
+                             num_parents * sizeof(int32_t))) {
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      }
+    }
+  }
+  return OkStatus();
+}
+
+Status SplitContainerDecoder::Decode(DecoderBuffer *in_buffer) {
+  uint32_t toc_size;
+  DRACO_RETURN_IF_ERROR(DecodeHeader(in_buffer, &toc_size));
+  return DecodeTableOfContents(in_buffer);
+}
+
+const SplitContainerEntry *SplitContainerDecoder::FindEntry(
+    const std::string &name) const {
+  for (const SplitContainerEntry &entry : entries_) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+const SplitContainerEntry *SplitContainerDecoder::FindEntryByDecoderId(
+    int32_t decoder_id) const {
+  for (const SplitContainerEntry &entry : entries_) {
+    if (entry.decoder_id == decoder_id) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+Status SplitContainerDecoder::GetChunk(const DecoderBuffer &container,
+                                       const std::string &name,
+                                       DecoderBuffer *out_buffer) const {
+  const SplitContainerEntry *const entry = FindEntry(name);
+  if (entry == nullptr) {
+    return Status(Status::DRACO_ERROR,
+                  "Split container has no chunk named " + name + ".");
+  }
+  const uint64_t container_size = static_cast<uint64_t>(container.size());
+  if (entry->offset > container_size ||
+      entry->size > container_size - entry->offset) {
+    return Status(Status::IO_ERROR, "Split container chunk out of bounds.");
+  }
+  // Note that |container| may already be advanced, we always address chunks
+  // from the beginning of the container data.
+  const char *const data = container.data_head() - container.decoded_size();
+  out_buffer->Init(data + entry->offset, static_cast<size_t>(entry->size));
+  return OkStatus();
+}
+
+}  // namespace draco
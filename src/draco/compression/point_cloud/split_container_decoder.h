@@ -0,0 +1,84 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_DECODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_DECODER_H_
+
+#include <string>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+
+namespace draco {
+
+// Class for reading the table of contents of a container produced by
+// SplitContainerEncoder. The container can be parsed either from a buffer
+// holding the whole file or in two steps from ranged reads: first
+// kSplitContainerHeaderSize bytes are passed to DecodeHeader() that returns
+// the size of the table of contents, then the table itself is passed to
+// DecodeTableOfContents(). The returned entries can then be used to fetch the
+// base geometry and the needed attribute chunks only.
+class SplitContainerDecoder {
+ public:
+  SplitContainerDecoder() : version_minor_(0), toc_size_(0) {}
+
+  // Returns true when |data| starts with the split container magic string.
+  static bool IsSplitContainer(const char *data, size_t data_size);
+
+  // Decodes the fixed-size container header from |in_buffer|. On success the
+  // size of the table of contents that follows the header is returned in
+  // |out_toc_size|.
+  Status DecodeHeader(DecoderBuffer *in_buffer, uint32_t *out_toc_size);
+
+  // Decodes the table of contents from |in_buffer|. Must be called after
+  // DecodeHeader().
+  Status DecodeTableOfContents(DecoderBuffer *in_buffer);
+
+  // Decodes both the header and the table of contents from |in_buffer|.
+  Status Decode(DecoderBuffer *in_buffer);
+
+  // Returns the entry with the given |name| or nullptr if it does not exist.
+  const SplitContainerEntry *FindEntry(const std::string &name) const;
+
+  // Returns the entry of the chunk decoded by the attributes decoder
+  // |decoder_id| or nullptr if it does not exist.
+  const SplitContainerEntry *FindEntryByDecoderId(int32_t decoder_id) const;
+
+  // Initializes |out_buffer| to the data of the chunk with the given |name|.
+  // |container| must hold the whole container (e.g. a memory mapped file).
+  // No data is copied.
+  Status GetChunk(const DecoderBuffer &container, const std::string &name,
+                  DecoderBuffer *out_buffer) const;
+
+  // Returns true when the entries list the parent attributes decoders of their
+  // chunks. Containers of version 1.0 do not store them.
+  bool has_parent_decoder_ids() const { return version_minor_ >= 1; }
+
+  int num_entries() const { return static_cast<int>(entries_.size()); }
+  const SplitContainerEntry &entry(int i) const { return entries_[i]; }
+
+  // Total size of the header and the table of contents in bytes.
+  size_t header_size() const { return kSplitContainerHeaderSize + toc_size_; }
+
+ private:
+  std::vector<SplitContainerEntry> entries_;
+  uint8_t version_minor_;
+  uint32_t toc_size_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_DECODER_H_
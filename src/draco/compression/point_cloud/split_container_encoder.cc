@@ -0,0 +1,94 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/point_cloud/split_container_encoder.h"
+
+namespace draco {
+
+SplitContainerEncoder::SplitContainerEncoder() : chunks_(1) {
+  chunks_[0].entry.name = kSplitContainerBaseName;
+}
+
+void SplitContainerEncoder::SetBase(const char *data, size_t data_size) {
+  chunks_[0].entry.size = data_size;
+  chunks_[0].data.assign(data, data + data_size);
+}
+
+bool SplitContainerEncoder::AddChunk(
+    const std::string &name, int32_t decoder_id,
+    const std::vector<int32_t> &parent_decoder_ids, const char *data,
+    size_t data_size) {
+  // Names and parents are stored with a one byte length, same as metadata
+  // strings.
+  if (name.size() > 255 || parent_decoder_ids.size() > 255) {
+    return false;
+  }
+  for (const Chunk &chunk : chunks_) {
+    if (chunk.entry.name == name) {
+      return false;
+    }
+  }
+  Chunk chunk;
+  chunk.entry.name = name;
+  chunk.entry.decoder_id = decoder_id;
+  chunk.entry.parent_decoder_ids = parent_decoder_ids;
+  chunk.entry.size = data_size;
+  chunk.data.assign(data, data + data_size);
+  chunks_.push_back(std::move(chunk));
+  return true;
+}
+
+bool SplitContainerEncoder::Encode(EncoderBuffer *out_buffer) const {
+  // All table of contents fields have a fixed size so we can compute the
+  // offsets of the chunks before anything is written.
+  uint64_t toc_size = sizeof(uint32_t);
+  for (const Chunk &chunk : chunks_) {
+    toc_size += sizeof(uint8_t) + chunk.entry.name.size() + sizeof(int32_t) +
+                2 * sizeof(uint64_t) + sizeof(uint8_t) +
+                chunk.entry.parent_decoder_ids.size() * sizeof(int32_t);
+  }
+  if (toc_size > UINT32_MAX) {
+    return false;
+  }
+
+  out_buffer->Encode(kSplitContainerMagic, sizeof(kSplitContainerMagic));
+  out_buffer->Encode(kSplitContainerVersionMajor);
+  out_buffer->Encode(kSplitContainerVersionMinor);
+  out_buffer->Encode(static_cast<uint32_t>(toc_size));
+
+  // Table of contents.
+  out_buffer->Encode(static_cast<uint32_t>(chunks_.size()));
+  uint64_t offset = kSplitContainerHeaderSize + toc_size;
+  for (const Chunk &chunk : chunks_) {
+    out_buffer->Encode(static_cast<uint8_t>(chunk.entry.name.size()));
+    out_buffer->Encode(chunk.entry.name.data(), chunk.entry.name.size());
+    out_buffer->Encode(chunk.entry.decoder_id);
+    out_buffer->Encode(offset);
+    out_buffer->Encode(chunk.entry.size);
+    out_buffer->Encode(
+        static_cast<uint8_t>(chunk.entry.parent_decoder_ids.size()));
+    for (const int32_t parent : chunk.entry.parent_decoder_ids) {
+      out_buffer->Encode(parent);
+    }
+    offset += chunk.entry.size;
+  }
+
+  // Chunk data.
+  for (const Chunk &chunk : chunks_) {
+    out_buffer->Encode(chunk.data.data(), chunk.data.size());
+  }
+  return true;
+}
+
+}  // namespace draco
@@ -0,0 +1,76 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_ENCODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_ENCODER_H_
+
+#include <string>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+// Class for packing the base geometry and the attribute chunks produced by
+// the "split_attr" encoding mode into a single seekable container. See
+// SplitContainerEntry for the layout of the table of contents.
+class SplitContainerEncoder {
+ public:
+  SplitContainerEncoder();
+
+  // Sets the base geometry chunk (everything the encoder wrote outside of the
+  // attribute chunks). The data is copied. The base is always stored as the
+  // first chunk of the container under kSplitContainerBaseName.
+  void SetBase(const char *data, size_t data_size);
+
+  // Adds a new attribute chunk to the container. The data is copied. Chunks
+  // are stored in the order in which they were added. Returns false when the
+  // |name| is too long to be stored, when there are too many
+  // |parent_decoder_ids| or when a chunk with the same name already exists.
+  bool AddChunk(const std::string &name, int32_t decoder_id,
+                const std::vector<int32_t> &parent_decoder_ids,
+                const char *data, size_t data_size);
+  // Same as above for a chunk that does not depend on any other chunk.
+  bool AddChunk(const std::string &name, int32_t decoder_id, const char *data,
+                size_t data_size) {
+    return AddChunk(name, decoder_id, std::vector<int32_t>(), data, data_size);
+  }
+
+  // Encodes the container header, the table of contents and all chunks into
+  // |out_buffer|.
+  bool Encode(EncoderBuffer *out_buffer) const;
+
+  // Removes the base and all attribute chunks.
+  void Clear() {
+    chunks_.resize(1);
+    chunks_[0].entry.size = 0;
+    chunks_[0].data.clear();
+  }
+
+  // Returns the number of attribute chunks (the base is not included).
+  int num_chunks() const { return static_cast<int>(chunks_.size()) - 1; }
+
+ private:
+  struct Chunk {
+    SplitContainerEntry entry;
+    std::vector<char> data;
+  };
+  // The first chunk is always the base geometry.
+  std::vector<Chunk> chunks_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_SPLIT_CONTAINER_ENCODER_H_
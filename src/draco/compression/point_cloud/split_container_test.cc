@@ -0,0 +1,116 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <string>
+
+#include "draco/compression/point_cloud/split_container_decoder.h"
+#include "draco/compression/point_cloud/split_container_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class SplitContainerTest : public ::testing::Test {
+ protected:
+  void EncodeTestContainer(EncoderBuffer *out_buffer) {
+    SplitContainerEncoder encoder;
+    const std::string base = "base data";
+    const std::string position = "position data";
+    const std::string field = "field";
+    encoder.SetBase(base.data(), base.size());
+    ASSERT_TRUE(encoder.AddChunk("position", 0, position.data(),
+                                 position.size()));
+    ASSERT_TRUE(
+        encoder.AddChunk("temperature", 1, {0}, field.data(), field.size()));
+    // Duplicate names are not allowed.
+    ASSERT_FALSE(encoder.AddChunk("position", 2, field.data(), field.size()));
+    ASSERT_FALSE(encoder.AddChunk(kSplitContainerBaseName, 2, field.data(),
+                                  field.size()));
+    ASSERT_EQ(encoder.num_chunks(), 2);
+    ASSERT_TRUE(encoder.Encode(out_buffer));
+  }
+};
+
+TEST_F(SplitContainerTest, TestEncodeDecode) {
+  EncoderBuffer buffer;
+  EncodeTestContainer(&buffer);
+  ASSERT_TRUE(
+      SplitContainerDecoder::IsSplitContainer(buffer.data(), buffer.size()));
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  SplitContainerDecoder decoder;
+  DRACO_ASSERT_OK(decoder.Decode(&dec_buffer));
+  ASSERT_EQ(decoder.num_entries(), 3);
+  ASSERT_EQ(decoder.entry(0).name, kSplitContainerBaseName);
+  ASSERT_EQ(decoder.entry(0).decoder_id, -1);
+  ASSERT_EQ(decoder.entry(0).offset, decoder.header_size());
+
+  const SplitContainerEntry *const entry = decoder.FindEntry("temperature");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(entry->decoder_id, 1);
+  ASSERT_EQ(entry->parent_decoder_ids, std::vector<int32_t>({0}));
+  ASSERT_EQ(decoder.FindEntryByDecoderId(1), entry);
+  ASSERT_TRUE(decoder.FindEntry("position")->parent_decoder_ids.empty());
+  ASSERT_EQ(decoder.FindEntry("missing"), nullptr);
+
+  DecoderBuffer chunk_buffer;
+  DRACO_ASSERT_OK(decoder.GetChunk(dec_buffer, "position", &chunk_buffer));
+  ASSERT_EQ(std::string(chunk_buffer.data_head(), chunk_buffer.size()),
+            "position data");
+  DRACO_ASSERT_OK(decoder.GetChunk(dec_buffer, "temperature", &chunk_buffer));
+  ASSERT_EQ(std::string(chunk_buffer.data_head(), chunk_buffer.size()),
+            "field");
+  DRACO_ASSERT_OK(
+      decoder.GetChunk(dec_buffer, kSplitContainerBaseName, &chunk_buffer));
+  ASSERT_EQ(std::string(chunk_buffer.data_head(), chunk_buffer.size()),
+            "base data");
+  ASSERT_FALSE(decoder.GetChunk(dec_buffer, "missing", &chunk_buffer).ok());
+}
+
+TEST_F(SplitContainerTest, TestRangedDecode) {
+  // Tests that the container can be parsed from the header and the table of
+  // contents alone, as done with ranged reads.
+  EncoderBuffer buffer;
+  EncodeTestContainer(&buffer);
+
+  DecoderBuffer header_buffer;
+  header_buffer.Init(buffer.data(), kSplitContainerHeaderSize);
+  SplitContainerDecoder decoder;
+  uint32_t toc_size;
+  DRACO_ASSERT_OK(decoder.DecodeHeader(&header_buffer, &toc_size));
+
+  DecoderBuffer toc_buffer;
+  toc_buffer.Init(buffer.data() + kSplitContainerHeaderSize, toc_size);
+  DRACO_ASSERT_OK(decoder.DecodeTableOfContents(&toc_buffer));
+  const SplitContainerEntry *const entry = decoder.FindEntry("position");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(std::string(buffer.data() + entry->offset, entry->size),
+            "position data");
+
+  // Truncated table of contents must be rejected.
+  toc_buffer.Init(buffer.data() + kSplitContainerHeaderSize, toc_size - 1);
+  ASSERT_FALSE(decoder.DecodeTableOfContents(&toc_buffer).ok());
+}
+
+TEST_F(SplitContainerTest, TestNotAContainer) {
+  const std::string data = "DRACO not a container";
+  ASSERT_FALSE(SplitContainerDecoder::IsSplitContainer(data.data(), 4));
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(data.data(), data.size());
+  SplitContainerDecoder decoder;
+  ASSERT_FALSE(decoder.Decode(&dec_buffer).ok());
+}
+
+}  // namespace draco
@@ -0,0 +1,65 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/arena.h"
+
+#include <algorithm>
+
+namespace draco {
+
+constexpr size_t Arena::kDefaultBlockSize;
+
+Arena::Arena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 1)),
+      num_reserved_bytes_(0),
+      current_block_(0),
+      current_offset_(0) {}
+
+void *Arena::Allocate(size_t size, size_t alignment) {
+  while (current_block_ < blocks_.size()) {
+    Block &block = blocks_[current_block_];
+    const uintptr_t address =
+        reinterpret_cast<uintptr_t>(block.data.get()) + current_offset_;
+    const size_t padding = (alignment - address % alignment) % alignment;
+    if (current_offset_ + padding + size <= block.size) {
+      current_offset_ += padding + size;
+      return block.data.get() + current_offset_ - size;
+    }
+    // Blocks are reused in the order they were created. A block that is too
+    // small for this allocation is skipped until the next Reset().
+    ++current_block_;
+    current_offset_ = 0;
+  }
+  // Blocks are allocated with operator new[] and they are suitably aligned
+  // for any fundamental type, larger alignments need padding.
+  const size_t block_size = std::max(block_size_, size + alignment);
+  Block block;
+  block.data.reset(new uint8_t[block_size]);
+  block.size = block_size;
+  num_reserved_bytes_ += block_size;
+  blocks_.push_back(std::move(block));
+  current_block_ = blocks_.size() - 1;
+  current_offset_ = 0;
+  return Allocate(size, alignment);
+}
+
+void Arena::Reset(size_t max_reserved_bytes) {
+  Reset();
+  while (num_reserved_bytes_ > max_reserved_bytes) {
+    num_reserved_bytes_ -= blocks_.back().size;
+    blocks_.pop_back();
+  }
+}
+
+}  // namespace draco
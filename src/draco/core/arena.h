@@ -0,0 +1,139 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_ARENA_H_
+#define DRACO_CORE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace draco {
+
+// Monotonic allocator that hands out memory from a list of large blocks.
+// Individual allocations are never freed. Instead, all of them are released
+// at once by Reset(), which keeps the blocks for reuse so that repeated
+// workloads of a similar size stop allocating from the heap after the first
+// run. The class is not thread-safe.
+class Arena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  Arena() : Arena(kDefaultBlockSize) {}
+  explicit Arena(size_t block_size);
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  // Returns |size| bytes of memory aligned to |alignment|, which must be a
+  // power of two.
+  void *Allocate(size_t size, size_t alignment);
+
+  // Makes all memory of the arena available again. All memory returned by
+  // Allocate() becomes invalid. The blocks are kept, so the cost of the reset
+  // does not depend on the number of allocations.
+  void Reset() {
+    current_block_ = 0;
+    current_offset_ = 0;
+  }
+
+  // Same as Reset() but also frees blocks, starting with the most recently
+  // created ones, until at most |max_reserved_bytes| remain reserved.
+  void Reset(size_t max_reserved_bytes);
+
+  // Returns the total size of all blocks owned by the arena.
+  size_t num_reserved_bytes() const { return num_reserved_bytes_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  size_t block_size_;
+  size_t num_reserved_bytes_;
+  // Block used for the next allocation and the offset of its first free byte.
+  size_t current_block_;
+  size_t current_offset_;
+};
+
+// STL allocator that takes memory from an Arena. Deallocation is a no-op for
+// arena memory. An allocator without an arena uses the regular heap, so
+// containers that use ArenaAllocator behave as usual when no arena is given.
+// Moving or swapping a container created with an arena moves the arena along
+// with it. Copies never take the arena: a copy-constructed container uses the
+// heap and a copy-assigned one keeps its own allocator, so copies can outlive
+// the arena they were made from.
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() : arena_(nullptr) {}
+  explicit ArenaAllocator(Arena *arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    if (arena_ != nullptr) {
+      return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *p, size_t) {
+    if (arena_ == nullptr) {
+      ::operator delete(p);
+    }
+  }
+
+  // Copy-constructed containers allocate from the heap.
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  Arena *arena() const { return arena_; }
+
+ private:
+  Arena *arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() == b.arena();
+}
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+// Containers allocating from an optional arena.
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+template <typename KeyT, typename ValueT>
+using ArenaUnorderedMap =
+    std::unordered_map<KeyT, ValueT, std::hash<KeyT>, std::equal_to<KeyT>,
+                       ArenaAllocator<std::pair<const KeyT, ValueT>>>;
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_ARENA_H_
@@ -0,0 +1,93 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/arena.h"
+
+#include <cstdint>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class ArenaTest : public ::testing::Test {};
+
+TEST_F(ArenaTest, TestAllocate) {
+  draco::Arena arena(64);
+  // Allocations are aligned and they don't overlap.
+  uint8_t *const a = static_cast<uint8_t *>(arena.Allocate(3, 1));
+  uint8_t *const b = static_cast<uint8_t *>(arena.Allocate(8, 8));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0);
+  ASSERT_GE(b, a + 3);
+  // Allocations larger than the block size get their own block.
+  void *const c = arena.Allocate(1000, 16);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(c) % 16, 0);
+  const size_t num_reserved_bytes = arena.num_reserved_bytes();
+  ASSERT_GE(num_reserved_bytes, 1064);
+
+  // The same allocations after a reset reuse the existing blocks.
+  arena.Reset();
+  ASSERT_EQ(arena.Allocate(3, 1), a);
+  ASSERT_EQ(arena.Allocate(8, 8), b);
+  ASSERT_EQ(arena.Allocate(1000, 16), c);
+  ASSERT_EQ(arena.num_reserved_bytes(), num_reserved_bytes);
+}
+
+TEST_F(ArenaTest, TestResetWithLimit) {
+  draco::Arena arena(64);
+  // Each allocation gets its own block.
+  void *const a = arena.Allocate(48, 1);
+  arena.Allocate(48, 1);
+  arena.Allocate(48, 1);
+  ASSERT_EQ(arena.num_reserved_bytes(), 192);
+
+  // Blocks are freed starting with the most recent one.
+  arena.Reset(150);
+  ASSERT_EQ(arena.num_reserved_bytes(), 128);
+  ASSERT_EQ(arena.Allocate(48, 1), a);
+  arena.Reset(0);
+  ASSERT_EQ(arena.num_reserved_bytes(), 0);
+  ASSERT_NE(arena.Allocate(8, 8), nullptr);
+}
+
+TEST_F(ArenaTest, TestArenaVector) {
+  draco::Arena arena(256);
+  draco::ArenaVector<int> values{draco::ArenaAllocator<int>(&arena)};
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+  ASSERT_GT(arena.num_reserved_bytes(), 0);
+
+  // Containers without an arena use the heap.
+  draco::ArenaVector<int> heap_values(values.begin(), values.end());
+  ASSERT_EQ(heap_values.get_allocator().arena(), nullptr);
+  ASSERT_EQ(heap_values, values);
+
+  // Copies of arena containers use the heap.
+  draco::ArenaVector<int> copied_values(values);
+  ASSERT_EQ(copied_values.get_allocator().arena(), nullptr);
+  ASSERT_EQ(copied_values, values);
+  copied_values.clear();
+  copied_values = values;
+  ASSERT_EQ(copied_values.get_allocator().arena(), nullptr);
+  ASSERT_EQ(copied_values, values);
+
+  // Move assignment moves the arena with the container.
+  heap_values = draco::ArenaVector<int>(draco::ArenaAllocator<int>(&arena));
+  ASSERT_EQ(heap_values.get_allocator().arena(), &arena);
+}
+
+}  // namespace
@@ -0,0 +1,146 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Microbenchmark of DecoderBuffer::DecodeLeastSignificantBits32() and
+// DecoderBuffer::DecodeLeastSignificantBitsBulk() compared to a reader that
+// assembles every value one bit at a time.
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "draco/core/cycle_timer.h"
+#include "draco/core/decoder_buffer.h"
+
+namespace {
+
+// Reads bits the same way as DecoderBuffer::BitDecoder did before it was
+// changed to word-at-a-time reads.
+class BitByBitDecoder {
+ public:
+  BitByBitDecoder(const uint8_t *data, size_t size)
+      : data_(data), data_end_(data + size), bit_offset_(0) {}
+
+  uint32_t GetBits(int32_t nbits) {
+    uint32_t value = 0;
+    for (int32_t bit = 0; bit < nbits; ++bit) {
+      value |= GetBit() << bit;
+    }
+    return value;
+  }
+
+ private:
+  int GetBit() {
+    const size_t off = bit_offset_;
+    const size_t byte_offset = off >> 3;
+    const int bit_shift = static_cast<int>(off & 0x7);
+    if (data_ + byte_offset < data_end_) {
+      const int bit = (data_[byte_offset] >> bit_shift) & 1;
+      bit_offset_ = off + 1;
+      return bit;
+    }
+    return 0;
+  }
+
+  const uint8_t *data_;
+  const uint8_t *data_end_;
+  size_t bit_offset_;
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_iterations = 20;
+  if (argc > 1) {
+    num_iterations = atoi(argv[1]);
+  }
+  const size_t num_bytes = 1 << 22;
+  std::vector<uint8_t> data(num_bytes);
+  uint32_t state = 1;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    state = state * 1664525u + 1013904223u;
+    data[i] = static_cast<uint8_t>(state >> 24);
+  }
+  // Values are decoded in runs of the same width and the widths cycle through
+  // all supported widths.
+  const int run_length = 16;
+  std::vector<int> widths;
+  uint64_t total_bits = 0;
+  while (total_bits + 32 * run_length <= num_bytes * 8) {
+    const int nbits = static_cast<int>(widths.size() % 32) + 1;
+    widths.push_back(nbits);
+    total_bits += nbits * run_length;
+  }
+
+  draco::CycleTimer timer;
+  uint32_t reference_sum = 0;
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    BitByBitDecoder decoder(data.data(), data.size());
+    for (const int nbits : widths) {
+      for (int i = 0; i < run_length; ++i) {
+        reference_sum += decoder.GetBits(nbits);
+      }
+    }
+  }
+  timer.Stop();
+  const int64_t reference_ms = timer.GetInMs();
+
+  uint32_t sum = 0;
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(reinterpret_cast<const char *>(data.data()), data.size());
+    buffer.StartBitDecoding(false, nullptr);
+    for (const int nbits : widths) {
+      for (int i = 0; i < run_length; ++i) {
+        uint32_t value;
+        buffer.DecodeLeastSignificantBits32(nbits, &value);
+        sum += value;
+      }
+    }
+    buffer.EndBitDecoding();
+  }
+  timer.Stop();
+  const int64_t ms = timer.GetInMs();
+
+  uint32_t bulk_sum = 0;
+  timer.Start();
+  for (int it = 0; it < num_iterations; ++it) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(reinterpret_cast<const char *>(data.data()), data.size());
+    buffer.StartBitDecoding(false, nullptr);
+    uint32_t values[run_length];
+    for (const int nbits : widths) {
+      buffer.DecodeLeastSignificantBitsBulk(nbits, values, run_length);
+      for (int i = 0; i < run_length; ++i) {
+        bulk_sum += values[i];
+      }
+    }
+    buffer.EndBitDecoding();
+  }
+  timer.Stop();
+  const int64_t bulk_ms = timer.GetInMs();
+
+  if (sum != reference_sum || bulk_sum != reference_sum) {
+    printf("Decoded values do not match.\n");
+    return -1;
+  }
+  printf("Decoded %zu runs of %d values of 1-32 bits %d times.\n",
+         widths.size(), run_length, num_iterations);
+  printf("Bit by bit:     %" PRId64 " ms\n", reference_ms);
+  printf("Word at a time: %" PRId64 " ms\n", ms);
+  printf("Bulk:           %" PRId64 " ms\n", bulk_ms);
+  return 0;
+}
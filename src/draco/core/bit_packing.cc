@@ -0,0 +1,88 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/bit_packing.h"
+
+#include <cstring>
+
+#include "draco/core/cpu_features.h"
+
+namespace draco {
+
+void UnpackBits(const uint8_t *data, size_t data_size, uint64_t bit_offset,
+                int nbits, uint32_t *out_values, size_t count) {
+  size_t i = 0;
+#if DRACO_ENABLE_SSE4_1
+  if (CpuSupportsSse4()) {
+    i = UnpackBitsSse4(data, data_size, bit_offset, nbits, out_values, count);
+  }
+#elif DRACO_ENABLE_NEON && defined(__aarch64__)
+  i = UnpackBitsNeon(data, data_size, bit_offset, nbits, out_values, count);
+#endif
+  bit_offset += i * nbits;
+  const uint64_t mask = (static_cast<uint64_t>(1) << nbits) - 1;
+  for (; i < count; ++i) {
+    // A value with its bit shift always fits into a single 64-bit load.
+    const uint64_t byte_offset = bit_offset >> 3;
+    uint64_t word = 0;
+    if (byte_offset + sizeof(word) <= data_size) {
+      memcpy(&word, data + byte_offset, sizeof(word));
+    } else if (byte_offset < data_size) {
+      memcpy(&word, data + byte_offset, data_size - byte_offset);
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    out_values[i] = static_cast<uint32_t>((word >> (bit_offset & 7)) & mask);
+    bit_offset += nbits;
+  }
+}
+
+void PackBits(const uint32_t *values, size_t count, int nbits,
+              uint64_t bit_offset, uint8_t *data) {
+  if (nbits == 0 || count == 0) {
+    return;
+  }
+  const uint64_t mask = (static_cast<uint64_t>(1) << nbits) - 1;
+  uint8_t *dst = data + (bit_offset >> 3);
+  // Pending bits that were not written to |data| yet. Bits in front of the
+  // first value are taken from |data| so that they are preserved.
+  int num_pending_bits = static_cast<int>(bit_offset & 7);
+  uint64_t pending_bits = *dst & ((1u << num_pending_bits) - 1);
+  for (size_t i = 0; i < count; ++i) {
+    pending_bits |= (values[i] & mask) << num_pending_bits;
+    num_pending_bits += nbits;
+    if (num_pending_bits >= 32) {
+      uint32_t word = static_cast<uint32_t>(pending_bits);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      word = __builtin_bswap32(word);
+#endif
+      memcpy(dst, &word, sizeof(word));
+      dst += sizeof(word);
+      pending_bits >>= 32;
+      num_pending_bits -= 32;
+    }
+  }
+  while (num_pending_bits >= 8) {
+    *dst++ = static_cast<uint8_t>(pending_bits);
+    pending_bits >>= 8;
+    num_pending_bits -= 8;
+  }
+  if (num_pending_bits > 0) {
+    const uint8_t keep_mask = static_cast<uint8_t>(0xff << num_pending_bits);
+    *dst = static_cast<uint8_t>((*dst & keep_mask) | pending_bits);
+  }
+}
+
+}  // namespace draco
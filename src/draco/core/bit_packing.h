@@ -0,0 +1,56 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_BIT_PACKING_H_
+#define DRACO_CORE_BIT_PACKING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace draco {
+
+// Functions for packing of runs of values with the same bit width. Values are
+// stored back to back starting with the least significant bit, which is the
+// same layout as used by EncoderBuffer::EncodeLeastSignificantBits32(). The
+// layout is little-endian regardless of the byte order of the host.
+
+// Unpacks |count| values of |nbits| bits (0 to 32) starting at bit
+// |bit_offset| of |data| into |out_values|. All unpacked bits must be within
+// the first |data_size| bytes of |data|.
+void UnpackBits(const uint8_t *data, size_t data_size, uint64_t bit_offset,
+                int nbits, uint32_t *out_values, size_t count);
+
+// Packs |nbits| least significant bits (0 to 32) of |count| |values| into
+// |data| starting at bit |bit_offset|. Bits of |data| outside of the packed
+// range are preserved.
+void PackBits(const uint32_t *values, size_t count, int nbits,
+              uint64_t bit_offset, uint8_t *data);
+
+// SIMD kernels used by UnpackBits(). They unpack values in groups of four and
+// return the number of unpacked values, which may be anything from zero up to
+// |count|. Only widths of up to 25 bits are supported.
+#if DRACO_ENABLE_SSE4_1
+size_t UnpackBitsSse4(const uint8_t *data, size_t data_size,
+                      uint64_t bit_offset, int nbits, uint32_t *out_values,
+                      size_t count);
+#endif
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+size_t UnpackBitsNeon(const uint8_t *data, size_t data_size,
+                      uint64_t bit_offset, int nbits, uint32_t *out_values,
+                      size_t count);
+#endif
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_BIT_PACKING_H_
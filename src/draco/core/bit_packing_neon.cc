@@ -0,0 +1,84 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/bit_packing.h"
+
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+
+namespace draco {
+
+namespace {
+
+// Lookup tables and shifts for every supported value width and every bit shift
+// of the first value of a group of four values. Each group is unpacked from a
+// 16-byte load. The bytes of every value are looked up into its own 32-bit
+// lane and the lanes are shifted right by the bit shifts of the values.
+struct UnpackTables {
+  UnpackTables() {
+    for (int nbits = 1; nbits <= 25; ++nbits) {
+      for (int shift = 0; shift < 8; ++shift) {
+        uint8_t table[16];
+        int32_t lane_shifts[4];
+        for (int k = 0; k < 4; ++k) {
+          const int value_offset = shift + k * nbits;
+          for (int b = 0; b < 4; ++b) {
+            table[4 * k + b] = static_cast<uint8_t>((value_offset >> 3) + b);
+          }
+          // Negative shifts shift to the right.
+          lane_shifts[k] = -(value_offset & 7);
+        }
+        lookups[nbits][shift] = vld1q_u8(table);
+        shifts[nbits][shift] = vld1q_s32(lane_shifts);
+      }
+    }
+  }
+
+  uint8x16_t lookups[26][8];
+  int32x4_t shifts[26][8];
+};
+
+}  // namespace
+
+size_t UnpackBitsNeon(const uint8_t *data, size_t data_size,
+                      uint64_t bit_offset, int nbits, uint32_t *out_values,
+                      size_t count) {
+  if (nbits < 1 || nbits > 25 || count < 4) {
+    return 0;
+  }
+  static const UnpackTables tables;
+  const uint8x16_t *const lookups = tables.lookups[nbits];
+  const int32x4_t *const shifts = tables.shifts[nbits];
+  const uint32x4_t mask = vdupq_n_u32((1u << nbits) - 1);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint64_t byte_offset = bit_offset >> 3;
+    if (byte_offset + 16 > data_size) {
+      break;
+    }
+    const int shift = static_cast<int>(bit_offset & 7);
+    const uint8x16_t bytes =
+        vqtbl1q_u8(vld1q_u8(data + byte_offset), lookups[shift]);
+    const uint32x4_t values =
+        vshlq_u32(vreinterpretq_u32_u8(bytes), shifts[shift]);
+    vst1q_u32(out_values + i, vandq_u32(values, mask));
+    bit_offset += 4 * nbits;
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_NEON && defined(__aarch64__)
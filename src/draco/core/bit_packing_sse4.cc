@@ -0,0 +1,88 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/bit_packing.h"
+
+#if DRACO_ENABLE_SSE4_1
+#include <smmintrin.h>
+
+namespace draco {
+
+namespace {
+
+// Shuffles and multipliers for every supported value width and every bit shift
+// of the first value of a group of four values. Each group is unpacked from a
+// 16-byte load. The bytes of every value are shuffled into its own 32-bit
+// lane. The lanes are then shifted left by a multiplication so that all values
+// start at bit 7, which is possible because a value never spans more than 32
+// bits including its bit shift.
+struct UnpackTables {
+  UnpackTables() {
+    for (int nbits = 1; nbits <= 25; ++nbits) {
+      for (int shift = 0; shift < 8; ++shift) {
+        uint8_t shuffle[16];
+        uint32_t multiplier[4];
+        for (int k = 0; k < 4; ++k) {
+          const int value_offset = shift + k * nbits;
+          for (int b = 0; b < 4; ++b) {
+            shuffle[4 * k + b] = static_cast<uint8_t>((value_offset >> 3) + b);
+          }
+          multiplier[k] = 1u << (7 - (value_offset & 7));
+        }
+        shuffles[nbits][shift] =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle));
+        multipliers[nbits][shift] =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(multiplier));
+      }
+    }
+  }
+
+  __m128i shuffles[26][8];
+  __m128i multipliers[26][8];
+};
+
+}  // namespace
+
+size_t UnpackBitsSse4(const uint8_t *data, size_t data_size,
+                      uint64_t bit_offset, int nbits, uint32_t *out_values,
+                      size_t count) {
+  if (nbits < 1 || nbits > 25 || count < 4) {
+    return 0;
+  }
+  static const UnpackTables tables;
+  const __m128i *const shuffles = tables.shuffles[nbits];
+  const __m128i *const multipliers = tables.multipliers[nbits];
+  const __m128i mask = _mm_set1_epi32((1 << nbits) - 1);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint64_t byte_offset = bit_offset >> 3;
+    if (byte_offset + 16 > data_size) {
+      break;
+    }
+    const int shift = static_cast<int>(bit_offset & 7);
+    __m128i values = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(data + byte_offset));
+    values = _mm_shuffle_epi8(values, shuffles[shift]);
+    values = _mm_mullo_epi32(values, multipliers[shift]);
+    values = _mm_and_si128(_mm_srli_epi32(values, 7), mask);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out_values + i), values);
+    bit_offset += 4 * nbits;
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_SSE4_1
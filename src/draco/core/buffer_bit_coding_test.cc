@@ -13,6 +13,9 @@
 // limitations under the License.
 //
 #include "draco/core/decoder_buffer.h"
+
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 #include "draco/core/encoder_buffer.h"
 
@@ -112,4 +115,105 @@ TEST_F(BufferBitCodingTest, TestMultipleBits) {
   }
 }
 
+TEST_F(BufferBitCodingTest, TestVariableBitsMatchSingleBits) {
+  // Tests that values of any width read at any bit offset, including reads
+  // that cross the end of the buffer, match values assembled bit by bit.
+  uint8_t data[13];
+  for (int i = 0; i < 13; ++i) {
+    data[i] = static_cast<uint8_t>(i * 73 + 41);
+  }
+  for (int nbits = 0; nbits <= 32; ++nbits) {
+    BitDecoder decoder;
+    decoder.reset(static_cast<const void *>(data), sizeof(data));
+    uint64_t offset = 0;
+    while (offset < sizeof(data) * 8) {
+      uint32_t expected = 0;
+      uint64_t num_decoded = 0;
+      for (int bit = 0; bit < nbits; ++bit, ++num_decoded) {
+        const uint64_t bit_offset = offset + bit;
+        if (bit_offset >= sizeof(data) * 8) {
+          break;
+        }
+        expected |= ((data[bit_offset >> 3] >> (bit_offset & 7)) & 1) << bit;
+      }
+      uint32_t x = 0;
+      ASSERT_TRUE(decoder.GetBits(nbits, &x));
+      ASSERT_EQ(x, expected);
+      offset += num_decoded;
+      ASSERT_EQ(offset, decoder.BitsDecoded());
+      if (nbits == 0) {
+        break;
+      }
+    }
+  }
+}
+
+TEST_F(BufferBitCodingTest, TestBulkDecodingMatchesSingleValues) {
+  // Tests that bulk decoding of values of any width from any bit offset,
+  // including values past the end of the buffer, matches decoding of
+  // individual values.
+  std::vector<char> data(67);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 151 + 7);
+  }
+  for (int nbits = 0; nbits <= 32; ++nbits) {
+    for (int start_bits = 0; start_bits < 9; ++start_bits) {
+      const size_t count = 40;
+      DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      ASSERT_TRUE(buffer.StartBitDecoding(false, nullptr));
+      uint32_t x;
+      ASSERT_TRUE(buffer.DecodeLeastSignificantBits32(start_bits, &x));
+      std::vector<uint32_t> values(count);
+      ASSERT_TRUE(
+          buffer.DecodeLeastSignificantBitsBulk(nbits, values.data(), count));
+      buffer.EndBitDecoding();
+
+      DecoderBuffer ref_buffer;
+      ref_buffer.Init(data.data(), data.size());
+      ASSERT_TRUE(ref_buffer.StartBitDecoding(false, nullptr));
+      ASSERT_TRUE(ref_buffer.DecodeLeastSignificantBits32(start_bits, &x));
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(ref_buffer.DecodeLeastSignificantBits32(nbits, &x));
+        ASSERT_EQ(values[i], x);
+      }
+      ref_buffer.EndBitDecoding();
+      ASSERT_EQ(buffer.decoded_size(), ref_buffer.decoded_size());
+    }
+  }
+}
+
+TEST_F(BufferBitCodingTest, TestBulkEncodingMatchesSingleValues) {
+  // Tests that bulk encoding of values of any width from any bit offset
+  // matches encoding of individual values.
+  std::vector<uint32_t> values(37);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<uint32_t>(i * 2654435761u);
+  }
+  for (int nbits = 0; nbits <= 32; ++nbits) {
+    for (int start_bits = 0; start_bits < 9; ++start_bits) {
+      const int64_t required_bits = start_bits + nbits * values.size() + 1;
+      EncoderBuffer buffer;
+      ASSERT_TRUE(buffer.StartBitEncoding(required_bits, false));
+      ASSERT_TRUE(buffer.EncodeLeastSignificantBits32(start_bits, 0x1ff));
+      ASSERT_TRUE(buffer.EncodeLeastSignificantBitsBulk(nbits, values.data(),
+                                                        values.size()));
+      ASSERT_TRUE(buffer.EncodeLeastSignificantBits32(1, 1));
+      buffer.EndBitEncoding();
+
+      EncoderBuffer ref_buffer;
+      ASSERT_TRUE(ref_buffer.StartBitEncoding(required_bits, false));
+      ASSERT_TRUE(ref_buffer.EncodeLeastSignificantBits32(start_bits, 0x1ff));
+      for (const uint32_t value : values) {
+        ASSERT_TRUE(ref_buffer.EncodeLeastSignificantBits32(nbits, value));
+      }
+      ASSERT_TRUE(ref_buffer.EncodeLeastSignificantBits32(1, 1));
+      ref_buffer.EndBitEncoding();
+      ASSERT_EQ(std::vector<char>(buffer.data(), buffer.data() + buffer.size()),
+                std::vector<char>(ref_buffer.data(),
+                                  ref_buffer.data() + ref_buffer.size()));
+    }
+  }
+}
+
 }  // namespace draco
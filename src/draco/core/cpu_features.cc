@@ -0,0 +1,46 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/cpu_features.h"
+
+#if DRACO_ENABLE_SSE4_1 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace draco {
+
+namespace {
+
+bool DetectSse4() {
+#if DRACO_ENABLE_SSE4_1
+#if defined(_MSC_VER)
+  int cpu_info[4];
+  __cpuid(cpu_info, 1);
+  return (cpu_info[2] & (1 << 19)) != 0;
+#else
+  return __builtin_cpu_supports("sse4.1");
+#endif
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+bool CpuSupportsSse4() {
+  static const bool supported = DetectSse4();
+  return supported;
+}
+
+}  // namespace draco
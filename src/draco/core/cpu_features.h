@@ -0,0 +1,27 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_CPU_FEATURES_H_
+#define DRACO_CORE_CPU_FEATURES_H_
+
+namespace draco {
+
+// SIMD kernels in files with the sse4.cc suffix are compiled in whenever the
+// compiler supports them (DRACO_ENABLE_SSE4_1), but they may be used only when
+// this function returns true. The result is computed once and cached.
+bool CpuSupportsSse4();
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_CPU_FEATURES_H_
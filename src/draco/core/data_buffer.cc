@@ -15,10 +15,62 @@
 #include "draco/core/data_buffer.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace draco {
 
-DataBuffer::DataBuffer() {}
+DataBuffer::DataBuffer()
+    : external_data_(nullptr), external_size_(0), external_capacity_(0) {}
+
+DataBuffer::~DataBuffer() { ReleaseExternalData(); }
+
+DataBuffer::DataBuffer(const DataBuffer &buffer)
+    : data_(buffer.data(), buffer.data() + buffer.data_size()),
+      external_data_(nullptr),
+      external_size_(0),
+      external_capacity_(0),
+      descriptor_(buffer.descriptor_) {}
+
+DataBuffer &DataBuffer::operator=(const DataBuffer &buffer) {
+  if (this != &buffer) {
+    ReleaseExternalData();
+    data_.assign(buffer.data(), buffer.data() + buffer.data_size());
+    descriptor_ = buffer.descriptor_;
+  }
+  return *this;
+}
+
+DataBuffer::DataBuffer(DataBuffer &&buffer)
+    : data_(std::move(buffer.data_)),
+      external_data_(buffer.external_data_),
+      external_size_(buffer.external_size_),
+      external_capacity_(buffer.external_capacity_),
+      external_deleter_(std::move(buffer.external_deleter_)),
+      descriptor_(buffer.descriptor_) {
+  buffer.data_.clear();
+  buffer.external_data_ = nullptr;
+  buffer.external_size_ = 0;
+  buffer.external_capacity_ = 0;
+  buffer.external_deleter_ = nullptr;
+}
+
+DataBuffer &DataBuffer::operator=(DataBuffer &&buffer) {
+  if (this != &buffer) {
+    ReleaseExternalData();
+    data_ = std::move(buffer.data_);
+    external_data_ = buffer.external_data_;
+    external_size_ = buffer.external_size_;
+    external_capacity_ = buffer.external_capacity_;
+    external_deleter_ = std::move(buffer.external_deleter_);
+    descriptor_ = buffer.descriptor_;
+    buffer.data_.clear();
+    buffer.external_data_ = nullptr;
+    buffer.external_size_ = 0;
+    buffer.external_capacity_ = 0;
+    buffer.external_deleter_ = nullptr;
+  }
+  return *this;
+}
 
 bool DataBuffer::Update(const void *data, int64_t size) {
   const int64_t offset = 0;
@@ -26,6 +78,19 @@ bool DataBuffer::Update(const void *data, int64_t size) {
 }
 
 bool DataBuffer::Update(const void *data, int64_t size, int64_t offset) {
+  if (external_data_ != nullptr) {
+    if (size < 0 || offset < 0 || size + offset > external_capacity_) {
+      return false;
+    }
+    if (data == nullptr) {
+      external_size_ = size + offset;
+    } else {
+      external_size_ = std::max(external_size_, size + offset);
+      memcpy(external_data_ + offset, data, size);
+    }
+    descriptor_.buffer_update_count++;
+    return true;
+  }
   if (data == nullptr) {
     if (size + offset < 0) {
       return false;
@@ -47,15 +112,51 @@ bool DataBuffer::Update(const void *data, int64_t size, int64_t offset) {
 }
 
 void DataBuffer::Resize(int64_t size) {
+  if (external_data_ != nullptr) {
+    if (size <= external_capacity_) {
+      external_size_ = size;
+      descriptor_.buffer_update_count++;
+      return;
+    }
+    // Move the data to the internal storage that can grow.
+    data_.assign(external_data_, external_data_ + external_size_);
+    ReleaseExternalData();
+  }
   data_.resize(size);
   descriptor_.buffer_update_count++;
 }
 
 void DataBuffer::WriteDataToStream(std::ostream &stream) {
-  if (data_.size() == 0) {
+  if (data_size() == 0) {
+    return;
+  }
+  stream.write(reinterpret_cast<const char *>(data()), data_size());
+}
+
+void DataBuffer::SetExternalData(uint8_t *data, int64_t size,
+                                 const ExternalDataDeleter &deleter) {
+  ReleaseExternalData();
+  std::vector<uint8_t>().swap(data_);
+  external_data_ = data;
+  external_size_ = size;
+  external_capacity_ = size;
+  external_deleter_ = deleter;
+  descriptor_.buffer_update_count++;
+}
+
+void DataBuffer::ReleaseExternalData() {
+  if (external_data_ == nullptr) {
     return;
   }
-  stream.write(reinterpret_cast<char *>(data_.data()), data_.size());
+  uint8_t *const data = external_data_;
+  external_data_ = nullptr;
+  external_size_ = 0;
+  external_capacity_ = 0;
+  if (external_deleter_) {
+    ExternalDataDeleter deleter = std::move(external_deleter_);
+    external_deleter_ = nullptr;
+    deleter(data);
+  }
 }
 
 }  // namespace draco
@@ -16,6 +16,7 @@
 #define DRACO_CORE_DATA_BUFFER_H_
 
 #include <cstring>
+#include <functional>
 #include <ostream>
 #include <vector>
 
@@ -32,16 +33,50 @@ struct DataBufferDescriptor {
   int64_t buffer_update_count;
 };
 
-// Class used for storing raw buffer data.
+// Class used for storing raw buffer data. By default the data is stored in
+// memory owned by the buffer, but the buffer can also use external memory
+// owned by someone else (see SetExternalData()).
 class DataBuffer {
  public:
+  // Function called to release external memory that is no longer used.
+  typedef std::function<void(uint8_t *)> ExternalDataDeleter;
+
   DataBuffer();
+  ~DataBuffer();
+
+  // Copies of a buffer always store the copied data in their own memory.
+  DataBuffer(const DataBuffer &buffer);
+  DataBuffer &operator=(const DataBuffer &buffer);
+
+  // Moved buffers keep using their memory, including external memory and its
+  // deleter. |buffer| is left empty and it no longer releases the memory.
+  DataBuffer(DataBuffer &&buffer);
+  DataBuffer &operator=(DataBuffer &&buffer);
+
   bool Update(const void *data, int64_t size);
+  // When the buffer uses external memory, the update fails if |size| +
+  // |offset| exceeds the size of the external memory. Bytes added to the
+  // buffer are not initialized in that case.
   bool Update(const void *data, int64_t size, int64_t offset);
 
   // Reallocate the buffer storage to a new size keeping the data unchanged.
+  // External memory that is too small for |new_size| is replaced by the
+  // internal storage.
   void Resize(int64_t new_size);
   void WriteDataToStream(std::ostream &stream);
+
+  // Makes the buffer use |size| bytes of external memory at |data| instead of
+  // its own storage. The content of |data| becomes the content of the buffer
+  // without any copy. The memory must stay valid until it is released, that
+  // is, until the buffer is destroyed, a new memory is set, or the buffer
+  // grows past |size| in Resize(). The optional |deleter| is then called with
+  // |data|.
+  void SetExternalData(uint8_t *data, int64_t size,
+                       const ExternalDataDeleter &deleter);
+  void SetExternalData(uint8_t *data, int64_t size) {
+    SetExternalData(data, size, nullptr);
+  }
+  bool is_external() const { return external_data_ != nullptr; }
   // Reads data from the buffer. Potentially unsafe, called needs to ensure
   // the accessed memory is valid.
   void Read(int64_t byte_pos, void *out_data, size_t data_size) const {
@@ -65,14 +100,28 @@ class DataBuffer {
     descriptor_.buffer_update_count = buffer_update_count;
   }
   int64_t update_count() const { return descriptor_.buffer_update_count; }
-  size_t data_size() const { return data_.size(); }
-  const uint8_t *data() const { return data_.data(); }
-  uint8_t *data() { return &data_[0]; }
+  size_t data_size() const {
+    return external_data_ ? external_size_ : data_.size();
+  }
+  const uint8_t *data() const {
+    return external_data_ ? external_data_ : data_.data();
+  }
+  uint8_t *data() { return external_data_ ? external_data_ : data_.data(); }
   int64_t buffer_id() const { return descriptor_.buffer_id; }
   void set_buffer_id(int64_t buffer_id) { descriptor_.buffer_id = buffer_id; }
 
  private:
+  // Stops using the external memory and calls its deleter.
+  void ReleaseExternalData();
+
   std::vector<uint8_t> data_;
+  // External memory used instead of |data_| when set.
+  uint8_t *external_data_;
+  // Number of bytes of |external_data_| that are used by the buffer.
+  int64_t external_size_;
+  // Total size of the external memory.
+  int64_t external_capacity_;
+  ExternalDataDeleter external_deleter_;
   // Counter incremented by Update() calls.
   DataBufferDescriptor descriptor_;
 };
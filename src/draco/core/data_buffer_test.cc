@@ -0,0 +1,100 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/data_buffer.h"
+
+#include <utility>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class DataBufferTest : public ::testing::Test {};
+
+TEST_F(DataBufferTest, TestExternalData) {
+  // This test verifies that DataBuffer can use external memory without
+  // copying it and that the memory is released only once.
+  uint8_t memory[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  int num_released = 0;
+  {
+    draco::DataBuffer buffer;
+    ASSERT_TRUE(buffer.Update(memory, 2));
+    buffer.SetExternalData(memory, 8, [&](uint8_t *data) {
+      ASSERT_EQ(data, memory);
+      ++num_released;
+    });
+    ASSERT_TRUE(buffer.is_external());
+    ASSERT_EQ(buffer.data(), memory);
+    ASSERT_EQ(buffer.data_size(), 8);
+
+    // Updates within the external memory are written in place.
+    const uint8_t values[2] = {10, 11};
+    ASSERT_TRUE(buffer.Update(values, 2, 6));
+    ASSERT_EQ(memory[6], 10);
+    ASSERT_TRUE(buffer.Update(nullptr, 4));
+    ASSERT_EQ(buffer.data_size(), 4);
+    ASSERT_EQ(memory[7], 11);
+    ASSERT_FALSE(buffer.Update(values, 2, 7));
+    ASSERT_FALSE(buffer.Update(nullptr, 9));
+
+    // Copies own their data.
+    const draco::DataBuffer copy = buffer;
+    ASSERT_FALSE(copy.is_external());
+    ASSERT_EQ(copy.data_size(), 4);
+    ASSERT_EQ(copy.data()[3], 4);
+    ASSERT_EQ(num_released, 0);
+
+    // Growing past the external memory moves the data to the internal
+    // storage.
+    buffer.Resize(16);
+    ASSERT_FALSE(buffer.is_external());
+    ASSERT_EQ(num_released, 1);
+    ASSERT_EQ(buffer.data_size(), 16);
+    ASSERT_EQ(buffer.data()[3], 4);
+  }
+  ASSERT_EQ(num_released, 1);
+}
+
+TEST_F(DataBufferTest, TestMoveExternalData) {
+  // This test verifies that moved buffers take over the external memory and
+  // that the memory is released only by the buffer that uses it.
+  uint8_t memory[4] = {1, 2, 3, 4};
+  uint8_t other_memory[4] = {5, 6, 7, 8};
+  int num_released = 0;
+  int num_other_released = 0;
+  {
+    draco::DataBuffer buffer;
+    buffer.SetExternalData(memory, 4, [&](uint8_t *) { ++num_released; });
+    draco::DataBuffer moved(std::move(buffer));
+    ASSERT_TRUE(moved.is_external());
+    ASSERT_EQ(moved.data(), memory);
+    ASSERT_EQ(moved.data_size(), 4);
+    ASSERT_FALSE(buffer.is_external());
+    ASSERT_EQ(buffer.data_size(), 0);
+
+    // Move assignment releases the memory of the assigned buffer.
+    draco::DataBuffer other;
+    other.SetExternalData(other_memory, 4,
+                          [&](uint8_t *) { ++num_other_released; });
+    other = std::move(moved);
+    ASSERT_EQ(num_other_released, 1);
+    ASSERT_EQ(other.data(), memory);
+    ASSERT_FALSE(moved.is_external());
+    ASSERT_EQ(num_released, 0);
+  }
+  ASSERT_EQ(num_released, 1);
+  ASSERT_EQ(num_other_released, 1);
+}
+
+}  // namespace
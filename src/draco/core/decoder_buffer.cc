@@ -24,7 +24,8 @@ DecoderBuffer::DecoderBuffer()
       data_size_(0),
       pos_(0),
       bit_mode_(false),
-      bitstream_version_(0) {}
+      bitstream_version_(0),
+      out_of_data_(false) {}
 
 void DecoderBuffer::Init(const char *data, size_t data_size) {
   Init(data, data_size, bitstream_version_);
@@ -35,6 +36,7 @@ void DecoderBuffer::Init(const char *data, size_t data_size, uint16_t version) {
   data_size_ = data_size;
   bitstream_version_ = version;
   pos_ = 0;
+  out_of_data_ = false;
 }
 
 bool DecoderBuffer::StartBitDecoding(bool decode_size, uint64_t *out_size) {
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <memory>
 
+#include "draco/core/bit_packing.h"
 #include "draco/core/macros.h"
 #include "draco/draco_features.h"
 
@@ -36,7 +37,7 @@ class DecoderBuffer {
 
   // Sets the buffer's internal data. Note that no copy of the input data is
   // made so the data owner needs to keep the data valid and unchanged for
-  // runtime of the decoder.
+  // runtime of the decoder. Clears the out_of_data() state.
   void Init(const char *data, size_t data_size);
 
   // Sets the buffer's internal data. |version| is the Draco bitstream version.
@@ -58,10 +59,28 @@ class DecoderBuffer {
     if (!bit_decoder_active()) {
       return false;
     }
+    if (static_cast<uint64_t>(nbits) > bit_decoder_.AvailBits()) {
+      out_of_data_ = true;
+    }
     bit_decoder_.GetBits(nbits, out_value);
     return true;
   }
 
+  // Decodes |count| values of |nbits| bits each into |out_values|. Produces the
+  // same values as |count| calls of DecodeLeastSignificantBits32(), but it is
+  // faster for runs of values with the same width.
+  bool DecodeLeastSignificantBitsBulk(int nbits, uint32_t *out_values,
+                                      size_t count) {
+    if (!bit_decoder_active()) {
+      return false;
+    }
+    if (static_cast<uint64_t>(nbits) * count > bit_decoder_.AvailBits()) {
+      out_of_data_ = true;
+    }
+    bit_decoder_.GetBitsBulk(nbits, out_values, count);
+    return true;
+  }
+
   // Decodes an arbitrary data type.
   // Can be used only when we are not decoding a bit-sequence.
   // Returns false on error.
@@ -76,6 +95,7 @@ class DecoderBuffer {
 
   bool Decode(void *out_data, size_t size_to_decode) {
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_decode)) {
+      out_of_data_ = true;
       return false;  // Buffer overflow.
     }
     memcpy(out_data, (data_ + pos_), size_to_decode);
@@ -88,6 +108,7 @@ class DecoderBuffer {
   bool Peek(T *out_val) {
     const size_t size_to_decode = sizeof(T);
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_decode)) {
+      out_of_data_ = true;
       return false;  // Buffer overflow.
     }
     memcpy(out_val, (data_ + pos_), size_to_decode);
@@ -96,12 +117,33 @@ class DecoderBuffer {
 
   bool Peek(void *out_data, size_t size_to_peek) {
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_peek)) {
+      out_of_data_ = true;
       return false;  // Buffer overflow.
     }
     memcpy(out_data, (data_ + pos_), size_to_peek);
     return true;
   }
 
+  // Returns true when at least |size| bytes remain to be decoded. Otherwise
+  // marks the buffer as out of data. Decoders use it to validate the sizes
+  // of data blocks stored in the bitstream.
+  bool CheckRemainingSize(uint64_t size) {
+    if (size > static_cast<uint64_t>(remaining_size())) {
+      out_of_data_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  // Returns true when the decoding needed more data than the buffer holds,
+  // e.g. when a value or a bit sequence was read past the end of the buffer.
+  // Decoders of partially received data (see StreamingDecoder) use it to tell
+  // missing data from invalid data.
+  bool out_of_data() const { return out_of_data_; }
+  // Marks the buffer as out of data. Used to propagate the state of
+  // sub-buffers that end where this buffer ends.
+  void set_out_of_data() { out_of_data_ = true; }
+
   // Discards #bytes from the input buffer.
   void Advance(int64_t bytes) { pos_ += bytes; }
   void Seek(int64_t pos) { pos_ = pos; }
@@ -149,12 +191,8 @@ class DecoderBuffer {
     inline uint32_t EnsureBits(int k) {
       DRACO_DCHECK_LE(k, 24);
       DRACO_DCHECK_LE(static_cast<uint64_t>(k), AvailBits());
-
-      uint32_t buf = 0;
-      for (int i = 0; i < k; ++i) {
-        buf |= PeekBit(i) << i;
-      }
-      return buf;  // Okay to return extra bits
+      (void)k;
+      return static_cast<uint32_t>(LoadBits());  // Okay to return extra bits
     }
 
     inline void ConsumeBits(int k) { bit_offset_ += k; }
@@ -163,38 +201,57 @@ class DecoderBuffer {
     inline bool GetBits(int32_t nbits, uint32_t *x) {
       DRACO_DCHECK_GE(nbits, 0);
       DRACO_DCHECK_LE(nbits, 32);
-      uint32_t value = 0;
-      for (int32_t bit = 0; bit < nbits; ++bit) {
-        value |= GetBit() << bit;
+      // Bits past the end of the buffer are decoded as zeros and they are not
+      // counted as decoded.
+      const uint64_t avail_bits = AvailBits();
+      if (static_cast<uint64_t>(nbits) > avail_bits) {
+        nbits = static_cast<int32_t>(avail_bits);
       }
-      *x = value;
+      const uint64_t mask = (static_cast<uint64_t>(1) << nbits) - 1;
+      *x = static_cast<uint32_t>(LoadBits() & mask);
+      bit_offset_ += nbits;
       return true;
     }
 
-   private:
-    // TODO(fgalligan): Add support for error reporting on range check.
-    // Returns one bit from the bit buffer.
-    inline int GetBit() {
-      const size_t off = bit_offset_;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        bit_offset_ = off + 1;
-        return bit;
+    // Returns |count| values of |nbits| bits in |out_values|.
+    inline void GetBitsBulk(int32_t nbits, uint32_t *out_values,
+                            size_t count) {
+      DRACO_DCHECK_GE(nbits, 0);
+      DRACO_DCHECK_LE(nbits, 32);
+      // Values that are fully stored in the buffer are unpacked at once. Any
+      // remaining values are partially or fully past the end of the buffer.
+      size_t num_full_values = count;
+      if (nbits > 0 && AvailBits() / nbits < num_full_values) {
+        num_full_values = static_cast<size_t>(AvailBits() / nbits);
+      }
+      UnpackBits(bit_buffer_, bit_buffer_end_ - bit_buffer_, bit_offset_, nbits,
+                 out_values, num_full_values);
+      bit_offset_ += num_full_values * nbits;
+      for (size_t i = num_full_values; i < count; ++i) {
+        GetBits(nbits, out_values + i);
       }
-      return 0;
     }
 
-    inline int PeekBit(int offset) {
-      const size_t off = bit_offset_ + offset;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        return bit;
+   private:
+    // TODO(fgalligan): Add support for error reporting on range check.
+    // Returns at least 57 bits starting at the current bit offset. The bits
+    // are read with a single unaligned little-endian load of the byte that
+    // holds the current bit and the seven bytes that follow it, byte swapped
+    // on big-endian hosts. Bytes past the end of the buffer are read as zeros.
+    inline uint64_t LoadBits() const {
+      const size_t byte_offset = bit_offset_ >> 3;
+      const int bit_shift = static_cast<int>(bit_offset_ & 0x7);
+      const uint8_t *const src = bit_buffer_ + byte_offset;
+      uint64_t word = 0;
+      if (src + sizeof(word) <= bit_buffer_end_) {
+        memcpy(&word, src, sizeof(word));
+      } else if (src < bit_buffer_end_) {
+        memcpy(&word, src, bit_buffer_end_ - src);
       }
-      return 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      word = __builtin_bswap64(word);
+#endif
+      return word >> bit_shift;
     }
 
     const uint8_t *bit_buffer_;
@@ -211,6 +268,7 @@ class DecoderBuffer {
   BitDecoder bit_decoder_;
   bool bit_mode_;
   uint16_t bitstream_version_;
+  bool out_of_data_;
 };
 
 }  // namespace draco
@@ -16,6 +16,7 @@
 #define DRACO_CORE_DRACO_INDEX_TYPE_VECTOR_H_
 
 #include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -25,17 +26,20 @@ namespace draco {
 
 // A wrapper around the standard std::vector that supports indexing of the
 // vector entries using the strongly typed indices as defined in
-// draco_index_type.h .
+// draco_index_type.h . |AllocatorT| is the allocator of the underlying vector.
 // TODO(ostava): Make the interface more complete. It's currently missing
 // features such as iterators.
 // TODO(vytyaz): Add more unit tests for this class.
-template <class IndexTypeT, class ValueTypeT>
+template <class IndexTypeT, class ValueTypeT,
+          class AllocatorT = std::allocator<ValueTypeT>>
 class IndexTypeVector {
  public:
-  typedef typename std::vector<ValueTypeT>::const_reference const_reference;
-  typedef typename std::vector<ValueTypeT>::reference reference;
+  typedef std::vector<ValueTypeT, AllocatorT> VectorType;
+  typedef typename VectorType::const_reference const_reference;
+  typedef typename VectorType::reference reference;
 
   IndexTypeVector() {}
+  explicit IndexTypeVector(const AllocatorT &allocator) : vector_(allocator) {}
   explicit IndexTypeVector(size_t size) : vector_(size) {}
   IndexTypeVector(size_t size, const ValueTypeT &val) : vector_(size, val) {}
 
@@ -45,7 +49,7 @@ class IndexTypeVector {
   void resize(size_t size, const ValueTypeT &val) { vector_.resize(size, val); }
   void assign(size_t size, const ValueTypeT &val) { vector_.assign(size, val); }
 
-  void swap(IndexTypeVector<IndexTypeT, ValueTypeT> &arg) {
+  void swap(IndexTypeVector &arg) {
     vector_.swap(arg.vector_);
   }
 
@@ -75,7 +79,7 @@ class IndexTypeVector {
   const ValueTypeT *data() const { return vector_.data(); }
 
  private:
-  std::vector<ValueTypeT> vector_;
+  VectorType vector_;
 };
 
 }  // namespace draco
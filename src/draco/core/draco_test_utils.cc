@@ -14,6 +14,8 @@
 //
 #include "draco/core/draco_test_utils.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 
 #include "draco/core/macros.h"
@@ -25,6 +27,7 @@ namespace draco {
 namespace {
 static constexpr char kTestDataDir[] = DRACO_TEST_DATA_DIR;
 static constexpr char kTestTempDir[] = DRACO_TEST_TEMP_DIR;
+static constexpr char kTestToolsDir[] = DRACO_TEST_TOOLS_DIR;
 }  // namespace
 
 std::string GetTestFileFullPath(const std::string &file_name) {
@@ -35,6 +38,10 @@ std::string GetTestTempFileFullPath(const std::string &file_name) {
   return std::string(kTestTempDir) + std::string("/") + file_name;
 }
 
+std::string GetToolFullPath(const std::string &tool_name) {
+  return std::string(kTestToolsDir) + std::string("/") + tool_name;
+}
+
 bool GenerateGoldenFile(const std::string &golden_file_name, const void *data,
                         int data_size) {
   const std::string path = GetTestFileFullPath(golden_file_name);
@@ -77,4 +84,28 @@ bool CompareGoldenFile(const std::string &golden_file_name, const void *data,
   return true;
 }
 
+std::vector<std::string> GetSortedFaces(const Mesh &mesh,
+                                        const Mesh &ref_mesh) {
+  std::vector<std::string> faces;
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    std::array<std::string, 3> corners;
+    for (int c = 0; c < 3; ++c) {
+      for (int i = 0; i < ref_mesh.num_attributes(); ++i) {
+        const PointAttribute *const att =
+            mesh.GetAttributeByUniqueId(ref_mesh.attribute(i)->unique_id());
+        const char *const value = reinterpret_cast<const char *>(
+            att->GetAddressOfMappedIndex(mesh.face(f)[c]));
+        corners[c].append(value, att->byte_stride());
+      }
+    }
+    // Rotate the face so that it starts with its smallest corner.
+    const int first = static_cast<int>(
+        std::min_element(corners.begin(), corners.end()) - corners.begin());
+    faces.push_back(corners[first] + corners[(first + 1) % 3] +
+                    corners[(first + 2) % 3]);
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
 }  // namespace draco
@@ -15,6 +15,9 @@
 #ifndef DRACO_CORE_DRACO_TEST_UTILS_H_
 #define DRACO_CORE_DRACO_TEST_UTILS_H_
 
+#include <string>
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 #include "draco/io/mesh_io.h"
 #include "draco/io/point_cloud_io.h"
@@ -29,6 +32,9 @@ std::string GetTestFileFullPath(const std::string &entry_name);
 // generated files).
 std::string GetTestTempFileFullPath(const std::string &file_name);
 
+// Returns the full path to a given command line tool (e.g. "draco_encoder").
+std::string GetToolFullPath(const std::string &tool_name);
+
 // Generates a new golden file and saves it into the correct folder.
 // Returns false if the file couldn't be created.
 bool GenerateGoldenFile(const std::string &golden_file_name, const void *data,
@@ -65,6 +71,12 @@ inline std::unique_ptr<PointCloud> ReadPointCloudFromTestFile(
   return ReadPointCloudFromFile(path).value();
 }
 
+// Returns the faces of |mesh| described by the values of all attributes of
+// |ref_mesh| on their corners, independent of the order of the faces and the
+// points. Attributes of |mesh| are matched to |ref_mesh| by their unique ids.
+std::vector<std::string> GetSortedFaces(const Mesh &mesh,
+                                        const Mesh &ref_mesh);
+
 // Evaluates an expression that returns draco::Status. If the status is not OK,
 // the macro asserts and logs the error message.
 #define DRACO_ASSERT_OK(expression)                                      \
@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 
+#include "draco/core/bit_packing.h"
 #include "draco/core/bit_utils.h"
 #include "draco/core/macros.h"
 
@@ -53,6 +54,19 @@ class EncoderBuffer {
     bit_encoder_->PutBits(value, nbits);
     return true;
   }
+
+  // Encodes |nbits| least significant bits of each of the |count| |values|.
+  // Produces the same output as |count| calls of
+  // EncodeLeastSignificantBits32().
+  bool EncodeLeastSignificantBitsBulk(int nbits, const uint32_t *values,
+                                      size_t count) {
+    if (!bit_encoder_active()) {
+      return false;
+    }
+    bit_encoder_->PutBitsBulk(values, count, nbits);
+    return true;
+  }
+
   // Encode an arbitrary data type.
   // Can be used only when we are not encoding a bit-sequence.
   // Returns false when the value couldn't be encoded.
@@ -95,6 +109,15 @@ class EncoderBuffer {
       }
     }
 
+    // Write |nbits| of each of the |count| |values| into the bit buffer.
+    void PutBitsBulk(const uint32_t *values, size_t count, int32_t nbits) {
+      DRACO_DCHECK_GE(nbits, 0);
+      DRACO_DCHECK_LE(nbits, 32);
+      PackBits(values, count, nbits, bit_offset_,
+               reinterpret_cast<uint8_t *>(bit_buffer_));
+      bit_offset_ += count * nbits;
+    }
+
     // Return number of bits encoded so far.
     uint64_t Bits() const { return static_cast<uint64_t>(bit_offset_); }
 
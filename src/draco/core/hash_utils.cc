@@ -23,25 +23,25 @@ namespace draco {
 // Will never return 1 or 0.
 uint64_t FingerprintString(const char *s, size_t len) {
   const uint64_t seed = 0x87654321;
-  const int hash_loop_count = static_cast<int>(len / 8) + 1;
+  const size_t hash_loop_count = len / 8 + 1;
   uint64_t hash = seed;
 
-  for (int i = 0; i < hash_loop_count; ++i) {
-    const int off = i * 8;
-    const int num_chars_left = static_cast<int>(len) - off;
+  for (size_t i = 0; i < hash_loop_count; ++i) {
+    const size_t off = i * 8;
+    // |off| never exceeds |len|, so the subtraction can not wrap around.
+    const size_t num_chars_left = len - off;
     uint64_t new_hash = seed;
 
     if (num_chars_left > 7) {
-      const int off2 = i * 8;
-      new_hash = static_cast<uint64_t>(s[off2]) << 56 |
-                 static_cast<uint64_t>(s[off2 + 1]) << 48 |
-                 static_cast<uint64_t>(s[off2 + 2]) << 40 |
-                 static_cast<uint64_t>(s[off2 + 3]) << 32 |
-                 static_cast<uint64_t>(s[off2 + 4]) << 24 |
-                 static_cast<uint64_t>(s[off2 + 5]) << 16 |
-                 static_cast<uint64_t>(s[off2 + 6]) << 8 | s[off2 + 7];
+      new_hash = static_cast<uint64_t>(s[off]) << 56 |
+                 static_cast<uint64_t>(s[off + 1]) << 48 |
+                 static_cast<uint64_t>(s[off + 2]) << 40 |
+                 static_cast<uint64_t>(s[off + 3]) << 32 |
+                 static_cast<uint64_t>(s[off + 4]) << 24 |
+                 static_cast<uint64_t>(s[off + 5]) << 16 |
+                 static_cast<uint64_t>(s[off + 6]) << 8 | s[off + 7];
     } else {
-      for (int j = 0; j < num_chars_left; ++j) {
+      for (size_t j = 0; j < num_chars_left; ++j) {
         new_hash |= static_cast<uint64_t>(s[off + j])
                     << (64 - ((num_chars_left - j) * 8));
       }
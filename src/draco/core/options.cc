@@ -14,10 +14,13 @@
 //
 #include "draco/core/options.h"
 
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 #include <utility>
 
+#include "draco/core/hash_utils.h"
+
 namespace draco {
 
 Options::Options() {}
@@ -28,12 +31,23 @@ void Options::MergeAndReplace(const Options &other_options) {
   }
 }
 
+uint64_t Options::Fingerprint() const {
+  uint64_t hash = 79;  // Magic number.
+  for (const auto &item : options_) {
+    hash = HashCombine(
+        FingerprintString(item.first.c_str(), item.first.size()), hash);
+    hash = HashCombine(
+        FingerprintString(item.second.c_str(), item.second.size()), hash);
+  }
+  return hash;
+}
+
 void Options::SetInt(const std::string &name, int val) {
   options_[name] = std::to_string(val);
 }
 
 void Options::SetFloat(const std::string &name, float val) {
-  options_[name] = std::to_string(val);
+  options_[name] = ValueToString(val);
 }
 
 void Options::SetBool(const std::string &name, bool val) {
@@ -91,4 +105,11 @@ std::string Options::GetString(const std::string &name,
   return it->second;
 }
 
+std::string Options::ValueToString(float val) {
+  // Nine significant digits are enough to represent any float exactly.
+  char str[32];
+  snprintf(str, sizeof(str), "%.9g", val);
+  return str;
+}
+
 }  // namespace draco
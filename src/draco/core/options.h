@@ -15,6 +15,7 @@
 #ifndef DRACO_CORE_OPTIONS_H_
 #define DRACO_CORE_OPTIONS_H_
 
+#include <cstdint>
 #include <cstdlib>
 #include <map>
 #include <string>
@@ -68,7 +69,17 @@ class Options {
     return options_.count(name) > 0;
   }
 
+  // Returns a fingerprint of all options. Options with the same entries have
+  // the same fingerprint.
+  uint64_t Fingerprint() const;
+
  private:
+  // Converts |val| to the string stored in the options.
+  template <typename DataTypeT>
+  static std::string ValueToString(DataTypeT val);
+  // Floats are stored with enough digits to be parsed back to the same value.
+  static std::string ValueToString(float val);
+
   // All entries are internally stored as strings and converted to the desired
   // return type based on the used Get* method.
   // TODO(ostava): Consider adding type safety mechanism that would prevent
@@ -84,16 +95,20 @@ void Options::SetVector(const std::string &name, const DataTypeT *vec,
     if (i > 0) {
       out += " ";
     }
+    out += ValueToString(vec[i]);
+  }
+  options_[name] = out;
+}
 
+template <typename DataTypeT>
+std::string Options::ValueToString(DataTypeT val) {
 // GNU STL on android doesn't include a proper std::to_string, but the libc++
 // version does
 #if defined(ANDROID) && !defined(_LIBCPP_VERSION)
-    out += to_string(vec[i]);
+  return to_string(val);
 #else
-    out += std::to_string(vec[i]);
+  return std::to_string(val);
 #endif
-  }
-  options_[name] = out;
 }
 
 template <class VectorT>
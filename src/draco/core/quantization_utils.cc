@@ -14,6 +14,8 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include "draco/core/cpu_features.h"
+
 namespace draco {
 
 Quantizer::Quantizer() : inverse_delta_(1.f) {}
@@ -39,4 +41,25 @@ bool Dequantizer::Init(float delta) {
   return true;
 }
 
+void Dequantizer::DequantizeFloats(const int32_t *in, size_t num_entries,
+                                   int num_components, const float *min_values,
+                                   float *out) const {
+  const size_t num_values = num_entries * num_components;
+  size_t i = 0;
+#if DRACO_ENABLE_SSE4_1
+  if (CpuSupportsSse4()) {
+    i = DequantizeFloatsSse4(in, num_values, num_components, delta_,
+                             min_values, out);
+  }
+#elif DRACO_ENABLE_NEON && defined(__aarch64__)
+  i = DequantizeFloatsNeon(in, num_values, num_components, delta_, min_values,
+                           out);
+#endif
+  for (; i < num_values; i += num_components) {
+    for (int c = 0; c < num_components; ++c) {
+      out[i + c] = DequantizeFloat(in[i + c]) + min_values[c];
+    }
+  }
+}
+
 }  // namespace draco
@@ -21,6 +21,7 @@
 #ifndef DRACO_CORE_QUANTIZATION_UTILS_H_
 #define DRACO_CORE_QUANTIZATION_UTILS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <cmath>
@@ -73,10 +74,33 @@ class Dequantizer {
   }
   inline float operator()(int32_t val) const { return DequantizeFloat(val); }
 
+  // Dequantizes |num_entries| entries of |num_components| components stored
+  // in |in| into |out| and adds the per-component offsets |min_values| to
+  // them. The result is identical to calling DequantizeFloat() and adding
+  // the offset for every value.
+  void DequantizeFloats(const int32_t *in, size_t num_entries,
+                        int num_components, const float *min_values,
+                        float *out) const;
+
  private:
   float delta_;
 };
 
+// SIMD kernels used by Dequantizer::DequantizeFloats(). They dequantize values
+// from the start of the input and return the number of dequantized values,
+// which is a multiple of |num_components|. Only up to four components are
+// supported.
+#if DRACO_ENABLE_SSE4_1
+size_t DequantizeFloatsSse4(const int32_t *in, size_t num_values,
+                            int num_components, float delta,
+                            const float *min_values, float *out);
+#endif
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+size_t DequantizeFloatsNeon(const int32_t *in, size_t num_values,
+                            int num_components, float delta,
+                            const float *min_values, float *out);
+#endif
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_QUANTIZATION_UTILS_H_
@@ -0,0 +1,55 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/quantization_utils.h"
+
+#if DRACO_ENABLE_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+
+namespace draco {
+
+size_t DequantizeFloatsNeon(const int32_t *in, size_t num_values,
+                            int num_components, float delta,
+                            const float *min_values, float *out) {
+  if (num_components < 1 || num_components > 4) {
+    return 0;
+  }
+  // See quantization_utils_sse4.cc.
+  float32x4_t offsets[4];
+  for (int r = 0; r < num_components; ++r) {
+    float lanes[4];
+    for (int l = 0; l < 4; ++l) {
+      lanes[l] = min_values[(r * 4 + l) % num_components];
+    }
+    offsets[r] = vld1q_f32(lanes);
+  }
+  const float32x4_t delta_vec = vdupq_n_f32(delta);
+  const size_t step = 4 * num_components;
+  size_t i = 0;
+  for (; i + step <= num_values; i += step) {
+    for (int r = 0; r < num_components; ++r) {
+      const int32x4_t values = vld1q_s32(in + i + r * 4);
+      // Separate multiplication and addition instead of a fused multiply-add
+      // to match the rounding of the scalar code.
+      const float32x4_t dequantized = vaddq_f32(
+          vmulq_f32(vcvtq_f32_s32(values), delta_vec), offsets[r]);
+      vst1q_f32(out + i + r * 4, dequantized);
+    }
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_NEON && defined(__aarch64__)
@@ -0,0 +1,57 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/quantization_utils.h"
+
+#if DRACO_ENABLE_SSE4_1
+#include <smmintrin.h>
+
+namespace draco {
+
+size_t DequantizeFloatsSse4(const int32_t *in, size_t num_values,
+                            int num_components, float delta,
+                            const float *min_values, float *out) {
+  if (num_components < 1 || num_components > 4) {
+    return 0;
+  }
+  // Four vectors of |num_components| entries hold exactly |num_components|
+  // SIMD registers, so the per-lane offsets repeat after |num_components|
+  // registers.
+  __m128 offsets[4];
+  for (int r = 0; r < num_components; ++r) {
+    float lanes[4];
+    for (int l = 0; l < 4; ++l) {
+      lanes[l] = min_values[(r * 4 + l) % num_components];
+    }
+    offsets[r] = _mm_loadu_ps(lanes);
+  }
+  const __m128 delta_vec = _mm_set1_ps(delta);
+  const size_t step = 4 * num_components;
+  size_t i = 0;
+  for (; i + step <= num_values; i += step) {
+    for (int r = 0; r < num_components; ++r) {
+      const __m128i values =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + r * 4));
+      // The multiplication and the addition are rounded separately like in
+      // the scalar code.
+      const __m128 scaled = _mm_mul_ps(_mm_cvtepi32_ps(values), delta_vec);
+      _mm_storeu_ps(out + i + r * 4, _mm_add_ps(scaled, offsets[r]));
+    }
+  }
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_ENABLE_SSE4_1
@@ -14,6 +14,8 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 
 namespace draco {
@@ -88,4 +90,28 @@ TEST_F(QuantizationUtilsTest, TestDeltaQuantization) {
             dequantizer_range.DequantizeFloat(0));
 }
 
+TEST_F(QuantizationUtilsTest, TestDequantizeFloats) {
+  // Test verifies that bulk dequantization produces the same values as
+  // dequantization of the individual values.
+  Dequantizer dequantizer;
+  ASSERT_TRUE(dequantizer.Init(7.3f, (1 << 14) - 1));
+  const float min_values[5] = {-1.5f, 0.25f, 1000.f, -3.3f, 0.f};
+  for (int num_components = 1; num_components <= 5; ++num_components) {
+    for (const size_t num_entries : {0, 1, 3, 4, 5, 17, 100}) {
+      const size_t num_values = num_entries * num_components;
+      std::vector<int32_t> in(num_values);
+      for (size_t i = 0; i < num_values; ++i) {
+        in[i] = static_cast<int32_t>((i * 7919) % (1 << 14));
+      }
+      std::vector<float> out(num_values);
+      dequantizer.DequantizeFloats(in.data(), num_entries, num_components,
+                                   min_values, out.data());
+      for (size_t i = 0; i < num_values; ++i) {
+        ASSERT_EQ(out[i], dequantizer.DequantizeFloat(in[i]) +
+                              min_values[i % num_components]);
+      }
+    }
+  }
+}
+
 }  // namespace draco
@@ -32,6 +32,7 @@ class Status {
     UNKNOWN_VERSION = -5,      // Input was created with an unknown version of
                                // the library.
     UNSUPPORTED_FEATURE = -6,  // Input contains feature that is not supported.
+    NEED_MORE_DATA = -7,       // Input is incomplete and more data is needed.
   };
 
   Status() : code_(OK) {}
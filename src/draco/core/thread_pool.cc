@@ -0,0 +1,83 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <utility>
+
+namespace draco {
+
+ThreadPool::ThreadPool(int num_threads)
+    : num_running_tasks_(0), stopping_(false) {
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::thread(&ThreadPool::RunWorker, this));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_available_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  task_available_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  tasks_finished_.wait(
+      lock, [this]() { return tasks_.empty() && num_running_tasks_ == 0; });
+}
+
+void ThreadPool::RunWorker() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock,
+                           [this]() { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;  // The pool is being destroyed.
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      ++num_running_tasks_;
+    }
+    task();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_running_tasks_;
+      if (tasks_.empty() && num_running_tasks_ == 0) {
+        tasks_finished_.notify_all();
+      }
+    }
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,58 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <atomic>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  ThreadPoolTest() {}
+};
+
+TEST_F(ThreadPoolTest, TestAllTasksExecuted) {
+  // Tests that all scheduled tasks are finished after Wait().
+  draco::ThreadPool pool(4);
+  ASSERT_EQ(pool.num_threads(), 4);
+  std::atomic<int> counter(0);
+  for (int i = 0; i < 100; ++i) {
+    pool.Schedule([&counter]() { ++counter; });
+  }
+  pool.Wait();
+  ASSERT_EQ(counter.load(), 100);
+
+  // The pool can be reused after Wait().
+  pool.Schedule([&counter]() { ++counter; });
+  pool.Wait();
+  ASSERT_EQ(counter.load(), 101);
+}
+
+TEST_F(ThreadPoolTest, TestDestructorWaits) {
+  // Tests that the destructor finishes all scheduled tasks.
+  std::atomic<int> counter(0);
+  {
+    draco::ThreadPool pool(0);
+    ASSERT_EQ(pool.num_threads(), 1);
+    for (int i = 0; i < 10; ++i) {
+      pool.Schedule([&counter]() { ++counter; });
+    }
+  }
+  ASSERT_EQ(counter.load(), 10);
+}
+
+}  // namespace
@@ -23,6 +23,14 @@ class FileReaderInterface {
   virtual bool ReadFileToBuffer(std::vector<char> *buffer) = 0;
   virtual bool ReadFileToBuffer(std::vector<uint8_t> *buffer) = 0;
 
+  // Reads |size| bytes starting at byte |offset| of the input file into
+  // |buffer| and returns true. Readers that do not support ranged reads return
+  // false.
+  virtual bool ReadFileRangeToBuffer(size_t /* offset */, size_t /* size */,
+                                     std::vector<char> * /* buffer */) {
+    return false;
+  }
+
   // Returns the size of the file.
   virtual size_t GetFileSize() = 0;
 };
@@ -76,6 +76,16 @@ bool ReadFileToBuffer(const std::string &file_name,
   return file_reader->ReadFileToBuffer(buffer);
 }
 
+bool ReadFileRangeToBuffer(const std::string &file_name, size_t offset,
+                           size_t size, std::vector<char> *buffer) {
+  std::unique_ptr<FileReaderInterface> file_reader =
+      FileReaderFactory::OpenReader(file_name);
+  if (file_reader == nullptr) {
+    return false;
+  }
+  return file_reader->ReadFileRangeToBuffer(offset, size, buffer);
+}
+
 bool WriteBufferToFile(const char *buffer, size_t buffer_size,
                        const std::string &file_name) {
   std::unique_ptr<FileWriterInterface> file_writer =
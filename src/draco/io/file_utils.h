@@ -53,6 +53,12 @@ bool ReadFileToBuffer(const std::string &file_name, std::vector<char> *buffer);
 bool ReadFileToBuffer(const std::string &file_name,
                       std::vector<uint8_t> *buffer);
 
+// Convenience method. Uses draco::FileReaderFactory internally. Reads |size|
+// bytes starting at byte |offset| of the file referenced by |file_name| into
+// |buffer| and returns true upon success.
+bool ReadFileRangeToBuffer(const std::string &file_name, size_t offset,
+                           size_t size, std::vector<char> *buffer);
+
 // Convenience method. Uses draco::FileWriterFactory internally. Writes contents
 // of |buffer| to file referred to by |file_name|. File is overwritten if it
 // exists. Returns true after successful write.
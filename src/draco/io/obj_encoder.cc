@@ -15,6 +15,7 @@
 #include "draco/io/obj_encoder.h"
 
 #include <memory>
+#include <vector>
 
 #include "draco/io/file_writer_factory.h"
 #include "draco/io/file_writer_interface.h"
@@ -184,13 +185,15 @@ bool ObjEncoder::EncodePositions() {
   if (att == nullptr || att->size() == 0) {
     return false;  // Position attribute must be valid.
   }
-  std::array<float, 3> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 3>(i, &value[0])) {
-      return false;
-    }
+  const int num_values = static_cast<int>(att->size());
+  std::vector<float> values(num_values * 3);
+  if (!att->ConvertValues<float>(AttributeValueIndex(0), num_values, 3,
+                                 values.data())) {
+    return false;
+  }
+  for (int i = 0; i < num_values; ++i) {
     buffer()->Encode("v ", 2);
-    EncodeFloatList(&value[0], 3);
+    EncodeFloatList(&values[i * 3], 3);
     buffer()->Encode("\n", 1);
   }
   pos_att_ = att;
@@ -203,13 +206,15 @@ bool ObjEncoder::EncodeTextureCoordinates() {
   if (att == nullptr || att->size() == 0) {
     return true;  // It's OK if we don't have texture coordinates.
   }
-  std::array<float, 2> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 2>(i, &value[0])) {
-      return false;
-    }
+  const int num_values = static_cast<int>(att->size());
+  std::vector<float> values(num_values * 2);
+  if (!att->ConvertValues<float>(AttributeValueIndex(0), num_values, 2,
+                                 values.data())) {
+    return false;
+  }
+  for (int i = 0; i < num_values; ++i) {
     buffer()->Encode("vt ", 3);
-    EncodeFloatList(&value[0], 2);
+    EncodeFloatList(&values[i * 2], 2);
     buffer()->Encode("\n", 1);
   }
   tex_coord_att_ = att;
@@ -222,13 +227,15 @@ bool ObjEncoder::EncodeNormals() {
   if (att == nullptr || att->size() == 0) {
     return true;  // It's OK if we don't have normals.
   }
-  std::array<float, 3> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 3>(i, &value[0])) {
-      return false;
-    }
+  const int num_values = static_cast<int>(att->size());
+  std::vector<float> values(num_values * 3);
+  if (!att->ConvertValues<float>(AttributeValueIndex(0), num_values, 3,
+                                 values.data())) {
+    return false;
+  }
+  for (int i = 0; i < num_values; ++i) {
     buffer()->Encode("vn ", 3);
-    EncodeFloatList(&value[0], 3);
+    EncodeFloatList(&values[i * 3], 3);
     buffer()->Encode("\n", 1);
   }
   normal_att_ = att;
@@ -81,6 +81,29 @@ bool StdioFileReader::ReadFileToBuffer(std::vector<uint8_t> *buffer) {
   return fread(buffer->data(), 1, file_size, file_) == file_size;
 }
 
+bool StdioFileReader::ReadFileRangeToBuffer(size_t offset, size_t size,
+                                            std::vector<char> *buffer) {
+  if (buffer == nullptr) {
+    return false;
+  }
+  buffer->clear();
+
+#if _FILE_OFFSET_BITS == 64
+  const int seek_result = fseeko(file_, static_cast<off_t>(offset), SEEK_SET);
+#elif defined _WIN64
+  const int seek_result = _fseeki64(file_, offset, SEEK_SET);
+#else
+  const int seek_result = fseek(file_, static_cast<long>(offset), SEEK_SET);
+#endif
+  if (seek_result != 0) {
+    FILEREADER_LOG_ERROR("Seek to range offset failed");
+    return false;
+  }
+
+  buffer->resize(size);
+  return fread(buffer->data(), 1, size, file_) == size;
+}
+
 size_t StdioFileReader::GetFileSize() {
   if (fseek(file_, SEEK_SET, SEEK_END) != 0) {
     FILEREADER_LOG_ERROR("Seek to EoF failed");
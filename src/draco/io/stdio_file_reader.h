@@ -33,6 +33,11 @@ class StdioFileReader : public FileReaderInterface {
   bool ReadFileToBuffer(std::vector<char> *buffer) override;
   bool ReadFileToBuffer(std::vector<uint8_t> *buffer) override;
 
+  // Reads |size| bytes starting at byte |offset| into |buffer| and returns
+  // true.
+  bool ReadFileRangeToBuffer(size_t offset, size_t size,
+                             std::vector<char> *buffer) override;
+
   // Returns the size of the file.
   size_t GetFileSize() override;
 
@@ -258,20 +258,12 @@ bool Decoder::GetAttributeFloatForAllPoints(const PointCloud &pc,
   const int components = pa.num_components();
   const int num_points = pc.num_points();
   const int num_entries = num_points * components;
-  const int kMaxAttributeFloatValues = 4;
-  float values[kMaxAttributeFloatValues] = {-2.0, -2.0, -2.0, -2.0};
-  int entry_id = 0;
-
-  out_values->Resize(num_entries);
-  for (draco::PointIndex i(0); i < num_points; ++i) {
-    const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-    if (!pa.ConvertValue<float>(val_index, values)) {
-      return false;
-    }
-    for (int j = 0; j < components; ++j) {
-      out_values->SetValue(entry_id++, values[j]);
-    }
+  std::vector<float> values(num_entries);
+  if (!pa.ConvertMappedValues<float>(draco::PointIndex(0), num_points,
+                                     values.data())) {
+    return false;
   }
+  out_values->MoveData(std::move(values));
   return true;
 }
 
@@ -285,26 +277,8 @@ bool Decoder::GetAttributeFloatArrayForAllPoints(const PointCloud &pc,
   if (data_size != out_size) {
     return false;
   }
-  const bool requested_type_is_float = pa.data_type() == draco::DT_FLOAT32;
-  const int kMaxAttributeFloatValues = 4;
-  float values[kMaxAttributeFloatValues] = {-2.0, -2.0, -2.0, -2.0};
-  int entry_id = 0;
-  float *const floats = reinterpret_cast<float *>(out_values);
-
-  for (draco::PointIndex i(0); i < num_points; ++i) {
-    const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-    if (requested_type_is_float) {
-      pa.GetValue(val_index, values);
-    } else {
-      if (!pa.ConvertValue<float>(val_index, values)) {
-        return false;
-      }
-    }
-    for (int j = 0; j < components; ++j) {
-      floats[entry_id++] = values[j];
-    }
-  }
-  return true;
+  return pa.ConvertMappedValues<float>(draco::PointIndex(0), num_points,
+                                      reinterpret_cast<float *>(out_values));
 }
 
 bool Decoder::GetAttributeInt8ForAllPoints(const PointCloud &pc,
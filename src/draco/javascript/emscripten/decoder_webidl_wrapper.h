@@ -289,20 +289,13 @@ class Decoder {
       return true;
     }
 
-    // Copy values one by one.
-    std::vector<ValueTypeT> values(components);
-    int entry_id = 0;
-
-    out_values->Resize(num_entries);
-    for (draco::PointIndex i(0); i < num_points; ++i) {
-      const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-      if (!pa.ConvertValue<ValueTypeT>(val_index, &values[0])) {
-        return false;
-      }
-      for (int j = 0; j < components; ++j) {
-        out_values->SetValue(entry_id++, values[j]);
-      }
+    // Convert all values at once.
+    std::vector<ValueTypeT> values(num_entries);
+    if (!pa.ConvertMappedValues<ValueTypeT>(draco::PointIndex(0), num_points,
+                                            values.data())) {
+      return false;
     }
+    out_values->MoveData(std::move(values));
     return true;
   }
 
@@ -326,25 +319,9 @@ class Decoder {
       return true;
     }
 
-    // Copy values one by one.
-    std::vector<T> values(components);
-    int entry_id = 0;
-
-    T *const typed_output = reinterpret_cast<T *>(out_values);
-    for (draco::PointIndex i(0); i < num_points; ++i) {
-      const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-      if (requested_type_matches) {
-        pa.GetValue(val_index, values.data());
-      } else {
-        if (!pa.ConvertValue<T>(val_index, values.data())) {
-          return false;
-        }
-      }
-      for (int j = 0; j < components; ++j) {
-        typed_output[entry_id++] = values[j];
-      }
-    }
-    return true;
+    // Convert all values at once.
+    return pa.ConvertMappedValues<T>(draco::PointIndex(0), num_points,
+                                     reinterpret_cast<T *>(out_values));
   }
 
   draco::Decoder decoder_;
@@ -42,16 +42,8 @@ static void decode_vertices(std::unique_ptr<draco::Mesh> &drc_mesh,
   int num_vertices = drc_mesh->num_points();
   out_mesh->vertices = new float[num_vertices * 3];
   out_mesh->vertices_num = num_vertices;
-  for (int i = 0; i < num_vertices; i++) {
-    draco::PointIndex pi(i);
-    const draco::AttributeValueIndex val_index = pos_att->mapped_index(pi);
-    float out_vertex[3];
-    bool is_ok = pos_att->ConvertValue<float, 3>(val_index, out_vertex);
-    if (!is_ok) return;
-    out_mesh->vertices[i * 3 + 0] = out_vertex[0];
-    out_mesh->vertices[i * 3 + 1] = out_vertex[1];
-    out_mesh->vertices[i * 3 + 2] = out_vertex[2];
-  }
+  pos_att->ConvertMappedValues<float>(draco::PointIndex(0), num_vertices, 3,
+                                      out_mesh->vertices);
 }
 static void decode_normals(std::unique_ptr<draco::Mesh> &drc_mesh,
                            Drc2PyMesh *out_mesh) {
@@ -66,16 +58,8 @@ static void decode_normals(std::unique_ptr<draco::Mesh> &drc_mesh,
   out_mesh->normals = new float[num_normals * 3];
   out_mesh->normals_num = num_normals;
 
-  for (int i = 0; i < num_normals; i++) {
-    draco::PointIndex pi(i);
-    const draco::AttributeValueIndex val_index = normal_att->mapped_index(pi);
-    float out_normal[3];
-    bool is_ok = normal_att->ConvertValue<float, 3>(val_index, out_normal);
-    if (!is_ok) return;
-    out_mesh->normals[i * 3 + 0] = out_normal[0];
-    out_mesh->normals[i * 3 + 1] = out_normal[1];
-    out_mesh->normals[i * 3 + 2] = out_normal[2];
-  }
+  normal_att->ConvertMappedValues<float>(draco::PointIndex(0), num_normals, 3,
+                                         out_mesh->normals);
 }
 static void decode_uvs(std::unique_ptr<draco::Mesh> &drc_mesh,
                        Drc2PyMesh *out_mesh) {
@@ -92,15 +76,8 @@ static void decode_uvs(std::unique_ptr<draco::Mesh> &drc_mesh,
   out_mesh->uvs_num = num_uvs;
   out_mesh->uvs_real_num = uv_att->size();
 
-  for (int i = 0; i < num_uvs; i++) {
-    draco::PointIndex pi(i);
-    const draco::AttributeValueIndex val_index = uv_att->mapped_index(pi);
-    float out_uv[2];
-    bool is_ok = uv_att->ConvertValue<float, 2>(val_index, out_uv);
-    if (!is_ok) return;
-    out_mesh->uvs[i * 2 + 0] = out_uv[0];
-    out_mesh->uvs[i * 2 + 1] = out_uv[1];
-  }
+  uv_att->ConvertMappedValues<float>(draco::PointIndex(0), num_uvs, 2,
+                                     out_mesh->uvs);
 }
 
 void drc2py_free(Drc2PyMesh **mesh_ptr) {
@@ -0,0 +1,187 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/compact_corner_table.h"
+
+#include <algorithm>
+
+#include "draco/mesh/corner_table_iterators.h"
+
+namespace draco {
+
+CompactCornerTable::CompactCornerTable()
+    : num_vertices_(0),
+      num_original_vertices_(0),
+      num_degenerated_faces_(0),
+      num_isolated_vertices_(0),
+      valence_cache_(*this) {}
+
+std::unique_ptr<CompactCornerTable> CompactCornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  const std::unique_ptr<CornerTable> table = CornerTable::Create(faces);
+  if (table == nullptr) {
+    return nullptr;
+  }
+  return Create(*table);
+}
+
+std::unique_ptr<CompactCornerTable> CompactCornerTable::Create(
+    const CornerTable &table) {
+  std::unique_ptr<CompactCornerTable> ct(new CompactCornerTable());
+  if (!ct->InitFromCornerTable(table)) {
+    return nullptr;
+  }
+  return ct;
+}
+
+bool CompactCornerTable::InitFromCornerTable(const CornerTable &table) {
+  valence_cache_.ClearValenceCache();
+  valence_cache_.ClearValenceCacheInaccurate();
+  const int num_corners = table.num_corners();
+  opposite_corners_.resize(num_corners);
+  for (CornerIndex c(0); c < num_corners; ++c) {
+    const CornerIndex opp = table.Opposite(c);
+    // Vertex() relies on symmetric opposite corners, which guarantee that
+    // swinging around a vertex either returns to the start or ends at a
+    // boundary.
+    if (opp != kInvalidCornerIndex &&
+        (opp.value() >= static_cast<uint32_t>(num_corners) ||
+         table.Opposite(opp) != c)) {
+      return false;
+    }
+    opposite_corners_[c] = opp;
+  }
+
+  // Mark the left-most corner of every vertex.
+  num_vertices_ = table.num_vertices();
+  fan_corner_bits_.assign((num_corners + 63) / 64, 0);
+  for (VertexIndex v(0); v < num_vertices_; ++v) {
+    const CornerIndex c = table.LeftMostCorner(v);
+    if (c == kInvalidCornerIndex) {
+      continue;
+    }
+    if (c.value() >= static_cast<uint32_t>(num_corners) ||
+        table.Vertex(c) != v || IsFanCorner(c)) {
+      return false;
+    }
+    fan_corner_bits_[c.value() >> 6] |= static_cast<uint64_t>(1)
+                                        << (c.value() & 63);
+  }
+  fan_corner_ranks_.resize(fan_corner_bits_.size());
+  fan_vertices_.clear();
+  for (CornerIndex c(0); c < num_corners; ++c) {
+    if ((c.value() & 63) == 0) {
+      fan_corner_ranks_[c.value() >> 6] =
+          static_cast<uint32_t>(fan_vertices_.size());
+    }
+    if (IsFanCorner(c)) {
+      fan_vertices_.push_back(table.Vertex(c));
+    }
+  }
+
+  // Store the vertices of corners that cannot be derived from the fans.
+  extra_corner_vertices_.clear();
+  for (CornerIndex c(0); c < num_corners; ++c) {
+    const VertexIndex v = table.Vertex(c);
+    const VertexIndex fan_v = ConfidentVertex(c);
+    if (fan_v == v) {
+      continue;
+    }
+    if (fan_v != kInvalidVertexIndex) {
+      return false;  // The fan of |c| is marked with a different vertex.
+    }
+    extra_corner_vertices_.push_back(std::make_pair(c, v));
+  }
+
+  ReleaseVertexCorners();
+  ComputeVertexCorners();
+  num_original_vertices_ = table.NumOriginalVertices();
+  non_manifold_vertex_parents_.clear();
+  for (VertexIndex v(num_original_vertices_); v < num_vertices_; ++v) {
+    non_manifold_vertex_parents_.push_back(table.VertexParent(v));
+  }
+  num_degenerated_faces_ = table.NumDegeneratedFaces();
+  num_isolated_vertices_ = table.NumIsolatedVertices();
+  return true;
+}
+
+VertexIndex CompactCornerTable::ExtraCornerVertex(CornerIndex corner) const {
+  const auto it = std::lower_bound(
+      extra_corner_vertices_.begin(), extra_corner_vertices_.end(), corner,
+      [](const std::pair<CornerIndex, VertexIndex> &entry, CornerIndex c) {
+        return entry.first < c;
+      });
+  if (it == extra_corner_vertices_.end() || it->first != corner) {
+    return kInvalidVertexIndex;
+  }
+  return it->second;
+}
+
+bool CompactCornerTable::IsDegenerated(FaceIndex face) const {
+  if (face == kInvalidFaceIndex) {
+    return true;
+  }
+  const FaceType vertices = FaceData(face);
+  return vertices[0] == vertices[1] || vertices[0] == vertices[2] ||
+         vertices[1] == vertices[2];
+}
+
+int CompactCornerTable::Valence(VertexIndex v) const {
+  if (v == kInvalidVertexIndex) {
+    return -1;
+  }
+  return ConfidentValence(v);
+}
+
+int CompactCornerTable::ConfidentValence(VertexIndex v) const {
+  DRACO_DCHECK_GE(v.value(), 0);
+  DRACO_DCHECK_LT(v.value(), num_vertices());
+  VertexRingIterator<CompactCornerTable> vi(this, v);
+  int valence = 0;
+  for (; !vi.End(); vi.Next()) {
+    ++valence;
+  }
+  return valence;
+}
+
+void CompactCornerTable::ComputeVertexCorners() {
+  if (has_vertex_corners()) {
+    return;
+  }
+  // The marked corners are the left-most corners of their vertices.
+  vertex_corners_.assign(num_vertices_, kInvalidCornerIndex);
+  int rank = 0;
+  for (CornerIndex c(0); c < num_corners(); ++c) {
+    if (IsFanCorner(c)) {
+      vertex_corners_[fan_vertices_[rank++]] = c;
+    }
+  }
+}
+
+void CompactCornerTable::ReleaseVertexCorners() {
+  vertex_corners_ = IndexTypeVector<VertexIndex, CornerIndex>();
+}
+
+size_t CompactCornerTable::num_bytes() const {
+  return opposite_corners_.size() * sizeof(CornerIndex) +
+         fan_corner_bits_.size() * sizeof(uint64_t) +
+         fan_corner_ranks_.size() * sizeof(uint32_t) +
+         fan_vertices_.size() * sizeof(VertexIndex) +
+         extra_corner_vertices_.size() *
+             sizeof(std::pair<CornerIndex, VertexIndex>) +
+         vertex_corners_.size() * sizeof(CornerIndex) +
+         non_manifold_vertex_parents_.size() * sizeof(VertexIndex);
+}
+
+}  // namespace draco
@@ -0,0 +1,271 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_MESH_COMPACT_CORNER_TABLE_H_
+#define DRACO_MESH_COMPACT_CORNER_TABLE_H_
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "draco/attributes/geometry_indices.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/core/macros.h"
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/valence_cache.h"
+
+namespace draco {
+
+// Read-only corner table with the same connectivity and the same interface as
+// CornerTable, so that it can be used by all code templated on the corner
+// table type, such as traversers, prediction schemes or corner table
+// iterators. It uses roughly half of the memory of CornerTable, which makes
+// it suitable for very large meshes.
+//
+// Only the opposite corners are stored for every corner. The vertices are
+// derived from them: each vertex is attached to a single fan of corners and
+// one corner of every fan (the left-most corner of CornerTable) is marked in
+// a bit vector. Vertex() swings left from the given corner until it reaches
+// the marked corner, whose vertex is found through the rank of its bit. The
+// few corners that are not part of any fan, such as corners of degenerated
+// faces, store their vertices explicitly. As a result, Vertex() costs about
+// half of the valence of the vertex in opposite corner lookups, which makes
+// traversals slower than with CornerTable (see corner_table_benchmark.cc).
+//
+// The map from vertices to their left-most corners is needed only by
+// LeftMostCorner() and by functions built on it (e.g. IsOnBoundary(),
+// Valence() or VertexCornersIterator). It can be released to save memory and
+// rebuilt from the marked corners on demand.
+class CompactCornerTable {
+ public:
+  typedef CornerTable::FaceType FaceType;
+
+  CompactCornerTable();
+
+  // Creates a compact table from |faces|. The intermediate CornerTable is
+  // released before the function returns.
+  static std::unique_ptr<CompactCornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces);
+  // Creates a compact table with the connectivity of |table|.
+  static std::unique_ptr<CompactCornerTable> Create(const CornerTable &table);
+
+  // Initializes the table with the connectivity of |table|. Returns false
+  // when the vertices of |table| cannot be derived from its opposite corners,
+  // e.g. when the opposite corners are not symmetric.
+  bool InitFromCornerTable(const CornerTable &table);
+
+  inline int num_vertices() const { return num_vertices_; }
+  inline int num_corners() const {
+    return static_cast<int>(opposite_corners_.size());
+  }
+  inline int num_faces() const {
+    return static_cast<int>(opposite_corners_.size() / 3);
+  }
+
+  inline CornerIndex Opposite(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return opposite_corners_[corner];
+  }
+  inline CornerIndex Next(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return LocalIndex(++corner) ? corner : corner - 3;
+  }
+  inline CornerIndex Previous(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return LocalIndex(corner) ? corner - 1 : corner + 2;
+  }
+  inline VertexIndex Vertex(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return kInvalidVertexIndex;
+    }
+    return ConfidentVertex(corner);
+  }
+  inline VertexIndex ConfidentVertex(CornerIndex corner) const {
+    DRACO_DCHECK_GE(corner.value(), 0);
+    DRACO_DCHECK_LT(corner.value(), num_corners());
+    CornerIndex act_c = corner;
+    do {
+      if (IsFanCorner(act_c)) {
+        return fan_vertices_[FanCornerRank(act_c)];
+      }
+      act_c = SwingLeft(act_c);
+    } while (act_c != kInvalidCornerIndex && act_c != corner);
+    return ExtraCornerVertex(corner);
+  }
+  inline FaceIndex Face(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return kInvalidFaceIndex;
+    }
+    return FaceIndex(corner.value() / 3);
+  }
+  inline CornerIndex FirstCorner(FaceIndex face) const {
+    if (face == kInvalidFaceIndex) {
+      return kInvalidCornerIndex;
+    }
+    return CornerIndex(face.value() * 3);
+  }
+  inline std::array<CornerIndex, 3> AllCorners(FaceIndex face) const {
+    const CornerIndex ci = CornerIndex(face.value() * 3);
+    return {{ci, ci + 1, ci + 2}};
+  }
+  inline int LocalIndex(CornerIndex corner) const { return corner.value() % 3; }
+
+  inline FaceType FaceData(FaceIndex face) const {
+    const CornerIndex first_corner = FirstCorner(face);
+    FaceType face_data;
+    for (int i = 0; i < 3; ++i) {
+      face_data[i] = ConfidentVertex(first_corner + i);
+    }
+    return face_data;
+  }
+
+  // Returns the left-most corner of a single vertex 1-ring. Must not be
+  // called when the vertex corners are released.
+  inline CornerIndex LeftMostCorner(VertexIndex v) const {
+    DRACO_DCHECK(has_vertex_corners());
+    return vertex_corners_[v];
+  }
+
+  // Returns the parent vertex index of a given corner table vertex.
+  VertexIndex VertexParent(VertexIndex vertex) const {
+    if (vertex.value() < static_cast<uint32_t>(num_original_vertices_)) {
+      return vertex;
+    }
+    return non_manifold_vertex_parents_[vertex - num_original_vertices_];
+  }
+
+  inline bool IsValid(CornerIndex c) const {
+    return Vertex(c) != kInvalidVertexIndex;
+  }
+
+  int Valence(VertexIndex v) const;
+  int ConfidentValence(VertexIndex v) const;
+  inline int Valence(CornerIndex c) const {
+    if (c == kInvalidCornerIndex) {
+      return -1;
+    }
+    return ConfidentValence(c);
+  }
+  inline int ConfidentValence(CornerIndex c) const {
+    DRACO_DCHECK_LT(c.value(), num_corners());
+    return ConfidentValence(ConfidentVertex(c));
+  }
+
+  inline bool IsOnBoundary(VertexIndex vert) const {
+    const CornerIndex corner = LeftMostCorner(vert);
+    if (SwingLeft(corner) == kInvalidCornerIndex) {
+      return true;
+    }
+    return false;
+  }
+
+  inline CornerIndex SwingRight(CornerIndex corner) const {
+    return Previous(Opposite(Previous(corner)));
+  }
+  inline CornerIndex SwingLeft(CornerIndex corner) const {
+    return Next(Opposite(Next(corner)));
+  }
+
+  inline CornerIndex GetLeftCorner(CornerIndex corner_id) const {
+    if (corner_id == kInvalidCornerIndex) {
+      return kInvalidCornerIndex;
+    }
+    return Opposite(Previous(corner_id));
+  }
+  inline CornerIndex GetRightCorner(CornerIndex corner_id) const {
+    if (corner_id == kInvalidCornerIndex) {
+      return kInvalidCornerIndex;
+    }
+    return Opposite(Next(corner_id));
+  }
+
+  int NumNewVertices() const { return num_vertices() - num_original_vertices_; }
+  int NumOriginalVertices() const { return num_original_vertices_; }
+  int NumDegeneratedFaces() const { return num_degenerated_faces_; }
+  int NumIsolatedVertices() const { return num_isolated_vertices_; }
+
+  bool IsDegenerated(FaceIndex face) const;
+
+  inline bool IsVertexIsolated(VertexIndex v) const {
+    return LeftMostCorner(v) == kInvalidCornerIndex;
+  }
+
+  // Functions for the optional map from vertices to their left-most corners.
+  // The rebuilt map is the same as the one of the source CornerTable.
+  bool has_vertex_corners() const {
+    return static_cast<int>(vertex_corners_.size()) == num_vertices_;
+  }
+  void ComputeVertexCorners();
+  void ReleaseVertexCorners();
+
+  // Returns the number of bytes used by the connectivity data.
+  size_t num_bytes() const;
+
+  const ValenceCache<CompactCornerTable> &GetValenceCache() const {
+    return valence_cache_;
+  }
+
+ private:
+  // Returns true when |corner| is the marked corner of its fan.
+  inline bool IsFanCorner(CornerIndex corner) const {
+    return (fan_corner_bits_[corner.value() >> 6] >>
+            (corner.value() & 63)) &
+           1;
+  }
+  // Returns the number of marked corners before |corner|.
+  inline int FanCornerRank(CornerIndex corner) const {
+    const uint64_t bits = fan_corner_bits_[corner.value() >> 6] &
+                          ((static_cast<uint64_t>(1) << (corner.value() & 63)) -
+                           1);
+    return fan_corner_ranks_[corner.value() >> 6] +
+           CountOneBits32(static_cast<uint32_t>(bits)) +
+           CountOneBits32(static_cast<uint32_t>(bits >> 32));
+  }
+
+  // Returns the vertex of a corner that is not part of any marked fan.
+  VertexIndex ExtraCornerVertex(CornerIndex corner) const;
+
+  // Each three consecutive corners represent one face.
+  IndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
+  // One bit per corner marking the left-most corners of all vertices, and the
+  // number of marked corners before each 64-bit word of the bits.
+  std::vector<uint64_t> fan_corner_bits_;
+  std::vector<uint32_t> fan_corner_ranks_;
+  // Vertices of the marked corners in the order of the corners.
+  std::vector<VertexIndex> fan_vertices_;
+  // Vertices of corners that do not reach any marked corner, sorted by the
+  // corner index.
+  std::vector<std::pair<CornerIndex, VertexIndex>> extra_corner_vertices_;
+
+  IndexTypeVector<VertexIndex, CornerIndex> vertex_corners_;
+  int num_vertices_;
+  int num_original_vertices_;
+  int num_degenerated_faces_;
+  int num_isolated_vertices_;
+  IndexTypeVector<VertexIndex, VertexIndex> non_manifold_vertex_parents_;
+
+  ValenceCache<CompactCornerTable> valence_cache_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_MESH_COMPACT_CORNER_TABLE_H_
@@ -0,0 +1,233 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/compact_corner_table.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_encoding_transform.h"
+#include "draco/compression/mesh/traverser/depth_first_traverser.h"
+#include "draco/compression/mesh/traverser/max_prediction_degree_traverser.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/corner_table_iterators.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace {
+
+// Traversal observer that records the visited vertices and their corners.
+class RecordingObserver {
+ public:
+  RecordingObserver() : corners_(nullptr), vertices_(nullptr) {}
+  RecordingObserver(std::vector<draco::CornerIndex> *corners,
+                    std::vector<int32_t> *vertices)
+      : corners_(corners), vertices_(vertices) {}
+
+  void OnNewFaceVisited(draco::FaceIndex /* face */) {}
+  void OnNewVertexVisited(draco::VertexIndex vertex,
+                          draco::CornerIndex corner) {
+    (*vertices_)[vertex.value()] = static_cast<int32_t>(corners_->size());
+    corners_->push_back(corner);
+  }
+
+ private:
+  std::vector<draco::CornerIndex> *corners_;
+  std::vector<int32_t> *vertices_;
+};
+
+// Traverses all faces of |table| with TraverserT. Returns the visited corners
+// in |out_corners| and the order of the visited vertices in |out_vertices|.
+template <template <class, class> class TraverserT, class CornerTableT>
+void Traverse(const CornerTableT &table,
+              std::vector<draco::CornerIndex> *out_corners,
+              std::vector<int32_t> *out_vertices) {
+  out_corners->clear();
+  out_vertices->assign(table.num_vertices(), -1);
+  TraverserT<CornerTableT, RecordingObserver> traverser;
+  traverser.Init(&table, RecordingObserver(out_corners, out_vertices));
+  traverser.OnTraversalStart();
+  for (draco::FaceIndex f(0); f < table.num_faces(); ++f) {
+    if (!table.IsDegenerated(f)) {
+      ASSERT_TRUE(traverser.TraverseFromCorner(table.FirstCorner(f)));
+    }
+  }
+  traverser.OnTraversalEnd();
+}
+
+// Returns the parallelogram prediction corrections of |values| stored in the
+// traversal order |corners| of |table|.
+template <class CornerTableT>
+std::vector<int32_t> ComputeParallelogramCorrections(
+    const CornerTableT &table, const draco::Mesh &mesh,
+    const std::vector<draco::CornerIndex> &corners,
+    const std::vector<int32_t> &vertices,
+    const std::vector<int32_t> &values) {
+  typedef draco::MeshPredictionSchemeData<CornerTableT> MeshData;
+  MeshData mesh_data;
+  mesh_data.Set(&mesh, &table, &corners, &vertices);
+  draco::MeshPredictionSchemeParallelogramEncoder<
+      int32_t, draco::PredictionSchemeWrapEncodingTransform<int32_t>, MeshData>
+      encoder(nullptr, draco::PredictionSchemeWrapEncodingTransform<int32_t>(),
+              mesh_data);
+  std::vector<int32_t> corrections(values.size());
+  encoder.ComputeCorrectionValues(values.data(), corrections.data(),
+                                  static_cast<int>(values.size()), 3,
+                                  nullptr);
+  return corrections;
+}
+
+class CompactCornerTableTest : public ::testing::Test {
+ protected:
+  // Verifies that |compact_table| has the same connectivity as |table|.
+  void CompareTables(const draco::CornerTable &table,
+                     const draco::CompactCornerTable &compact_table) {
+    ASSERT_EQ(compact_table.num_faces(), table.num_faces());
+    ASSERT_EQ(compact_table.num_corners(), table.num_corners());
+    ASSERT_EQ(compact_table.num_vertices(), table.num_vertices());
+    ASSERT_EQ(compact_table.NumNewVertices(), table.NumNewVertices());
+    ASSERT_EQ(compact_table.NumDegeneratedFaces(), table.NumDegeneratedFaces());
+    ASSERT_EQ(compact_table.NumIsolatedVertices(), table.NumIsolatedVertices());
+    for (draco::FaceIndex f(0); f < table.num_faces(); ++f) {
+      ASSERT_EQ(compact_table.FaceData(f), table.FaceData(f));
+      ASSERT_EQ(compact_table.IsDegenerated(f), table.IsDegenerated(f));
+    }
+    for (draco::CornerIndex c(0); c < table.num_corners(); ++c) {
+      ASSERT_EQ(compact_table.Vertex(c), table.Vertex(c));
+      ASSERT_EQ(compact_table.Opposite(c), table.Opposite(c));
+      ASSERT_EQ(compact_table.SwingLeft(c), table.SwingLeft(c));
+      ASSERT_EQ(compact_table.SwingRight(c), table.SwingRight(c));
+      ASSERT_EQ(compact_table.GetLeftCorner(c), table.GetLeftCorner(c));
+      ASSERT_EQ(compact_table.GetRightCorner(c), table.GetRightCorner(c));
+    }
+    for (draco::VertexIndex v(0); v < table.num_vertices(); ++v) {
+      ASSERT_EQ(compact_table.LeftMostCorner(v), table.LeftMostCorner(v));
+      ASSERT_EQ(compact_table.VertexParent(v), table.VertexParent(v));
+      if (table.IsVertexIsolated(v)) {
+        continue;
+      }
+      ASSERT_EQ(compact_table.Valence(v), table.Valence(v));
+      ASSERT_EQ(compact_table.IsOnBoundary(v), table.IsOnBoundary(v));
+      draco::VertexCornersIterator<draco::CompactCornerTable> it(
+          &compact_table, v);
+      draco::VertexCornersIterator<draco::CornerTable> ref_it(&table, v);
+      for (; !ref_it.End(); ++it, ++ref_it) {
+        ASSERT_FALSE(it.End());
+        ASSERT_EQ(*it, *ref_it);
+      }
+      ASSERT_TRUE(it.End());
+    }
+  }
+
+  void TestFile(const std::string &file_name) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    const std::unique_ptr<draco::CornerTable> table =
+        draco::CreateCornerTableFromPositionAttribute(mesh.get());
+    ASSERT_NE(table, nullptr);
+    std::unique_ptr<draco::CompactCornerTable> compact_table =
+        draco::CompactCornerTable::Create(*table);
+    ASSERT_NE(compact_table, nullptr);
+    ASSERT_NO_FATAL_FAILURE(CompareTables(*table, *compact_table));
+    // The compact table is smaller than the vertices and opposite corners of
+    // CornerTable alone.
+    ASSERT_LT(compact_table->num_bytes(),
+              table->num_corners() * 2 * sizeof(uint32_t));
+
+    // Reconstructed vertex corners are the same as the original ones.
+    const size_t num_bytes = compact_table->num_bytes();
+    compact_table->ReleaseVertexCorners();
+    ASSERT_FALSE(compact_table->has_vertex_corners() &&
+                 table->num_vertices() > 0);
+    ASSERT_LT(compact_table->num_bytes(), num_bytes);
+    compact_table->ComputeVertexCorners();
+    ASSERT_TRUE(compact_table->has_vertex_corners());
+    ASSERT_NO_FATAL_FAILURE(CompareTables(*table, *compact_table));
+
+    // Both tables are traversed and predicted the same way.
+    std::vector<draco::CornerIndex> corners, ref_corners;
+    std::vector<int32_t> vertices, ref_vertices;
+    ASSERT_NO_FATAL_FAILURE(
+        Traverse<draco::MaxPredictionDegreeTraverser>(*table, &ref_corners,
+                                                      &ref_vertices));
+    ASSERT_NO_FATAL_FAILURE(Traverse<draco::MaxPredictionDegreeTraverser>(
+        *compact_table, &corners, &vertices));
+    ASSERT_EQ(corners, ref_corners);
+    ASSERT_EQ(vertices, ref_vertices);
+    ASSERT_NO_FATAL_FAILURE(Traverse<draco::DepthFirstTraverser>(
+        *table, &ref_corners, &ref_vertices));
+    ASSERT_NO_FATAL_FAILURE(Traverse<draco::DepthFirstTraverser>(
+        *compact_table, &corners, &vertices));
+    ASSERT_EQ(corners, ref_corners);
+    ASSERT_EQ(vertices, ref_vertices);
+
+    const draco::PointAttribute *const pos_att =
+        mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    std::vector<int32_t> values;
+    for (const draco::CornerIndex c : corners) {
+      const draco::PointIndex point =
+          mesh->face(draco::FaceIndex(c.value() / 3))[c.value() % 3];
+      std::array<float, 3> position;
+      pos_att->GetMappedValue(point, &position[0]);
+      for (const float component : position) {
+        values.push_back(static_cast<int32_t>(component * 1000.f));
+      }
+    }
+    ASSERT_EQ(
+        ComputeParallelogramCorrections(*compact_table, *mesh, corners,
+                                        vertices, values),
+        ComputeParallelogramCorrections(*table, *mesh, corners, vertices,
+                                        values));
+  }
+};
+
+TEST_F(CompactCornerTableTest, TestMeshes) {
+  TestFile("cube_att.obj");
+  TestFile("test_nm.obj");
+  TestFile("bun_zipper.ply");
+}
+
+TEST_F(CompactCornerTableTest, TestNonManifoldFaces) {
+  // Tests a table created from faces with degenerated faces, an isolated
+  // vertex and a non-manifold vertex shared by two separate fans.
+  typedef draco::CornerTable::FaceType FaceType;
+  draco::IndexTypeVector<draco::FaceIndex, FaceType> faces;
+  const int kFaces[][3] = {{0, 1, 2}, {0, 2, 3}, {0, 4, 5}, {0, 5, 6},
+                           {1, 1, 2}, {2, 1, 7}, {0, 6, 4}};
+  for (const auto &face : kFaces) {
+    faces.push_back({{draco::VertexIndex(face[0]), draco::VertexIndex(face[1]),
+                      draco::VertexIndex(face[2])}});
+  }
+  faces.push_back({{draco::VertexIndex(9), draco::VertexIndex(10),
+                    draco::VertexIndex(9)}});
+  const std::unique_ptr<draco::CornerTable> table =
+      draco::CornerTable::Create(faces);
+  ASSERT_NE(table, nullptr);
+  std::unique_ptr<draco::CompactCornerTable> compact_table =
+      draco::CompactCornerTable::Create(faces);
+  ASSERT_NE(compact_table, nullptr);
+  ASSERT_GT(table->NumNewVertices(), 0);
+  ASSERT_GT(table->NumDegeneratedFaces(), 0);
+  ASSERT_GT(table->NumIsolatedVertices(), 0);
+  ASSERT_NO_FATAL_FAILURE(CompareTables(*table, *compact_table));
+  compact_table->ReleaseVertexCorners();
+  compact_table->ComputeVertexCorners();
+  ASSERT_NO_FATAL_FAILURE(CompareTables(*table, *compact_table));
+}
+
+}  // namespace
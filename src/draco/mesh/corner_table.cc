@@ -14,15 +14,66 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 
 namespace draco {
 
-CornerTable::CornerTable()
-    : num_original_vertices_(0),
+namespace {
+
+// Maximum number of buckets used for sorting half-edges by their vertices.
+constexpr int kMaxNumHalfEdgeBuckets = 1 << 16;
+
+// Half-edge defined by its opposite corner and by its two vertices sorted by
+// their index. Both half-edges of an edge have the same vertices.
+struct SortedHalfEdge {
+  uint32_t min_vertex;
+  uint32_t max_vertex;
+  CornerIndex corner;
+
+  bool operator<(const SortedHalfEdge &other) const {
+    if (min_vertex != other.min_vertex) {
+      return min_vertex < other.min_vertex;
+    }
+    if (max_vertex != other.max_vertex) {
+      return max_vertex < other.max_vertex;
+    }
+    return corner < other.corner;
+  }
+};
+
+// Returns the start of the |i|-th of |num_ranges| ranges of a similar size
+// covering [0, |size|).
+inline uint32_t RangeStart(size_t size, int num_ranges, int i) {
+  return static_cast<uint32_t>(size * i / num_ranges);
+}
+
+// Runs |function(i)| for each i in [0, |num_tasks|) on |pool| and waits until
+// all of them are finished.
+template <class FunctionT>
+void RunTasks(ThreadPool *pool, int num_tasks, const FunctionT &function) {
+  for (int i = 0; i < num_tasks; ++i) {
+    pool->Schedule([&function, i]() { function(i); });
+  }
+  pool->Wait();
+}
+
+}  // namespace
+
+CornerTable::CornerTable() : CornerTable(nullptr) {}
+
+CornerTable::CornerTable(Arena *arena)
+    : corner_to_vertex_map_(ArenaAllocator<VertexIndex>(arena)),
+      opposite_corners_(ArenaAllocator<CornerIndex>(arena)),
+      vertex_corners_(ArenaAllocator<CornerIndex>(arena)),
+      num_original_vertices_(0),
       num_degenerated_faces_(0),
       num_isolated_vertices_(0),
       valence_cache_(*this) {}
@@ -36,6 +87,15 @@ std::unique_ptr<CornerTable> CornerTable::Create(
   return ct;
 }
 
+std::unique_ptr<CornerTable> CornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces, int num_threads) {
+  std::unique_ptr<CornerTable> ct(new CornerTable());
+  if (!ct->Init(faces, num_threads)) {
+    return nullptr;
+  }
+  return ct;
+}
+
 bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
@@ -58,6 +118,49 @@ bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
   return true;
 }
 
+bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+                       int num_threads) {
+  if (num_threads <= 1) {
+    return Init(faces);
+  }
+  valence_cache_.ClearValenceCache();
+  valence_cache_.ClearValenceCacheInaccurate();
+  corner_to_vertex_map_.resize(faces.size() * 3);
+  ThreadPool pool(num_threads);
+  RunTasks(&pool, num_threads, [&](int task) {
+    const FaceIndex end_face(RangeStart(faces.size(), num_threads, task + 1));
+    for (FaceIndex fi(RangeStart(faces.size(), num_threads, task));
+         fi < end_face; ++fi) {
+      for (int i = 0; i < 3; ++i) {
+        corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
+      }
+    }
+  });
+  int num_vertices = -1;
+  if (!ComputeOppositeCornersParallel(&pool, &num_vertices)) {
+    return false;
+  }
+  std::vector<CornerIndex> fan_corners;
+  bool has_folded_fans = false;
+  if (!FindFanCornersParallel(&pool, &fan_corners, &has_folded_fans)) {
+    return false;
+  }
+  // BreakNonManifoldEdges() is serial, but it can change the table only when
+  // some 1-ring fan is folded.
+  if (has_folded_fans) {
+    if (!BreakNonManifoldEdges()) {
+      return false;
+    }
+    if (!FindFanCornersParallel(&pool, &fan_corners, &has_folded_fans)) {
+      return false;
+    }
+  }
+  if (!ComputeVertexCornersParallel(&pool, num_vertices, fan_corners)) {
+    return false;
+  }
+  return true;
+}
+
 bool CornerTable::Reset(int num_faces) {
   return Reset(num_faces, num_faces * 3);
 }
@@ -208,6 +311,154 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   return true;
 }
 
+bool CornerTable::ComputeOppositeCornersParallel(ThreadPool *pool,
+                                                 int *num_vertices) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  if (num_vertices == nullptr) {
+    return false;
+  }
+  opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
+  const int num_tasks = pool->num_threads();
+  const size_t total_faces = num_faces();
+
+  // Compute the number of vertices and the number of degenerated faces.
+  std::vector<uint32_t> task_num_vertices(num_tasks, 0);
+  std::vector<int> task_num_degenerated_faces(num_tasks, 0);
+  RunTasks(pool, num_tasks, [&](int task) {
+    const FaceIndex end_face(RangeStart(total_faces, num_tasks, task + 1));
+    for (FaceIndex f(RangeStart(total_faces, num_tasks, task)); f < end_face;
+         ++f) {
+      for (int i = 0; i < 3; ++i) {
+        task_num_vertices[task] = std::max(
+            task_num_vertices[task], Vertex(FirstCorner(f) + i).value() + 1);
+      }
+      if (IsDegenerated(f)) {
+        ++task_num_degenerated_faces[task];
+      }
+    }
+  });
+  uint32_t total_vertices = 0;
+  for (int task = 0; task < num_tasks; ++task) {
+    total_vertices = std::max(total_vertices, task_num_vertices[task]);
+    num_degenerated_faces_ += task_num_degenerated_faces[task];
+  }
+
+  // Sort the half-edges of all non-degenerated faces into buckets by their
+  // smaller vertex. Each task counts the half-edges of its faces in each
+  // bucket first. Half-edges of each bucket are then stored in the order of
+  // their corners.
+  int bucket_shift = 0;
+  while ((total_vertices >> bucket_shift) >= kMaxNumHalfEdgeBuckets) {
+    ++bucket_shift;
+  }
+  const int num_buckets = (total_vertices >> bucket_shift) + 1;
+  const auto get_half_edge = [this](CornerIndex c) {
+    const uint32_t v0 = Vertex(Next(c)).value();
+    const uint32_t v1 = Vertex(Previous(c)).value();
+    return SortedHalfEdge{std::min(v0, v1), std::max(v0, v1), c};
+  };
+  std::vector<std::vector<uint32_t>> task_bucket_offsets(
+      num_tasks, std::vector<uint32_t>(num_buckets, 0));
+  RunTasks(pool, num_tasks, [&](int task) {
+    std::vector<uint32_t> &counts = task_bucket_offsets[task];
+    const FaceIndex end_face(RangeStart(total_faces, num_tasks, task + 1));
+    for (FaceIndex f(RangeStart(total_faces, num_tasks, task)); f < end_face;
+         ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (int i = 0; i < 3; ++i) {
+        ++counts[get_half_edge(FirstCorner(f) + i).min_vertex >> bucket_shift];
+      }
+    }
+  });
+  std::vector<uint32_t> bucket_starts(num_buckets + 1);
+  uint32_t num_half_edges = 0;
+  for (int b = 0; b < num_buckets; ++b) {
+    bucket_starts[b] = num_half_edges;
+    for (int task = 0; task < num_tasks; ++task) {
+      const uint32_t count = task_bucket_offsets[task][b];
+      task_bucket_offsets[task][b] = num_half_edges;
+      num_half_edges += count;
+    }
+  }
+  bucket_starts[num_buckets] = num_half_edges;
+  std::vector<SortedHalfEdge> half_edges(num_half_edges);
+  RunTasks(pool, num_tasks, [&](int task) {
+    std::vector<uint32_t> &offsets = task_bucket_offsets[task];
+    const FaceIndex end_face(RangeStart(total_faces, num_tasks, task + 1));
+    for (FaceIndex f(RangeStart(total_faces, num_tasks, task)); f < end_face;
+         ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (int i = 0; i < 3; ++i) {
+        const SortedHalfEdge half_edge = get_half_edge(FirstCorner(f) + i);
+        half_edges[offsets[half_edge.min_vertex >> bucket_shift]++] =
+            half_edge;
+      }
+    }
+  });
+
+  // Sort the half-edges in each bucket and connect the half-edges of each
+  // edge. The buckets are split into tasks with a similar number of
+  // half-edges.
+  const int num_match_tasks = 4 * num_tasks;
+  std::vector<int> task_first_buckets(num_match_tasks + 1, num_buckets);
+  for (int task = 0; task < num_match_tasks; ++task) {
+    task_first_buckets[task] = static_cast<int>(
+        std::lower_bound(bucket_starts.begin(), bucket_starts.end(),
+                         RangeStart(num_half_edges, num_match_tasks, task)) -
+        bucket_starts.begin());
+  }
+  RunTasks(pool, num_match_tasks, [&](int task) {
+    // Unmatched half-edges of the current edge for both orientations of the
+    // edge, in the order of their corners.
+    std::vector<CornerIndex> open_half_edges[2];
+    for (int b = task_first_buckets[task]; b < task_first_buckets[task + 1];
+         ++b) {
+      SortedHalfEdge *edge_begin = half_edges.data() + bucket_starts[b];
+      SortedHalfEdge *const bucket_end =
+          half_edges.data() + bucket_starts[b + 1];
+      std::sort(edge_begin, bucket_end);
+      while (edge_begin != bucket_end) {
+        SortedHalfEdge *edge_end = edge_begin + 1;
+        while (edge_end != bucket_end &&
+               edge_end->min_vertex == edge_begin->min_vertex &&
+               edge_end->max_vertex == edge_begin->max_vertex) {
+          ++edge_end;
+        }
+        // Each half-edge is connected to the first unmatched half-edge of the
+        // opposite orientation, the same way as in ComputeOppositeCorners().
+        open_half_edges[0].clear();
+        open_half_edges[1].clear();
+        for (const SortedHalfEdge *he = edge_begin; he != edge_end; ++he) {
+          const CornerIndex c = he->corner;
+          const VertexIndex tip_v = Vertex(c);
+          const int orientation =
+              Vertex(Next(c)).value() == he->min_vertex ? 0 : 1;
+          std::vector<CornerIndex> &opposite_half_edges =
+              open_half_edges[1 - orientation];
+          auto it = opposite_half_edges.begin();
+          while (it != opposite_half_edges.end() && Vertex(*it) == tip_v) {
+            ++it;  // Don't connect mirrored faces.
+          }
+          if (it == opposite_half_edges.end()) {
+            open_half_edges[orientation].push_back(c);
+          } else {
+            opposite_corners_[c] = *it;
+            opposite_corners_[*it] = c;
+            opposite_half_edges.erase(it);
+          }
+        }
+        edge_begin = edge_end;
+      }
+    }
+  });
+  *num_vertices = static_cast<int>(total_vertices);
+  return true;
+}
+
 bool CornerTable::BreakNonManifoldEdges() {
   // This function detects and breaks non-manifold edges that are caused by
   // folds in 1-ring neighborhood around a vertex. Non-manifold edges can occur
@@ -397,6 +648,161 @@ bool CornerTable::ComputeVertexCorners(int num_vertices) {
   return true;
 }
 
+bool CornerTable::FindFanCornersParallel(
+    ThreadPool *pool, std::vector<CornerIndex> *out_fan_corners,
+    bool *out_has_folded_fans) {
+  const int num_tasks = pool->num_threads();
+  const size_t total_faces = num_faces();
+
+  // Each task walks the fans of its unvisited corners and stores the smallest
+  // corner of the fan for all of its corners. A fan reached by several tasks
+  // at the same time can be walked more than once, but never twice by the
+  // same task, so the total work stays linear in the number of corners.
+  const uint32_t kUnvisited = kInvalidCornerIndex.value();
+  std::unique_ptr<std::atomic<uint32_t>[]> fan_first_corners(
+      new std::atomic<uint32_t>[num_corners()]);
+  RunTasks(pool, num_tasks, [&](int task) {
+    const uint32_t end = RangeStart(num_corners(), num_tasks, task + 1);
+    for (uint32_t i = RangeStart(num_corners(), num_tasks, task); i < end;
+         ++i) {
+      fan_first_corners[i].store(kUnvisited, std::memory_order_relaxed);
+    }
+  });
+  std::vector<uint8_t> task_has_folded_fans(num_tasks, 0);
+  RunTasks(pool, num_tasks, [&](int task) {
+    std::vector<CornerIndex> fan;
+    std::vector<VertexIndex> ring;
+    const FaceIndex end_face(RangeStart(total_faces, num_tasks, task + 1));
+    for (FaceIndex f(RangeStart(total_faces, num_tasks, task)); f < end_face;
+         ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (int k = 0; k < 3; ++k) {
+        const CornerIndex c = FirstCorner(f) + k;
+        if (fan_first_corners[c.value()].load(std::memory_order_relaxed) !=
+            kUnvisited) {
+          continue;
+        }
+        // Collect the fan the same way as ComputeVertexCorners().
+        fan.clear();
+        CornerIndex act_c(c);
+        do {
+          fan.push_back(act_c);
+          act_c = SwingLeft(act_c);
+        } while (act_c != kInvalidCornerIndex && act_c != c);
+        const bool is_open_fan = act_c == kInvalidCornerIndex;
+        if (is_open_fan) {
+          for (act_c = SwingRight(c); act_c != kInvalidCornerIndex;
+               act_c = SwingRight(act_c)) {
+            fan.push_back(act_c);
+          }
+        }
+        const CornerIndex first_c = *std::min_element(fan.begin(), fan.end());
+        // The ring of vertices around the fan. The fan is folded when the
+        // ring passes a vertex more than once, which is the only case where
+        // BreakNonManifoldEdges() changes the table.
+        ring.clear();
+        for (const CornerIndex fan_c : fan) {
+          fan_first_corners[fan_c.value()].store(first_c.value(),
+                                                 std::memory_order_relaxed);
+          ring.push_back(Vertex(Next(fan_c)));
+          if (is_open_fan && SwingRight(fan_c) == kInvalidCornerIndex) {
+            ring.push_back(Vertex(Previous(fan_c)));
+          }
+        }
+        std::sort(ring.begin(), ring.end());
+        if (std::adjacent_find(ring.begin(), ring.end()) != ring.end()) {
+          task_has_folded_fans[task] = 1;
+        }
+      }
+    }
+  });
+
+  // The first corners of the fans in the order of their corners, which is the
+  // order in which ComputeVertexCorners() visits the fans.
+  std::vector<std::vector<CornerIndex>> task_fan_corners(num_tasks);
+  RunTasks(pool, num_tasks, [&](int task) {
+    const uint32_t end = RangeStart(num_corners(), num_tasks, task + 1);
+    for (uint32_t i = RangeStart(num_corners(), num_tasks, task); i < end;
+         ++i) {
+      if (fan_first_corners[i].load(std::memory_order_relaxed) == i) {
+        task_fan_corners[task].push_back(CornerIndex(i));
+      }
+    }
+  });
+  out_fan_corners->clear();
+  for (const std::vector<CornerIndex> &corners : task_fan_corners) {
+    out_fan_corners->insert(out_fan_corners->end(), corners.begin(),
+                            corners.end());
+  }
+  *out_has_folded_fans =
+      std::find(task_has_folded_fans.begin(), task_has_folded_fans.end(),
+                1) != task_has_folded_fans.end();
+  return true;
+}
+
+bool CornerTable::ComputeVertexCornersParallel(
+    ThreadPool *pool, int num_vertices,
+    const std::vector<CornerIndex> &fan_corners) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  num_original_vertices_ = num_vertices;
+  vertex_corners_.resize(num_vertices, kInvalidCornerIndex);
+  const int num_tasks = pool->num_threads();
+
+  // Assign vertices to the fans. Each fan of an already visited vertex is a
+  // new non-manifold vertex.
+  std::vector<bool> visited_vertices(num_vertices, false);
+  std::vector<VertexIndex> fan_vertices(fan_corners.size());
+  for (size_t i = 0; i < fan_corners.size(); ++i) {
+    VertexIndex v = corner_to_vertex_map_[fan_corners[i]];
+    if (visited_vertices[v.value()]) {
+      vertex_corners_.push_back(kInvalidCornerIndex);
+      non_manifold_vertex_parents_.push_back(v);
+      v = VertexIndex(num_vertices++);
+    } else {
+      visited_vertices[v.value()] = true;
+    }
+    fan_vertices[i] = v;
+  }
+  num_isolated_vertices_ = static_cast<int>(
+      std::count(visited_vertices.begin(), visited_vertices.end(), false));
+
+  // Update the corners of all fans.
+  RunTasks(pool, num_tasks, [&](int task) {
+    const uint32_t end = RangeStart(fan_corners.size(), num_tasks, task + 1);
+    for (uint32_t i = RangeStart(fan_corners.size(), num_tasks, task); i < end;
+         ++i) {
+      const CornerIndex c = fan_corners[i];
+      const VertexIndex v = fan_vertices[i];
+      const bool is_non_manifold_vertex =
+          v.value() >= static_cast<uint32_t>(num_original_vertices_);
+      CornerIndex act_c(c);
+      while (act_c != kInvalidCornerIndex) {
+        // Vertex will eventually point to the left most corner.
+        vertex_corners_[v] = act_c;
+        if (is_non_manifold_vertex) {
+          corner_to_vertex_map_[act_c] = v;
+        }
+        act_c = SwingLeft(act_c);
+        if (act_c == c) {
+          break;  // Full circle reached.
+        }
+      }
+      if (act_c == kInvalidCornerIndex) {
+        act_c = SwingRight(c);
+        while (act_c != kInvalidCornerIndex) {
+          if (is_non_manifold_vertex) {
+            corner_to_vertex_map_[act_c] = v;
+          }
+          act_c = SwingRight(act_c);
+        }
+      }
+    }
+  });
+  return true;
+}
+
 bool CornerTable::IsDegenerated(FaceIndex face) const {
   if (face == kInvalidFaceIndex) {
     return true;
@@ -19,12 +19,15 @@
 #include <memory>
 
 #include "draco/attributes/geometry_indices.h"
+#include "draco/core/arena.h"
 #include "draco/core/draco_index_type_vector.h"
 #include "draco/core/macros.h"
 #include "draco/mesh/valence_cache.h"
 
 namespace draco {
 
+class ThreadPool;
+
 // CornerTable is used to represent connectivity of triangular meshes.
 // For every corner of all faces, the corner table stores the index of the
 // opposite corner in the neighboring face (if it exists) as illustrated in the
@@ -55,13 +58,23 @@ class CornerTable {
   typedef std::array<VertexIndex, 3> FaceType;
 
   CornerTable();
+  // Creates a corner table whose connectivity data is allocated from |arena|.
+  // The arena must outlive the corner table. A null |arena| uses the heap.
+  explicit CornerTable(Arena *arena);
   static std::unique_ptr<CornerTable> Create(
       const IndexTypeVector<FaceIndex, FaceType> &faces);
+  // Same as above, but the table is computed by |num_threads| threads. The
+  // table is the same for any number of threads.
+  static std::unique_ptr<CornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces, int num_threads);
 
   // Initializes the CornerTable from provides set of indexed faces.
   // The input faces can represent a non-manifold topology, in which case the
   // non-manifold edges and vertices are going to be split.
   bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces);
+  // Same as above, but the table is computed by |num_threads| threads.
+  bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+            int num_threads);
 
   // Resets the corner table to the given number of invalid faces.
   bool Reset(int num_faces);
@@ -374,10 +387,33 @@ class CornerTable {
   // vertices.
   bool ComputeVertexCorners(int num_vertices);
 
+  // Parallel versions of the functions above that compute the same data.
+  // Half-edges are sorted by their vertices using a bucket sort, and the
+  // half-edges of each edge are then matched in the same order as in
+  // ComputeOppositeCorners().
+  bool ComputeOppositeCornersParallel(ThreadPool *pool, int *num_vertices);
+  // Finds the first corner of each 1-ring fan, i.e., the corner from which
+  // ComputeVertexCorners() would visit the fan, in a single walk over each
+  // fan. |out_has_folded_fans| is set to true when the vertex ring of some
+  // fan passes a vertex twice. Otherwise BreakNonManifoldEdges() would not
+  // change the table.
+  bool FindFanCornersParallel(ThreadPool *pool,
+                              std::vector<CornerIndex> *out_fan_corners,
+                              bool *out_has_folded_fans);
+  // New vertices are assigned to the fans found by FindFanCornersParallel()
+  // serially, and the corners of all fans are then updated in parallel.
+  bool ComputeVertexCornersParallel(
+      ThreadPool *pool, int num_vertices,
+      const std::vector<CornerIndex> &fan_corners);
+
+  template <class IndexT, class ValueT>
+  using ArenaIndexTypeVector =
+      IndexTypeVector<IndexT, ValueT, ArenaAllocator<ValueT>>;
+
   // Each three consecutive corners represent one face.
-  IndexTypeVector<CornerIndex, VertexIndex> corner_to_vertex_map_;
-  IndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
-  IndexTypeVector<VertexIndex, CornerIndex> vertex_corners_;
+  ArenaIndexTypeVector<CornerIndex, VertexIndex> corner_to_vertex_map_;
+  ArenaIndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
+  ArenaIndexTypeVector<VertexIndex, CornerIndex> vertex_corners_;
 
   int num_original_vertices_;
   int num_degenerated_faces_;
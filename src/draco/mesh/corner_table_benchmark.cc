@@ -0,0 +1,204 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmark of the memory use and traversal speed of CornerTable compared to
+// CompactCornerTable on a grid mesh. The faces of the grid are stored either
+// row by row or in a shuffled order that mimics meshes with poor locality.
+// The construction of CornerTable is timed with one and with multiple
+// threads.
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "draco/compression/mesh/traverser/depth_first_traverser.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/mesh/compact_corner_table.h"
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/corner_table_iterators.h"
+
+namespace {
+
+typedef draco::CornerTable::FaceType FaceType;
+
+// Observer that sums the visited corners so that the traversal is not
+// optimized away.
+class SumObserver {
+ public:
+  SumObserver() : sum_(nullptr) {}
+  explicit SumObserver(uint64_t *sum) : sum_(sum) {}
+  void OnNewFaceVisited(draco::FaceIndex /* face */) {}
+  void OnNewVertexVisited(draco::VertexIndex /* vertex */,
+                          draco::CornerIndex corner) {
+    *sum_ += corner.value();
+  }
+
+ private:
+  uint64_t *sum_;
+};
+
+// Returns the faces of a grid of |size| x |size| quads split into triangles.
+draco::IndexTypeVector<draco::FaceIndex, FaceType> CreateGrid(int size,
+                                                              bool shuffle) {
+  draco::IndexTypeVector<draco::FaceIndex, FaceType> faces;
+  const auto vertex = [size](int x, int y) {
+    return draco::VertexIndex(y * (size + 1) + x);
+  };
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      faces.push_back({{vertex(x, y), vertex(x + 1, y), vertex(x, y + 1)}});
+      faces.push_back(
+          {{vertex(x + 1, y), vertex(x + 1, y + 1), vertex(x, y + 1)}});
+    }
+  }
+  if (shuffle) {
+    uint32_t state = 1;
+    for (size_t i = faces.size() - 1; i > 0; --i) {
+      state = state * 1664525u + 1013904223u;
+      std::swap(faces[draco::FaceIndex(static_cast<uint32_t>(i))],
+                faces[draco::FaceIndex(state % static_cast<uint32_t>(i + 1))]);
+    }
+  }
+  return faces;
+}
+
+// Runs the traversal benchmarks on |table| and prints their times.
+template <class CornerTableT>
+uint64_t RunTraversals(const char *name, const CornerTableT &table,
+                       size_t num_bytes) {
+  draco::CycleTimer timer;
+  uint64_t sum = 0;
+
+  timer.Start();
+  for (draco::CornerIndex c(0); c < table.num_corners(); ++c) {
+    sum += table.Vertex(c).value();
+  }
+  timer.Stop();
+  const int64_t vertex_ms = timer.GetInMs();
+
+  timer.Start();
+  for (draco::VertexIndex v(0); v < table.num_vertices(); ++v) {
+    sum += table.Valence(v);
+  }
+  timer.Stop();
+  const int64_t valence_ms = timer.GetInMs();
+
+  timer.Start();
+  for (draco::CornerIndex c(0); c < table.num_corners(); ++c) {
+    sum += table.SwingRight(c).value() + table.SwingLeft(c).value();
+  }
+  timer.Stop();
+  const int64_t swing_ms = timer.GetInMs();
+
+  timer.Start();
+  draco::DepthFirstTraverser<CornerTableT, SumObserver> traverser;
+  traverser.Init(&table, SumObserver(&sum));
+  traverser.OnTraversalStart();
+  for (draco::FaceIndex f(0); f < table.num_faces(); ++f) {
+    traverser.TraverseFromCorner(table.FirstCorner(f));
+  }
+  traverser.OnTraversalEnd();
+  timer.Stop();
+  const int64_t traversal_ms = timer.GetInMs();
+
+  printf("  %-8s %8.1f MB  vertex %5" PRId64 " ms  valence %5" PRId64
+         " ms  swing %5" PRId64 " ms  traversal %5" PRId64 " ms\n",
+         name, num_bytes / (1024.0 * 1024.0), vertex_ms, valence_ms, swing_ms,
+         traversal_ms);
+  return sum;
+}
+
+// Creates corner tables of |faces| with one and with |num_threads| threads
+// and prints their times. Returns the table created by one thread.
+std::unique_ptr<draco::CornerTable> RunCreate(
+    const draco::IndexTypeVector<draco::FaceIndex, FaceType> &faces,
+    int num_threads) {
+  draco::CycleTimer timer;
+  timer.Start();
+  std::unique_ptr<draco::CornerTable> table = draco::CornerTable::Create(faces);
+  timer.Stop();
+  const int64_t serial_ms = timer.GetInMs();
+
+  timer.Start();
+  const std::unique_ptr<draco::CornerTable> parallel_table =
+      draco::CornerTable::Create(faces, num_threads);
+  timer.Stop();
+  const int64_t parallel_ms = timer.GetInMs();
+  if (table == nullptr || parallel_table == nullptr) {
+    return nullptr;
+  }
+  for (draco::CornerIndex c(0); c < table->num_corners(); ++c) {
+    if (table->Opposite(c) != parallel_table->Opposite(c)) {
+      printf("Parallel corner table does not match.\n");
+      return nullptr;
+    }
+  }
+  printf("  Create   serial %5" PRId64 " ms  parallel %5" PRId64
+         " ms (%d threads)\n",
+         serial_ms, parallel_ms, num_threads);
+  return table;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int grid_size = 1000;
+  int num_threads = 4;
+  if (argc > 1) {
+    grid_size = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_threads = atoi(argv[2]);
+  }
+  if (grid_size < 1 || num_threads < 1) {
+    printf("Usage: %s [grid_size] [num_threads]\n", argv[0]);
+    return -1;
+  }
+  for (const bool shuffle : {false, true}) {
+    const draco::IndexTypeVector<draco::FaceIndex, FaceType> faces =
+        CreateGrid(grid_size, shuffle);
+    printf("%zu faces in %s order:\n", faces.size(),
+           shuffle ? "shuffled" : "row");
+    std::unique_ptr<draco::CornerTable> table = RunCreate(faces, num_threads);
+    if (table == nullptr) {
+      printf("Failed to create the corner tables.\n");
+      return -1;
+    }
+    // Size of the corner to vertex map, the opposite corners, the vertex
+    // corners and the parents of new vertices.
+    const size_t num_bytes =
+        table->num_corners() * 2 * sizeof(uint32_t) +
+        (table->num_vertices() + table->NumNewVertices()) * sizeof(uint32_t);
+    const uint64_t sum = RunTraversals("Table", *table, num_bytes);
+    std::unique_ptr<draco::CompactCornerTable> compact_table =
+        draco::CompactCornerTable::Create(*table);
+    if (compact_table == nullptr) {
+      printf("Failed to create the compact corner table.\n");
+      return -1;
+    }
+    table.reset();
+    const uint64_t compact_sum = RunTraversals(
+        "Compact", *compact_table, compact_table->num_bytes());
+    compact_table->ReleaseVertexCorners();
+    printf("  Compact table without vertex corners: %.1f MB\n",
+           compact_table->num_bytes() / (1024.0 * 1024.0));
+    if (sum != compact_sum) {
+      printf("Traversals do not match.\n");
+      return -1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,156 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/corner_table.h"
+
+#include <memory>
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace {
+
+typedef draco::IndexTypeVector<draco::FaceIndex, draco::CornerTable::FaceType>
+    FaceVector;
+
+// Verifies that the corner tables computed from |faces| by multiple threads
+// are the same as the table computed by a single thread.
+void CompareParallelCornerTables(const FaceVector &faces) {
+  const std::unique_ptr<draco::CornerTable> expected =
+      draco::CornerTable::Create(faces);
+  ASSERT_NE(expected, nullptr);
+  for (const int num_threads : {2, 3, 8}) {
+    SCOPED_TRACE(num_threads);
+    const std::unique_ptr<draco::CornerTable> table =
+        draco::CornerTable::Create(faces, num_threads);
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->num_corners(), expected->num_corners());
+    ASSERT_EQ(table->num_vertices(), expected->num_vertices());
+    ASSERT_EQ(table->NumOriginalVertices(), expected->NumOriginalVertices());
+    ASSERT_EQ(table->NumDegeneratedFaces(), expected->NumDegeneratedFaces());
+    ASSERT_EQ(table->NumIsolatedVertices(), expected->NumIsolatedVertices());
+    for (draco::CornerIndex c(0); c < table->num_corners(); ++c) {
+      ASSERT_EQ(table->Vertex(c), expected->Vertex(c));
+      ASSERT_EQ(table->Opposite(c), expected->Opposite(c));
+    }
+    for (draco::VertexIndex v(0); v < table->num_vertices(); ++v) {
+      ASSERT_EQ(table->LeftMostCorner(v), expected->LeftMostCorner(v));
+      ASSERT_EQ(table->VertexParent(v), expected->VertexParent(v));
+    }
+  }
+}
+
+// Returns the faces of the position attribute of mesh |file_name|.
+FaceVector GetPositionFaces(const std::string &file_name) {
+  FaceVector faces;
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile(file_name);
+  if (mesh == nullptr) {
+    return faces;
+  }
+  const draco::PointAttribute *const att =
+      mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  faces.resize(mesh->num_faces());
+  for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      faces[f][c] = att->mapped_index(mesh->face(f)[c]).value();
+    }
+  }
+  return faces;
+}
+
+TEST(CornerTableTest, TestParallelCreate) {
+  for (const std::string file_name :
+       {"bun_zipper.ply", "test_nm.obj", "cube_att.obj"}) {
+    SCOPED_TRACE(file_name);
+    const FaceVector faces = GetPositionFaces(file_name);
+    ASSERT_GT(faces.size(), 0);
+    CompareParallelCornerTables(faces);
+  }
+}
+
+TEST(CornerTableTest, TestParallelCreateFromAttributes) {
+  // Tables of meshes split on attribute seams.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  const std::unique_ptr<draco::CornerTable> expected =
+      draco::CreateCornerTableFromAllAttributes(mesh.get());
+  const std::unique_ptr<draco::CornerTable> table =
+      draco::CreateCornerTableFromAllAttributes(mesh.get(), 4);
+  ASSERT_NE(expected, nullptr);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(table->num_vertices(), expected->num_vertices());
+  for (draco::CornerIndex c(0); c < table->num_corners(); ++c) {
+    ASSERT_EQ(table->Vertex(c), expected->Vertex(c));
+    ASSERT_EQ(table->Opposite(c), expected->Opposite(c));
+  }
+}
+
+TEST(CornerTableTest, TestParallelCreateNonManifold) {
+  // Faces with non-manifold edges and vertices, mirrored faces, degenerated
+  // faces and isolated vertices.
+  FaceVector faces;
+  const auto add_face = [&faces](uint32_t v0, uint32_t v1, uint32_t v2) {
+    faces.push_back({{draco::VertexIndex(v0), draco::VertexIndex(v1),
+                      draco::VertexIndex(v2)}});
+  };
+  add_face(0, 1, 2);
+  add_face(2, 1, 3);
+  add_face(1, 2, 4);  // Third face on edge 1-2.
+  add_face(2, 1, 5);  // Fourth face on edge 1-2.
+  add_face(0, 1, 2);  // Duplicate face.
+  add_face(2, 1, 0);  // Mirrored face.
+  add_face(6, 6, 7);  // Degenerated face.
+  add_face(3, 8, 9);  // Vertex 3 connects two fans.
+  add_face(12, 13, 14);
+  add_face(14, 13, 15);
+  add_face(10, 10, 10);
+  CompareParallelCornerTables(faces);
+
+  // The 1-ring of vertex 0 is folded over edge 0-1 (ring 1, 2, 3, 1, 4).
+  faces.clear();
+  add_face(0, 1, 2);
+  add_face(0, 2, 3);
+  add_face(0, 3, 1);
+  add_face(0, 1, 4);
+  CompareParallelCornerTables(faces);
+
+  // Random faces on a small number of vertices have many non-manifold edges.
+  uint32_t seed = 1;
+  const auto random_vertex = [&seed](uint32_t num_vertices) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % num_vertices;
+  };
+  faces.clear();
+  for (int i = 0; i < 2000; ++i) {
+    add_face(random_vertex(60), random_vertex(60), random_vertex(60));
+  }
+  CompareParallelCornerTables(faces);
+
+  // Vertices that don't fit into a single half-edge bucket each.
+  faces.clear();
+  for (int i = 0; i < 20000; ++i) {
+    add_face(random_vertex(1 << 18), random_vertex(1 << 18), i % 1000);
+  }
+  CompareParallelCornerTables(faces);
+
+  // Empty table.
+  faces.clear();
+  CompareParallelCornerTables(faces);
+}
+
+}  // namespace
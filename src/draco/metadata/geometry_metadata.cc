@@ -18,6 +18,14 @@
 
 namespace draco {
 
+GeometryMetadata::GeometryMetadata(const GeometryMetadata &metadata)
+    : Metadata(metadata) {
+  for (const auto &att_metadata : metadata.att_metadatas_) {
+    att_metadatas_.push_back(std::unique_ptr<AttributeMetadata>(
+        new AttributeMetadata(*att_metadata)));
+  }
+}
+
 const AttributeMetadata *GeometryMetadata::GetAttributeMetadataByStringEntry(
     const std::string &entry_name, const std::string &entry_value) const {
   for (auto &&att_metadata : att_metadatas_) {
@@ -100,7 +100,7 @@ bool MetadataDecoder::DecodeMetadata(Metadata *metadata) {
     if (!DecodeVarint(&num_sub_metadata, buffer_)) {
       return false;
     }
-    if (num_sub_metadata > buffer_->remaining_size()) {
+    if (!buffer_->CheckRemainingSize(num_sub_metadata)) {
       // The decoded number of metadata items is unreasonably high.
       return false;
     }
@@ -31,6 +31,17 @@ int PointCloudBuilder::AddAttribute(GeometryAttribute::Type attribute_type,
   return point_cloud_->AddAttribute(ga, true, point_cloud_->num_points());
 }
 
+int PointCloudBuilder::AddAttribute(GeometryAttribute::Type attribute_type,
+                                    int8_t num_components, DataType data_type,
+                                    std::unique_ptr<DataBuffer> buffer) {
+  std::unique_ptr<PointAttribute> pa(new PointAttribute());
+  if (!pa->Init(attribute_type, num_components, data_type, false,
+                point_cloud_->num_points(), std::move(buffer))) {
+    return -1;
+  }
+  return point_cloud_->AddAttribute(std::move(pa));
+}
+
 void PointCloudBuilder::SetAttributeValueForPoint(int att_id,
                                                   PointIndex point_index,
                                                   const void *attribute_value) {
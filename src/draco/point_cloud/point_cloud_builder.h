@@ -46,6 +46,15 @@ class PointCloudBuilder {
   int AddAttribute(GeometryAttribute::Type attribute_type,
                    int8_t num_components, DataType data_type);
 
+  // Same as above, but the attribute values are stored in |buffer| that can
+  // use external memory (see DataBuffer::SetExternalData()). Values already
+  // stored in |buffer| are kept, and values set through the builder are
+  // written directly into it. Returns -1 when |buffer| can't hold the values
+  // of all points.
+  int AddAttribute(GeometryAttribute::Type attribute_type,
+                   int8_t num_components, DataType data_type,
+                   std::unique_ptr<DataBuffer> buffer);
+
   // Sets attribute value for a specific point.
   // |attribute_value| must contain data in the format specified by the
   // AddAttribute method.
@@ -112,6 +112,56 @@ TEST_F(PointCloudBuilderTest, BatchTest) {
   }
 }
 
+TEST_F(PointCloudBuilderTest, ExternalDataTest) {
+  // This test verifies that PointCloudBuilder can construct point cloud with
+  // attribute values stored in external memory.
+  std::vector<float> pos_memory = pos_data_;
+  std::vector<int16_t> intensity_memory(intensity_data_.size());
+  PointCloudBuilder builder;
+  builder.Start(10);
+  std::unique_ptr<DataBuffer> pos_buffer(new DataBuffer());
+  pos_buffer->SetExternalData(reinterpret_cast<uint8_t *>(pos_memory.data()),
+                              pos_memory.size() * sizeof(float));
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32,
+                           std::move(pos_buffer));
+  std::unique_ptr<DataBuffer> intensity_buffer(new DataBuffer());
+  intensity_buffer->SetExternalData(
+      reinterpret_cast<uint8_t *>(intensity_memory.data()),
+      intensity_memory.size() * sizeof(int16_t));
+  const int intensity_att_id =
+      builder.AddAttribute(GeometryAttribute::GENERIC, 1, DT_INT16,
+                           std::move(intensity_buffer));
+  ASSERT_GE(pos_att_id, 0);
+  ASSERT_GE(intensity_att_id, 0);
+  builder.SetAttributeValuesForAllPoints(intensity_att_id,
+                                         intensity_data_.data(), 0);
+  // The values were written directly into the external memory.
+  ASSERT_EQ(intensity_memory, intensity_data_);
+
+  // Memory that is too small for all points is rejected.
+  std::vector<float> small_memory(3);
+  std::unique_ptr<DataBuffer> small_buffer(new DataBuffer());
+  small_buffer->SetExternalData(
+      reinterpret_cast<uint8_t *>(small_memory.data()),
+      small_memory.size() * sizeof(float));
+  ASSERT_EQ(builder.AddAttribute(GeometryAttribute::NORMAL, 3, DT_FLOAT32,
+                                 std::move(small_buffer)),
+            -1);
+
+  std::unique_ptr<PointCloud> res = builder.Finalize(false);
+  ASSERT_TRUE(res != nullptr);
+  ASSERT_EQ(res->attribute(pos_att_id)->buffer()->data(),
+            reinterpret_cast<uint8_t *>(pos_memory.data()));
+  for (PointIndex i(0); i < 10; ++i) {
+    float pos_val[3];
+    res->attribute(pos_att_id)->GetMappedValue(i, pos_val);
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(pos_val[c], pos_data_[3 * i.value() + c]);
+    }
+  }
+}
+
 TEST_F(PointCloudBuilderTest, MultiUse) {
   // This test verifies that PointCloudBuilder can be used multiple times
   PointCloudBuilder builder;
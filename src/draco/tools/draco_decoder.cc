@@ -15,6 +15,8 @@
 #include <cinttypes>
 
 #include "draco/compression/decode.h"
+#include "draco/compression/point_cloud/split_attribute_names.h"
+#include "draco/compression/point_cloud/split_container_decoder.h"
 #include "draco/core/cycle_timer.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/obj_encoder.h"
@@ -43,7 +45,8 @@ void Usage() {
   printf("Main options:\n");
   printf("  -h | -?               show help.\n");
   printf("  -o <output>           output file name.\n");
-  printf("  --split_attr          load attr data from seprate file.\n");
+  printf("  --split_attr <name>   load attr data from seprate file or from a\n");
+  printf("                        split container.\n");
   printf("  --format_output       format output.\n");
   printf("  --to_generic          decode attr to generic.\n");
 }
@@ -67,6 +70,67 @@ bool LoadDecoderBuffer(const std::string &filename, std::vector<char> &data,
   return true;
 }
 
+// Reads the header and the table of contents of a split container. Returns
+// false when |filename| is not a split container.
+bool LoadSplitContainer(const std::string &filename,
+                        draco::SplitContainerDecoder *container) {
+  std::vector<char> header_data;
+  if (!draco::ReadFileRangeToBuffer(filename, 0,
+                                    draco::kSplitContainerHeaderSize,
+                                    &header_data)) {
+    return false;
+  }
+  if (!draco::SplitContainerDecoder::IsSplitContainer(header_data.data(),
+                                                      header_data.size())) {
+    return false;
+  }
+  draco::DecoderBuffer header_buffer;
+  header_buffer.Init(header_data.data(), header_data.size());
+  uint32_t toc_size;
+  if (!container->DecodeHeader(&header_buffer, &toc_size).ok()) {
+    return false;
+  }
+  std::vector<char> toc_data;
+  if (!draco::ReadFileRangeToBuffer(filename, draco::kSplitContainerHeaderSize,
+                                    toc_size, &toc_data)) {
+    return false;
+  }
+  draco::DecoderBuffer toc_buffer;
+  toc_buffer.Init(toc_data.data(), toc_data.size());
+  return container->DecodeTableOfContents(&toc_buffer).ok();
+}
+
+// Reads a single chunk of a split container with a ranged read.
+bool LoadSplitContainerChunk(const std::string &filename,
+                             const draco::SplitContainerDecoder &container,
+                             const std::string &name, std::vector<char> &data,
+                             draco::DecoderBuffer &attr_buffer) {
+  const draco::SplitContainerEntry *const entry = container.FindEntry(name);
+  if (entry == nullptr || entry->size == 0) {
+    return false;
+  }
+  if (!draco::ReadFileRangeToBuffer(filename, entry->offset, entry->size,
+                                    &data)) {
+    return false;
+  }
+  attr_buffer.Init(data.data(), data.size());
+  return true;
+}
+
+// Reads the attribute chunk |name| either from the split container |input|
+// or from the file written next to |input| by the "split_attr" encoding mode.
+bool LoadSplitAttributeChunk(const std::string &input, bool is_container,
+                             const draco::SplitContainerDecoder &container,
+                             const std::string &name, std::vector<char> &data,
+                             draco::DecoderBuffer &attr_buffer) {
+  if (is_container) {
+    return LoadSplitContainerChunk(input, container, name, data, attr_buffer);
+  }
+  const std::string filename = input.substr(0, input.size() - 4) + '_' + name +
+                               input.substr(input.size() - 4);
+  return LoadDecoderBuffer(filename, data, attr_buffer);
+}
+
 int main(int argc, char **argv) {
   Options options;
   const int argc_check = argc - 1;
@@ -93,8 +157,22 @@ int main(int argc, char **argv) {
     return -1;
   }
 
+  // Split attribute data may be packed in a single container. In that case
+  // only the table of contents and the chunks we need are read.
+  draco::SplitContainerDecoder container;
+  const bool is_container =
+      options.split_attr && LoadSplitContainer(options.input, &container);
+
   std::vector<char> data;
-  if (!draco::ReadFileToBuffer(options.input, &data)) {
+  if (is_container) {
+    draco::DecoderBuffer unused_buffer;
+    if (!LoadSplitContainerChunk(options.input, container,
+                                 draco::kSplitContainerBaseName, data,
+                                 unused_buffer)) {
+      printf("Failed reading the base from the input container.\n");
+      return -1;
+    }
+  } else if (!draco::ReadFileToBuffer(options.input, &data)) {
     printf("Failed opening the input file.\n");
     return -1;
   }
@@ -141,25 +219,13 @@ int main(int argc, char **argv) {
     timer.Start();
 
     if (options.split_attr) {
-      const std::string filename =
-          options.input.substr(0, options.input.size() - 4);
-      const std::string fileext =
-          options.input.substr(options.input.size() - 4);
       // Create a draco decoding buffer. Note that no data is copied in this
       // step.
-      std::vector<char> pos_data;
-      draco::DecoderBuffer pos_buffer;
-      const std::string pos_filename = filename + "_position" + fileext;
-      if (!LoadDecoderBuffer(pos_filename, pos_data, pos_buffer)) {
-        return ReturnError(draco::Status(draco::Status::DRACO_ERROR,
-                                         "Load position buffer failed."));
-      }
-
       std::vector<char> attr_data;
       draco::DecoderBuffer attr_buffer;
-      const std::string attr_filename =
-          filename + '_' + options.attribute_name + fileext;
-      if (!LoadDecoderBuffer(attr_filename, attr_data, attr_buffer)) {
+      if (!LoadSplitAttributeChunk(options.input, is_container, container,
+                                   options.attribute_name, attr_data,
+                                   attr_buffer)) {
         return ReturnError(draco::Status(draco::Status::DRACO_ERROR,
                                          "Load attr buffer failed."));
       }
@@ -178,13 +244,26 @@ int main(int argc, char **argv) {
         pc = std::move(in_mesh);
       }
 
-      auto status = decoder.DecodeBufferAttrToGeometry(&pos_buffer, &header,
-                                                       "position", mesh);
-      if (!status.ok()) {
-        return ReturnError(status);
+      // Positions are needed by most of the other attributes. The name of
+      // their chunk is known only once the base is decoded.
+      const std::string pos_name = draco::GetSplitAttributeName(
+          *mesh, mesh->GetNamedAttributeId(draco::GeometryAttribute::POSITION));
+      if (pos_name != options.attribute_name) {
+        std::vector<char> pos_data;
+        draco::DecoderBuffer pos_buffer;
+        if (!LoadSplitAttributeChunk(options.input, is_container, container,
+                                     pos_name, pos_data, pos_buffer)) {
+          return ReturnError(draco::Status(draco::Status::DRACO_ERROR,
+                                           "Load position buffer failed."));
+        }
+        auto status = decoder.DecodeBufferAttrToGeometry(
+            &pos_buffer, &header, pos_name.c_str(), mesh);
+        if (!status.ok()) {
+          return ReturnError(status);
+        }
       }
 
-      status = decoder.DecodeBufferAttrToGeometry(
+      auto status = decoder.DecodeBufferAttrToGeometry(
           &attr_buffer, &header, options.attribute_name.c_str(), mesh);
       if (!status.ok()) {
         return ReturnError(status);
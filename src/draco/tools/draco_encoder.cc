@@ -40,7 +40,9 @@ struct Options {
   std::string output;
 
   bool split_attr = false;
+  bool split_container = false;
   bool format_output = false;
+  int interleaved_rans_states = 1;
 };
 
 Options::Options()
@@ -88,8 +90,15 @@ void Usage() {
       "mesh files.\n");
   printf(
       "  --split_attr          save attr data into seprate files.\n");
+  printf(
+      "  --split_container     save base and attr data into a single split "
+      "container.\n");
   printf(
       "  --format_output       format output.\n");
+  printf(
+      "  --interleaved_rans <value> number of interleaved rANS states used "
+      "for attribute values (4 or 8), requires a decoder supporting "
+      "interleaved rANS.\n");
   printf(
       "\nUse negative quantization values to skip the specified attribute\n");
 }
@@ -263,8 +272,20 @@ int main(int argc, char **argv) {
     } else if (!strcmp("--split_attr", argv[i])) {
       options.split_attr = true;
       options.use_metadata = true;
+    } else if (!strcmp("--split_container", argv[i])) {
+      options.split_attr = true;
+      options.split_container = true;
+      options.use_metadata = true;
     } else if (!strcmp("--format_output", argv[i])) {
       options.format_output = true;
+    } else if (!strcmp("--interleaved_rans", argv[i]) && i < argc_check) {
+      options.interleaved_rans_states = StringToInt(argv[++i]);
+      if (options.interleaved_rans_states != 4 &&
+          options.interleaved_rans_states != 8) {
+        printf("Error: The number of interleaved rANS states must be 4 or "
+               "8.\n");
+        return -1;
+      }
     }
   }
   if (argc < 3 || options.input.empty()) {
@@ -371,7 +392,9 @@ int main(int argc, char **argv) {
   // Set options
   auto &op = encoder.options();
   op.SetGlobalBool("split_attr", options.split_attr);
+  op.SetGlobalBool("split_container", options.split_container);
   op.SetGlobalBool("format_output", options.format_output);
+  op.SetGlobalInt("interleaved_rans_states", options.interleaved_rans_states);
   op.SetGlobalString("output", options.output);
 
   int ret = -1;
@@ -0,0 +1,121 @@
+// Copyright 2021 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/mesh_io.h"
+
+namespace {
+
+class DracoToolsTest : public ::testing::Test {
+ protected:
+  // Runs the command line tool |tool_name| with |args| and returns its exit
+  // code.
+  int RunTool(const std::string &tool_name, const std::string &args) {
+    const std::string command =
+        draco::GetToolFullPath(tool_name) + " " + args + " > /dev/null";
+    return std::system(command.c_str());
+  }
+
+  // Returns the sorted (x, y, z, value) tuples of the points of |mesh|, where
+  // value is the first component of the attribute |att_id|.
+  std::vector<std::array<float, 4>> GetSortedPoints(const draco::Mesh &mesh,
+                                                    int att_id) {
+    const draco::PointAttribute *const pos_att =
+        mesh.GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    const draco::PointAttribute *const att = mesh.attribute(att_id);
+    std::vector<std::array<float, 4>> points;
+    for (draco::PointIndex i(0); i < mesh.num_points(); ++i) {
+      std::array<float, 4> point;
+      pos_att->GetMappedValue(i, &point[0]);
+      att->GetMappedValue(i, &point[3]);
+      points.push_back(point);
+    }
+    std::sort(points.begin(), points.end());
+    return points;
+  }
+
+  // Encodes split_attr_names.ply into |out_name| using the encoder tool with
+  // |encoder_args| and checks that each of its generic attributes can be
+  // decoded separately using the decoder tool.
+  void TestSplitAttributes(const std::string &encoder_args,
+                           const std::string &out_name) {
+    const std::string in_file =
+        draco::GetTestFileFullPath("split_attr_names.ply");
+    const std::string out_file = draco::GetTestTempFileFullPath(out_name);
+    ASSERT_EQ(RunTool("draco_encoder", "-i " + in_file + " -o " + out_file +
+                                           " --metadata -qg 0 " +
+                                           encoder_args),
+              0);
+
+    const std::unique_ptr<draco::Mesh> in_mesh =
+        draco::ReadMeshFromTestFile("split_attr_names.ply");
+    ASSERT_NE(in_mesh, nullptr);
+    ASSERT_EQ(in_mesh->num_attributes(), 4);
+    // The generic attributes are named "base", "foo" and "foo" so none of
+    // them can be stored under its own name.
+    for (int att_id = 1; att_id < 4; ++att_id) {
+      const std::string chunk_name = "attribute_" + std::to_string(att_id);
+      const std::string dec_file =
+          draco::GetTestTempFileFullPath(out_name + "_" + chunk_name + ".ply");
+      ASSERT_EQ(RunTool("draco_decoder", "-i " + out_file + " -o " +
+                                             dec_file + " --split_attr " +
+                                             chunk_name),
+                0);
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> dec_mesh,
+                             draco::ReadMeshFromFile(dec_file));
+      // Only the requested attribute is written next to the positions.
+      ASSERT_EQ(dec_mesh->num_attributes(), 2);
+      ASSERT_EQ(GetSortedPoints(*dec_mesh, 1),
+                GetSortedPoints(*in_mesh, att_id));
+    }
+    // Duplicate names are not used as chunk names.
+    ASSERT_NE(RunTool("draco_decoder", "-i " + out_file + " -o " +
+                                           out_file + ".ply --split_attr foo"),
+              0);
+  }
+};
+
+TEST_F(DracoToolsTest, TestSplitContainerAttributeNames) {
+  TestSplitAttributes("--split_container", "split_names_container.drc");
+}
+
+TEST_F(DracoToolsTest, TestSplitFilesAttributeNames) {
+  TestSplitAttributes("--split_attr", "split_names_files.drc");
+}
+
+TEST_F(DracoToolsTest, TestSplitUnnamedAttributes) {
+  // Attributes of a mesh loaded without metadata have no names.
+  const std::string out_file =
+      draco::GetTestTempFileFullPath("split_unnamed.drc");
+  ASSERT_EQ(RunTool("draco_encoder",
+                    "-i " + draco::GetTestFileFullPath("cube_att.obj") +
+                        " -o " + out_file + " --split_container"),
+            0);
+  for (const std::string chunk_name :
+       {"attribute_0", "attribute_1", "attribute_2"}) {
+    ASSERT_EQ(RunTool("draco_decoder", "-i " + out_file + " -o " + out_file +
+                                           "_" + chunk_name +
+                                           ".obj --split_attr " + chunk_name),
+              0);
+  }
+}
+
+}  // namespace
@@ -33,40 +33,34 @@ draco::DracoAttribute *CreateDracoAttribute(const draco::PointAttribute *attr) {
 template <typename T>
 T *CopyAttributeData(int num_points, const draco::PointAttribute *attr) {
   const int num_components = attr->num_components();
+  if (num_components < 1 || num_components > 4) {
+    return nullptr;
+  }
   T *const data = new T[num_points * num_components];
-
-  for (draco::PointIndex i(0); i < num_points; ++i) {
-    const draco::AttributeValueIndex val_index = attr->mapped_index(i);
-    bool got_data = false;
-    switch (num_components) {
-      case 1:
-        got_data = attr->ConvertValue<T, 1>(val_index,
-                                            data + i.value() * num_components);
-        break;
-      case 2:
-        got_data = attr->ConvertValue<T, 2>(val_index,
-                                            data + i.value() * num_components);
-        break;
-      case 3:
-        got_data = attr->ConvertValue<T, 3>(val_index,
-                                            data + i.value() * num_components);
-        break;
-      case 4:
-        got_data = attr->ConvertValue<T, 4>(val_index,
-                                            data + i.value() * num_components);
-        break;
-      default:
-        break;
-    }
-    if (!got_data) {
-      delete[] data;
-      return nullptr;
-    }
+  if (!attr->ConvertMappedValues<T>(draco::PointIndex(0), num_points,
+                                    num_components, data)) {
+    delete[] data;
+    return nullptr;
   }
-
   return data;
 }
 
+// Writes the first attribute of |type| in |mesh| into |out_values| as floats
+// with |num_components| components per point.
+draco::Status WriteFloatArray(const draco::Mesh &mesh,
+                              draco::GeometryAttribute::Type type,
+                              int num_components, float *out_values) {
+  draco::MeshBufferLayout layout;
+  draco::VertexBufferAttribute out_att;
+  out_att.attribute_type = type;
+  out_att.num_components = num_components;
+  layout.attributes.push_back(out_att);
+  layout.vertex_data = reinterpret_cast<uint8_t *>(out_values);
+  layout.vertex_stride = num_components * sizeof(float);
+  layout.vertex_data_size = mesh.num_points() * layout.vertex_stride;
+  return draco::WriteMeshToBuffers(mesh, layout);
+}
+
 // Returns the attribute data in |attr| as an array of void*.
 void *ConvertAttributeData(int num_points, const draco::PointAttribute *attr) {
   switch (attr->data_type()) {
@@ -316,90 +310,68 @@ int DecodeMeshForUnity(char *data, unsigned int length,
     return -2;
   }
 
-  draco::Decoder decoder;
-  auto statusor = decoder.DecodeMeshFromBuffer(&buffer);
-  if (!statusor.ok()) {
-    return -3;
-  }
-  std::unique_ptr<draco::Mesh> in_mesh = std::move(statusor).value();
-
   *tmp_mesh = new DracoToUnityMesh();
   DracoToUnityMesh *unity_mesh = *tmp_mesh;
-  unity_mesh->num_faces = in_mesh->num_faces();
-  unity_mesh->num_vertices = in_mesh->num_points();
-
-  unity_mesh->indices = new int[in_mesh->num_faces() * 3];
-  for (draco::FaceIndex face_id(0); face_id < in_mesh->num_faces(); ++face_id) {
-    const Mesh::Face &face = in_mesh->face(draco::FaceIndex(face_id));
-    memcpy(unity_mesh->indices + face_id.value() * 3,
-           reinterpret_cast<const int *>(face.data()), sizeof(int) * 3);
-  }
+  bool decoded = false;
+  // The values are written straight into the arrays of |unity_mesh| once the
+  // number of points and faces is known.
+  const auto write_unity_mesh = [&](const draco::Mesh &mesh,
+                                    draco::MeshBufferLayout *layout)
+      -> draco::Status {
+    decoded = true;
+    unity_mesh->num_faces = mesh.num_faces();
+    unity_mesh->num_vertices = mesh.num_points();
+    unity_mesh->indices = new int[mesh.num_faces() * 3];
+    layout->index_data = unity_mesh->indices;
+    layout->index_data_size = mesh.num_faces() * 3 * sizeof(int);
+    layout->index_type = DT_UINT32;
 
-  // TODO(draco-eng): Add other attributes.
-  unity_mesh->position = new float[in_mesh->num_points() * 3];
-  const auto pos_att =
-      in_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
-  for (draco::PointIndex i(0); i < in_mesh->num_points(); ++i) {
-    const draco::AttributeValueIndex val_index = pos_att->mapped_index(i);
-    if (!pos_att->ConvertValue<float, 3>(
-            val_index, unity_mesh->position + i.value() * 3)) {
-      ReleaseUnityMesh(&unity_mesh);
-      return -8;
-    }
-  }
-  // Get normal attributes.
-  const auto normal_att =
-      in_mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
-  if (normal_att != nullptr) {
-    unity_mesh->normal = new float[in_mesh->num_points() * 3];
-    unity_mesh->has_normal = true;
-    for (draco::PointIndex i(0); i < in_mesh->num_points(); ++i) {
-      const draco::AttributeValueIndex val_index = normal_att->mapped_index(i);
-      if (!normal_att->ConvertValue<float, 3>(
-              val_index, unity_mesh->normal + i.value() * 3)) {
-        ReleaseUnityMesh(&unity_mesh);
-        return -8;
-      }
+    // TODO(draco-eng): Add other attributes.
+    unity_mesh->position = new float[mesh.num_points() * 3];
+    DRACO_RETURN_IF_ERROR(WriteFloatArray(
+        mesh, draco::GeometryAttribute::POSITION, 3, unity_mesh->position))
+    // Get normal attributes.
+    if (mesh.GetNamedAttribute(draco::GeometryAttribute::NORMAL) != nullptr) {
+      unity_mesh->normal = new float[mesh.num_points() * 3];
+      unity_mesh->has_normal = true;
+      DRACO_RETURN_IF_ERROR(WriteFloatArray(
+          mesh, draco::GeometryAttribute::NORMAL, 3, unity_mesh->normal))
     }
-  }
-  // Get color attributes.
-  const auto color_att =
-      in_mesh->GetNamedAttribute(draco::GeometryAttribute::COLOR);
-  if (color_att != nullptr) {
-    unity_mesh->color = new float[in_mesh->num_points() * 4];
-    unity_mesh->has_color = true;
-    for (draco::PointIndex i(0); i < in_mesh->num_points(); ++i) {
-      const draco::AttributeValueIndex val_index = color_att->mapped_index(i);
-      if (!color_att->ConvertValue<float, 4>(
-              val_index, unity_mesh->color + i.value() * 4)) {
-        ReleaseUnityMesh(&unity_mesh);
-        return -8;
-      }
+    // Get color attributes.
+    const auto color_att =
+        mesh.GetNamedAttribute(draco::GeometryAttribute::COLOR);
+    if (color_att != nullptr) {
+      unity_mesh->color = new float[mesh.num_points() * 4];
+      unity_mesh->has_color = true;
+      DRACO_RETURN_IF_ERROR(WriteFloatArray(
+          mesh, draco::GeometryAttribute::COLOR, 4, unity_mesh->color))
       if (color_att->num_components() < 4) {
         // If the alpha component wasn't set in the input data we should set
         // it to an opaque value.
-        unity_mesh->color[i.value() * 4 + 3] = 1.f;
+        for (int i = 0; i < mesh.num_points(); ++i) {
+          unity_mesh->color[i * 4 + 3] = 1.f;
+        }
       }
     }
-  }
-  // Get texture coordinates attributes.
-  const auto texcoord_att =
-      in_mesh->GetNamedAttribute(draco::GeometryAttribute::TEX_COORD);
-  if (texcoord_att != nullptr) {
-    unity_mesh->texcoord = new float[in_mesh->num_points() * 2];
-    unity_mesh->has_texcoord = true;
-    for (draco::PointIndex i(0); i < in_mesh->num_points(); ++i) {
-      const draco::AttributeValueIndex val_index =
-          texcoord_att->mapped_index(i);
-      if (!texcoord_att->ConvertValue<float, 2>(
-              val_index, unity_mesh->texcoord + i.value() * 2)) {
-        ReleaseUnityMesh(&unity_mesh);
-        return -8;
-      }
+    // Get texture coordinates attributes.
+    if (mesh.GetNamedAttribute(draco::GeometryAttribute::TEX_COORD) !=
+        nullptr) {
+      unity_mesh->texcoord = new float[mesh.num_points() * 2];
+      unity_mesh->has_texcoord = true;
+      DRACO_RETURN_IF_ERROR(WriteFloatArray(
+          mesh, draco::GeometryAttribute::TEX_COORD, 2, unity_mesh->texcoord))
     }
+    return draco::OkStatus();
+  };
+
+  draco::Decoder decoder;
+  if (!decoder.DecodeMeshToBuffers(&buffer, write_unity_mesh).ok()) {
+    ReleaseUnityMesh(&unity_mesh);
+    *tmp_mesh = nullptr;
+    return decoded ? -8 : -3;
   }
 
-  return in_mesh->num_faces();
+  return unity_mesh->num_faces;
 }
 
 }  // namespace draco